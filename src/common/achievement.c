@@ -1,11 +1,20 @@
 #include "achievement.h"
+#include "intern.h"
 #include "memory.h"
 #include "diagnostics/log.h"
+#include "diagnostics/memory_accounting.h"
 
 #include <inttypes.h>
 #include <obs-module.h>
 #include <stdlib.h>
 
+achievement_t *alloc_achievement(void) {
+
+    memory_account(MEMORY_TAG_MODEL, (int64_t)sizeof(achievement_t));
+
+    return bzalloc(sizeof(achievement_t));
+}
+
 achievement_t *copy_achievement(const achievement_t *achievement) {
 
     if (!achievement) {
@@ -20,13 +29,13 @@ achievement_t *copy_achievement(const achievement_t *achievement) {
     while (current) {
         const achievement_t *next = current->next;
 
-        achievement_t *copy = bzalloc(sizeof(achievement_t));
+        achievement_t *copy = alloc_achievement();
 
-        copy->id                 = bstrdup(current->id);
-        copy->name               = bstrdup(current->name);
-        copy->description        = bstrdup(current->description);
-        copy->icon_url           = bstrdup(current->icon_url);
-        copy->measured_progress  = bstrdup(current->measured_progress);
+        copy->id                 = intern_string(current->id);
+        copy->name               = intern_string(current->name);
+        copy->description        = intern_string(current->description);
+        copy->icon_url           = intern_string(current->icon_url);
+        copy->measured_progress  = intern_string(current->measured_progress);
         copy->is_secret          = current->is_secret;
         copy->value              = current->value;
         copy->unlocked_timestamp = current->unlocked_timestamp;
@@ -58,13 +67,15 @@ void free_achievement(achievement_t **achievement) {
     while (current) {
         achievement_t *next = current->next;
 
-        free_memory((void **)&current->id);
-        free_memory((void **)&current->name);
-        free_memory((void **)&current->description);
-        free_memory((void **)&current->icon_url);
-        free_memory((void **)&current->measured_progress);
+        intern_release(&current->id);
+        intern_release(&current->name);
+        intern_release(&current->description);
+        intern_release(&current->icon_url);
+        intern_release(&current->measured_progress);
         free_memory((void **)&current);
 
+        memory_account(MEMORY_TAG_MODEL, -(int64_t)sizeof(achievement_t));
+
         current = next;
     }
 
@@ -149,6 +160,49 @@ const achievement_t *get_random_locked_achievement(const achievement_t *achievem
     return NULL;
 }
 
+float get_achievement_progress(const achievement_t *achievement) {
+
+    if (!achievement) {
+        return -1.0f;
+    }
+
+    if (achievement->unlocked_timestamp != 0) {
+        return 1.0f;
+    }
+
+    if (!achievement->measured_progress) {
+        return -1.0f;
+    }
+
+    char        *end     = NULL;
+    const double current = strtod(achievement->measured_progress, &end);
+
+    if (end == achievement->measured_progress) {
+        return -1.0f;
+    }
+
+    double target = 0.0;
+
+    if (*end == '%') {
+        target = 100.0;
+    } else if (*end == '/') {
+        const char *denominator = end + 1;
+        target                  = strtod(denominator, &end);
+
+        if (end == denominator) {
+            return -1.0f;
+        }
+    }
+
+    if (target <= 0.0) {
+        return -1.0f;
+    }
+
+    const double ratio = current / target;
+
+    return ratio < 0.0 ? 0.0f : ratio > 1.0 ? 1.0f : (float)ratio;
+}
+
 void sort_achievements(achievement_t **achievements) {
 
     if (!achievements || !*achievements || !(*achievements)->next) {
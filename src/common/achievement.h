@@ -70,9 +70,23 @@ typedef struct achievement {
     struct achievement  *next;
 } achievement_t;
 
+/**
+ * @brief Allocates a zeroed achievement node.
+ *
+ * The node is accounted to the model memory tag and released by
+ * @ref free_achievement: allocate nodes with this function rather than
+ * bzalloc() so that the accounting balances.
+ *
+ * @return The new node, to be freed with @ref free_achievement.
+ */
+achievement_t *alloc_achievement(void);
+
 /**
  * @brief Deep-copies a linked list of generic achievements.
  *
+ * The string fields are interned (see intern.h): the copy shares them with
+ * @p achievement instead of duplicating them.
+ *
  * @param achievement Head of the source list (may be NULL).
  *
  * @return Head of the newly allocated list, or NULL if @p achievement is NULL.
@@ -133,6 +147,17 @@ int count_unlocked_achievements(const achievement_t *achievements);
  */
 const achievement_t *get_random_locked_achievement(const achievement_t *achievements);
 
+/**
+ * @brief Get the completion of an achievement as a ratio.
+ *
+ * Parses @c measured_progress ("5/10", or "50%").
+ *
+ * @param achievement Achievement to read (may be NULL).
+ * @return 1 if unlocked, the measured progress in [0, 1] if locked and
+ *         measured, or a negative value if the progress is unknown.
+ */
+float get_achievement_progress(const achievement_t *achievement);
+
 /**
  * @brief Sort achievements in place (unlocked first, then by timestamp descending).
  *
@@ -1,19 +1,28 @@
 #include "game.h"
 
+#include "intern.h"
 #include "memory.h"
+#include "diagnostics/memory_accounting.h"
 #include <obs-module.h>
 
+game_t *alloc_game(void) {
+
+    memory_account(MEMORY_TAG_MODEL, (int64_t)sizeof(game_t));
+
+    return bzalloc(sizeof(game_t));
+}
+
 game_t *copy_game(const game_t *game) {
 
     if (!game) {
         return NULL;
     }
 
-    game_t *copy       = bzalloc(sizeof(game_t));
-    copy->id           = bstrdup(game->id);
-    copy->title        = bstrdup(game->title);
-    copy->console_name = bstrdup(game->console_name);
-    copy->cover_url    = game->cover_url ? bstrdup(game->cover_url) : NULL;
+    game_t *copy       = alloc_game();
+    copy->id           = intern_string(game->id);
+    copy->title        = intern_string(game->title);
+    copy->console_name = intern_string(game->console_name);
+    copy->cover_url    = intern_string(game->cover_url);
 
     return copy;
 }
@@ -26,11 +35,13 @@ void free_game(game_t **game) {
 
     game_t *current = *game;
 
-    free_memory((void **)&current->id);
-    free_memory((void **)&current->title);
-    free_memory((void **)&current->console_name);
-    free_memory((void **)&current->cover_url);
+    intern_release((char **)&current->id);
+    intern_release((char **)&current->title);
+    intern_release((char **)&current->console_name);
+    intern_release((char **)&current->cover_url);
 
     bfree(current);
     *game = NULL;
+
+    memory_account(MEMORY_TAG_MODEL, -(int64_t)sizeof(game_t));
 }
@@ -12,7 +12,8 @@ extern "C" {
  * Ownership:
  * - Instances returned by @ref copy_game are owned by the caller and must be
  *   freed with @ref free_game.
- * - String fields are deep-copied by @ref copy_game and freed by @ref free_game.
+ * - String fields are interned (see intern.h): @ref copy_game shares them and
+ *   @ref free_game releases them. They must not be modified in place.
  */
 typedef struct game {
     /** Game identifier (service-provided). */
@@ -25,6 +26,17 @@ typedef struct game {
     const char *cover_url;
 } game_t;
 
+/**
+ * @brief Allocates a zeroed game object.
+ *
+ * The object is accounted to the model memory tag and released by
+ * @ref free_game: allocate games with this function rather than bzalloc() so
+ * that the accounting balances.
+ *
+ * @return The new object, to be freed with @ref free_game.
+ */
+game_t *alloc_game(void);
+
 /**
  * @brief Creates a deep copy of a game object.
  *
@@ -1,6 +1,69 @@
 #include "gamerscore.h"
 #include "integrations/xbox/contracts/xbox_unlocked_achievement.h"
 #include <obs-module.h>
+#include <stdint.h>
+#include <string.h>
+
+/** Minimum number of slots of the unlocked index. */
+#define UNLOCKED_INDEX_MIN_CAPACITY 16
+
+/**
+ * @brief FNV-1a hash of an achievement id.
+ */
+static uint32_t hash_id(const char *id) {
+
+    uint32_t hash = 2166136261u;
+
+    for (const unsigned char *c = (const unsigned char *)id; *c; c++) {
+        hash ^= *c;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Find the slot of an id in the unlocked index: its node, or the empty slot it would go to.
+ *
+ * The index must have at least one empty slot.
+ */
+static xbox_unlocked_achievement_t **find_slot(const gamerscore_t *gamerscore, const char *id) {
+
+    const size_t mask = gamerscore->unlocked_index_capacity - 1;
+
+    for (size_t i = hash_id(id) & mask;; i = (i + 1) & mask) {
+        xbox_unlocked_achievement_t **slot = &gamerscore->unlocked_index[i];
+
+        if (!*slot || strcmp((*slot)->id, id) == 0) {
+            return slot;
+        }
+    }
+}
+
+/**
+ * @brief Add a node to the unlocked index, growing it to keep the load under one half.
+ */
+static void index_unlocked_achievement(gamerscore_t *gamerscore, xbox_unlocked_achievement_t *node) {
+
+    if ((gamerscore->unlocked_index_count + 1) * 2 > gamerscore->unlocked_index_capacity) {
+        xbox_unlocked_achievement_t **previous          = gamerscore->unlocked_index;
+        const size_t                  previous_capacity = gamerscore->unlocked_index_capacity;
+
+        gamerscore->unlocked_index_capacity = previous_capacity ? previous_capacity * 2 : UNLOCKED_INDEX_MIN_CAPACITY;
+        gamerscore->unlocked_index = bzalloc(gamerscore->unlocked_index_capacity * sizeof(*gamerscore->unlocked_index));
+
+        for (size_t i = 0; i < previous_capacity; i++) {
+            if (previous[i]) {
+                *find_slot(gamerscore, previous[i]->id) = previous[i];
+            }
+        }
+
+        bfree(previous);
+    }
+
+    *find_slot(gamerscore, node->id) = node;
+    gamerscore->unlocked_index_count++;
+}
 
 gamerscore_t *copy_gamerscore(const gamerscore_t *gamerscore) {
 
@@ -12,6 +75,18 @@ gamerscore_t *copy_gamerscore(const gamerscore_t *gamerscore) {
 
     copy->base_value            = gamerscore->base_value;
     copy->unlocked_achievements = xbox_copy_unlocked_achievement(gamerscore->unlocked_achievements);
+    copy->unlocked_value        = gamerscore->unlocked_value;
+
+    xbox_unlocked_achievement_t *tail = NULL;
+
+    for (xbox_unlocked_achievement_t *node = copy->unlocked_achievements; node; node = node->next) {
+        if (node->id) {
+            index_unlocked_achievement(copy, node);
+        }
+        tail = node;
+    }
+
+    copy->unlocked_achievements_tail = tail;
 
     return copy;
 }
@@ -24,25 +99,45 @@ void free_gamerscore(gamerscore_t **gamerscore) {
 
     gamerscore_t *current = *gamerscore;
     xbox_free_unlocked_achievement(&current->unlocked_achievements);
+    bfree(current->unlocked_index);
 
     bfree(current);
     *gamerscore = NULL;
 }
 
-int gamerscore_compute(const gamerscore_t *gamerscore) {
+bool gamerscore_add_unlocked_achievement(gamerscore_t *gamerscore, const char *id, int value) {
 
-    if (!gamerscore) {
-        return 0;
+    if (!gamerscore || !id) {
+        return false;
+    }
+
+    if (gamerscore->unlocked_index && *find_slot(gamerscore, id)) {
+        return false;
     }
 
-    int total_value = gamerscore->base_value;
+    xbox_unlocked_achievement_t *unlocked_achievement = bzalloc(sizeof(xbox_unlocked_achievement_t));
+    unlocked_achievement->id                          = bstrdup(id);
+    unlocked_achievement->value                       = value;
 
-    const xbox_unlocked_achievement_t *current = gamerscore->unlocked_achievements;
+    index_unlocked_achievement(gamerscore, unlocked_achievement);
 
-    while (current) {
-        total_value += current->value;
-        current = current->next;
+    if (gamerscore->unlocked_achievements_tail) {
+        gamerscore->unlocked_achievements_tail->next = unlocked_achievement;
+    } else {
+        gamerscore->unlocked_achievements = unlocked_achievement;
+    }
+
+    gamerscore->unlocked_achievements_tail = unlocked_achievement;
+    gamerscore->unlocked_value += value;
+
+    return true;
+}
+
+int gamerscore_compute(const gamerscore_t *gamerscore) {
+
+    if (!gamerscore) {
+        return 0;
     }
 
-    return total_value;
+    return gamerscore->base_value + gamerscore->unlocked_value;
 }
@@ -2,6 +2,9 @@
 
 #include "integrations/xbox/contracts/xbox_unlocked_achievement.h"
 
+#include <stdbool.h>
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -15,6 +18,11 @@ extern "C" {
  * When an achievement is unlocked, the gamerscore is not immediately updated on the server so retrieving it
  * via the API is not working. Instead, I chose to keep track of all the unlocked achievements locally.
  *
+ * The sum of the unlocked values, the list tail and the id index are maintained
+ * by @ref gamerscore_add_unlocked_achievement so that appending and computing
+ * the total are O(1), even though the total is recomputed on every progress
+ * event. Fill the list through that function rather than directly.
+ *
  * Ownership:
  * - Instances returned by @ref copy_gamerscore are owned by the caller and must
  *   be freed with @ref free_gamerscore.
@@ -26,6 +34,16 @@ typedef struct gamerscore {
     int                          base_value;
     /** Linked list of unlocked achievements used to compute additional score. */
     xbox_unlocked_achievement_t *unlocked_achievements;
+    /** Last node of @c unlocked_achievements (borrowed), or NULL if the list is empty. */
+    xbox_unlocked_achievement_t *unlocked_achievements_tail;
+    /** Running sum of the values in @c unlocked_achievements. */
+    int                          unlocked_value;
+    /** Open-addressing index of @c unlocked_achievements by id (nodes borrowed), or NULL. */
+    xbox_unlocked_achievement_t **unlocked_index;
+    /** Number of slots of @c unlocked_index (a power of two, or 0). */
+    size_t                        unlocked_index_capacity;
+    /** Number of nodes in @c unlocked_index. */
+    size_t                        unlocked_index_count;
 } gamerscore_t;
 
 /**
@@ -39,10 +57,27 @@ typedef struct gamerscore {
  */
 gamerscore_t *copy_gamerscore(const gamerscore_t *gamerscore);
 
+/**
+ * @brief Records an unlocked achievement and adds its value to the running total.
+ *
+ * Idempotent: Xbox may deliver the same "Achieved" event several times, so an
+ * achievement whose id is already recorded is ignored. The ids are looked up in
+ * a hash index, in constant time.
+ *
+ * @param gamerscore Gamerscore container (may be NULL).
+ * @param id         Achievement id (copied). Must not be NULL.
+ * @param value      Gamerscore value of the achievement.
+ *
+ * @return true if the achievement was recorded; false if it was already
+ *         recorded or an argument is NULL.
+ */
+bool gamerscore_add_unlocked_achievement(gamerscore_t *gamerscore, const char *id, int value);
+
 /**
  * @brief Computes the total gamerscore.
  *
- * Returns @c base_value plus the sum of values from all unlocked achievements.
+ * Returns @c base_value plus the running sum of values from all unlocked
+ * achievements. Runs in constant time.
  *
  * @param gamerscore Gamerscore container (may be NULL).
  *
@@ -1,6 +1,7 @@
 #include "common/identity.h"
 
 #include "common/gamerscore.h"
+#include "common/intern.h"
 #include "common/memory.h"
 
 #include <obs-module.h>
@@ -26,8 +27,8 @@ identity_t *copy_identity(const identity_t *identity) {
     }
 
     identity_t *copy = alloc_identity();
-    copy->name       = identity->name ? bstrdup(identity->name) : NULL;
-    copy->avatar_url = identity->avatar_url ? bstrdup(identity->avatar_url) : NULL;
+    copy->name       = intern_string(identity->name);
+    copy->avatar_url = intern_string(identity->avatar_url);
     copy->score      = identity->score;
 
     return copy;
@@ -40,7 +41,7 @@ identity_t *identity_from_xbox(const xbox_identity_t *xbox_identity, const gamer
 
     identity_t *identity = alloc_identity();
     identity->source     = IDENTITY_SOURCE_XBOX;
-    identity->name       = xbox_identity->gamertag ? bstrdup(xbox_identity->gamertag) : NULL;
+    identity->name       = intern_string(xbox_identity->gamertag);
     identity->avatar_url = NULL;
 
     int computed    = gamerscore_compute(gamerscore);
@@ -59,9 +60,9 @@ identity_t *identity_from_retro(const retro_user_t *user) {
 
     /* Prefer display_name; fall back to username when it is empty. */
     const char *name = (user->display_name[0] != '\0') ? user->display_name : user->username;
-    identity->name   = bstrdup(name);
+    identity->name   = intern_string(name);
 
-    identity->avatar_url = (user->avatar_url[0] != '\0') ? bstrdup(user->avatar_url) : NULL;
+    identity->avatar_url = (user->avatar_url[0] != '\0') ? intern_string(user->avatar_url) : NULL;
 
     /* Pick the higher of hardcore and softcore scores. */
     identity->score = (user->score >= user->score_softcore) ? user->score : user->score_softcore;
@@ -76,8 +77,8 @@ void free_identity_t(identity_t **identity) {
 
     identity_t *current = *identity;
 
-    free_memory((void **)&current->name);
-    free_memory((void **)&current->avatar_url);
+    intern_release(&current->name);
+    intern_release(&current->avatar_url);
 
     bfree(current);
     *identity = NULL;
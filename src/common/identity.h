@@ -31,8 +31,8 @@ typedef enum {
  * - Instances returned by @ref copy_identity, @ref identity_from_xbox, or
  *   @ref identity_from_retro are owned by the caller and must be freed with
  *   @ref free_identity_t.
- * - All string fields are heap-allocated (via @c bstrdup / @c bzalloc) and
- *   freed by @ref free_identity_t.
+ * - String fields are interned (see intern.h) or heap-allocated via
+ *   @c bstrdup, and released by @ref free_identity_t.
  */
 typedef struct identity {
     /**
@@ -0,0 +1,191 @@
+#include "common/intern.h"
+
+#include <obs-module.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include "diagnostics/memory_accounting.h"
+#include "util/thread_compat.h"
+
+/** Initial number of buckets; the table doubles when it gets twice as full. */
+#define INTERN_INITIAL_BUCKETS 256
+
+/**
+ * @brief Pooled string, allocated in one block with its text.
+ */
+typedef struct intern_entry {
+    struct intern_entry *next;
+    uint32_t             hash;
+    uint32_t             references;
+    char                 text[];
+} intern_entry_t;
+
+static pthread_mutex_t  g_mutex        = PTHREAD_MUTEX_INITIALIZER;
+static intern_entry_t **g_buckets      = NULL;
+static size_t           g_bucket_count = 0;
+static size_t           g_entry_count  = 0;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Private functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+/** FNV-1a. */
+static uint32_t hash_text(const char *text) {
+
+    uint32_t hash = 2166136261u;
+
+    for (const unsigned char *c = (const unsigned char *)text; *c; c++) {
+        hash ^= *c;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Find the entry holding @p text.
+ *
+ * Must be called with the mutex held.
+ *
+ * @return The entry's link in its bucket, or NULL if @p text is not interned.
+ */
+static intern_entry_t **find_entry(const char *text, uint32_t hash) {
+
+    if (!g_buckets) {
+        return NULL;
+    }
+
+    for (intern_entry_t **link = &g_buckets[hash & (g_bucket_count - 1)]; *link; link = &(*link)->next) {
+        if ((*link)->hash == hash && strcmp((*link)->text, text) == 0) {
+            return link;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Double the bucket array, or create it.
+ *
+ * Must be called with the mutex held.
+ */
+static void grow_buckets(void) {
+
+    const size_t     bucket_count = g_bucket_count ? g_bucket_count * 2 : INTERN_INITIAL_BUCKETS;
+    intern_entry_t **buckets      = memory_alloc(MEMORY_TAG_MODEL, bucket_count * sizeof(intern_entry_t *));
+
+    for (size_t i = 0; i < g_bucket_count; i++) {
+        intern_entry_t *entry = g_buckets[i];
+
+        while (entry) {
+            intern_entry_t  *next = entry->next;
+            intern_entry_t **head = &buckets[entry->hash & (bucket_count - 1)];
+
+            entry->next = *head;
+            *head       = entry;
+            entry       = next;
+        }
+    }
+
+    memory_free(g_buckets);
+    g_buckets      = buckets;
+    g_bucket_count = bucket_count;
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public API
+//  --------------------------------------------------------------------------------------------------------------------
+
+char *intern_string(const char *text) {
+
+    if (!text) {
+        return NULL;
+    }
+
+    const uint32_t hash = hash_text(text);
+
+    pthread_mutex_lock(&g_mutex);
+
+    intern_entry_t **link = find_entry(text, hash);
+
+    if (link) {
+        (*link)->references++;
+        pthread_mutex_unlock(&g_mutex);
+        return (*link)->text;
+    }
+
+    if (g_entry_count >= g_bucket_count * 2) {
+        grow_buckets();
+    }
+
+    const size_t     length = strlen(text);
+    intern_entry_t  *entry  = memory_malloc(MEMORY_TAG_MODEL, sizeof(intern_entry_t) + length + 1);
+    intern_entry_t **head   = &g_buckets[hash & (g_bucket_count - 1)];
+
+    entry->hash       = hash;
+    entry->references = 1;
+    memcpy(entry->text, text, length + 1);
+
+    entry->next = *head;
+    *head       = entry;
+    g_entry_count++;
+
+    pthread_mutex_unlock(&g_mutex);
+
+    return entry->text;
+}
+
+void intern_release(char **text) {
+
+    if (!text || !*text) {
+        return;
+    }
+
+    const uint32_t hash = hash_text(*text);
+
+    pthread_mutex_lock(&g_mutex);
+
+    intern_entry_t **link = find_entry(*text, hash);
+
+    /* Same content but a different pointer: a plain bstrdup() copy */
+    if (!link || (*link)->text != *text) {
+        pthread_mutex_unlock(&g_mutex);
+        bfree(*text);
+        *text = NULL;
+        return;
+    }
+
+    intern_entry_t *entry = *link;
+
+    if (--entry->references == 0) {
+        *link = entry->next;
+        g_entry_count--;
+        memory_free(entry);
+    }
+
+    pthread_mutex_unlock(&g_mutex);
+
+    *text = NULL;
+}
+
+void intern_assign(char **text, const char *value) {
+
+    if (!text) {
+        return;
+    }
+
+    /* Intern first: value may be the string being released */
+    char *interned = intern_string(value);
+    intern_release(text);
+    *text = interned;
+}
+
+size_t intern_count(void) {
+
+    pthread_mutex_lock(&g_mutex);
+    const size_t count = g_entry_count;
+    pthread_mutex_unlock(&g_mutex);
+
+    return count;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file intern.h
+ * @brief Refcounted pool of immutable strings shared by the data model.
+ *
+ * Achievement, game and identity strings are copied many times over (the
+ * Xbox contract, the converted achievements, the cycle copy, the displayed
+ * game...). Interning keeps a single allocation per distinct text: taking
+ * another reference only bumps a counter.
+ *
+ * Interned strings are immutable. They are typed @c char* so they can be
+ * stored in the existing model fields, but must never be written to nor
+ * passed to bfree(): release them with @ref intern_release.
+ *
+ * @ref intern_release also accepts strings that were not interned (e.g.
+ * produced with bstrdup() by a parser) and frees them with bfree(), so a
+ * field may hold either kind.
+ *
+ * Thread safety:
+ *   All functions may be called from any thread.
+ */
+
+/**
+ * @brief Take a reference on the interned copy of @p text.
+ *
+ * Interns @p text on first use. @p text itself may be interned or not; it is
+ * never retained.
+ *
+ * @param text NUL-terminated string, or NULL.
+ *
+ * @return Interned string (release with @ref intern_release), or NULL if
+ *         @p text is NULL.
+ */
+char *intern_string(const char *text);
+
+/**
+ * @brief Release a string and set the caller's pointer to NULL.
+ *
+ * Drops one reference if @p *text is interned, the last one freeing it.
+ * Otherwise, frees @p *text with bfree(). Safe to call with NULL or with
+ * @c *text == NULL.
+ *
+ * @param[in,out] text Address of the string to release.
+ */
+void intern_release(char **text);
+
+/**
+ * @brief Replace @p *text with an interned copy of @p value.
+ *
+ * Releases the previous value with @ref intern_release.
+ *
+ * @param[in,out] text  Address of the field to update.
+ * @param         value New value (may be NULL).
+ */
+void intern_assign(char **text, const char *value);
+
+/**
+ * @brief Get the number of distinct strings currently interned.
+ */
+size_t intern_count(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -269,6 +269,27 @@ typedef struct achievement_cycle_timings {
     int locked_cycle_total_duration;
 } achievement_cycle_timings_t;
 
+/** Default seconds without traffic before the Xbox RTA connection is probed with a ping. */
+#define RTA_CONNECTION_DEFAULT_PING_INTERVAL      10
+/** Default upper bound (seconds) the ping interval stretches to while the connection stays healthy. */
+#define RTA_CONNECTION_DEFAULT_MAX_PING_INTERVAL  60
+/** Default seconds to wait for a pong before the connection is considered dead. */
+#define RTA_CONNECTION_DEFAULT_PONG_TIMEOUT        8
+
+/**
+ * @brief Keepalive and compression settings of the Xbox RTA websocket.
+ */
+typedef struct rta_connection_configuration {
+    /** Seconds without traffic before a ping is sent. Default: RTA_CONNECTION_DEFAULT_PING_INTERVAL. */
+    int  ping_interval;
+    /** Longest interval between pings on a healthy connection. Default: RTA_CONNECTION_DEFAULT_MAX_PING_INTERVAL. */
+    int  max_ping_interval;
+    /** Seconds to wait for the pong before reconnecting. Default: RTA_CONNECTION_DEFAULT_PONG_TIMEOUT. */
+    int  pong_timeout;
+    /** Whether permessage-deflate is offered during the handshake. Default: true. */
+    bool compression_enabled;
+} rta_connection_configuration_t;
+
 /**
  * @brief Dummy type to ensure OpenSSL public types are available to consumers.
  *
@@ -0,0 +1,286 @@
+#include "diagnostics/memory_accounting.h"
+
+#include <obs-module.h>
+#include <diagnostics/log.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "util/thread_compat.h"
+
+/** Marks the header of a tagged block; catches a bfree()'d or foreign pointer. */
+#define MEMORY_MAGIC 0x4D454D54u
+
+/**
+ * @brief Header stored in front of every tagged block.
+ *
+ * Padded to 16 bytes so that the returned blocks keep the allocator's alignment.
+ */
+typedef struct memory_header {
+    size_t   size;
+    uint32_t tag;
+    uint32_t magic;
+} memory_header_t;
+
+#define MEMORY_HEADER_SIZE 16
+
+static pthread_mutex_t g_mutex                    = PTHREAD_MUTEX_INITIALIZER;
+static memory_usage_t  g_usage[MEMORY_TAG_COUNT] = {0};
+
+static const char *const g_tag_names[MEMORY_TAG_COUNT] = {
+    "net",
+    "parse",
+    "model",
+    "render",
+    "cache",
+    "gpu",
+};
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Private functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+static bool is_valid_tag(memory_tag_t tag) {
+    return (int)tag >= 0 && tag < MEMORY_TAG_COUNT;
+}
+
+/**
+ * @brief Update the counters of a tag.
+ *
+ * @param bytes  Bytes allocated (positive) or released (negative).
+ * @param blocks Blocks allocated (1), released (-1) or resized (0).
+ */
+static void update_usage(memory_tag_t tag, int64_t bytes, int64_t blocks) {
+
+    if (!is_valid_tag(tag)) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_mutex);
+
+    memory_usage_t *usage = &g_usage[tag];
+
+    usage->live_bytes += bytes;
+    usage->live_blocks += blocks;
+
+    if (usage->live_bytes > usage->peak_bytes) {
+        usage->peak_bytes = usage->live_bytes;
+    }
+
+    pthread_mutex_unlock(&g_mutex);
+}
+
+static memory_header_t *header_of(void *pointer) {
+    return (memory_header_t *)((unsigned char *)pointer - MEMORY_HEADER_SIZE);
+}
+
+static void *block_of(memory_header_t *header) {
+    return (unsigned char *)header + MEMORY_HEADER_SIZE;
+}
+
+static void *wrap_block(memory_header_t *header, memory_tag_t tag, size_t size) {
+
+    if (!header) {
+        return NULL;
+    }
+
+    header->size  = size;
+    header->tag   = (uint32_t)tag;
+    header->magic = MEMORY_MAGIC;
+
+    update_usage(tag, (int64_t)size, 1);
+
+    return block_of(header);
+}
+
+/**
+ * @brief Format a byte count with a binary unit (e.g. "1.5 MiB").
+ */
+static void format_bytes(int64_t bytes, char *buffer, size_t size) {
+
+    const double value = (double)(bytes < 0 ? -bytes : bytes);
+    const char  *sign  = bytes < 0 ? "-" : "";
+
+    if (value >= 1024.0 * 1024.0) {
+        snprintf(buffer, size, "%s%.1f MiB", sign, value / (1024.0 * 1024.0));
+    } else if (value >= 1024.0) {
+        snprintf(buffer, size, "%s%.1f KiB", sign, value / 1024.0);
+    } else {
+        snprintf(buffer, size, "%s%" PRId64 " B", sign, (int64_t)value);
+    }
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public API
+//  --------------------------------------------------------------------------------------------------------------------
+
+void *memory_alloc(memory_tag_t tag, size_t size) {
+    return wrap_block(bzalloc(MEMORY_HEADER_SIZE + size), tag, size);
+}
+
+void *memory_malloc(memory_tag_t tag, size_t size) {
+    return wrap_block(bmalloc(MEMORY_HEADER_SIZE + size), tag, size);
+}
+
+void *memory_realloc(memory_tag_t tag, void *pointer, size_t size) {
+
+    if (!pointer) {
+        return memory_malloc(tag, size);
+    }
+
+    memory_header_t *header = header_of(pointer);
+
+    if (header->magic != MEMORY_MAGIC) {
+        obs_log(LOG_ERROR, "[Memory] Reallocation of an untagged block");
+        return NULL;
+    }
+
+    const memory_tag_t block_tag = (memory_tag_t)header->tag;
+    const size_t       old_size  = header->size;
+
+    header = brealloc(header, MEMORY_HEADER_SIZE + size);
+
+    if (!header) {
+        return NULL;
+    }
+
+    header->size = size;
+    update_usage(block_tag, (int64_t)size - (int64_t)old_size, 0);
+
+    return block_of(header);
+}
+
+char *memory_strdup(memory_tag_t tag, const char *text) {
+
+    if (!text) {
+        return NULL;
+    }
+
+    const size_t length = strlen(text);
+    char        *copy   = memory_malloc(tag, length + 1);
+
+    if (copy) {
+        memcpy(copy, text, length + 1);
+    }
+
+    return copy;
+}
+
+void memory_free(void *pointer) {
+
+    if (!pointer) {
+        return;
+    }
+
+    memory_header_t *header = header_of(pointer);
+
+    /* Leaking beats corrupting the heap: the counters will show it */
+    if (header->magic != MEMORY_MAGIC) {
+        obs_log(LOG_ERROR, "[Memory] Release of an untagged block");
+        return;
+    }
+
+    header->magic = 0;
+    update_usage((memory_tag_t)header->tag, -(int64_t)header->size, -1);
+
+    bfree(header);
+}
+
+void memory_account(memory_tag_t tag, int64_t bytes) {
+
+    if (bytes == 0) {
+        return;
+    }
+
+    update_usage(tag, bytes, bytes > 0 ? 1 : -1);
+}
+
+void memory_get_usage(memory_tag_t tag, memory_usage_t *usage) {
+
+    if (!usage) {
+        return;
+    }
+
+    if (!is_valid_tag(tag)) {
+        memset(usage, 0, sizeof(*usage));
+        return;
+    }
+
+    pthread_mutex_lock(&g_mutex);
+    *usage = g_usage[tag];
+    pthread_mutex_unlock(&g_mutex);
+}
+
+const char *memory_tag_name(memory_tag_t tag) {
+    return is_valid_tag(tag) ? g_tag_names[tag] : "unknown";
+}
+
+void memory_format_report(char *buffer, size_t size) {
+
+    if (!buffer || size == 0) {
+        return;
+    }
+
+    memory_usage_t usage[MEMORY_TAG_COUNT];
+
+    pthread_mutex_lock(&g_mutex);
+    memcpy(usage, g_usage, sizeof(usage));
+    pthread_mutex_unlock(&g_mutex);
+
+    size_t  length     = 0;
+    int64_t total_live = 0;
+
+    buffer[0] = '\0';
+
+    for (int tag = 0; tag < MEMORY_TAG_COUNT; tag++) {
+        char live[32];
+        char peak[32];
+
+        format_bytes(usage[tag].live_bytes, live, sizeof(live));
+        format_bytes(usage[tag].peak_bytes, peak, sizeof(peak));
+
+        const int written = snprintf(buffer + length,
+                                     size - length,
+                                     "%-6s %10s live (peak %s, %" PRId64 " blocks)\n",
+                                     g_tag_names[tag],
+                                     live,
+                                     peak,
+                                     usage[tag].live_blocks);
+
+        if (written < 0 || (size_t)written >= size - length) {
+            return;
+        }
+
+        length += (size_t)written;
+        total_live += usage[tag].live_bytes;
+    }
+
+    char total[32];
+    format_bytes(total_live, total, sizeof(total));
+
+    snprintf(buffer + length, size - length, "%-6s %10s live", "total", total);
+}
+
+void memory_log_report(const char *reason) {
+
+    char report[1024];
+    memory_format_report(report, sizeof(report));
+
+    obs_log(LOG_INFO, "[Memory] Usage (%s):", reason ? reason : "report");
+
+    /* One log line per tag keeps the OBS log readable */
+    char *line = report;
+
+    while (line && *line) {
+        char *end = strchr(line, '\n');
+
+        if (end) {
+            *end = '\0';
+        }
+
+        obs_log(LOG_INFO, "[Memory]   %s", line);
+
+        line = end ? end + 1 : NULL;
+    }
+}
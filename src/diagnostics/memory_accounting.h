@@ -0,0 +1,135 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file memory_accounting.h
+ * @brief Per-subsystem memory counters, to spot leaks and regressions on long streams.
+ *
+ * Two ways of feeding the counters:
+ *  - Tagged wrappers around the OBS allocator (@ref memory_alloc,
+ *    @ref memory_strdup, ...). They keep the size and tag in a small header in
+ *    front of the block, so @ref memory_free needs nothing else. A tagged block
+ *    must be freed with @ref memory_free, never with bfree(): use them only for
+ *    memory whose allocation and release are in the same module.
+ *  - @ref memory_account for memory allocated elsewhere (GPU textures) or whose
+ *    type can be freed by code outside the plugin's allocation helpers (model
+ *    nodes, see alloc_achievement()).
+ *
+ * Each tag keeps the bytes currently live, the peak and the number of live
+ * blocks. The report is written to the OBS log (@ref memory_log_report) and
+ * shown in the Achievement Tracker dialog (@ref memory_format_report).
+ *
+ * Thread safety:
+ *   All functions may be called from any thread.
+ */
+
+/**
+ * @brief Subsystem a block of memory is accounted to.
+ */
+typedef enum memory_tag {
+    /** Websocket receive buffers. */
+    MEMORY_TAG_NET,
+    /** JSON scratch arenas. */
+    MEMORY_TAG_PARSE,
+    /** Achievements, games and their interned text. */
+    MEMORY_TAG_MODEL,
+    /** Source instances and their images. */
+    MEMORY_TAG_RENDER,
+    /** Images being downloaded to the file cache. */
+    MEMORY_TAG_CACHE,
+    /** GPU textures (estimated at 4 bytes per pixel). */
+    MEMORY_TAG_GPU,
+    MEMORY_TAG_COUNT,
+} memory_tag_t;
+
+/**
+ * @brief Counters of one tag.
+ */
+typedef struct memory_usage {
+    /** Bytes currently allocated. */
+    int64_t live_bytes;
+    /** Highest value reached by @c live_bytes. */
+    int64_t peak_bytes;
+    /** Number of blocks currently allocated. */
+    int64_t live_blocks;
+} memory_usage_t;
+
+/**
+ * @brief Allocate a zeroed block (bzalloc) accounted to @p tag.
+ */
+void *memory_alloc(memory_tag_t tag, size_t size);
+
+/**
+ * @brief Allocate an uninitialized block (bmalloc) accounted to @p tag.
+ */
+void *memory_malloc(memory_tag_t tag, size_t size);
+
+/**
+ * @brief Resize a tagged block (brealloc).
+ *
+ * @param tag     Tag of the block (used when @p pointer is NULL).
+ * @param pointer Block returned by a tagged allocation, or NULL.
+ * @param size    New size.
+ *
+ * @return The resized block. The content is preserved up to the smaller size.
+ */
+void *memory_realloc(memory_tag_t tag, void *pointer, size_t size);
+
+/**
+ * @brief Duplicate a string into a block accounted to @p tag.
+ *
+ * @return The copy, or NULL if @p text is NULL.
+ */
+char *memory_strdup(memory_tag_t tag, const char *text);
+
+/**
+ * @brief Free a block returned by a tagged allocation. NULL is ignored.
+ */
+void memory_free(void *pointer);
+
+/**
+ * @brief Account memory that was not allocated by the tagged wrappers.
+ *
+ * @param tag   Tag to account to.
+ * @param bytes Bytes allocated (positive) or released (negative).
+ */
+void memory_account(memory_tag_t tag, int64_t bytes);
+
+/**
+ * @brief Get the counters of a tag.
+ *
+ * @param tag   Tag to read.
+ * @param usage Receives the counters (must not be NULL).
+ */
+void memory_get_usage(memory_tag_t tag, memory_usage_t *usage);
+
+/**
+ * @brief Short lowercase name of a tag (e.g. "net"), for the reports.
+ */
+const char *memory_tag_name(memory_tag_t tag);
+
+/**
+ * @brief Write a human-readable report, one line per tag plus a total.
+ *
+ * @param buffer Destination (always NUL-terminated when @p size > 0).
+ * @param size   Size of @p buffer.
+ */
+void memory_format_report(char *buffer, size_t size);
+
+/**
+ * @brief Write the report to the OBS log.
+ *
+ * @param reason Why the report is logged (e.g. "game changed").
+ */
+void memory_log_report(const char *reason);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,124 @@
+#include "progress_bar.h"
+
+#include <obs-module.h>
+#include <graphics/graphics.h>
+#include <graphics/vec2.h>
+#include <graphics/vec4.h>
+
+/* Static effect cached for the lifetime of the plugin */
+static gs_effect_t *progress_bar_effect         = NULL;
+static bool         progress_bar_load_attempted = false;
+
+/**
+ * @brief Create the progress bar effect on first use.
+ */
+static void load_progress_bar_effect(void) {
+
+    if (progress_bar_effect || progress_bar_load_attempted) {
+        return;
+    }
+
+    progress_bar_load_attempted = true;
+
+    const char *effect_code = "uniform float4x4 ViewProj;\n"
+                              "uniform float2 size;\n"
+                              "uniform float ratio;\n"
+                              "uniform float4 fill_color;\n"
+                              "uniform float4 background_color;\n"
+                              "uniform float opacity;\n"
+                              "\n"
+                              "struct VertInOut {\n"
+                              "    float4 pos : POSITION;\n"
+                              "    float2 uv  : TEXCOORD0;\n"
+                              "};\n"
+                              "\n"
+                              "VertInOut VSDefault(VertInOut vert_in)\n"
+                              "{\n"
+                              "    VertInOut vert_out;\n"
+                              "    vert_out.pos = mul(float4(vert_in.pos.xyz, 1.0), ViewProj);\n"
+                              "    vert_out.uv  = vert_in.uv;\n"
+                              "    return vert_out;\n"
+                              "}\n"
+                              "\n"
+                              "float4 PSProgressBar(VertInOut vert_in) : TARGET\n"
+                              "{\n"
+                              "    float2 pos    = vert_in.uv * size;\n"
+                              "    float  radius = size.y * 0.5;\n"
+                              "\n"
+                              "    /* Coverage of the capsule, anti-aliased over one pixel */\n"
+                              "    float  right    = max(radius, size.x - radius);\n"
+                              "    float2 center   = float2(clamp(pos.x, radius, right), radius);\n"
+                              "    float  coverage = saturate(radius - distance(pos, center) + 0.5);\n"
+                              "\n"
+                              "    /* Edge of the filled part, between two pixels for a fractional ratio */\n"
+                              "    float filled = saturate(ratio * size.x - pos.x + 0.5);\n"
+                              "\n"
+                              "    float4 color = lerp(background_color, fill_color, filled);\n"
+                              "    return float4(color.rgb, color.a * coverage * opacity);\n"
+                              "}\n"
+                              "\n"
+                              "technique Draw\n"
+                              "{\n"
+                              "    pass\n"
+                              "    {\n"
+                              "        vertex_shader = VSDefault(vert_in);\n"
+                              "        pixel_shader  = PSProgressBar(vert_in);\n"
+                              "    }\n"
+                              "}\n";
+
+    char *error_string  = NULL;
+    progress_bar_effect = gs_effect_create(effect_code, "progress_bar_effect", &error_string);
+
+    if (error_string) {
+        blog(LOG_ERROR, "[ProgressBar] Effect compile error: %s", error_string);
+        bfree(error_string);
+    }
+}
+
+void draw_progress_bar(const uint32_t width, const uint32_t height, float ratio, uint32_t fill_color,
+                       uint32_t background_color, float opacity) {
+
+    if (width == 0 || height == 0) {
+        return;
+    }
+
+    load_progress_bar_effect();
+
+    if (!progress_bar_effect) {
+        return;
+    }
+
+    struct vec2 size;
+    vec2_set(&size, (float)width, (float)height);
+
+    struct vec4 fill;
+    vec4_from_rgba(&fill, fill_color);
+
+    struct vec4 background;
+    vec4_from_rgba(&background, background_color);
+
+    gs_effect_set_vec2(gs_effect_get_param_by_name(progress_bar_effect, "size"), &size);
+    gs_effect_set_float(gs_effect_get_param_by_name(progress_bar_effect, "ratio"), ratio);
+    gs_effect_set_vec4(gs_effect_get_param_by_name(progress_bar_effect, "fill_color"), &fill);
+    gs_effect_set_vec4(gs_effect_get_param_by_name(progress_bar_effect, "background_color"), &background);
+    gs_effect_set_float(gs_effect_get_param_by_name(progress_bar_effect, "opacity"), opacity);
+
+    /* Works whether or not the caller already has an effect active */
+    gs_technique_t *tech = gs_effect_get_technique(progress_bar_effect, "Draw");
+
+    if (tech) {
+        gs_technique_begin(tech);
+        gs_technique_begin_pass(tech, 0);
+        gs_draw_sprite(NULL, 0, width, height);
+        gs_technique_end_pass(tech);
+        gs_technique_end(tech);
+    }
+}
+
+void progress_bar_cleanup(void) {
+
+    if (progress_bar_effect) {
+        gs_effect_destroy(progress_bar_effect);
+        progress_bar_effect = NULL;
+    }
+}
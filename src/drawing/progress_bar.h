@@ -0,0 +1,40 @@
+#pragma once
+
+#include <obs-module.h>
+#include <graphics/graphics.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Draw a progress bar with a pixel shader.
+ *
+ * Renders a capsule of @p width by @p height pixels at the current position,
+ * filled from the left up to @p ratio. The rounded ends and the edge of the
+ * filled part are anti-aliased by the shader, so a fractional @p ratio moves
+ * the edge smoothly between pixels: no texture or text is involved.
+ *
+ * Colors are packed as the OBS color properties (0xAABBGGRR).
+ *
+ * @param width            Width of the bar in pixels.
+ * @param height           Height of the bar in pixels.
+ * @param ratio            Filled part, in [0, 1].
+ * @param fill_color       Color of the filled part.
+ * @param background_color Color of the rest of the bar.
+ * @param opacity          Opacity (0.0 = transparent, 1.0 = opaque).
+ */
+void draw_progress_bar(uint32_t width, uint32_t height, float ratio, uint32_t fill_color, uint32_t background_color,
+                       float opacity);
+
+/**
+ * @brief Clean up progress bar drawing resources.
+ *
+ * Destroys the shader effect created by draw_progress_bar().
+ * Should be called during plugin unload.
+ */
+void progress_bar_cleanup(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,314 @@
+#include "integrations/asset_prefetch.h"
+
+#include <obs-module.h>
+#include <diagnostics/log.h>
+
+#include "common/types.h"
+#include "io/cache.h"
+#include "util/thread_compat.h"
+#include "util/worker_pool.h"
+
+/** Pause after each actual download so the image endpoints are not hammered. */
+#define PREFETCH_THROTTLE_MS 150
+
+/**
+ * @brief Single worker running the prefetch tasks, created on first use.
+ *
+ * A joinable pool rather than a detached thread so that asset_prefetch_stop()
+ * can guarantee no download is still running when the plugin unloads.
+ */
+static worker_pool_t  *g_pool       = NULL;
+static pthread_mutex_t g_mutex      = PTHREAD_MUTEX_INITIALIZER;
+static uint32_t        g_generation = 0;
+
+/** True while the downloads are deferred (no tracker source visible). */
+static bool              g_deferred        = false;
+/** Latest assets left to download, queued once the deferral ends. */
+static prefetch_asset_t *g_deferred_assets = NULL;
+
+/**
+ * @brief Context passed to the prefetch task.
+ */
+typedef struct prefetch_context {
+    /** Assets to download, in priority order. Freed with the context. */
+    prefetch_asset_t *assets;
+    /** Pool running the task. */
+    worker_pool_t    *pool;
+    /** Value of g_generation when the task was queued. */
+    uint32_t          generation;
+} prefetch_context_t;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Private functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Append an asset to the list whose last link is @p tail.
+ *
+ * @return The new last link.
+ */
+static prefetch_asset_t **append_asset(prefetch_asset_t **tail, const char *type, const char *id, const char *url) {
+
+    if (!url || url[0] == '\0') {
+        return tail;
+    }
+
+    prefetch_asset_t *asset = bzalloc(sizeof(prefetch_asset_t));
+    asset->type             = type;
+    asset->id               = bstrdup(id ? id : "");
+    asset->url              = bstrdup(url);
+
+    *tail = asset;
+    return &asset->next;
+}
+
+/**
+ * @brief Check whether a newer game (or a shutdown) superseded a prefetch task.
+ */
+static bool is_prefetch_cancelled(const prefetch_context_t *ctx) {
+
+    pthread_mutex_lock(&g_mutex);
+    bool superseded = ctx->generation != g_generation;
+    pthread_mutex_unlock(&g_mutex);
+
+    return superseded || worker_pool_is_stopping(ctx->pool);
+}
+
+/**
+ * @brief Set aside the remaining assets of a prefetch task if the downloads got deferred.
+ *
+ * @param ctx       Context of the running task.
+ * @param remaining Link to the first asset not downloaded yet; detached when parked.
+ *
+ * @return True if the task must stop.
+ */
+static bool park_if_deferred(const prefetch_context_t *ctx, prefetch_asset_t **remaining) {
+
+    pthread_mutex_lock(&g_mutex);
+
+    const bool park = g_deferred && ctx->generation == g_generation;
+
+    if (park) {
+        free_prefetch_assets(&g_deferred_assets);
+        g_deferred_assets = *remaining;
+        *remaining        = NULL;
+    }
+
+    pthread_mutex_unlock(&g_mutex);
+
+    return park;
+}
+
+/**
+ * @brief Release a prefetch context (also used when the task is discarded).
+ */
+static void free_prefetch_context(void *arg) {
+
+    prefetch_context_t *ctx = arg;
+
+    free_prefetch_assets(&ctx->assets);
+    bfree(ctx);
+}
+
+/**
+ * @brief Prefetch task: downloads the assets in order until superseded.
+ */
+static void prefetch_task(void *arg) {
+
+    prefetch_context_t *ctx        = arg;
+    int                 downloaded = 0;
+
+    for (prefetch_asset_t **link = &ctx->assets; *link; link = &(*link)->next) {
+
+        if (is_prefetch_cancelled(ctx)) {
+            obs_log(LOG_INFO, "[AssetPrefetch] Prefetch cancelled after %d download(s)", downloaded);
+            free_prefetch_context(ctx);
+            return;
+        }
+
+        if (park_if_deferred(ctx, link)) {
+            obs_log(LOG_INFO, "[AssetPrefetch] Prefetch deferred after %d download(s)", downloaded);
+            free_prefetch_context(ctx);
+            return;
+        }
+
+        const prefetch_asset_t *asset = *link;
+
+        /* Only a real download returns true: cache hits are not throttled */
+        if (cache_download(asset->url, asset->type, asset->id, NULL, 0)) {
+            downloaded++;
+            sleep_ms(PREFETCH_THROTTLE_MS);
+        }
+    }
+
+    obs_log(LOG_INFO, "[AssetPrefetch] Finished prefetching: %d download(s)", downloaded);
+
+    free_prefetch_context(ctx);
+}
+
+/**
+ * @brief Queue a prefetch task for @p assets, superseding the previous one.
+ *
+ * @param assets Assets to download (ownership transferred), or NULL to only cancel.
+ */
+static void queue_assets(prefetch_asset_t *assets) {
+
+    pthread_mutex_lock(&g_mutex);
+
+    g_generation++;
+
+    if (!g_pool && assets) {
+        g_pool = worker_pool_create("AssetPrefetch", THREAD_CLASS_BACKGROUND, 1);
+    }
+
+    worker_pool_t *pool = g_pool;
+
+    prefetch_context_t *ctx = NULL;
+
+    if (assets) {
+        ctx             = bzalloc(sizeof(prefetch_context_t));
+        ctx->assets     = assets;
+        ctx->pool       = pool;
+        ctx->generation = g_generation;
+    }
+
+    pthread_mutex_unlock(&g_mutex);
+
+    /* Whatever is still queued belongs to the previous game */
+    worker_pool_cancel_pending(pool);
+
+    if (!ctx) {
+        return;
+    }
+
+    if (worker_pool_submit(pool, prefetch_task, free_prefetch_context, ctx)) {
+        obs_log(LOG_INFO, "[AssetPrefetch] Queued background prefetch");
+    } else {
+        obs_log(LOG_ERROR, "[AssetPrefetch] Failed to queue the prefetch");
+    }
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public API
+//  --------------------------------------------------------------------------------------------------------------------
+
+prefetch_asset_t *asset_prefetch_plan(const game_t *game, const identity_t *identity, const achievement_t *achievements) {
+
+    prefetch_asset_t  *assets = NULL;
+    prefetch_asset_t **tail   = &assets;
+
+    /* The cycle starts with the last unlocked achievement */
+    const achievement_t *last_unlocked = find_latest_unlocked_achievement(achievements);
+
+    if (last_unlocked) {
+        tail = append_asset(tail, "achievement_icon", last_unlocked->id, last_unlocked->icon_url);
+    }
+
+    /* Same keys as game_cover.c and gamerpic.c */
+    if (game) {
+        tail = append_asset(tail, "game_cover", game->id, game->cover_url);
+    }
+
+    if (identity) {
+        tail = append_asset(tail,
+                            "gamerpic",
+                            identity->name && identity->name[0] != '\0' ? identity->name : "default",
+                            identity->avatar_url);
+    }
+
+    /* Then the rotation candidates, then the rest */
+    for (const achievement_t *a = achievements; a; a = a->next) {
+        if (a->unlocked_timestamp == 0) {
+            tail = append_asset(tail, "achievement_icon", a->id, a->icon_url);
+        }
+    }
+
+    for (const achievement_t *a = achievements; a; a = a->next) {
+        if (a->unlocked_timestamp != 0 && a != last_unlocked) {
+            tail = append_asset(tail, "achievement_icon", a->id, a->icon_url);
+        }
+    }
+
+    return assets;
+}
+
+void free_prefetch_assets(prefetch_asset_t **assets) {
+
+    if (!assets || !*assets) {
+        return;
+    }
+
+    prefetch_asset_t *current = *assets;
+
+    while (current) {
+        prefetch_asset_t *next = current->next;
+
+        bfree(current->id);
+        bfree(current->url);
+        bfree(current);
+
+        current = next;
+    }
+
+    *assets = NULL;
+}
+
+void asset_prefetch_start(const game_t *game, const identity_t *identity, const achievement_t *achievements) {
+
+    prefetch_asset_t *assets = asset_prefetch_plan(game, identity, achievements);
+
+    pthread_mutex_lock(&g_mutex);
+
+    if (!g_deferred) {
+        pthread_mutex_unlock(&g_mutex);
+        queue_assets(assets);
+        return;
+    }
+
+    /* Only the latest game matters: replace what was waiting and stop the
+     * task of the previous game, if still running */
+    free_prefetch_assets(&g_deferred_assets);
+    g_deferred_assets = assets;
+    g_generation++;
+
+    worker_pool_t *pool = g_pool;
+
+    pthread_mutex_unlock(&g_mutex);
+
+    worker_pool_cancel_pending(pool);
+
+    obs_log(LOG_INFO, "[AssetPrefetch] Prefetch deferred until a tracker source is visible");
+}
+
+void asset_prefetch_set_deferred(bool deferred) {
+
+    pthread_mutex_lock(&g_mutex);
+
+    g_deferred = deferred;
+
+    prefetch_asset_t *assets = NULL;
+
+    if (!deferred) {
+        assets            = g_deferred_assets;
+        g_deferred_assets = NULL;
+    }
+
+    pthread_mutex_unlock(&g_mutex);
+
+    if (assets) {
+        obs_log(LOG_INFO, "[AssetPrefetch] Resuming the deferred prefetch");
+        queue_assets(assets);
+    }
+}
+
+void asset_prefetch_stop(void) {
+
+    pthread_mutex_lock(&g_mutex);
+    g_generation++;
+    worker_pool_t *pool = g_pool;
+    g_pool              = NULL;
+    free_prefetch_assets(&g_deferred_assets);
+    pthread_mutex_unlock(&g_mutex);
+
+    worker_pool_destroy(&pool);
+}
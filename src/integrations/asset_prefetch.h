@@ -0,0 +1,99 @@
+#pragma once
+
+#include <stdbool.h>
+
+#include "common/achievement.h"
+#include "common/game.h"
+#include "common/identity.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file asset_prefetch.h
+ * @brief Background download of the images of the active game, for any integration.
+ *
+ * When a game becomes active (Xbox or RetroAchievements), its achievement
+ * icons, cover and the gamerpic are downloaded to the local file cache in the
+ * background, under the same cache keys as the image sources use, so an
+ * achievement is never displayed blank while its icon downloads.
+ *
+ * Assets are fetched in the order they are likely to be displayed:
+ *   1. the icon of the last unlocked achievement (shown first by the cycle);
+ *   2. the game cover and the gamerpic;
+ *   3. the icons of the locked achievements (the rotation candidates);
+ *   4. the icons of the other unlocked achievements.
+ *
+ * Thread safety:
+ *   All functions may be called from any thread.
+ */
+
+/**
+ * @brief Image to download into the cache (singly linked list node).
+ */
+typedef struct prefetch_asset {
+    /** Cache category, as used by the image source (e.g. "achievement_icon"). */
+    const char            *type;
+    /** Cache identifier, as used by the image source. */
+    char                  *id;
+    /** Remote URL. */
+    char                  *url;
+    struct prefetch_asset *next;
+} prefetch_asset_t;
+
+/**
+ * @brief Build the ordered list of assets to prefetch.
+ *
+ * Entries without a URL are skipped.
+ *
+ * @param game         Active game (borrowed), or NULL.
+ * @param identity     Active identity (borrowed), or NULL.
+ * @param achievements Achievements of @p game (borrowed), or NULL.
+ *
+ * @return Newly allocated list (free with @ref free_prefetch_assets), or NULL
+ *         if there is nothing to download.
+ */
+prefetch_asset_t *asset_prefetch_plan(const game_t *game, const identity_t *identity, const achievement_t *achievements);
+
+/**
+ * @brief Free a list built by @ref asset_prefetch_plan and set the caller's pointer to NULL.
+ */
+void free_prefetch_assets(prefetch_asset_t **assets);
+
+/**
+ * @brief Prefetch the assets of the active game in the background.
+ *
+ * Supersedes the prefetch in progress, if any: its remaining downloads are
+ * dropped. The arguments are copied.
+ *
+ * @param game         Active game, or NULL.
+ * @param identity     Active identity, or NULL.
+ * @param achievements Achievements of @p game, or NULL.
+ */
+void asset_prefetch_start(const game_t *game, const identity_t *identity, const achievement_t *achievements);
+
+/**
+ * @brief Defer the downloads, or resume them.
+ *
+ * While deferred (no tracker source is visible), @ref asset_prefetch_start only
+ * remembers the latest game's assets and a running prefetch stops after its
+ * current download, setting its remaining assets aside. Resuming queues what
+ * was set aside.
+ *
+ * @param deferred True to defer the downloads, false to resume them.
+ */
+void asset_prefetch_set_deferred(bool deferred);
+
+/**
+ * @brief Stop prefetching and wait for the running download to finish.
+ *
+ * Once this returns no prefetch task is running; a later call to
+ * @ref asset_prefetch_start starts a new worker. Must not run concurrently
+ * with @ref asset_prefetch_start: stop the integrations first.
+ */
+void asset_prefetch_stop(void);
+
+#ifdef __cplusplus
+}
+#endif
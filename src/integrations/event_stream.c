@@ -0,0 +1,390 @@
+#include "integrations/event_stream.h"
+
+#include <obs-module.h>
+#include <diagnostics/log.h>
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cJSON.h"
+#include "util/thread_compat.h"
+
+/**
+ * @brief Serialized achievement of the snapshot.
+ *
+ * The snapshot is kept as pre-serialized fragments: an event replaces the
+ * fragment of the achievement it carries, and a snapshot request only
+ * concatenates them.
+ */
+typedef struct stream_entry {
+    char *id;
+    char *json;
+} stream_entry_t;
+
+/** Growable text buffer used to assemble payloads. */
+typedef struct json_writer {
+    char  *data;
+    size_t size;
+    size_t capacity;
+} json_writer_t;
+
+/** Event built under the stream's lock, handed to the sink once the lock is released. */
+typedef struct pending_event {
+    const char *event_type;
+    char       *json;
+    uint64_t    generation;
+} pending_event_t;
+
+/** Guards the snapshot and the generation counter. Never held while calling the sink. */
+static pthread_mutex_t g_mutex      = PTHREAD_MUTEX_INITIALIZER;
+static uint64_t        g_generation = 0;
+
+/**
+ * Guards the sink and the delivery order. Emitters wait on g_emit_cond for
+ * their generation's turn, so that events reach the sink in generation order
+ * even though they are emitted outside of g_mutex.
+ */
+static pthread_mutex_t     g_emit_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t      g_emit_cond  = PTHREAD_COND_INITIALIZER;
+static event_stream_sink_t g_sink       = NULL;
+static uint64_t            g_emitted    = 0;
+
+/** Snapshot state, patched by each event. */
+static char           *g_game_json    = NULL;
+static stream_entry_t *g_entries      = NULL;
+static size_t          g_entry_count  = 0;
+static char           *g_current_json = NULL;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Private functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+static void write_text(json_writer_t *writer, const char *text) {
+
+    const size_t length = strlen(text);
+
+    if (writer->size + length + 1 > writer->capacity) {
+        size_t capacity = writer->capacity ? writer->capacity : 256;
+
+        while (capacity < writer->size + length + 1) {
+            capacity *= 2;
+        }
+
+        writer->data     = brealloc(writer->data, capacity);
+        writer->capacity = capacity;
+    }
+
+    memcpy(writer->data + writer->size, text, length + 1);
+    writer->size += length;
+}
+
+/**
+ * @brief Print @p item compactly and free it.
+ *
+ * @return Newly allocated JSON text (caller must bfree()).
+ */
+static char *print_json(cJSON *item) {
+
+    char *printed = cJSON_PrintUnformatted(item);
+    cJSON_Delete(item);
+
+    char *json = bstrdup(printed ? printed : "null");
+    free(printed);
+
+    return json;
+}
+
+static cJSON *create_string_or_null(const char *value) {
+    return value ? cJSON_CreateString(value) : cJSON_CreateNull();
+}
+
+static char *game_to_json(const game_t *game) {
+
+    if (!game) {
+        return bstrdup("null");
+    }
+
+    cJSON *object = cJSON_CreateObject();
+    cJSON_AddItemToObject(object, "id", create_string_or_null(game->id));
+    cJSON_AddItemToObject(object, "title", create_string_or_null(game->title));
+    cJSON_AddItemToObject(object, "console", create_string_or_null(game->console_name));
+    cJSON_AddItemToObject(object, "cover_url", create_string_or_null(game->cover_url));
+
+    return print_json(object);
+}
+
+static char *achievement_to_json(const achievement_t *achievement) {
+
+    cJSON *object = cJSON_CreateObject();
+    cJSON_AddItemToObject(object, "id", create_string_or_null(achievement->id));
+    cJSON_AddItemToObject(object, "name", create_string_or_null(achievement->name));
+    cJSON_AddItemToObject(object, "description", create_string_or_null(achievement->description));
+    cJSON_AddItemToObject(object, "icon_url", create_string_or_null(achievement->icon_url));
+    cJSON_AddItemToObject(object, "progress", create_string_or_null(achievement->measured_progress));
+    cJSON_AddItemToObject(object, "value", cJSON_CreateNumber(achievement->value));
+    cJSON_AddItemToObject(object, "unlocked_at", cJSON_CreateNumber((double)achievement->unlocked_timestamp));
+    cJSON_AddItemToObject(object, "secret", cJSON_CreateBool(achievement->is_secret));
+
+    return print_json(object);
+}
+
+static void free_entries(void) {
+
+    for (size_t i = 0; i < g_entry_count; i++) {
+        bfree(g_entries[i].id);
+        bfree(g_entries[i].json);
+    }
+
+    bfree(g_entries);
+    g_entries     = NULL;
+    g_entry_count = 0;
+}
+
+/**
+ * @brief Stamp the next generation on an event and build its payload.
+ *
+ * Must be called with the mutex held. The event must then be handed to
+ * emit() once the mutex is released.
+ *
+ * @param event_type Event name.
+ * @param fields     JSON members of the payload, without the braces.
+ */
+static pending_event_t publish(const char *event_type, const char *fields) {
+
+    g_generation++;
+
+    char generation[48];
+    snprintf(generation, sizeof(generation), "{\"generation\":%" PRIu64 ",", g_generation);
+
+    json_writer_t writer = {0};
+    write_text(&writer, generation);
+    write_text(&writer, fields);
+    write_text(&writer, "}");
+
+    return (pending_event_t){.event_type = event_type, .json = writer.data, .generation = g_generation};
+}
+
+/**
+ * @brief Publish an event whose payload is a single member.
+ *
+ * Must be called with the mutex held.
+ */
+static pending_event_t publish_member(const char *event_type, const char *name, const char *value_json) {
+
+    json_writer_t writer = {0};
+    write_text(&writer, "\"");
+    write_text(&writer, name);
+    write_text(&writer, "\":");
+    write_text(&writer, value_json);
+
+    pending_event_t event = publish(event_type, writer.data);
+    bfree(writer.data);
+
+    return event;
+}
+
+/**
+ * @brief Hand a published event to the sink, after the ones of lower generations, and free it.
+ *
+ * Must be called without the mutex: a snapshot request never waits for the
+ * sink.
+ */
+static void emit(pending_event_t *event) {
+
+    pthread_mutex_lock(&g_emit_mutex);
+
+    while (g_emitted + 1 != event->generation) {
+        pthread_cond_wait(&g_emit_cond, &g_emit_mutex);
+    }
+
+    if (g_sink) {
+        g_sink(event->event_type, event->json);
+    }
+
+    g_emitted = event->generation;
+    pthread_cond_broadcast(&g_emit_cond);
+
+    pthread_mutex_unlock(&g_emit_mutex);
+
+    bfree(event->json);
+    event->json = NULL;
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public API
+//  --------------------------------------------------------------------------------------------------------------------
+
+void event_stream_set_sink(event_stream_sink_t sink) {
+
+    pthread_mutex_lock(&g_emit_mutex);
+    g_sink = sink;
+    pthread_mutex_unlock(&g_emit_mutex);
+}
+
+void event_stream_game_changed(const game_t *game) {
+
+    char *game_json = game_to_json(game);
+
+    pthread_mutex_lock(&g_mutex);
+
+    bfree(g_game_json);
+    g_game_json = game_json;
+    free_entries();
+    bfree(g_current_json);
+    g_current_json = NULL;
+
+    pending_event_t event = publish_member("GameChanged", "game", g_game_json);
+
+    pthread_mutex_unlock(&g_mutex);
+
+    emit(&event);
+}
+
+void event_stream_achievements_loaded(const achievement_t *achievements) {
+
+    size_t count    = 0;
+    int    unlocked = 0;
+
+    for (const achievement_t *achievement = achievements; achievement; achievement = achievement->next) {
+        count++;
+    }
+
+    stream_entry_t *entries = count ? bzalloc(count * sizeof(stream_entry_t)) : NULL;
+    size_t          index   = 0;
+
+    for (const achievement_t *achievement = achievements; achievement; achievement = achievement->next) {
+        entries[index].id   = achievement->id ? bstrdup(achievement->id) : NULL;
+        entries[index].json = achievement_to_json(achievement);
+        index++;
+
+        if (achievement->unlocked_timestamp > 0) {
+            unlocked++;
+        }
+    }
+
+    char fields[64];
+    snprintf(fields, sizeof(fields), "\"total\":%zu,\"unlocked\":%d", count, unlocked);
+
+    pthread_mutex_lock(&g_mutex);
+
+    free_entries();
+    g_entries     = entries;
+    g_entry_count = count;
+
+    pending_event_t event = publish("AchievementsLoaded", fields);
+
+    pthread_mutex_unlock(&g_mutex);
+
+    emit(&event);
+}
+
+void event_stream_achievement_updated(const achievement_t *achievement) {
+
+    if (!achievement) {
+        return;
+    }
+
+    char *json = achievement_to_json(achievement);
+
+    pthread_mutex_lock(&g_mutex);
+
+    pending_event_t event = publish_member(
+        achievement->unlocked_timestamp > 0 ? "AchievementUnlocked" : "AchievementProgressed", "achievement", json);
+
+    for (size_t i = 0; achievement->id && i < g_entry_count; i++) {
+        if (g_entries[i].id && strcmp(g_entries[i].id, achievement->id) == 0) {
+            bfree(g_entries[i].json);
+            g_entries[i].json = json;
+            json              = NULL;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&g_mutex);
+
+    emit(&event);
+
+    bfree(json);
+}
+
+void event_stream_cycle_moved(const achievement_t *achievement) {
+
+    char *id_json = print_json(create_string_or_null(achievement ? achievement->id : NULL));
+
+    pthread_mutex_lock(&g_mutex);
+
+    const bool      same  = strcmp(g_current_json ? g_current_json : "null", id_json) == 0;
+    pending_event_t event = {0};
+
+    if (!same) {
+        bfree(g_current_json);
+        g_current_json = id_json;
+        id_json        = NULL;
+
+        event = publish_member("CycleMoved", "achievement_id", g_current_json);
+    }
+
+    pthread_mutex_unlock(&g_mutex);
+
+    if (!same) {
+        emit(&event);
+    }
+
+    bfree(id_json);
+}
+
+char *event_stream_get_snapshot(void) {
+
+    json_writer_t writer = {0};
+
+    pthread_mutex_lock(&g_mutex);
+
+    char generation[48];
+    snprintf(generation, sizeof(generation), "{\"generation\":%" PRIu64 ",\"game\":", g_generation);
+
+    write_text(&writer, generation);
+    write_text(&writer, g_game_json ? g_game_json : "null");
+    write_text(&writer, ",\"achievements\":[");
+
+    for (size_t i = 0; i < g_entry_count; i++) {
+        if (i > 0) {
+            write_text(&writer, ",");
+        }
+        write_text(&writer, g_entries[i].json);
+    }
+
+    write_text(&writer, "],\"current_achievement_id\":");
+    write_text(&writer, g_current_json ? g_current_json : "null");
+    write_text(&writer, "}");
+
+    pthread_mutex_unlock(&g_mutex);
+
+    return writer.data;
+}
+
+uint64_t event_stream_get_generation(void) {
+
+    pthread_mutex_lock(&g_mutex);
+    uint64_t generation = g_generation;
+    pthread_mutex_unlock(&g_mutex);
+
+    return generation;
+}
+
+void event_stream_cleanup(void) {
+
+    event_stream_set_sink(NULL);
+
+    pthread_mutex_lock(&g_mutex);
+
+    free_entries();
+    bfree(g_game_json);
+    bfree(g_current_json);
+    g_game_json    = NULL;
+    g_current_json = NULL;
+
+    pthread_mutex_unlock(&g_mutex);
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "common/achievement.h"
+#include "common/game.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file event_stream.h
+ * @brief Compact JSON delta events for external overlays.
+ *
+ * Turns the monitoring notifications into small, self-describing events that
+ * are pushed to a sink (the obs-websocket vendor, see obs_websocket_vendor.h):
+ *
+ *   - @c GameChanged            `{"generation", "game": {...} | null}`
+ *   - @c AchievementsLoaded     `{"generation", "total", "unlocked"}`
+ *   - @c AchievementProgressed  `{"generation", "achievement": {...}}`
+ *   - @c AchievementUnlocked    `{"generation", "achievement": {...}}`
+ *   - @c CycleMoved             `{"generation", "achievement_id"}`
+ *
+ * Every event carries a generation number that increases by one per event.
+ * A consumer subscribes to the events first, then requests the snapshot
+ * (@ref event_stream_get_snapshot) and applies only the events whose
+ * generation is greater than the snapshot's: nothing is missed and nothing is
+ * applied twice.
+ *
+ * Events only serialize the game or the achievement that changed. The snapshot
+ * is kept as per-achievement JSON fragments that each event patches, so
+ * answering a snapshot request only concatenates text and never walks the live
+ * achievements list of the monitoring service from the requesting thread.
+ *
+ * Thread safety:
+ *   All functions may be called from any thread. Events are delivered to the
+ *   sink in generation order, from the publishing thread but outside of the
+ *   stream's lock: a snapshot request never waits for the sink.
+ */
+
+/**
+ * @brief Receives each event as it is published.
+ *
+ * Called in generation order, one event at a time, outside of the snapshot's
+ * lock: the sink may request the snapshot but must not publish events.
+ *
+ * @param event_type Event name (e.g. "AchievementUnlocked").
+ * @param json       Compact JSON payload (borrowed; valid during the call).
+ */
+typedef void (*event_stream_sink_t)(const char *event_type, const char *json);
+
+/**
+ * @brief Set the sink receiving the events.
+ *
+ * Once this returns, no event is being delivered to the previous sink.
+ *
+ * @param sink Sink to use, or NULL to stop delivering events. The snapshot
+ *             keeps being maintained either way.
+ */
+void event_stream_set_sink(event_stream_sink_t sink);
+
+/**
+ * @brief Publish a @c GameChanged event and reset the snapshot to @p game.
+ *
+ * @param game Game now played (borrowed), or NULL when none.
+ */
+void event_stream_game_changed(const game_t *game);
+
+/**
+ * @brief Publish an @c AchievementsLoaded event and store @p achievements in the snapshot.
+ *
+ * @param achievements Full achievements list of the current game (borrowed), or NULL.
+ */
+void event_stream_achievements_loaded(const achievement_t *achievements);
+
+/**
+ * @brief Publish an @c AchievementUnlocked or @c AchievementProgressed event.
+ *
+ * The event type is chosen from @c unlocked_timestamp. The matching snapshot
+ * entry is replaced.
+ *
+ * @param achievement Updated achievement (borrowed; its @c next is ignored).
+ */
+void event_stream_achievement_updated(const achievement_t *achievement);
+
+/**
+ * @brief Publish a @c CycleMoved event when the displayed achievement changes.
+ *
+ * Repeated notifications for the achievement already displayed are ignored.
+ *
+ * @param achievement Achievement now displayed (borrowed), or NULL.
+ */
+void event_stream_cycle_moved(const achievement_t *achievement);
+
+/**
+ * @brief Serialize the current state.
+ *
+ * Payload: `{"generation", "game", "achievements": [...], "current_achievement_id"}`.
+ *
+ * @return Newly allocated compact JSON (caller must bfree()).
+ */
+char *event_stream_get_snapshot(void);
+
+/**
+ * @brief Get the generation of the last published event.
+ *
+ * @return 0 before the first event.
+ */
+uint64_t event_stream_get_generation(void);
+
+/**
+ * @brief Release the snapshot and detach the sink.
+ */
+void event_stream_cleanup(void);
+
+#ifdef __cplusplus
+}
+#endif
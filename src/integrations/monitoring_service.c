@@ -2,7 +2,9 @@
 
 #include <obs-module.h>
 #include <diagnostics/log.h>
+#include <diagnostics/memory_accounting.h>
 
+#include "integrations/asset_prefetch.h"
 #include "integrations/xbox/xbox_monitor.h"
 #include "integrations/xbox/xbox_client.h"
 #include "integrations/xbox/contracts/xbox_achievement.h"
@@ -10,10 +12,13 @@
 #include "common/identity.h"
 #include "common/game.h"
 #include "common/gamerscore.h"
+#include "common/intern.h"
 #include "common/memory.h"
+#include "io/snapshot.h"
 #include "io/state.h"
 #include "sources/common/achievement_cycle.h"
 #include "time/time.h"
+#include "util/thread_compat.h"
 
 /* --------------------------------------------------------------------------
  * Active-identity subscription list
@@ -77,6 +82,16 @@ static void clear_game_played_subscriptions(void) {
  * Module state
  * ----------------------------------------------------------------------- */
 
+/**
+ * @brief Serializes the monitor callbacks and the public entry points.
+ *
+ * The Xbox and RetroAchievements monitors call back from their own threads.
+ * Every event is handled, and its notifications delivered, with this mutex
+ * held: subscribers observe the events in order and may read the module state
+ * (monitoring_get_*) from their callbacks without further locking.
+ */
+static pthread_mutex_t g_event_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 static on_monitoring_connection_changed_t g_connection_changed_callback = NULL;
 
 static identity_t *g_xbox_identity  = NULL;
@@ -116,6 +131,42 @@ static const identity_t *get_current_active_identity(void) {
 /** Cached generic achievements for the current game (owned by this module). */
 static achievement_t *g_current_achievements = NULL;
 
+/**
+ * @brief Guards g_current_achievements against monitoring_copy_current_game_achievements().
+ *
+ * Only held while the list is swapped, patched or copied, never while calling
+ * out, so that the render thread can copy the list while an event is handled.
+ */
+static pthread_mutex_t g_achievements_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Whether g_current_achievements belongs to the game of the last game source.
+ *
+ * Cleared when a new game starts and set again once its achievements are
+ * loaded. The snapshot is only persisted while this is true so that it never
+ * pairs a game with the achievements of the previous one.
+ */
+static bool g_session_ready = false;
+
+/**
+ * @brief Whether the cached state was restored from the snapshot and is still unconfirmed.
+ *
+ * Set by monitoring_restore_snapshot() and cleared by the first game event
+ * (see confirm_warm_start()).
+ */
+static bool g_warm_start = false;
+
+/** Integration that produced the restored snapshot. */
+static identity_source_t g_warm_start_source = IDENTITY_SOURCE_XBOX;
+
+/**
+ * @brief Whether the next achievements list replaces the restored one silently.
+ *
+ * Set when a live game event confirms the restored game: the display keeps
+ * running on the restored achievements until the live list arrives.
+ */
+static bool g_reconcile_silently = false;
+
 /* --------------------------------------------------------------------------
  * Achievements-changed subscription list
  * ----------------------------------------------------------------------- */
@@ -145,6 +196,35 @@ static void clear_achievements_changed_subscriptions(void) {
     g_achievements_changed_subscriptions = NULL;
 }
 
+/* --------------------------------------------------------------------------
+ * Achievement-updated subscription list
+ * ----------------------------------------------------------------------- */
+
+typedef struct achievement_updated_subscription {
+    on_monitoring_achievement_updated_t      callback;
+    struct achievement_updated_subscription *next;
+} achievement_updated_subscription_t;
+
+static achievement_updated_subscription_t *g_achievement_updated_subscriptions = NULL;
+
+static void notify_achievement_updated(const achievement_t *achievement) {
+    achievement_updated_subscription_t *node = g_achievement_updated_subscriptions;
+    while (node) {
+        node->callback(achievement);
+        node = node->next;
+    }
+}
+
+static void clear_achievement_updated_subscriptions(void) {
+    achievement_updated_subscription_t *node = g_achievement_updated_subscriptions;
+    while (node) {
+        achievement_updated_subscription_t *next = node->next;
+        bfree(node);
+        node = next;
+    }
+    g_achievement_updated_subscriptions = NULL;
+}
+
 /* --------------------------------------------------------------------------
  * Session-ready subscription list
  * ----------------------------------------------------------------------- */
@@ -174,6 +254,20 @@ static void clear_session_ready_subscriptions(void) {
     g_session_ready_subscriptions = NULL;
 }
 
+/**
+ * @brief Store a new cached achievements list and free the previous one.
+ *
+ * @param new_achievements New list to cache (ownership transferred to this module).
+ */
+static void swap_current_achievements(achievement_t *new_achievements) {
+    pthread_mutex_lock(&g_achievements_mutex);
+    achievement_t *previous = g_current_achievements;
+    g_current_achievements  = new_achievements;
+    pthread_mutex_unlock(&g_achievements_mutex);
+
+    free_achievement(&previous);
+}
+
 /**
  * @brief Replace the cached achievements list with a new one.
  *
@@ -183,12 +277,144 @@ static void clear_session_ready_subscriptions(void) {
  * @param new_achievements New list to cache (ownership transferred to this module).
  */
 static void replace_current_achievements(achievement_t *new_achievements) {
-    free_achievement(&g_current_achievements);
-    g_current_achievements = new_achievements;
+    swap_current_achievements(new_achievements);
 
     notify_achievements_changed();
 }
 
+/* --------------------------------------------------------------------------
+ * Warm-start snapshot
+ * ----------------------------------------------------------------------- */
+
+/**
+ * @brief Save the current identity, game, achievements and cycle position.
+ *
+ * Skipped while the achievements of the current game are loading, and when no
+ * game is played so that the last meaningful snapshot survives a disconnect
+ * or a shutdown.
+ */
+static void persist_snapshot(void) {
+    if (!g_session_ready)
+        return;
+
+    const bool xbox = g_last_game_source == IDENTITY_SOURCE_XBOX;
+    game_t    *game = xbox ? g_xbox_game : g_retro_game;
+
+    if (!game)
+        return;
+
+    char *current_achievement_id = achievement_cycle_get_current_id();
+
+    snapshot_t snapshot = {
+        .source                 = g_last_game_source,
+        .identity               = xbox ? g_xbox_identity : g_retro_identity,
+        .game                   = game,
+        .achievements           = g_current_achievements,
+        .current_achievement_id = current_achievement_id,
+    };
+
+    snapshot_save(&snapshot);
+
+    intern_release(&current_achievement_id);
+}
+
+/* --------------------------------------------------------------------------
+ * Asset prefetch
+ * ----------------------------------------------------------------------- */
+
+/**
+ * @brief Warm the image cache for the game of the last game source.
+ *
+ * Runs for both integrations once their achievements are loaded, so the
+ * icons, cover and gamerpic are cached before the sources display them.
+ */
+static void prefetch_current_assets(void) {
+    const bool xbox = g_last_game_source == IDENTITY_SOURCE_XBOX;
+
+    asset_prefetch_start(xbox ? g_xbox_game : g_retro_game,
+                         xbox ? g_xbox_identity : g_retro_identity,
+                         g_current_achievements);
+}
+
+/**
+ * @brief Check a live game event against the restored snapshot.
+ *
+ * Ends the warm start. Returns true when @p source reports the very game that
+ * was restored, in which case the caller keeps the display as is and the
+ * achievements are reconciled silently when the live list arrives. When
+ * another integration starts a game, the restored game is dropped so it cannot
+ * take over again later.
+ *
+ * @param source  Integration that produced the event.
+ * @param game_id Identifier of the game now played, or NULL when none.
+ * @return true if the live game confirms the restored one.
+ */
+static bool confirm_warm_start(identity_source_t source, const char *game_id) {
+    g_reconcile_silently = false;
+
+    if (!g_warm_start)
+        return false;
+
+    if (source != g_warm_start_source) {
+        /* The other integration has nothing to show: keep the snapshot. */
+        if (!game_id)
+            return false;
+
+        g_warm_start = false;
+        free_game(source == IDENTITY_SOURCE_XBOX ? &g_retro_game : &g_xbox_game);
+        return false;
+    }
+
+    g_warm_start = false;
+
+    const game_t *restored = source == IDENTITY_SOURCE_XBOX ? g_xbox_game : g_retro_game;
+
+    if (!game_id || !restored || !restored->id || strcmp(restored->id, game_id) != 0)
+        return false;
+
+    obs_log(LOG_INFO, "[MonitoringService] Live game matches the restored snapshot: %s", restored->title);
+
+    g_reconcile_silently = true;
+    return true;
+}
+
+/**
+ * @brief Store a freshly fetched achievements list for the current game.
+ *
+ * Behaves like replace_current_achievements() followed by a session-ready
+ * notification, except right after a confirmed warm start: when the live list
+ * has the same number of achievements and unlocks as the restored one, it is
+ * swapped in without notifying so the display cycle keeps its position.
+ *
+ * @param achievements New list to cache (ownership transferred to this module).
+ */
+static void load_current_achievements(achievement_t *achievements) {
+    const bool silently = g_reconcile_silently && g_session_ready &&
+                          count_achievements(achievements) == count_achievements(g_current_achievements) &&
+                          count_unlocked_achievements(achievements) ==
+                              count_unlocked_achievements(g_current_achievements);
+
+    g_reconcile_silently = false;
+
+    if (silently) {
+        swap_current_achievements(achievements);
+
+        /* Pick up any text or progress change of the displayed achievement. */
+        achievement_cycle_refresh_current();
+    } else {
+        replace_current_achievements(achievements);
+
+        g_session_ready = true;
+        notify_session_ready();
+
+        /* A checkpoint per game: the model and parse tags grow with its list */
+        memory_log_report("achievements loaded");
+    }
+
+    prefetch_current_assets();
+    persist_snapshot();
+}
+
 /**
  * @brief Convert RetroAchievements records to a generic achievement_t linked list.
  */
@@ -199,17 +425,17 @@ static achievement_t *retro_to_achievements(const retro_achievement_t *retro, si
     for (size_t i = 0; i < count; i++) {
         const retro_achievement_t *r = &retro[i];
 
-        achievement_t *a = bzalloc(sizeof(achievement_t));
+        achievement_t *a = alloc_achievement();
 
         /* retro_achievement_t.id is a uint32_t – convert to string */
         char id_buf[16];
         snprintf(id_buf, sizeof(id_buf), "%u", r->id);
-        a->id = bstrdup(id_buf);
+        a->id = intern_string(id_buf);
 
-        a->name              = bstrdup(r->name);
-        a->description       = bstrdup(r->description);
-        a->icon_url          = bstrdup(r->badge_url);
-        a->measured_progress = (r->measured_progress[0] != '\0') ? bstrdup(r->measured_progress) : NULL;
+        a->name              = intern_string(r->name);
+        a->description       = intern_string(r->description);
+        a->icon_url          = intern_string(r->badge_url);
+        a->measured_progress = (r->measured_progress[0] != '\0') ? intern_string(r->measured_progress) : NULL;
         a->is_secret         = false;
         a->value             = (int)r->points;
         /* Use the real unlock timestamp when available; fall back to 1 (a
@@ -254,7 +480,7 @@ static void refresh_xbox_score(identity_t *identity) {
     identity->score        = gs ? (uint32_t)gamerscore_compute(gs) : 0;
 }
 
-static void on_xbox_connection_changed(bool connected, const char *error_message) {
+static void handle_xbox_connection_changed(bool connected, const char *error_message) {
     if (connected) {
         free_identity_t(&g_xbox_identity);
 
@@ -264,7 +490,7 @@ static void on_xbox_connection_changed(bool connected, const char *error_message
             free_identity(&xbox);
 
             if (g_xbox_identity) {
-                free_memory((void **)&g_xbox_identity->avatar_url);
+                intern_release(&g_xbox_identity->avatar_url);
                 g_xbox_identity->avatar_url = xbox_fetch_gamerpic();
                 obs_log(LOG_INFO,
                         "[MonitoringService] Xbox identity cached: %s (score: %u, avatar: %s)",
@@ -277,6 +503,18 @@ static void on_xbox_connection_changed(bool connected, const char *error_message
                  * will fire from on_xbox_game_played. */
             }
         }
+
+        /* Reconnected after a short outage: the monitor resumes the session
+         * without notifying the game again, so refresh the identity here. */
+        if (g_xbox_game && !g_warm_start)
+            notify_active_identity(get_current_active_identity());
+    } else if (g_warm_start && g_warm_start_source == IDENTITY_SOURCE_XBOX) {
+        /* A failed connection attempt says nothing about what is being
+         * played: keep showing the restored snapshot. */
+    } else if (xbox_monitoring_is_active() && get_current_game()) {
+        /* The monitor retains its session through a short outage, and either
+         * resumes it on reconnection or reports the game stopped once the
+         * outage lasts too long: keep the identity and the game meanwhile. */
     } else {
         free_identity_t(&g_xbox_identity);
         free_game(&g_xbox_game);
@@ -290,7 +528,7 @@ static void on_xbox_connection_changed(bool connected, const char *error_message
         g_connection_changed_callback(connected, error_message);
 }
 
-static void on_xbox_achievements_progressed(const gamerscore_t                *gamerscore,
+static void handle_xbox_achievements_progressed(const gamerscore_t                *gamerscore,
                                             const xbox_achievement_progress_t *progress) {
     UNUSED_PARAMETER(gamerscore);
 
@@ -304,8 +542,15 @@ static void on_xbox_achievements_progressed(const gamerscore_t                *g
      * achievement so the display reflects the new value without resetting
      * the cycle (which would jump back to the first achievement). */
     if (progress && progress->id && g_current_achievements) {
+        achievement_t *updated  = NULL;
+        bool           unlocked = false;
+
+        /* Patched under the list lock: the render thread may be copying it. */
+        pthread_mutex_lock(&g_achievements_mutex);
+
         for (achievement_t *a = g_current_achievements; a != NULL; a = a->next) {
             if (a->id && strcasecmp(a->id, progress->id) == 0) {
+                updated = a;
 
                 if (progress->progress_state && strcasecmp(progress->progress_state, "Achieved") == 0) {
                     /* Achievement was just unlocked — patch in-place using the
@@ -315,31 +560,50 @@ static void on_xbox_achievements_progressed(const gamerscore_t                *g
                      * information we need right here. */
                     a->unlocked_timestamp = progress->unlocked_timestamp > 0 ? progress->unlocked_timestamp
                                                                              : (int64_t)now();
-                    free_memory((void **)&a->measured_progress);
+                    intern_release(&a->measured_progress);
                     sort_achievements(&g_current_achievements);
-                    notify_achievements_changed();
+                    unlocked = true;
                 } else {
                     /* Still in progress — patch measured_progress in-place so
                      * the display updates without resetting the cycle. */
-                    free_memory((void **)&a->measured_progress);
+                    intern_release(&a->measured_progress);
                     if (progress->current && progress->target && strcmp(progress->current, "0") != 0) {
                         char measured[128];
                         snprintf(measured, sizeof(measured), "%s/%s", progress->current, progress->target);
-                        a->measured_progress = bstrdup(measured);
+                        a->measured_progress = intern_string(measured);
                     }
-                    achievement_cycle_refresh_current();
                 }
                 break;
             }
         }
+
+        pthread_mutex_unlock(&g_achievements_mutex);
+
+        /* The list is only freed by event handlers: the node outlives the lock */
+        if (updated) {
+            notify_achievement_updated(updated);
+
+            if (unlocked) {
+                notify_achievements_changed();
+            } else {
+                achievement_cycle_refresh_current();
+            }
+        }
     }
 
     /* Re-notify so subscribers receive the updated score. */
     if (g_xbox_game)
         notify_active_identity(get_current_active_identity());
+
+    persist_snapshot();
 }
 
-static void on_xbox_game_played(const game_t *game) {
+static void handle_xbox_game_played(const game_t *game) {
+    const bool confirmed = confirm_warm_start(IDENTITY_SOURCE_XBOX, game ? game->id : NULL);
+
+    /* The restored game already knows its cover: no need to fetch it again. */
+    char *known_cover_url = confirmed && g_xbox_game->cover_url ? intern_string(g_xbox_game->cover_url) : NULL;
+
     free_game(&g_xbox_game);
     g_xbox_game = copy_game(game);
 
@@ -354,6 +618,7 @@ static void on_xbox_game_played(const game_t *game) {
         }
 
         /* No active game on either source — clear everything. */
+        g_session_ready = false;
         replace_current_achievements(NULL);
         notify_active_identity(get_current_active_identity());
         notify_game_played(NULL);
@@ -361,9 +626,13 @@ static void on_xbox_game_played(const game_t *game) {
     }
 
     if (!g_xbox_game->cover_url || g_xbox_game->cover_url[0] == '\0') {
-        g_xbox_game->cover_url = xbox_get_game_cover(g_xbox_game);
+        intern_release((char **)&g_xbox_game->cover_url);
+        g_xbox_game->cover_url = known_cover_url ? known_cover_url : xbox_get_game_cover(g_xbox_game);
+        known_cover_url        = NULL;
     }
 
+    intern_release(&known_cover_url);
+
     obs_log(LOG_INFO, "[MonitoringService] Xbox game cached: %s", g_xbox_game->title);
 
     g_last_game_source = IDENTITY_SOURCE_XBOX;
@@ -376,6 +645,12 @@ static void on_xbox_game_played(const game_t *game) {
      * event (which caches the identity), in which case NULL is notified. */
     notify_active_identity(get_current_active_identity());
 
+    /* Same game as the restored snapshot: keep the display running on the
+     * restored achievements until on_xbox_session_ready() reconciles them. */
+    if (confirmed)
+        return;
+
+    g_session_ready = false;
     notify_game_played(g_xbox_game);
 }
 
@@ -387,22 +662,22 @@ static void on_xbox_game_played(const game_t *game) {
  * monitor fires a session-ready after reporting "game stopped") to avoid
  * overwriting data from another source such as RetroAchievements.
  */
-static void on_xbox_session_ready(void) {
+static void handle_xbox_session_ready(void) {
     if (!g_xbox_game) {
         return;
     }
 
-    replace_current_achievements(xbox_to_achievements(get_current_game_achievements()));
-
-    notify_session_ready();
+    load_current_achievements(xbox_to_achievements(get_current_game_achievements()));
 }
 
 /* --------------------------------------------------------------------------
  * RetroAchievements callbacks
  * ----------------------------------------------------------------------- */
 
-static void on_retro_connection_changed(bool connected, const char *error_message) {
-    if (!connected) {
+static void handle_retro_connection_changed(bool connected, const char *error_message) {
+    if (!connected && g_warm_start && g_warm_start_source == IDENTITY_SOURCE_RETRO) {
+        /* RetroArch is not reachable yet: keep showing the restored snapshot. */
+    } else if (!connected) {
         /* Treat a disconnect the same as no_game + no_user so that all
          * subscribers (game cover, achievement sources, identity sources)
          * are cleared immediately instead of staying stale. */
@@ -410,6 +685,7 @@ static void on_retro_connection_changed(bool connected, const char *error_messag
 
         if (g_retro_game) {
             free_game(&g_retro_game);
+            g_session_ready = false;
 
             /* Fire game_played(NULL) BEFORE clearing achievements so that the
              * achievement cycle sets g_session_ready = false first, preventing
@@ -428,7 +704,7 @@ static void on_retro_connection_changed(bool connected, const char *error_messag
         g_connection_changed_callback(connected, error_message);
 }
 
-static void on_retro_user(const retro_user_t *user) {
+static void handle_retro_user(const retro_user_t *user) {
     free_identity_t(&g_retro_identity);
     g_retro_identity = identity_from_retro(user);
     obs_log(LOG_INFO,
@@ -439,11 +715,13 @@ static void on_retro_user(const retro_user_t *user) {
     /* The user message may arrive before or after the game message. Only
      * notify if a retro game is already active and retro is the last game
      * source, otherwise the notification will come from on_retro_game_playing. */
-    if (g_retro_game && g_last_game_source == IDENTITY_SOURCE_RETRO)
+    if (g_retro_game && g_last_game_source == IDENTITY_SOURCE_RETRO) {
         notify_active_identity(get_current_active_identity());
+        persist_snapshot();
+    }
 }
 
-static void on_retro_no_user(void) {
+static void handle_retro_no_user(void) {
     free_identity_t(&g_retro_identity);
 
     /* If retro was the active source, losing the identity means the active
@@ -452,19 +730,30 @@ static void on_retro_no_user(void) {
         notify_active_identity(get_current_active_identity());
 }
 
-static void on_retro_game_playing(const retro_game_t *retro_game) {
+static void handle_retro_game_playing(const retro_game_t *retro_game) {
+    const bool confirmed = confirm_warm_start(IDENTITY_SOURCE_RETRO, retro_game->game_id);
+
     free_game(&g_retro_game);
 
-    g_retro_game               = bzalloc(sizeof(game_t));
-    g_retro_game->id           = bstrdup(retro_game->game_id);
-    g_retro_game->title        = bstrdup(retro_game->game_name);
-    g_retro_game->console_name = bstrdup(retro_game->console_name);
-    g_retro_game->cover_url    = bstrdup(retro_game->cover_url);
+    g_retro_game               = alloc_game();
+    g_retro_game->id           = intern_string(retro_game->game_id);
+    g_retro_game->title        = intern_string(retro_game->game_name);
+    g_retro_game->console_name = intern_string(retro_game->console_name);
+    g_retro_game->cover_url    = intern_string(retro_game->cover_url);
 
     obs_log(LOG_INFO, "[MonitoringService] Retro game cached: %s (%s)", g_retro_game->title, g_retro_game->console_name);
 
     g_last_game_source = IDENTITY_SOURCE_RETRO;
 
+    /* Same game as the restored snapshot: keep the display running on the
+     * restored achievements until on_retro_achievements() reconciles them. */
+    if (confirmed) {
+        notify_active_identity(get_current_active_identity());
+        return;
+    }
+
+    g_session_ready = false;
+
     /* Notify game_played BEFORE clearing achievements so that the achievement
      * cycle can mark the session as not-ready before on_achievements_changed
      * fires. If we cleared achievements first while g_session_ready was still
@@ -481,8 +770,16 @@ static void on_retro_game_playing(const retro_game_t *retro_game) {
     replace_current_achievements(NULL);
 }
 
-static void on_retro_no_game(void) {
+static void handle_retro_no_game(void) {
+    /* RetroArch having nothing loaded says nothing about a restored Xbox
+     * snapshot. */
+    if (g_warm_start && g_warm_start_source == IDENTITY_SOURCE_XBOX)
+        return;
+
+    confirm_warm_start(IDENTITY_SOURCE_RETRO, NULL);
+
     free_game(&g_retro_game);
+    g_session_ready = false;
 
     /* Notify game_played BEFORE clearing achievements so that the achievement
      * cycle sets g_session_ready = false first.  Otherwise replace_current_achievements(NULL)
@@ -512,12 +809,81 @@ static void on_retro_no_game(void) {
  * initial blank state persists. Only fire session_ready when the list is
  * non-empty so the cycle always starts with at least one achievement to show.
  */
-static void on_retro_achievements(const retro_achievement_t *achievements, size_t count) {
-    replace_current_achievements(retro_to_achievements(achievements, count));
-
+static void handle_retro_achievements(const retro_achievement_t *achievements, size_t count) {
     if (g_retro_game && count > 0) {
-        notify_session_ready();
+        load_current_achievements(retro_to_achievements(achievements, count));
+        return;
     }
+
+    replace_current_achievements(retro_to_achievements(achievements, count));
+}
+
+/* --------------------------------------------------------------------------
+ * Monitor entry points
+ *
+ * The monitors call these from their own threads: each event is handled under
+ * g_event_mutex.
+ * ----------------------------------------------------------------------- */
+
+static void on_xbox_connection_changed(bool connected, const char *error_message) {
+    pthread_mutex_lock(&g_event_mutex);
+    handle_xbox_connection_changed(connected, error_message);
+    pthread_mutex_unlock(&g_event_mutex);
+}
+
+static void on_xbox_achievements_progressed(const gamerscore_t                *gamerscore,
+                                            const xbox_achievement_progress_t *progress) {
+    pthread_mutex_lock(&g_event_mutex);
+    handle_xbox_achievements_progressed(gamerscore, progress);
+    pthread_mutex_unlock(&g_event_mutex);
+}
+
+static void on_xbox_game_played(const game_t *game) {
+    pthread_mutex_lock(&g_event_mutex);
+    handle_xbox_game_played(game);
+    pthread_mutex_unlock(&g_event_mutex);
+}
+
+static void on_xbox_session_ready(void) {
+    pthread_mutex_lock(&g_event_mutex);
+    handle_xbox_session_ready();
+    pthread_mutex_unlock(&g_event_mutex);
+}
+
+static void on_retro_connection_changed(bool connected, const char *error_message) {
+    pthread_mutex_lock(&g_event_mutex);
+    handle_retro_connection_changed(connected, error_message);
+    pthread_mutex_unlock(&g_event_mutex);
+}
+
+static void on_retro_user(const retro_user_t *user) {
+    pthread_mutex_lock(&g_event_mutex);
+    handle_retro_user(user);
+    pthread_mutex_unlock(&g_event_mutex);
+}
+
+static void on_retro_no_user(void) {
+    pthread_mutex_lock(&g_event_mutex);
+    handle_retro_no_user();
+    pthread_mutex_unlock(&g_event_mutex);
+}
+
+static void on_retro_game_playing(const retro_game_t *retro_game) {
+    pthread_mutex_lock(&g_event_mutex);
+    handle_retro_game_playing(retro_game);
+    pthread_mutex_unlock(&g_event_mutex);
+}
+
+static void on_retro_no_game(void) {
+    pthread_mutex_lock(&g_event_mutex);
+    handle_retro_no_game();
+    pthread_mutex_unlock(&g_event_mutex);
+}
+
+static void on_retro_achievements(const retro_achievement_t *achievements, size_t count) {
+    pthread_mutex_lock(&g_event_mutex);
+    handle_retro_achievements(achievements, count);
+    pthread_mutex_unlock(&g_event_mutex);
 }
 
 /* --------------------------------------------------------------------------
@@ -545,6 +911,9 @@ void monitoring_stop(void) {
     retro_achievements_monitor_stop();
     xbox_monitoring_stop();
 
+    /* The monitor threads queued the prefetch tasks: none can be added anymore */
+    asset_prefetch_stop();
+
     xbox_subscribe_connected_changed(NULL);
     xbox_subscribe_achievements_progressed(NULL);
     xbox_subscribe_game_played(NULL);
@@ -557,31 +926,118 @@ void monitoring_stop(void) {
     retro_achievements_subscribe_no_game(NULL);
     retro_achievements_subscribe_achievements(NULL);
 
+    pthread_mutex_lock(&g_event_mutex);
+
     free_identity_t(&g_xbox_identity);
     free_identity_t(&g_retro_identity);
     free_game(&g_xbox_game);
     free_game(&g_retro_game);
-    free_achievement(&g_current_achievements);
+    swap_current_achievements(NULL);
+
+    g_session_ready      = false;
+    g_warm_start         = false;
+    g_reconcile_silently = false;
 
     clear_active_identity_subscriptions();
     clear_game_played_subscriptions();
     clear_achievements_changed_subscriptions();
+    clear_achievement_updated_subscriptions();
     clear_session_ready_subscriptions();
+
+    pthread_mutex_unlock(&g_event_mutex);
+}
+
+/**
+ * @brief Take over the state saved by the last session (see monitoring_restore_snapshot()).
+ */
+static void restore_snapshot(void) {
+    /* Live data always wins over the snapshot. */
+    if (g_xbox_game || g_retro_game)
+        return;
+
+    snapshot_t *snapshot = snapshot_load();
+
+    if (!snapshot)
+        return;
+
+    if (!snapshot->game) {
+        free_snapshot(&snapshot);
+        return;
+    }
+
+    /* Take ownership of the restored data. */
+    if (snapshot->source == IDENTITY_SOURCE_RETRO) {
+        free_identity_t(&g_retro_identity);
+        g_retro_identity = snapshot->identity;
+        g_retro_game     = snapshot->game;
+    } else {
+        free_identity_t(&g_xbox_identity);
+        g_xbox_identity = snapshot->identity;
+        g_xbox_game     = snapshot->game;
+    }
+
+    swap_current_achievements(snapshot->achievements);
+
+    char *current_achievement_id = snapshot->current_achievement_id;
+
+    snapshot->identity               = NULL;
+    snapshot->game                   = NULL;
+    snapshot->achievements           = NULL;
+    snapshot->current_achievement_id = NULL;
+    free_snapshot(&snapshot);
+
+    g_warm_start_source = g_xbox_game ? IDENTITY_SOURCE_XBOX : IDENTITY_SOURCE_RETRO;
+    g_last_game_source  = g_warm_start_source;
+    g_warm_start        = true;
+
+    const game_t *game = g_xbox_game ? g_xbox_game : g_retro_game;
+
+    obs_log(LOG_INFO, "[MonitoringService] Restored snapshot of %s", game->title);
+
+    notify_active_identity(get_current_active_identity());
+    notify_game_played(game);
+
+    if (g_current_achievements) {
+        g_session_ready = true;
+        notify_session_ready();
+        achievement_cycle_navigate_to(current_achievement_id);
+        prefetch_current_assets();
+    }
+
+    free_memory((void **)&current_achievement_id);
+}
+
+void monitoring_restore_snapshot(void) {
+    pthread_mutex_lock(&g_event_mutex);
+    restore_snapshot();
+    pthread_mutex_unlock(&g_event_mutex);
+}
+
+void monitoring_save_snapshot(void) {
+    pthread_mutex_lock(&g_event_mutex);
+    persist_snapshot();
+    pthread_mutex_unlock(&g_event_mutex);
 }
 
 void monitoring_subscribe_connection_changed(on_monitoring_connection_changed_t callback) {
+    pthread_mutex_lock(&g_event_mutex);
     g_connection_changed_callback = callback;
+    pthread_mutex_unlock(&g_event_mutex);
 }
 
 void monitoring_subscribe_active_identity(on_monitoring_active_identity_changed_t callback) {
+    pthread_mutex_lock(&g_event_mutex);
+
     if (!callback) {
         clear_active_identity_subscriptions();
+        pthread_mutex_unlock(&g_event_mutex);
         return;
     }
 
     active_identity_subscription_t *node = bzalloc(sizeof(active_identity_subscription_t));
     if (!node) {
         obs_log(LOG_ERROR, "[MonitoringService] Failed to allocate active identity subscription");
+        pthread_mutex_unlock(&g_event_mutex);
         return;
     }
 
@@ -590,63 +1046,173 @@ void monitoring_subscribe_active_identity(on_monitoring_active_identity_changed_
     g_active_identity_subscriptions = node;
 
     callback(get_current_active_identity());
+
+    pthread_mutex_unlock(&g_event_mutex);
 }
 
 void monitoring_subscribe_game_played(on_monitoring_game_played_t callback) {
+    pthread_mutex_lock(&g_event_mutex);
+
     if (!callback) {
         clear_game_played_subscriptions();
+        pthread_mutex_unlock(&g_event_mutex);
         return;
     }
 
     game_played_subscription_t *node = bzalloc(sizeof(game_played_subscription_t));
     if (!node) {
         obs_log(LOG_ERROR, "[MonitoringService] Failed to allocate game-played subscription");
+        pthread_mutex_unlock(&g_event_mutex);
         return;
     }
 
     node->callback              = callback;
     node->next                  = g_game_played_subscriptions;
     g_game_played_subscriptions = node;
+
+    pthread_mutex_unlock(&g_event_mutex);
 }
 
 void monitoring_subscribe_achievements_changed(on_monitoring_achievements_changed_t callback) {
+    pthread_mutex_lock(&g_event_mutex);
+
     if (!callback) {
         clear_achievements_changed_subscriptions();
+        pthread_mutex_unlock(&g_event_mutex);
         return;
     }
 
     achievements_changed_subscription_t *node = bzalloc(sizeof(achievements_changed_subscription_t));
     if (!node) {
         obs_log(LOG_ERROR, "[MonitoringService] Failed to allocate achievements-changed subscription");
+        pthread_mutex_unlock(&g_event_mutex);
         return;
     }
 
     node->callback                       = callback;
     node->next                           = g_achievements_changed_subscriptions;
     g_achievements_changed_subscriptions = node;
+
+    pthread_mutex_unlock(&g_event_mutex);
+}
+
+void monitoring_subscribe_achievement_updated(on_monitoring_achievement_updated_t callback) {
+    pthread_mutex_lock(&g_event_mutex);
+
+    if (!callback) {
+        clear_achievement_updated_subscriptions();
+        pthread_mutex_unlock(&g_event_mutex);
+        return;
+    }
+
+    achievement_updated_subscription_t *node = bzalloc(sizeof(achievement_updated_subscription_t));
+    if (!node) {
+        obs_log(LOG_ERROR, "[MonitoringService] Failed to allocate achievement-updated subscription");
+        pthread_mutex_unlock(&g_event_mutex);
+        return;
+    }
+
+    node->callback                      = callback;
+    node->next                          = g_achievement_updated_subscriptions;
+    g_achievement_updated_subscriptions = node;
+
+    pthread_mutex_unlock(&g_event_mutex);
 }
 
 void monitoring_subscribe_session_ready(on_monitoring_session_ready_t callback) {
+    pthread_mutex_lock(&g_event_mutex);
+
     if (!callback) {
         clear_session_ready_subscriptions();
+        pthread_mutex_unlock(&g_event_mutex);
         return;
     }
 
     session_ready_subscription_t *node = bzalloc(sizeof(session_ready_subscription_t));
     if (!node) {
         obs_log(LOG_ERROR, "[MonitoringService] Failed to allocate session-ready subscription");
+        pthread_mutex_unlock(&g_event_mutex);
         return;
     }
 
     node->callback                = callback;
     node->next                    = g_session_ready_subscriptions;
     g_session_ready_subscriptions = node;
+
+    pthread_mutex_unlock(&g_event_mutex);
+}
+
+void monitoring_unsubscribe_game_played(on_monitoring_game_played_t callback) {
+    pthread_mutex_lock(&g_event_mutex);
+
+    game_played_subscription_t **link = &g_game_played_subscriptions;
+    while (*link) {
+        if ((*link)->callback == callback) {
+            game_played_subscription_t *node = *link;
+            *link = node->next;
+            bfree(node);
+            break;
+        }
+        link = &(*link)->next;
+    }
+
+    pthread_mutex_unlock(&g_event_mutex);
+}
+
+void monitoring_unsubscribe_achievement_updated(on_monitoring_achievement_updated_t callback) {
+    pthread_mutex_lock(&g_event_mutex);
+
+    achievement_updated_subscription_t **link = &g_achievement_updated_subscriptions;
+    while (*link) {
+        if ((*link)->callback == callback) {
+            achievement_updated_subscription_t *node = *link;
+            *link = node->next;
+            bfree(node);
+            break;
+        }
+        link = &(*link)->next;
+    }
+
+    pthread_mutex_unlock(&g_event_mutex);
+}
+
+void monitoring_unsubscribe_session_ready(on_monitoring_session_ready_t callback) {
+    pthread_mutex_lock(&g_event_mutex);
+
+    session_ready_subscription_t **link = &g_session_ready_subscriptions;
+    while (*link) {
+        if ((*link)->callback == callback) {
+            session_ready_subscription_t *node = *link;
+            *link = node->next;
+            bfree(node);
+            break;
+        }
+        link = &(*link)->next;
+    }
+
+    pthread_mutex_unlock(&g_event_mutex);
 }
 
 const identity_t *monitoring_get_current_active_identity(void) {
     return get_current_active_identity();
 }
 
+identity_t *monitoring_copy_current_active_identity(void) {
+    pthread_mutex_lock(&g_event_mutex);
+    identity_t *identity = copy_identity(get_current_active_identity());
+    pthread_mutex_unlock(&g_event_mutex);
+
+    return identity;
+}
+
 const achievement_t *monitoring_get_current_game_achievements(void) {
     return g_current_achievements;
 }
+
+achievement_t *monitoring_copy_current_game_achievements(void) {
+    pthread_mutex_lock(&g_achievements_mutex);
+    achievement_t *achievements = copy_achievement(g_current_achievements);
+    pthread_mutex_unlock(&g_achievements_mutex);
+
+    return achievements;
+}
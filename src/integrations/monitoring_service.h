@@ -17,6 +17,15 @@ extern "C" {
  * Wraps @ref xbox_monitoring_start / @ref xbox_monitoring_stop and
  * @ref retro_achievements_monitor_start / @ref retro_achievements_monitor_stop
  * so that callers do not need to depend on each integration directly.
+ *
+ * Thread safety:
+ *   The monitors report events from their own threads. Events are handled one
+ *   at a time and the subscribers are notified in order, from the monitor
+ *   thread, with the service locked: a subscriber may call the
+ *   monitoring_get_* functions but must not subscribe or restore/save the
+ *   snapshot from its callback. Other threads (render, UI) use
+ *   @ref monitoring_copy_current_game_achievements and
+ *   @ref monitoring_copy_current_active_identity.
  */
 
 /**
@@ -62,6 +71,17 @@ typedef void (*on_monitoring_game_played_t)(const game_t *game);
  */
 typedef void (*on_monitoring_achievements_changed_t)(void);
 
+/**
+ * @brief Callback invoked when a single achievement of the current game changes.
+ *
+ * Fired when an integration reports progress on, or the unlock of, one
+ * achievement that is patched in place in the cached list (no full reload).
+ * The achievement is unlocked when its @c unlocked_timestamp is non-zero.
+ *
+ * @param achievement The updated achievement (borrowed; valid during the call).
+ */
+typedef void (*on_monitoring_achievement_updated_t)(const achievement_t *achievement);
+
 /**
  * @brief Callback invoked when the session is fully ready.
  *
@@ -88,6 +108,36 @@ void monitoring_start(void);
  */
 void monitoring_stop(void);
 
+/**
+ * @brief Seed the cached state from the snapshot saved by the previous session.
+ *
+ * Restores the identity, game, achievements and cycle position persisted by
+ * @ref monitoring_save_snapshot and notifies every subscriber as if the
+ * session had just become ready, so the overlay renders immediately at OBS
+ * launch instead of staying blank until the monitors connect.
+ *
+ * The restored state is reconciled silently once the integration that
+ * produced it reports the same game: its achievements replace the restored
+ * ones without resetting the display cycle. A different game, or an
+ * integration reporting that nothing is played, replaces it through the usual
+ * notifications. Failed connection attempts leave it in place.
+ *
+ * Call this after the sources have subscribed and before
+ * @ref monitoring_start. No-op when there is no valid snapshot.
+ */
+void monitoring_restore_snapshot(void);
+
+/**
+ * @brief Persist the current state for the next launch.
+ *
+ * The state is also saved automatically whenever the achievements of the
+ * current game are (re)loaded or change; call this on shutdown to capture the
+ * latest cycle position. Nothing is written while the achievements of the
+ * current game are still loading or when no game is played, so the last
+ * meaningful snapshot is kept.
+ */
+void monitoring_save_snapshot(void);
+
 /**
  * @brief Subscribe to connection-state change events from any monitor.
  *
@@ -133,6 +183,17 @@ void monitoring_subscribe_game_played(on_monitoring_game_played_t callback);
  */
 void monitoring_subscribe_achievements_changed(on_monitoring_achievements_changed_t callback);
 
+/**
+ * @brief Subscribe to single-achievement update events from any integration.
+ *
+ * The callback is fired whenever one achievement is unlocked or progresses.
+ * Passing NULL unsubscribes.
+ *
+ * @param callback Function to invoke when an achievement is updated, or NULL
+ *                 to unsubscribe.
+ */
+void monitoring_subscribe_achievement_updated(on_monitoring_achievement_updated_t callback);
+
 /**
  * @brief Subscribe to session-ready events from any integration.
  *
@@ -144,6 +205,36 @@ void monitoring_subscribe_achievements_changed(on_monitoring_achievements_change
  */
 void monitoring_subscribe_session_ready(on_monitoring_session_ready_t callback);
 
+/**
+ * @brief Unsubscribe a single game-played callback.
+ *
+ * Unlike passing NULL to monitoring_subscribe_game_played(), the other
+ * subscribers are kept. Does nothing when @p callback is not subscribed.
+ *
+ * @param callback Callback previously passed to monitoring_subscribe_game_played().
+ */
+void monitoring_unsubscribe_game_played(on_monitoring_game_played_t callback);
+
+/**
+ * @brief Unsubscribe a single achievement-updated callback.
+ *
+ * Unlike passing NULL to monitoring_subscribe_achievement_updated(), the other
+ * subscribers are kept. Does nothing when @p callback is not subscribed.
+ *
+ * @param callback Callback previously passed to monitoring_subscribe_achievement_updated().
+ */
+void monitoring_unsubscribe_achievement_updated(on_monitoring_achievement_updated_t callback);
+
+/**
+ * @brief Unsubscribe a single session-ready callback.
+ *
+ * Unlike passing NULL to monitoring_subscribe_session_ready(), the other
+ * subscribers are kept. Does nothing when @p callback is not subscribed.
+ *
+ * @param callback Callback previously passed to monitoring_subscribe_session_ready().
+ */
+void monitoring_unsubscribe_session_ready(on_monitoring_session_ready_t callback);
+
 /**
  * @brief Get the currently active identity, if any.
  *
@@ -152,12 +243,24 @@ void monitoring_subscribe_session_ready(on_monitoring_session_ready_t callback);
  * state at creation time, after the monitor has already connected.
  *
  * Ownership/lifetime: the returned pointer is owned by the monitoring service
- * and may be replaced on the next identity update. Do not free it.
+ * and may be replaced on the next identity update. Do not free it. Only call
+ * it from a monitoring callback, where no update can run concurrently.
  *
  * @return The active identity, or NULL if no session is established.
  */
 const identity_t *monitoring_get_current_active_identity(void);
 
+/**
+ * @brief Copy the currently active identity, if any.
+ *
+ * Safe to call from any thread but a monitoring callback: the sources use it
+ * at creation time, while the warm-up task may be restoring the snapshot.
+ *
+ * @return A copy of the active identity (free with free_identity_t()), or NULL
+ *         if no session is established.
+ */
+identity_t *monitoring_copy_current_active_identity(void);
+
 /**
  * @brief Get the cached generic achievements list for the current game.
  *
@@ -165,12 +268,22 @@ const identity_t *monitoring_get_current_active_identity(void);
  * regardless of which integration provided them.
  *
  * Ownership/lifetime: the returned pointer is owned by the monitoring service
- * and may be replaced on the next update. Copy if you need to keep it.
+ * and may be replaced on the next update. Copy if you need to keep it. Only
+ * call it from a monitoring callback, where no update can run concurrently.
  *
  * @return Head of the generic achievements linked list, or NULL if unavailable.
  */
 const achievement_t *monitoring_get_current_game_achievements(void);
 
+/**
+ * @brief Copy the cached generic achievements list for the current game.
+ *
+ * Safe to call from any thread, including while an event is being handled.
+ *
+ * @return A deep copy of the list (free with free_achievement()), or NULL if unavailable.
+ */
+achievement_t *monitoring_copy_current_game_achievements(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -26,6 +26,7 @@
 #include <string.h>
 
 #include "common/types.h"
+#include "diagnostics/memory_accounting.h"
 #include "external/cjson/cJSON.h"
 
 /* -------------------------------------------------------------------------
@@ -297,7 +298,8 @@ static void on_message_received(const char *buffer) {
                 cJSON_Delete(root);
                 return;
             }
-            achievements = (retro_achievement_t *)bzalloc(sizeof(retro_achievement_t) * (size_t)count);
+            achievements = (retro_achievement_t *)memory_alloc(MEMORY_TAG_MODEL,
+                                                               sizeof(retro_achievement_t) * (size_t)count);
             if (!achievements) {
                 obs_log(LOG_ERROR, "[RetroAchievements] Failed to allocate achievements array");
                 cJSON_Delete(root);
@@ -348,7 +350,7 @@ static void on_message_received(const char *buffer) {
         }
 
         notify_achievements(achievements, (size_t)count);
-        bfree(achievements);
+        memory_free(achievements);
 
     } else if (strcmp(type_item->valuestring, "user") == 0) {
         retro_user_t user;
@@ -437,7 +439,7 @@ static int websocket_callback(struct lws *wsi, enum lws_callback_reasons reason,
             size_t needed = ctx->rx_buffer_used + len + 1;
             if (needed > ctx->rx_buffer_size) {
                 size_t new_size   = needed * 2;
-                char  *new_buffer = (char *)brealloc(ctx->rx_buffer, new_size);
+                char  *new_buffer = (char *)memory_realloc(MEMORY_TAG_NET, ctx->rx_buffer, new_size);
                 if (!new_buffer) {
                     obs_log(LOG_ERROR, "[RetroAchievements] Failed to grow receive buffer");
                     return -1;
@@ -496,6 +498,10 @@ static const struct lws_protocols protocols[] = {
 static void *monitor_thread(void *arg) {
     monitor_context_t *ctx = arg;
 
+    if (!thread_set_class(THREAD_CLASS_NETWORK, "RetroMonitor")) {
+        obs_log(LOG_WARNING, "[RetroAchievements] Could not apply the thread priority");
+    }
+
     struct lws_context_creation_info info;
     memset(&info, 0, sizeof(info));
 
@@ -602,7 +608,7 @@ bool retro_achievements_monitor_start(void) {
     g_monitor_context->last_status_notified = false;
 
     g_monitor_context->rx_buffer_size = 4096;
-    g_monitor_context->rx_buffer      = (char *)bmalloc(g_monitor_context->rx_buffer_size);
+    g_monitor_context->rx_buffer      = (char *)memory_malloc(MEMORY_TAG_NET, g_monitor_context->rx_buffer_size);
     g_monitor_context->rx_buffer_used = 0;
 
     if (!g_monitor_context->rx_buffer) {
@@ -620,7 +626,7 @@ bool retro_achievements_monitor_start(void) {
     goto done;
 
 error:
-    bfree(g_monitor_context->rx_buffer);
+    memory_free(g_monitor_context->rx_buffer);
     bfree(g_monitor_context);
     g_monitor_context = NULL;
 
@@ -645,7 +651,7 @@ void retro_achievements_monitor_stop(void) {
         pthread_join(g_monitor_context->thread, NULL);
     }
 
-    bfree(g_monitor_context->rx_buffer);
+    memory_free(g_monitor_context->rx_buffer);
     bfree(g_monitor_context);
     g_monitor_context = NULL;
 
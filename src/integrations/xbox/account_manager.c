@@ -5,53 +5,205 @@
 
 #include <stdio.h>
 
+#include "io/snapshot.h"
 #include "io/state.h"
 #include "integrations/xbox/oauth/xbox-live.h"
 #include "integrations/xbox/xbox_monitor.h"
+#include "util/thread_compat.h"
+
+/**
+ * Account listener and sign-in flag. The listener is invoked with the mutex
+ * held so that clearing it waits for any callback in progress.
+ */
+static pthread_mutex_t                     g_listener_mutex      = PTHREAD_MUTEX_INITIALIZER;
+static on_xbox_account_changed_t           g_on_account_changed  = NULL;
+static on_xbox_connection_health_changed_t g_on_health_changed   = NULL;
+static void                               *g_listener_data       = NULL;
+static bool                                g_health_subscribed   = false;
+static bool                                g_signing_in          = false;
+
+/**
+ * Signed-in flag and gamertag, as stored. Guarded by g_listener_mutex and
+ * reloaded with each account notification, so that the dialog renders without
+ * reading the state or refreshing the tokens.
+ */
+static bool g_account_loaded = false;
+static bool g_signed_in      = false;
+static char g_gamertag[128];
+
+/**
+ * @brief Reload the signed-in flag and the gamertag from the stored identity. Called with g_listener_mutex held.
+ *
+ * Reads the state only: an expired token is refreshed by the next Xbox call, not here.
+ */
+static void load_account(void) {
+
+    xbox_identity_t *identity = state_get_xbox_identity();
+
+    g_signed_in = identity != NULL;
+    snprintf(g_gamertag, sizeof(g_gamertag), "%s", identity && identity->gamertag ? identity->gamertag : "");
+    g_account_loaded = true;
+
+    free_identity(&identity);
+}
+
+static void notify_account_changed(void) {
+
+    pthread_mutex_lock(&g_listener_mutex);
+
+    load_account();
+
+    if (g_on_account_changed) {
+        g_on_account_changed(g_listener_data);
+    }
+
+    pthread_mutex_unlock(&g_listener_mutex);
+}
+
+static void on_xbox_health_changed(const xbox_connection_health_t *health) {
+
+    pthread_mutex_lock(&g_listener_mutex);
+
+    if (g_on_health_changed) {
+        g_on_health_changed(health, g_listener_data);
+    }
+
+    pthread_mutex_unlock(&g_listener_mutex);
+}
+
+static void set_signing_in(bool signing_in) {
+
+    pthread_mutex_lock(&g_listener_mutex);
+    g_signing_in = signing_in;
+    pthread_mutex_unlock(&g_listener_mutex);
+}
 
 static void on_xbox_signed_in(void *data) {
     UNUSED_PARAMETER(data);
 
     xbox_monitoring_start();
+
+    set_signing_in(false);
+    notify_account_changed();
+}
+
+void xbox_account_set_listener(on_xbox_account_changed_t           on_account_changed,
+                               on_xbox_connection_health_changed_t on_health_changed,
+                               void                               *data) {
+
+    pthread_mutex_lock(&g_listener_mutex);
+
+    g_on_account_changed = on_account_changed;
+    g_on_health_changed  = on_health_changed;
+    g_listener_data      = data;
+
+    const bool subscribe = on_health_changed && !g_health_subscribed;
+    g_health_subscribed  = g_health_subscribed || subscribe;
+
+    pthread_mutex_unlock(&g_listener_mutex);
+
+    /* Subscribed once and for all, outside of the lock: the monitor invokes the callback with its own lock held */
+    if (subscribe) {
+        xbox_subscribe_health_changed(on_xbox_health_changed);
+    }
+}
+
+void xbox_account_get_connection_health(xbox_connection_health_t *health) {
+    xbox_monitoring_get_health(health);
+}
+
+void xbox_account_get_connection_configuration(rta_connection_configuration_t *configuration) {
+
+    rta_connection_configuration_t *stored = state_get_rta_connection_configuration();
+
+    *configuration = *stored;
+
+    bfree(stored);
+}
+
+void xbox_account_set_connection_configuration(const rta_connection_configuration_t *configuration) {
+
+    if (!configuration) {
+        return;
+    }
+
+    state_set_rta_connection_configuration(configuration);
+
+    /* The monitor reads its settings when it starts */
+    if (xbox_monitoring_is_active()) {
+        obs_log(LOG_INFO, "[XboxAccount] Connection settings changed, restarting the monitoring");
+        xbox_monitoring_stop();
+        xbox_monitoring_start();
+    }
 }
 
 bool xbox_account_sign_in(void) {
+    set_signing_in(true);
+
     if (!xbox_live_authenticate(NULL, &on_xbox_signed_in)) {
         obs_log(LOG_WARNING, "[XboxAccount] Sign-in failed");
+        set_signing_in(false);
         return false;
     }
 
+    notify_account_changed();
+
     return true;
 }
 
+void xbox_account_cancel_sign_in(void) {
+    xbox_live_cancel_authentication();
+}
+
+bool xbox_account_is_signing_in(void) {
+
+    pthread_mutex_lock(&g_listener_mutex);
+    const bool signing_in = g_signing_in;
+    pthread_mutex_unlock(&g_listener_mutex);
+
+    return signing_in;
+}
+
 void xbox_account_sign_out(void) {
     state_clear();
+    snapshot_delete();
     xbox_monitoring_stop();
+
+    notify_account_changed();
 }
 
 bool xbox_account_is_signed_in(void) {
-    xbox_identity_t *identity  = xbox_live_get_identity();
-    const bool       signed_in = identity != NULL;
 
-    free_identity(&identity);
+    pthread_mutex_lock(&g_listener_mutex);
+
+    if (!g_account_loaded) {
+        load_account();
+    }
+
+    const bool signed_in = g_signed_in;
+
+    pthread_mutex_unlock(&g_listener_mutex);
 
     return signed_in;
 }
 
 void xbox_account_get_status_text(char *buffer, size_t buffer_size) {
-    xbox_identity_t *identity;
 
     if (!buffer || buffer_size == 0) {
         return;
     }
 
-    identity = xbox_live_get_identity();
+    pthread_mutex_lock(&g_listener_mutex);
 
-    if (identity && identity->gamertag && *identity->gamertag) {
-        snprintf(buffer, buffer_size, "Signed in as %s", identity->gamertag);
+    if (!g_account_loaded) {
+        load_account();
+    }
+
+    if (g_signed_in && g_gamertag[0] != '\0') {
+        snprintf(buffer, buffer_size, "Signed in as %s", g_gamertag);
     } else {
         snprintf(buffer, buffer_size, "Not connected.");
     }
 
-    free_identity(&identity);
+    pthread_mutex_unlock(&g_listener_mutex);
 }
@@ -3,10 +3,73 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+#include "common/types.h"
+#include "integrations/xbox/entities/xbox_connection_health.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief Callback invoked when the account state changes.
+ *
+ * Fired when a sign-in starts or ends (successfully, with an error or
+ * cancelled) and on sign-out. Invoked from the thread causing the change,
+ * possibly a background thread: marshal to the UI thread before touching UI.
+ *
+ * @param data Opaque pointer passed to xbox_account_set_listener().
+ */
+typedef void (*on_xbox_account_changed_t)(void *data);
+
+/**
+ * @brief Callback invoked when the Xbox Live connection health changes.
+ *
+ * Invoked from the monitor thread.
+ *
+ * @param health Current health (borrowed; valid during the call).
+ * @param data   Opaque pointer passed to xbox_account_set_listener().
+ */
+typedef void (*on_xbox_connection_health_changed_t)(const xbox_connection_health_t *health, void *data);
+
+/**
+ * @brief Set the listener notified of account and connection changes.
+ *
+ * There is a single listener (the Xbox Account dialog). Passing NULL callbacks
+ * removes it; once this returns, no callback of the previous listener is
+ * running or will run.
+ *
+ * @param on_account_changed Called when the account state changes (may be NULL).
+ * @param on_health_changed  Called when the connection health changes (may be NULL).
+ * @param data               Opaque pointer forwarded to the callbacks.
+ */
+void xbox_account_set_listener(on_xbox_account_changed_t           on_account_changed,
+                               on_xbox_connection_health_changed_t on_health_changed,
+                               void                               *data);
+
+/**
+ * @brief Get the current Xbox Live connection health.
+ *
+ * @param health Receives the health (must not be NULL).
+ */
+void xbox_account_get_connection_health(xbox_connection_health_t *health);
+
+/**
+ * @brief Get the keepalive and compression settings of the Xbox Live connection.
+ *
+ * @param configuration Receives the settings, defaults applied (must not be NULL).
+ */
+void xbox_account_get_connection_configuration(rta_connection_configuration_t *configuration);
+
+/**
+ * @brief Store the keepalive and compression settings of the Xbox Live connection.
+ *
+ * A running monitoring is restarted so that the new settings take effect
+ * immediately. Blocks until the previous connection is closed.
+ *
+ * @param configuration Settings to store. May be NULL (no-op).
+ */
+void xbox_account_set_connection_configuration(const rta_connection_configuration_t *configuration);
+
 /**
  * @brief Starts Xbox monitoring if a persisted identity is already available.
  */
@@ -21,6 +84,16 @@ void xbox_account_start_monitoring_if_needed(void);
  */
 bool xbox_account_sign_in(void);
 
+/**
+ * @brief Cancel the sign-in started by xbox_account_sign_in(), if still waiting for the user.
+ */
+void xbox_account_cancel_sign_in(void);
+
+/**
+ * @brief Returns whether a sign-in started by xbox_account_sign_in() is still running.
+ */
+bool xbox_account_is_signing_in(void);
+
 /**
  * @brief Sign the current Xbox user out and stop monitoring.
  */
@@ -28,6 +101,9 @@ void xbox_account_sign_out(void);
 
 /**
  * @brief Returns whether an Xbox identity is currently stored.
+ *
+ * Answered from a cache reloaded on each account notification: cheap enough
+ * for the UI thread, and never refreshes the tokens over the network.
  */
 bool xbox_account_is_signed_in(void);
 
@@ -35,7 +111,7 @@ bool xbox_account_is_signed_in(void);
  * @brief Formats the current Xbox account status into the provided buffer.
  *
  * The buffer always receives a NUL-terminated string when @p buffer_size is
- * greater than zero.
+ * greater than zero. Rendered from the same cache as xbox_account_is_signed_in().
  */
 void xbox_account_get_status_text(char *buffer, size_t buffer_size);
 
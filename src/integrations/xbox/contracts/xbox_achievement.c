@@ -1,6 +1,8 @@
 #include "integrations/xbox/contracts/xbox_achievement.h"
+#include "common/intern.h"
 #include "common/memory.h"
 #include "diagnostics/log.h"
+#include "diagnostics/memory_accounting.h"
 
 #include <inttypes.h>
 #include <obs-module.h>
@@ -110,6 +112,13 @@ void xbox_free_reward(xbox_reward_t **reward) {
     *reward = NULL;
 }
 
+xbox_achievement_t *xbox_alloc_achievement(void) {
+
+    memory_account(MEMORY_TAG_MODEL, (int64_t)sizeof(xbox_achievement_t));
+
+    return bzalloc(sizeof(xbox_achievement_t));
+}
+
 xbox_achievement_t *xbox_copy_achievement(const xbox_achievement_t *achievement) {
 
     if (!achievement) {
@@ -124,15 +133,15 @@ xbox_achievement_t *xbox_copy_achievement(const xbox_achievement_t *achievement)
     while (current) {
         const xbox_achievement_t *next = current->next;
 
-        xbox_achievement_t *copy = bzalloc(sizeof(xbox_achievement_t));
+        xbox_achievement_t *copy = xbox_alloc_achievement();
 
-        copy->id                  = bstrdup(current->id);
-        copy->description         = bstrdup(current->description);
-        copy->locked_description  = bstrdup(current->locked_description);
-        copy->name                = bstrdup(current->name);
+        copy->id                  = intern_string(current->id);
+        copy->description         = intern_string(current->description);
+        copy->locked_description  = intern_string(current->locked_description);
+        copy->name                = intern_string(current->name);
         copy->progress_state      = bstrdup(current->progress_state);
-        copy->service_config_id   = bstrdup(current->service_config_id);
-        copy->icon_url            = bstrdup(current->icon_url);
+        copy->service_config_id   = intern_string(current->service_config_id);
+        copy->icon_url            = intern_string(current->icon_url);
         copy->media_assets        = xbox_copy_media_asset(current->media_assets);
         copy->rewards             = xbox_copy_reward(current->rewards);
         copy->is_secret           = current->is_secret;
@@ -166,19 +175,21 @@ void xbox_free_achievement(xbox_achievement_t **achievement) {
     while (current) {
         xbox_achievement_t *next = current->next;
 
-        free_memory((void **)&current->service_config_id);
-        free_memory((void **)&current->id);
-        free_memory((void **)&current->name);
-        free_memory((void **)&current->description);
-        free_memory((void **)&current->locked_description);
+        intern_release(&current->service_config_id);
+        intern_release(&current->id);
+        intern_release(&current->name);
+        intern_release(&current->description);
+        intern_release(&current->locked_description);
         free_memory((void **)&current->progress_state);
-        free_memory((void **)&current->icon_url);
+        intern_release(&current->icon_url);
         free_memory((void **)&current->progression_current);
         free_memory((void **)&current->progression_target);
         xbox_free_media_asset(&current->media_assets);
         xbox_free_reward(&current->rewards);
         free_memory((void **)&current);
 
+        memory_account(MEMORY_TAG_MODEL, -(int64_t)sizeof(xbox_achievement_t));
+
         current = next;
     }
 
@@ -327,11 +338,11 @@ achievement_t *xbox_to_achievements(const xbox_achievement_t *xbox) {
     achievement_t *previous = NULL;
 
     for (const xbox_achievement_t *x = xbox; x != NULL; x = x->next) {
-        achievement_t *a      = bzalloc(sizeof(achievement_t));
-        a->id                 = bstrdup(x->id);
-        a->name               = bstrdup(x->name);
-        a->description        = bstrdup(x->description);
-        a->icon_url           = bstrdup(x->icon_url);
+        achievement_t *a      = alloc_achievement();
+        a->id                 = intern_string(x->id);
+        a->name               = intern_string(x->name);
+        a->description        = intern_string(x->description);
+        a->icon_url           = intern_string(x->icon_url);
         a->is_secret          = x->is_secret;
         a->value              = (x->rewards && x->rewards->value) ? atoi(x->rewards->value) : 0;
         a->unlocked_timestamp = x->unlocked_timestamp;
@@ -340,7 +351,7 @@ achievement_t *xbox_to_achievements(const xbox_achievement_t *xbox) {
         if (x->progression_current && x->progression_target && strcmp(x->progression_current, "0") != 0) {
             char measured[128];
             snprintf(measured, sizeof(measured), "%s/%s", x->progression_current, x->progression_target);
-            a->measured_progress = bstrdup(measured);
+            a->measured_progress = intern_string(measured);
         }
 
         if (previous) {
@@ -45,7 +45,9 @@ typedef struct xbox_reward {
  *
  * This type is used as a singly linked list (@c next). Most fields are strings
  * coming from the Xbox Live service. When an @c xbox_achievement_t is produced
- * by @ref xbox_copy_achievement, all strings and nested lists are deep-copied.
+ * by @ref xbox_copy_achievement, nested lists are deep-copied and the
+ * descriptive strings (ids, name, descriptions, icon URL) are interned (see
+ * intern.h).
  *
  * Ownership:
  * - Instances returned by @ref xbox_copy_achievement are owned by the caller
@@ -134,11 +136,22 @@ xbox_reward_t *xbox_copy_reward(const xbox_reward_t *reward);
  */
 void xbox_free_reward(xbox_reward_t **reward);
 
+/**
+ * @brief Allocates a zeroed Xbox achievement node.
+ *
+ * The node is accounted to the model memory tag and released by
+ * @ref xbox_free_achievement: allocate nodes with this function rather than
+ * bzalloc() so that the accounting balances.
+ *
+ * @return The new node, to be freed with @ref xbox_free_achievement.
+ */
+xbox_achievement_t *xbox_alloc_achievement(void);
+
 /**
  * @brief Deep-copies a linked list of Xbox achievements.
  *
- * Performs a deep copy of the list, including all strings and nested
- * @c media_assets and @c rewards lists.
+ * Performs a deep copy of the list, including the nested @c media_assets and
+ * @c rewards lists. Descriptive strings are shared through the intern pool.
  *
  * @param achievement Head of the source list (may be NULL).
  *
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Health of the Xbox Live RTA connection.
+ *
+ * Plain value type: copied as a whole, owns no memory.
+ */
+typedef struct xbox_connection_health {
+    /** Whether the websocket is currently established. */
+    bool     connected;
+    /** Last measured websocket ping/pong round trip in milliseconds, or -1 if unknown. */
+    int64_t  round_trip_ms;
+    /** Monotonic time (os_gettime_ns()) of the last message received, or 0 if none. */
+    uint64_t last_message_ns;
+    /** Number of reconnections since monitoring started. */
+    uint32_t reconnect_count;
+} xbox_connection_health_t;
+
+#ifdef __cplusplus
+}
+#endif
@@ -27,8 +27,11 @@
  * Acquires a device authentication token using an emulated Xbox device identity:
  * - Uses cryptographic signing (ECDSA P-256) to prove possession of the device key
  * - The device token is required for SISU authentication
- * - Cached device tokens are reused if not expired
+ * - Cached device tokens are reused until they expire, including across token refreshes
  * - Device identity includes UUID, serial number, and public/private key pair
+ * - The device token does not depend on the user token: it is fetched on a helper
+ *   thread while Stage 1 runs (typically while the user enters the code), so it
+ *   is ready by the time the user token arrives
  *
  * ### Stage 3: SISU Token and Xbox Identity
  * Acquires the final Xbox Live authentication token:
@@ -39,7 +42,9 @@
  * ## Threading Model
  *
  * All authentication work is performed on a background pthread to avoid blocking
- * the OBS main thread. Completion is signaled via callback.
+ * the OBS main thread. Completion is signaled via callback. A second, short-lived
+ * thread fetches the device token concurrently with the user token; it is joined
+ * before the SISU request and never touches the persisted state.
  *
  * ## Token Expiration and Refresh
  *
@@ -92,8 +97,10 @@
 #include "io/state.h"
 #include "common/device.h"
 #include "text/convert.h"
+#include "text/parsers.h"
 #include "time/time.h"
 
+#include <util/platform.h>
 #include <util/thread_compat.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -146,18 +153,6 @@ typedef struct authentication_ctx {
      */
     device_t *device;
 
-    /**
-     * Whether to use cached tokens. Set to false to force token refresh.
-     * When true, cached user, device, and SISU tokens are preferred.
-     */
-    bool allow_cache;
-
-    /**
-     * Background worker thread running the authentication flow.
-     * Created by xbox_live_authenticate() to avoid blocking the main thread.
-     */
-    pthread_t thread;
-
     /**
      * Completion callback invoked when the flow finishes (success or error).
      * Called exactly once at the end of the authentication process.
@@ -182,17 +177,18 @@ typedef struct authentication_ctx {
      */
     long interval_in_seconds;
 
-    /**
-     * Sleep time (currently unused / reserved for future rate limiting).
-     */
-    long sleep_time;
-
     /**
      * Device-code flow: device-code expiry time in seconds.
      * After this duration, the device code expires and cannot be used.
      */
     long expires_in_seconds;
 
+    /**
+     * Device-code flow: monotonic time (os_gettime_ns()) at which the device
+     * code was issued; expires_in_seconds counts from there.
+     */
+    uint64_t issued_at_ns;
+
     /**
      * Result struct holding any error message / status for the caller.
      * Populated if authentication fails at any stage.
@@ -217,8 +213,42 @@ typedef struct authentication_ctx {
      */
     token_t *device_token;
 
+    /**
+     * Thread fetching the device token while the user token is acquired.
+     * Only valid when device_token_thread_started is true.
+     */
+    pthread_t device_token_thread;
+
+    /** Whether device_token_thread is running and must be joined. */
+    bool device_token_thread_started;
+
+    /** Error reported by the device token fetch, or NULL. */
+    const char *device_token_error;
+
 } authentication_ctx_t;
 
+/** @brief Polling granularity of the device-code wait, so a cancellation is noticed quickly. */
+#define POLL_CANCEL_CHECK_MS 50
+
+/** @brief Device-code polling interval when the server does not provide one (RFC 8628, section 3.2). */
+#define DEFAULT_POLL_INTERVAL_SECONDS 5
+
+/** @brief Interval increase requested by a slow_down response (RFC 8628, section 3.5). */
+#define SLOW_DOWN_INCREMENT_SECONDS 5
+
+/**
+ * @brief Number of authentication flows running on a background thread.
+ *
+ * The flow threads are detached; xbox_live_stop() waits on g_flows_done until
+ * this drops back to zero. Protected by g_flows_mutex.
+ */
+static int             g_running_flows = 0;
+static pthread_mutex_t g_flows_mutex   = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  g_flows_done    = PTHREAD_COND_INITIALIZER;
+
+/** Set by xbox_live_cancel_authentication(); cleared when a new flow starts. Protected by g_flows_mutex. */
+static bool g_sign_in_cancelled = false;
+
 //  --------------------------------------------------------------------------------------------------------------------
 //  Private
 //  --------------------------------------------------------------------------------------------------------------------
@@ -274,13 +304,10 @@ static void complete(authentication_ctx_t *ctx) {
  * "signature" HTTP header.
  *
  * ## Error Handling
- * On any failure (signing, network, parsing), sets ctx->result.error_message
- * and calls complete(ctx) to notify the caller.
+ * On any failure (signing, network, parsing), sets ctx->result.error_message.
  *
  * @param ctx Authentication context containing user_token and device_token
  * @return true on success, false on failure
- *
- * @note On success or failure, this function calls complete(ctx) to signal completion.
  */
 static bool retrieve_sisu_token(authentication_ctx_t *ctx) {
 
@@ -454,21 +481,15 @@ cleanup:
     free_memory((void **)&sisu_token_response);
     free_json_memory((void **)&sisu_token_json);
 
-    complete(ctx);
-
     return succeeded;
 }
 
 /**
- * @brief Retrieve the device Proof-of-Possession (PoP) token required for SISU.
+ * @brief Request a new device Proof-of-Possession (PoP) token required for SISU.
  *
  * This implements Xbox Live's device authentication protocol, which proves the
  * client possesses a specific device private key.
  *
- * ## Caching Behavior
- * If allow_cache is true and a valid cached device token exists, it is reused
- * and the flow proceeds directly to retrieve_sisu_token().
- *
  * ## Device Authentication Process
  * 1. Constructs a JSON request containing:
  *    - AuthMethod: "ProofOfPossession"
@@ -479,47 +500,35 @@ cleanup:
  * 4. Parses response for:
  *    - Token: The device authentication token (JWT)
  *    - NotAfter: Token expiration timestamp (ISO8601)
- * 5. Persists the token via state_set_device_token()
  *
  * ## Security
  * The cryptographic signature proves that the client controls the private key
  * corresponding to the ProofKey. This prevents device spoofing.
  *
- * ## Error Handling
- * On failure (signing, network, parsing), sets ctx->result.error_message and
- * calls complete(ctx).
- *
- * @param ctx Authentication context containing device identity
- * @return true if successful and proceeding to next stage, false on failure
+ * ## Threading
+ * Runs on the device token thread: it only uses the device identity and does
+ * not touch the persisted state, which is updated by the flow thread once the
+ * token is joined (see acquire_device_token()).
  *
- * @note On success, proceeds to retrieve_sisu_token(). On failure, calls complete(ctx).
+ * @param device        Device identity whose keys sign the request
+ * @param error_message Receives a static error message on failure
+ * @return Newly allocated device token, or NULL on failure
  */
-static bool retrieve_device_token(struct authentication_ctx *ctx) {
-
-    /* Finds out if a device token already exists */
-    token_t *existing_device_token = state_get_device_token();
-
-    if (ctx->allow_cache && existing_device_token) {
-        obs_log(LOG_INFO, "[XboxAuth] Using cached device token");
-        ctx->device_token = existing_device_token;
-        return retrieve_sisu_token(ctx);
-    }
+static token_t *request_device_token(const device_t *device, const char **error_message) {
 
-    bool     succeeded             = false;
+    token_t *device_token          = NULL;
     char    *encoded_signature     = NULL;
     char    *device_token_response = NULL;
     uint8_t *signature             = NULL;
     char    *proof_key             = NULL;
     cJSON   *device_token_json     = NULL;
 
-    obs_log(LOG_INFO, "[XboxAuth] No cached device token found, requesting a new one");
-
     /* Builds the device token request */
-    proof_key = crypto_to_string(ctx->device->keys, false);
+    proof_key = crypto_to_string(device->keys, false);
 
     if (!proof_key) {
-        ctx->result.error_message = "Unable retrieve a device token: could not serialize proof key";
-        obs_log(LOG_ERROR, "[XboxAuth] %s", ctx->result.error_message);
+        *error_message = "Unable retrieve a device token: could not serialize proof key";
+        obs_log(LOG_ERROR, "[XboxAuth] %s", *error_message);
         goto cleanup;
     }
 
@@ -527,19 +536,19 @@ static bool retrieve_device_token(struct authentication_ctx *ctx) {
     snprintf(json_body,
              sizeof(json_body),
              "{\"Properties\":{\"AuthMethod\":\"ProofOfPossession\",\"Id\":\"{%s}\",\"DeviceType\":\"iOS\",\"SerialNumber\":\"{%s}\",\"Version\":\"1.0.0\",\"ProofKey\":%s},\"RelyingParty\":\"http://auth.xboxlive.com\",\"TokenType\":\"JWT\"}",
-             ctx->device->uuid,
-             ctx->device->serial_number,
+             device->uuid,
+             device->serial_number,
              proof_key);
 
     obs_log(LOG_DEBUG, "[XboxAuth] Device token request body: %s", json_body);
 
     /* Signs the request */
     size_t signature_len = 0;
-    signature            = crypto_sign(ctx->device->keys, DEVICE_AUTHENTICATE, "", json_body, &signature_len);
+    signature            = crypto_sign(device->keys, DEVICE_AUTHENTICATE, "", json_body, &signature_len);
 
     if (!signature) {
-        ctx->result.error_message = "Unable retrieve a device token: signing failed";
-        obs_log(LOG_ERROR, "[XboxAuth] %s", ctx->result.error_message);
+        *error_message = "Unable retrieve a device token: signing failed";
+        obs_log(LOG_ERROR, "[XboxAuth] %s", *error_message);
         goto cleanup;
     }
 
@@ -547,8 +556,8 @@ static bool retrieve_device_token(struct authentication_ctx *ctx) {
     encoded_signature = base64_encode(signature, signature_len);
 
     if (!encoded_signature) {
-        ctx->result.error_message = "Unable retrieve a device token: signature encoding failed";
-        obs_log(LOG_ERROR, "[XboxAuth] %s", ctx->result.error_message);
+        *error_message = "Unable retrieve a device token: signature encoding failed";
+        obs_log(LOG_ERROR, "[XboxAuth] %s", *error_message);
         goto cleanup;
     }
 
@@ -569,42 +578,41 @@ static bool retrieve_device_token(struct authentication_ctx *ctx) {
     device_token_response = http_post(DEVICE_AUTHENTICATE, json_body, extra_headers, &http_code);
 
     if (!device_token_response) {
-        ctx->result.error_message = "Unable retrieve a device token: server returned no response";
-        obs_log(LOG_ERROR, "[XboxAuth] %s", ctx->result.error_message);
-        return false;
+        *error_message = "Unable retrieve a device token: server returned no response";
+        obs_log(LOG_ERROR, "[XboxAuth] %s", *error_message);
+        goto cleanup;
     }
 
     obs_log(LOG_DEBUG, "Received response with status code %d: %s", http_code, device_token_response);
 
     if (http_code < 200 || http_code >= 300) {
-        ctx->result.error_message = "Unable retrieve a device token: server returned an error";
+        *error_message = "Unable retrieve a device token: server returned an error";
         obs_log(LOG_ERROR, "Unable retrieve a device token: server returned status code %d", http_code);
-        free_memory((void **)&device_token_response);
-        return false;
+        goto cleanup;
     }
 
     /* Retrieves the device token */
     device_token_json = cJSON_Parse(device_token_response);
 
     if (!device_token_json) {
-        ctx->result.error_message = "Unable retrieve a device token: unable to parse the JSON response";
+        *error_message = "Unable retrieve a device token: unable to parse the JSON response";
         goto cleanup;
     }
 
     cJSON *token_node = cJSONUtils_GetPointer(device_token_json, "/Token");
 
     if (!token_node) {
-        ctx->result.error_message = "Unable retrieve a device token: unable to read the token from the response";
-        obs_log(LOG_ERROR, "[XboxAuth] %s", ctx->result.error_message);
+        *error_message = "Unable retrieve a device token: unable to read the token from the response";
+        obs_log(LOG_ERROR, "[XboxAuth] %s", *error_message);
         goto cleanup;
     }
 
     cJSON *not_after_date_node = cJSONUtils_GetPointer(device_token_json, "/NotAfter");
 
     if (!not_after_date_node) {
-        ctx->result.error_message =
+        *error_message =
             "Unable retrieve a device token: unable to read the NotAfter field from the response";
-        obs_log(LOG_ERROR, "[XboxAuth] %s", ctx->result.error_message);
+        obs_log(LOG_ERROR, "[XboxAuth] %s", *error_message);
         goto cleanup;
     }
 
@@ -612,22 +620,16 @@ static bool retrieve_device_token(struct authentication_ctx *ctx) {
     int64_t unix_timestamp = 0;
 
     if (!convert_iso8601_utc_to_unix(not_after_date_node->valuestring, &unix_timestamp, &fraction)) {
-        ctx->result.error_message = "Unable retrieve a device token: unable to read the NotAfter date";
-        obs_log(LOG_ERROR, "[XboxAuth] %s", ctx->result.error_message);
+        *error_message = "Unable retrieve a device token: unable to read the NotAfter date";
+        obs_log(LOG_ERROR, "[XboxAuth] %s", *error_message);
         goto cleanup;
     }
 
-    /* Saves the device token */
     obs_log(LOG_INFO, "Device authentication succeeded!");
 
-    token_t *device = bzalloc(sizeof(token_t));
-    device->value   = bstrdup(token_node->valuestring);
-    device->expires = unix_timestamp;
-
-    state_set_device_token(device);
-
-    ctx->device_token = device;
-    succeeded         = true;
+    device_token          = bzalloc(sizeof(token_t));
+    device_token->value   = bstrdup(token_node->valuestring);
+    device_token->expires = unix_timestamp;
 
 cleanup:
     free_memory((void **)&proof_key);
@@ -636,15 +638,108 @@ cleanup:
     free_memory((void **)&device_token_response);
     free_json_memory((void **)&device_token_json);
 
-    if (ctx->result.error_message) {
-        complete(ctx);
+    return device_token;
+}
+
+/**
+ * @brief Entry point of the device token thread.
+ *
+ * @param param Opaque pointer to authentication_ctx_t
+ * @return Always NULL
+ */
+static void *fetch_device_token(void *param) {
+
+    authentication_ctx_t *ctx = param;
+
+    if (!thread_set_class(THREAD_CLASS_NETWORK, "XboxDeviceToken")) {
+        obs_log(LOG_WARNING, "[XboxAuth] Could not apply the thread priority");
+    }
+
+    ctx->device_token = request_device_token(ctx->device, &ctx->device_token_error);
+
+    return NULL;
+}
+
+/**
+ * @brief Start acquiring the device token while the user token is acquired.
+ *
+ * A cached device token is reused as long as it is not expired. Otherwise a new
+ * one is requested on a helper thread, so that the signed device round trip
+ * overlaps the user-code wait or the user token refresh instead of following it.
+ * Every call must be balanced by acquire_device_token() or
+ * join_device_token_prefetch().
+ *
+ * @param ctx Authentication context containing the device identity
+ */
+static void start_device_token_prefetch(authentication_ctx_t *ctx) {
+
+    token_t *cached_device_token = state_get_device_token();
+
+    if (cached_device_token && !token_is_expired(cached_device_token)) {
+        obs_log(LOG_INFO, "[XboxAuth] Using cached device token");
+        ctx->device_token = cached_device_token;
+        return;
     }
 
-    if (!succeeded) {
+    free_token(&cached_device_token);
+
+    obs_log(LOG_INFO, "[XboxAuth] No valid cached device token found, requesting a new one");
+
+    ctx->device_token_thread_started =
+        pthread_create(&ctx->device_token_thread, NULL, fetch_device_token, ctx) == 0;
+
+    if (!ctx->device_token_thread_started) {
+        obs_log(LOG_WARNING, "[XboxAuth] Could not start the device token thread, fetching it after the user token");
+    }
+}
+
+/**
+ * @brief Wait for the device token thread, if any, and persist its token.
+ *
+ * @param ctx Authentication context
+ */
+static void join_device_token_prefetch(authentication_ctx_t *ctx) {
+
+    if (!ctx->device_token_thread_started) {
+        return;
+    }
+
+    pthread_join(ctx->device_token_thread, NULL);
+    ctx->device_token_thread_started = false;
+
+    if (ctx->device_token) {
+        state_set_device_token(ctx->device_token);
+    }
+}
+
+/**
+ * @brief Obtain the device token started by start_device_token_prefetch().
+ *
+ * Joins the device token thread, or requests the token synchronously if the
+ * thread could not be started.
+ *
+ * @param ctx Authentication context
+ * @return true if ctx->device_token is set, false on failure (ctx->result.error_message is set)
+ */
+static bool acquire_device_token(authentication_ctx_t *ctx) {
+
+    join_device_token_prefetch(ctx);
+
+    if (!ctx->device_token && !ctx->device_token_error) {
+        ctx->device_token = request_device_token(ctx->device, &ctx->device_token_error);
+
+        if (ctx->device_token) {
+            state_set_device_token(ctx->device_token);
+        }
+    }
+
+    if (!ctx->device_token) {
+        ctx->result.error_message =
+            ctx->device_token_error ? ctx->device_token_error : "Unable retrieve a device token";
         return false;
     }
 
-    return retrieve_sisu_token(ctx);
+    return true;
 }
 
 /**
@@ -674,16 +769,20 @@ cleanup:
  * should be stored securely.
  *
  * ## Error Handling
- * On failure (network error, HTTP error, parse error), sets ctx->result.error_message
- * and calls complete(ctx). Common failures include expired refresh tokens.
+ * On failure (network error, HTTP error, parse error), sets ctx->result.error_message.
+ * Common failures include expired refresh tokens.
  *
  * @param ctx Authentication context containing refresh_token and device_code
- * @return true if successful and proceeding to device token retrieval, false on failure
- *
- * @note On success, proceeds to retrieve_device_token(). On failure, calls complete(ctx).
+ * @return true if ctx->user_token has been set, false on failure
  */
 static bool refresh_user_token(authentication_ctx_t *ctx) {
 
+    if (!ctx->refresh_token) {
+        ctx->result.error_message = "Unable to refresh the user token: no refresh token found";
+        obs_log(LOG_ERROR, "[XboxAuth] %s", ctx->result.error_message);
+        return false;
+    }
+
     bool   succeeded              = false;
     char  *refresh_token_response = NULL;
     cJSON *refresh_token_json     = NULL;
@@ -760,7 +859,7 @@ static bool refresh_user_token(authentication_ctx_t *ctx) {
     /* The token has been found and is saved in the context */
     token_t *user_token = bzalloc(sizeof(token_t));
     user_token->value   = bstrdup(access_token_node->valuestring);
-    user_token->expires = time(NULL) + expires_in_node->valueint / 1000;
+    user_token->expires = now() + expires_in_node->valueint / 1000;
 
     token_t *refresh_token = bzalloc(sizeof(token_t));
     refresh_token->value   = bstrdup(refresh_token_node->valuestring);
@@ -780,57 +879,127 @@ cleanup:
     free_memory((void **)&refresh_token_response);
     free_json_memory((void **)&refresh_token_json);
 
-    /* Either complete the process if an error has been encountered or go to the next step */
-    if (!ctx->user_token) {
-        complete(ctx);
-        return false;
+    return succeeded;
+}
+
+/**
+ * @brief Whether the device-code polling must stop.
+ *
+ * True on plugin unload (http_cancel_all()) and when the user cancels the
+ * sign-in (xbox_live_cancel_authentication()).
+ */
+static bool is_sign_in_cancelled(void) {
+
+    if (http_is_cancelled()) {
+        return true;
     }
 
-    if (!succeeded) {
+    pthread_mutex_lock(&g_flows_mutex);
+    const bool cancelled = g_sign_in_cancelled;
+    pthread_mutex_unlock(&g_flows_mutex);
+
+    return cancelled;
+}
+
+/**
+ * @brief Wait until @p until_ns, returning early when the sign-in is cancelled.
+ *
+ * @return false if the sign-in was cancelled during the wait.
+ */
+static bool wait_until(uint64_t until_ns) {
+
+    while (!is_sign_in_cancelled()) {
+        const uint64_t current_ns = os_gettime_ns();
+
+        if (current_ns >= until_ns) {
+            return true;
+        }
+
+        const uint64_t remaining_ms = (until_ns - current_ns) / 1000000;
+        sleep_ms(remaining_ms < POLL_CANCEL_CHECK_MS ? (unsigned int)remaining_ms + 1 : POLL_CANCEL_CHECK_MS);
+    }
+
+    return false;
+}
+
+/**
+ * @brief Persist the tokens of a successful device-code token response.
+ *
+ * @return true if the response carried the tokens and ctx->user_token has been set.
+ */
+static bool read_user_token(authentication_ctx_t *ctx, const char *token_response) {
+
+    cJSON *token_json = cJSON_Parse(token_response);
+
+    if (!token_json) {
+        obs_log(LOG_ERROR, "Failed to retrieve the user token: unable to parse the JSON response");
         return false;
     }
 
-    return retrieve_device_token(ctx);
+    cJSON *access_token_node     = cJSONUtils_GetPointer(token_json, "/access_token");
+    cJSON *refresh_token_node    = cJSONUtils_GetPointer(token_json, "/refresh_token");
+    cJSON *token_expires_in_node = cJSONUtils_GetPointer(token_json, "/expires_in");
+
+    if (access_token_node && refresh_token_node && token_expires_in_node) {
+
+        /* The token has been found and is saved in the context */
+        token_t *user_token = bzalloc(sizeof(token_t));
+        user_token->value   = bstrdup(access_token_node->valuestring);
+        user_token->expires = now() + token_expires_in_node->valueint;
+
+        token_t *refresh_token = bzalloc(sizeof(token_t));
+        refresh_token->value   = bstrdup(refresh_token_node->valuestring);
+
+        ctx->user_token = user_token;
+
+        /* And in the persistence */
+        state_set_user_token(ctx->device_code, user_token, refresh_token);
+        free_token(&refresh_token);
+
+        obs_log(LOG_INFO, "User & refresh token received");
+    }
+
+    free_json_memory((void **)&token_json);
+
+    return ctx->user_token != NULL;
 }
 
 /**
  * @brief Poll TOKEN_ENDPOINT until the user completes device-code verification.
  *
- * This implements the polling phase of OAuth 2.0 device code flow. After the user
- * has been shown a verification URL and code, this function repeatedly checks if
- * they've completed authorization.
+ * This implements the polling phase of the OAuth 2.0 device authorization grant
+ * (RFC 8628, section 3.4 and 3.5). After the user has been shown a verification
+ * URL and code, this function repeatedly checks if they've completed authorization.
  *
  * ## Polling Behavior
  * 1. Constructs form-urlencoded GET parameters with:
  *    - client_id: Xbox Live client ID
  *    - device_code: The device code from the initial request
  *    - grant_type: "urn:ietf:params:oauth:grant-type:device_code"
- * 2. Sleeps for the server-specified interval (typically 5 seconds)
+ * 2. Waits for the server-specified interval (5 seconds when not provided)
  * 3. Sends GET request to TOKEN_ENDPOINT
- * 4. Handles responses:
+ * 4. Handles responses (see parse_device_code_poll_error()):
  *    - HTTP 200: Parse access_token, refresh_token, expires_in and exit loop
- *    - HTTP 4xx: User hasn't authorized yet, continue polling
- *    - HTTP 5xx: Server error, continue polling (may want to abort)
- * 5. Repeats until:
- *    - Success (HTTP 200 with tokens)
- *    - Timeout (expires_in_seconds elapsed)
- *    - Parse error
+ *    - authorization_pending, or no recognizable error (network, 5xx): continue polling
+ *    - slow_down: continue polling with the interval increased by 5 seconds
+ *    - access_denied, expired_token or any other error: stop
+ * 5. Stops without polling past the device code expiry (expires_in seconds after
+ *    the code was issued), or as soon as the sign-in is cancelled.
  *
  * ## Token Persistence
  * On success, creates token_t structures for both access and refresh tokens,
  * calculates absolute expiration time, and persists via state_set_user_token().
  *
  * ## Threading
- * This function blocks the worker thread for the entire polling duration
- * (potentially several minutes). It should never be called on the main thread.
+ * This function blocks the worker thread for the polling duration (at most
+ * expires_in seconds, usually 15 minutes). It should never be called on the
+ * main thread.
  *
  * ## Error Handling
- * On timeout or parse error, exits without setting ctx->user_token. The caller
- * checks this condition and calls complete(ctx) with an error.
+ * On expiry, refusal, cancellation or parse error, sets ctx->result.error_message
+ * and exits without setting ctx->user_token.
  *
  * @param ctx Authentication context containing device_code and polling parameters
- *
- * @note On success, proceeds to retrieve_device_token(). On failure, calls complete(ctx).
  */
 static void poll_for_user_token(authentication_ctx_t *ctx) {
 
@@ -846,81 +1015,78 @@ static void poll_for_user_token(authentication_ctx_t *ctx) {
     obs_log(LOG_INFO, "Waiting for the user to validate the code");
     obs_log(LOG_DEBUG, "URL: %s", get_token_form_url_encoded);
 
-    /* Polls the server at a regular interval (as instructed by the server) */
-    time_t       start_time = time(NULL);
-    long         code       = 0;
-    unsigned int interval   = (unsigned int)ctx->interval_in_seconds * 1000;
-    long         expires_in = ctx->expires_in_seconds * 1000;
+    /* Polls the server at the interval it dictates, until the device code expires */
+    const long interval_in_seconds =
+        ctx->interval_in_seconds > 0 ? ctx->interval_in_seconds : DEFAULT_POLL_INTERVAL_SECONDS;
 
-    while (time(NULL) - start_time < expires_in) {
+    const uint64_t expires_at_ns = ctx->issued_at_ns + (uint64_t)ctx->expires_in_seconds * 1000000000ULL;
+    uint64_t       interval_ns   = (uint64_t)interval_in_seconds * 1000000000ULL;
+    uint64_t       next_poll_ns  = os_gettime_ns() + interval_ns;
 
-        sleep_ms(interval);
+    while (!ctx->user_token && !ctx->result.error_message) {
 
+        if (next_poll_ns >= expires_at_ns) {
+            ctx->result.error_message = "Sign-in expired: the code was not validated in time";
+            obs_log(LOG_WARNING, "[XboxAuth] %s", ctx->result.error_message);
+            break;
+        }
+
+        if (!wait_until(next_poll_ns)) {
+            ctx->result.error_message = "Sign-in cancelled";
+            obs_log(LOG_INFO, "[XboxAuth] %s", ctx->result.error_message);
+            break;
+        }
+
+        long  code           = 0;
         char *token_response = http_get(TOKEN_ENDPOINT, NULL, get_token_form_url_encoded, &code);
 
-        if (code != 200) {
-            obs_log(LOG_INFO,
-                    "Device not validated yet. Received status code %d, Waiting %d second before retrying...",
-                    code,
-                    interval);
-        } else {
+        next_poll_ns = os_gettime_ns() + interval_ns;
 
+        if (code == 200) {
             obs_log(LOG_DEBUG, "Response received: %s", token_response);
 
-            cJSON *token_json = cJSON_Parse(token_response);
-
-            if (!token_json) {
-                obs_log(LOG_ERROR, "Failed to retrieve the user token: unable to parse the JSON response");
-                free_memory((void **)&token_response);
-                break;
+            if (!read_user_token(ctx, token_response)) {
+                ctx->result.error_message = "Could not parse access_token from token response";
+                obs_log(LOG_ERROR, ctx->result.error_message);
             }
 
-            cJSON *access_token_node     = cJSONUtils_GetPointer(token_json, "/access_token");
-            cJSON *refresh_token_node    = cJSONUtils_GetPointer(token_json, "/refresh_token");
-            cJSON *token_expires_in_node = cJSONUtils_GetPointer(token_json, "/expires_in");
-
-            if (access_token_node && refresh_token_node && token_expires_in_node) {
-
-                /* The token has been found and is saved in the context */
-                token_t *user_token = bzalloc(sizeof(token_t));
-                user_token->value   = bstrdup(access_token_node->valuestring);
-                user_token->expires = time(NULL) + token_expires_in_node->valueint;
-
-                token_t *refresh_token = bzalloc(sizeof(token_t));
-                refresh_token->value   = bstrdup(refresh_token_node->valuestring);
-
-                ctx->user_token = user_token;
-
-                /* And in the persistence */
-                state_set_user_token(ctx->device_code, user_token, refresh_token);
-
-                obs_log(LOG_INFO, "User & refresh token received");
-                free_json_memory((void **)&token_json);
-                break;
-            }
+            free_memory((void **)&token_response);
+            continue;
+        }
 
-            ctx->result.error_message = "Could not parse access_token from token response";
-            obs_log(LOG_ERROR, ctx->result.error_message);
-            free_json_memory((void **)&token_json);
+        switch (parse_device_code_poll_error(token_response)) {
+        case DEVICE_CODE_POLL_ERROR_SLOW_DOWN:
+            interval_ns += SLOW_DOWN_INCREMENT_SECONDS * 1000000000ULL;
+            next_poll_ns = os_gettime_ns() + interval_ns;
+            obs_log(LOG_INFO,
+                    "[XboxAuth] Server asked to slow down, polling every %d seconds",
+                    (int)(interval_ns / 1000000000ULL));
+            break;
+        case DEVICE_CODE_POLL_ERROR_ACCESS_DENIED:
+            ctx->result.error_message = "Sign-in declined by the user";
+            obs_log(LOG_WARNING, "[XboxAuth] %s", ctx->result.error_message);
+            break;
+        case DEVICE_CODE_POLL_ERROR_EXPIRED_TOKEN:
+            ctx->result.error_message = "Sign-in expired: the code was not validated in time";
+            obs_log(LOG_WARNING, "[XboxAuth] %s", ctx->result.error_message);
+            break;
+        case DEVICE_CODE_POLL_ERROR_OTHER:
+            ctx->result.error_message = "Unable to retrieve a user token: received an error from the server";
+            obs_log(LOG_ERROR, "[XboxAuth] Device code polling failed (status %ld): %s", code, token_response);
+            break;
+        case DEVICE_CODE_POLL_ERROR_AUTHORIZATION_PENDING:
+        case DEVICE_CODE_POLL_ERROR_UNKNOWN:
+        default:
+            obs_log(LOG_DEBUG, "[XboxAuth] Device not validated yet (status %ld)", code);
+            break;
         }
 
         free_memory((void **)&token_response);
     }
-
-    /* Either complete the process if an error has been encountered or go to the next step */
-    if (!ctx->user_token) {
-        complete(ctx);
-    } else {
-        retrieve_device_token(ctx);
-    }
 }
 
 /**
- * @brief Worker thread entry point running the full authentication flow.
- *
- * This is the main entry point for the background authentication thread. It
- * implements a cascading fallback strategy to obtain a user access token, then
- * proceeds through device and SISU authentication.
+ * @brief Obtain the user access token, from the cache or from Microsoft.
  *
  * ## Token Acquisition Priority
  * The function attempts to obtain a user token in this order:
@@ -931,35 +1097,18 @@ static void poll_for_user_token(authentication_ctx_t *ctx) {
  *    - Open browser to verification URL
  *    - Poll TOKEN_ENDPOINT until user authorizes
  *
- * ## Flow Continuation
- * After obtaining a user token (by any method), the flow proceeds to:
- * 1. retrieve_device_token() - Get device Proof-of-Possession token
- * 2. retrieve_sisu_token() - Get final Xbox Live authorization
- *
- * ## Threading Context
- * This function runs entirely on a background pthread created by
- * xbox_live_authenticate(). It must not block the OBS main thread.
- *
  * ## Error Handling
- * Any failure in the device code request phase sets ctx->result.error_message
- * and calls complete(ctx). Failures in later stages are handled by those
- * respective functions.
- *
- * ## Memory Management
- * The authentication_ctx_t is freed at the end of this function. All allocated
- * resources (device, tokens, JSON) are cleaned up via the goto cleanup pattern.
+ * Any failure sets ctx->result.error_message.
  *
- * @param param Opaque pointer to authentication_ctx_t
- * @return Always returns (void *)false (return value currently unused)
+ * @param ctx Authentication context
+ * @return true if ctx->user_token has been set, false on failure
  */
-static void *start_authentication_flow(void *param) {
+static bool acquire_user_token(authentication_ctx_t *ctx) {
 
     char  *scope_enc      = NULL;
     char  *token_response = NULL;
     cJSON *token_json     = NULL;
 
-    authentication_ctx_t *ctx = param;
-
     token_t *user_token = state_get_user_token();
 
     if (user_token) {
@@ -984,6 +1133,7 @@ static void *start_authentication_flow(void *param) {
     scope_enc = http_urlencode(SCOPE);
 
     if (!scope_enc) {
+        ctx->result.error_message = "Unable to retrieve a user token: could not encode the scope";
         obs_log(LOG_WARNING, ctx->result.error_message);
         goto cleanup;
     }
@@ -996,8 +1146,9 @@ static void *start_authentication_flow(void *param) {
              scope_enc);
 
     /* Requests a device code from the connect endpoint */
-    long http_code = 0;
-    token_response = http_post_form(CONNECT_ENDPOINT, form_url_encoded, &http_code);
+    const uint64_t issued_at_ns = os_gettime_ns();
+    long           http_code    = 0;
+    token_response              = http_post_form(CONNECT_ENDPOINT, form_url_encoded, &http_code);
 
     if (!token_response) {
         ctx->result.error_message = "Unable to retrieve a user token: received no response from the server";
@@ -1016,7 +1167,8 @@ static void *start_authentication_flow(void *param) {
     token_json = cJSON_Parse(token_response);
 
     if (!token_json) {
-        obs_log(LOG_ERROR, "Failed to retrieve the user token: unable to parse the JSON response");
+        ctx->result.error_message = "Unable to retrieve a user token: unable to parse the JSON response";
+        obs_log(LOG_ERROR, ctx->result.error_message);
         goto cleanup;
     }
 
@@ -1038,14 +1190,9 @@ static void *start_authentication_flow(void *param) {
         goto cleanup;
     }
 
+    /* The interval is optional (RFC 8628, section 3.2) */
     cJSON *interval_node = cJSONUtils_GetPointer(token_json, "/interval");
 
-    if (!interval_node) {
-        ctx->result.error_message = "Unable to received a user token: could not parse the interval from token response";
-        obs_log(LOG_ERROR, "[XboxAuth] %s", ctx->result.error_message);
-        goto cleanup;
-    }
-
     cJSON *expires_in_node = cJSONUtils_GetPointer(token_json, "/expires_in");
 
     if (!expires_in_node) {
@@ -1056,8 +1203,9 @@ static void *start_authentication_flow(void *param) {
     }
 
     ctx->device_code         = bstrdup(device_code_node->valuestring);
-    ctx->interval_in_seconds = interval_node->valueint;
+    ctx->interval_in_seconds = interval_node ? interval_node->valueint : DEFAULT_POLL_INTERVAL_SECONDS;
     ctx->expires_in_seconds  = expires_in_node->valueint;
+    ctx->issued_at_ns        = issued_at_ns;
 
     /* Open the browser to the verification URL */
     char verification_uri[4096];
@@ -1079,15 +1227,62 @@ cleanup:
     free_memory((void **)&token_response);
     free_json_memory((void **)&token_json);
 
-    if (!ctx->result.error_message) {
-        retrieve_device_token(ctx);
-    } else {
-        complete(ctx);
+    if (!ctx->user_token && !ctx->result.error_message) {
+        ctx->result.error_message = "Unable to retrieve a user token: the code was not validated in time";
+        obs_log(LOG_ERROR, "[XboxAuth] %s", ctx->result.error_message);
+    }
+
+    return ctx->user_token != NULL;
+}
+
+/**
+ * @brief Worker thread entry point running the full authentication flow.
+ *
+ * The device token is fetched concurrently with the user token
+ * (start_device_token_prefetch()); the SISU request then combines both.
+ * The completion callback is invoked exactly once, whatever the outcome.
+ *
+ * ## Threading Context
+ * This function runs entirely on a background pthread created by
+ * xbox_live_authenticate(). It must not block the OBS main thread.
+ *
+ * ## Memory Management
+ * The authentication_ctx_t and everything it owns are freed at the end of this function.
+ *
+ * @param param Opaque pointer to authentication_ctx_t
+ * @return Always returns (void *)false (return value currently unused)
+ */
+static void *start_authentication_flow(void *param) {
+
+    authentication_ctx_t *ctx = param;
+
+    if (!thread_set_class(THREAD_CLASS_NETWORK, "XboxAuth")) {
+        obs_log(LOG_WARNING, "[XboxAuth] Could not apply the thread priority");
     }
 
+    start_device_token_prefetch(ctx);
+
+    if (acquire_user_token(ctx) && acquire_device_token(ctx)) {
+        retrieve_sisu_token(ctx);
+    }
+
+    /* The device token thread is still running if the user token could not be obtained */
+    join_device_token_prefetch(ctx);
+
+    complete(ctx);
+
     free_device(&ctx->device);
+    free_token(&ctx->user_token);
+    free_token(&ctx->refresh_token);
+    free_token(&ctx->device_token);
+    free_memory((void **)&ctx->device_code);
     free_memory((void **)&ctx);
 
+    pthread_mutex_lock(&g_flows_mutex);
+    g_running_flows--;
+    pthread_cond_broadcast(&g_flows_done);
+    pthread_mutex_unlock(&g_flows_mutex);
+
     return (void *)false;
 }
 
@@ -1162,9 +1357,52 @@ bool xbox_live_authenticate(void *data, on_xbox_live_authenticated_t callback) {
     ctx->device               = device;
     ctx->on_completed         = callback;
     ctx->on_completed_data    = data;
-    ctx->allow_cache          = true;
 
-    return pthread_create(&ctx->thread, NULL, start_authentication_flow, ctx) == 0;
+    pthread_mutex_lock(&g_flows_mutex);
+    g_running_flows++;
+    g_sign_in_cancelled = false;
+    pthread_mutex_unlock(&g_flows_mutex);
+
+    pthread_t thread;
+
+    if (pthread_create(&thread, NULL, start_authentication_flow, ctx) != 0) {
+        obs_log(LOG_ERROR, "[XboxAuth] Unable to authenticate: could not start the authentication thread");
+
+        pthread_mutex_lock(&g_flows_mutex);
+        g_running_flows--;
+        pthread_mutex_unlock(&g_flows_mutex);
+
+        free_device(&ctx->device);
+        free_memory((void **)&ctx);
+        return false;
+    }
+
+    pthread_detach(thread);
+
+    return true;
+}
+
+void xbox_live_cancel_authentication(void) {
+
+    pthread_mutex_lock(&g_flows_mutex);
+
+    if (g_running_flows > 0) {
+        g_sign_in_cancelled = true;
+        obs_log(LOG_INFO, "[XboxAuth] Cancelling the sign-in");
+    }
+
+    pthread_mutex_unlock(&g_flows_mutex);
+}
+
+void xbox_live_stop(void) {
+
+    pthread_mutex_lock(&g_flows_mutex);
+
+    while (g_running_flows > 0) {
+        pthread_cond_wait(&g_flows_done, &g_flows_mutex);
+    }
+
+    pthread_mutex_unlock(&g_flows_mutex);
 }
 
 /**
@@ -1261,13 +1499,19 @@ xbox_identity_t *xbox_live_get_identity(void) {
     ctx->device               = device;
     ctx->on_completed         = NULL;
     ctx->on_completed_data    = NULL;
-    ctx->allow_cache          = false;
     ctx->refresh_token        = state_get_user_refresh_token();
+    ctx->device_code          = state_get_device_code();
 
     free_identity(&identity);
 
-    /* All the tokens (User, Device and Sisu) will be retrieved */
-    if (!refresh_user_token(ctx)) {
+    /* The user token is refreshed while the device token is fetched (or reused if still valid) */
+    start_device_token_prefetch(ctx);
+
+    const bool refreshed = refresh_user_token(ctx) && acquire_device_token(ctx) && retrieve_sisu_token(ctx);
+
+    join_device_token_prefetch(ctx);
+
+    if (!refreshed) {
         goto cleanup;
     }
 
@@ -1278,6 +1522,7 @@ cleanup:
     free_token(&ctx->user_token);
     free_token(&ctx->device_token);
     free_token(&ctx->refresh_token);
+    free_memory((void **)&ctx->device_code);
     free_memory((void **)&ctx);
 
     return identity;
@@ -45,6 +45,23 @@ typedef void (*on_xbox_live_authenticated_t)(void *data);
  */
 bool xbox_live_authenticate(void *data, on_xbox_live_authenticated_t callback);
 
+/**
+ * @brief Cancel the sign-in currently waiting for the user.
+ *
+ * The device-code polling stops within a few tens of milliseconds and the flow
+ * invokes its callback (with an error). Does nothing when no flow is running.
+ */
+void xbox_live_cancel_authentication(void);
+
+/**
+ * @brief Wait for every authentication flow started by xbox_live_authenticate().
+ *
+ * Meant for plugin unload, after http_cancel_all(): the pending requests and
+ * the device-code polling then stop within a few tens of milliseconds, and
+ * each flow invokes its callback (with an error) before this returns.
+ */
+void xbox_live_stop(void);
+
 /**
  * @brief Get the currently persisted Xbox identity (if any).
  *
@@ -0,0 +1,96 @@
+#include "integrations/xbox/rta_keepalive.h"
+
+#define NS_PER_SECOND 1000000000ULL
+#define NS_PER_MS     1000000ULL
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public API
+//  --------------------------------------------------------------------------------------------------------------------
+
+void rta_keepalive_reset(rta_keepalive_t *keepalive, const rta_connection_configuration_t *configuration,
+                         uint64_t now_ns) {
+
+    keepalive->base_interval_ns = (uint64_t)configuration->ping_interval * NS_PER_SECOND;
+    keepalive->max_interval_ns  = (uint64_t)configuration->max_ping_interval * NS_PER_SECOND;
+    keepalive->pong_timeout_ns  = (uint64_t)configuration->pong_timeout * NS_PER_SECOND;
+    keepalive->interval_ns      = keepalive->base_interval_ns;
+    keepalive->last_activity_ns = now_ns;
+    keepalive->ping_sent_ns     = 0;
+
+    if (keepalive->max_interval_ns < keepalive->base_interval_ns) {
+        keepalive->max_interval_ns = keepalive->base_interval_ns;
+    }
+}
+
+void rta_keepalive_on_activity(rta_keepalive_t *keepalive, uint64_t now_ns) {
+    keepalive->last_activity_ns = now_ns;
+}
+
+bool rta_keepalive_is_ping_due(const rta_keepalive_t *keepalive, uint64_t now_ns) {
+
+    if (keepalive->ping_sent_ns) {
+        return false;
+    }
+
+    return now_ns >= keepalive->last_activity_ns + keepalive->interval_ns;
+}
+
+void rta_keepalive_on_ping_sent(rta_keepalive_t *keepalive, uint64_t now_ns) {
+    keepalive->ping_sent_ns = now_ns;
+}
+
+int64_t rta_keepalive_on_pong(rta_keepalive_t *keepalive, uint64_t now_ns) {
+
+    if (!keepalive->ping_sent_ns) {
+        return -1;
+    }
+
+    const uint64_t round_trip_ns = now_ns > keepalive->ping_sent_ns ? now_ns - keepalive->ping_sent_ns : 0;
+
+    keepalive->ping_sent_ns     = 0;
+    keepalive->last_activity_ns = now_ns;
+
+    /* A pong taking half the timeout hints at a flaky link: probe it often again */
+    if (round_trip_ns * 2 > keepalive->pong_timeout_ns) {
+        keepalive->interval_ns = keepalive->base_interval_ns;
+    } else {
+        keepalive->interval_ns *= 2;
+
+        if (keepalive->interval_ns > keepalive->max_interval_ns) {
+            keepalive->interval_ns = keepalive->max_interval_ns;
+        }
+    }
+
+    return (int64_t)(round_trip_ns / NS_PER_MS);
+}
+
+bool rta_keepalive_is_dead(const rta_keepalive_t *keepalive, uint64_t now_ns) {
+
+    /* Frames received since the ping prove the connection alive all the same */
+    if (!keepalive->ping_sent_ns || keepalive->last_activity_ns > keepalive->ping_sent_ns) {
+        return false;
+    }
+
+    return now_ns >= keepalive->ping_sent_ns + keepalive->pong_timeout_ns;
+}
+
+int rta_reconnect_delay_with_jitter(int delay_ms, unsigned int random) {
+
+    const int spread = delay_ms / 2;
+
+    if (spread <= 0) {
+        return delay_ms;
+    }
+
+    /* delay - 25% .. delay + 25% */
+    return delay_ms - spread / 2 + (int)(random % (unsigned int)(spread + 1));
+}
+
+int rta_reconnect_next_delay(int delay_ms, int max_delay_ms) {
+
+    if (delay_ms >= max_delay_ms / 2) {
+        return max_delay_ms;
+    }
+
+    return delay_ms * 2;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file rta_keepalive.h
+ * @brief Adaptive keepalive and reconnection pacing of the Xbox RTA websocket.
+ *
+ * Pure bookkeeping (no I/O) driven by the monitor thread with monotonic
+ * timestamps (os_gettime_ns()):
+ *  - A ping is only sent once the connection has been silent for the current
+ *    interval: any received frame already proves the connection is alive.
+ *  - Each fast pong doubles the interval, up to the configured maximum, so a
+ *    stable idle connection costs fewer and fewer pings; a slow pong brings it
+ *    back to the base interval.
+ *  - A ping left unanswered for the pong timeout marks the connection as dead,
+ *    well before the TCP stack or the server would notice.
+ *
+ * Thread safety:
+ *   None: a keepalive belongs to the thread servicing the connection.
+ */
+
+/**
+ * @brief Keepalive state of one connection.
+ */
+typedef struct rta_keepalive {
+    /** Interval after a (re)connection or a slow pong. */
+    uint64_t base_interval_ns;
+    /** Upper bound of @c interval_ns. */
+    uint64_t max_interval_ns;
+    /** Time allowed for the pong. */
+    uint64_t pong_timeout_ns;
+    /** Current silence allowed before a ping. */
+    uint64_t interval_ns;
+    /** Time of the last frame received (or of the connection). */
+    uint64_t last_activity_ns;
+    /** Time the ping in flight was sent, or 0 if none. */
+    uint64_t ping_sent_ns;
+} rta_keepalive_t;
+
+/**
+ * @brief Start tracking a new connection.
+ *
+ * @param keepalive     Keepalive to reset (must not be NULL).
+ * @param configuration Intervals to use (must not be NULL).
+ * @param now_ns        Current time.
+ */
+void rta_keepalive_reset(rta_keepalive_t *keepalive, const rta_connection_configuration_t *configuration,
+                         uint64_t now_ns);
+
+/**
+ * @brief Record a frame received on the connection.
+ */
+void rta_keepalive_on_activity(rta_keepalive_t *keepalive, uint64_t now_ns);
+
+/**
+ * @brief Check whether the connection has been silent long enough to be pinged.
+ *
+ * @return true if a ping is due and none is in flight.
+ */
+bool rta_keepalive_is_ping_due(const rta_keepalive_t *keepalive, uint64_t now_ns);
+
+/**
+ * @brief Record that a ping was written.
+ */
+void rta_keepalive_on_ping_sent(rta_keepalive_t *keepalive, uint64_t now_ns);
+
+/**
+ * @brief Record a pong and adapt the interval to the round trip.
+ *
+ * @return The round trip in milliseconds, or -1 if no ping was in flight.
+ */
+int64_t rta_keepalive_on_pong(rta_keepalive_t *keepalive, uint64_t now_ns);
+
+/**
+ * @brief Check whether the ping in flight went unanswered for too long.
+ *
+ * Frames received after the ping count as an answer.
+ *
+ * @return true if the connection must be considered dead.
+ */
+bool rta_keepalive_is_dead(const rta_keepalive_t *keepalive, uint64_t now_ns);
+
+/**
+ * @brief Compute the delay before the next reconnection attempt.
+ *
+ * Spreads @p delay_ms by up to ±25% so that many clients dropped at the same
+ * time (e.g. a server restart) do not all come back on the same tick.
+ *
+ * @param delay_ms Nominal delay.
+ * @param random   Any random value.
+ *
+ * @return The delay to wait, in milliseconds.
+ */
+int rta_reconnect_delay_with_jitter(int delay_ms, unsigned int random);
+
+/**
+ * @brief Compute the nominal delay following a failed or unproven attempt.
+ *
+ * @return Twice @p delay_ms, capped at @p max_delay_ms.
+ */
+int rta_reconnect_next_delay(int delay_ms, int max_delay_ms);
+
+#ifdef __cplusplus
+}
+#endif
@@ -28,6 +28,7 @@
 #include "net/http/http.h"
 #include "net/json/json.h"
 #include "integrations/xbox/oauth/xbox-live.h"
+#include "integrations/xbox/xbox_title_cache.h"
 #include "text/parsers.h"
 
 #include <cJSON.h>
@@ -40,6 +41,7 @@
 #define GAMERPIC_SETTING                   "GameDisplayPicRaw"
 #define XBOX_TITLE_HUB                     "https://titlehub.xboxlive.com/users/xuid(%s)/titles/titleId(%s)/decoration/image"
 #define XBOX_ACHIEVEMENTS_ENDPOINT         "https://achievements.xboxlive.com/users/xuid(%s)/achievements?titleId=%s"
+#define XBOX_ACHIEVEMENTS_UNLOCKED_QUERY   "&unlockedOnly=true&orderBy=UnlockTime"
 
 #define XBOX_GAME_COVER_DISPLAY_IMAGE      "/titles/0/displayImage"
 #define XBOX_GAME_COVER_TYPE               "/titles/0/images/%d/type"
@@ -47,6 +49,20 @@
 #define XBOX_GAME_COVER_POSTER_TYPE        "poster"
 #define XBOX_GAME_COVER_BOX_ART_TYPE       "boxart"
 
+/**
+ * Hosts contacted when a game starts: the REST services read right after
+ * the RTA connection and on a title change, and the CDNs serving the
+ * achievement icons, gamerpics and covers.
+ */
+static const char *const XBOX_PREWARM_URLS[] = {
+    "https://achievements.xboxlive.com/",
+    "https://titlehub.xboxlive.com/",
+    "https://profile.xboxlive.com/",
+    "https://userpresence.xboxlive.com/",
+    "https://images-eds-ssl.xboxlive.com/",
+    "https://store-images.s-microsoft.com/",
+};
+
 /**
  * @brief In-place substring replacement helper.
  *
@@ -473,12 +489,15 @@ game_t *xbox_get_current_game(void) {
 
     obs_log(LOG_INFO, "[XboxClient] Current game: %s (%s)", current_game_title, current_game_id);
 
-    game               = bzalloc(sizeof(game_t));
+    game               = alloc_game();
     game->id           = bstrdup(current_game_id);
     game->title        = bstrdup(current_game_title);
     /* TODO Figure out if it is Xbox one, Xbox series S, Xbox series X */
     game->console_name = bstrdup("xbox");
 
+    /* Later presence messages for this title are resolved without this call */
+    xbox_title_cache_put(game);
+
 cleanup:
     free_json_memory((void **)&presence_json);
     free_identity(&identity);
@@ -487,11 +506,18 @@ cleanup:
     return game;
 }
 
-xbox_achievement_t *xbox_get_game_achievements(const game_t *game) {
-
-    if (!game) {
-        return NULL;
-    }
+/**
+ * @brief Fetches the achievements of a game, page by page.
+ *
+ * @param game           Game for which achievements should be fetched.
+ * @param query          Extra query string appended to the endpoint ("" for the whole catalog).
+ * @param unlocked_since When > 0, the pages are expected to be sorted by descending unlock
+ *                       time and the paging stops after the first page reaching an
+ *                       achievement unlocked before this Unix timestamp.
+ *
+ * @return Head of a newly allocated linked list of achievements, or NULL on error.
+ */
+static xbox_achievement_t *fetch_achievements(const game_t *game, const char *query, int64_t unlocked_since) {
 
     xbox_identity_t *identity = state_get_xbox_identity();
 
@@ -523,14 +549,20 @@ xbox_achievement_t *xbox_get_game_achievements(const game_t *game) {
         if (continuation_token) {
             snprintf(achievements_url,
                      sizeof(achievements_url),
-                     XBOX_ACHIEVEMENTS_ENDPOINT "&continuationToken=%s",
+                     XBOX_ACHIEVEMENTS_ENDPOINT "%s&continuationToken=%s",
                      identity->xid,
                      game->id,
+                     query,
                      continuation_token);
             bfree(continuation_token);
             continuation_token = NULL;
         } else {
-            snprintf(achievements_url, sizeof(achievements_url), XBOX_ACHIEVEMENTS_ENDPOINT, identity->xid, game->id);
+            snprintf(achievements_url,
+                     sizeof(achievements_url),
+                     XBOX_ACHIEVEMENTS_ENDPOINT "%s",
+                     identity->xid,
+                     game->id,
+                     query);
         }
 
         long http_code = 0;
@@ -565,6 +597,12 @@ xbox_achievement_t *xbox_get_game_achievements(const game_t *game) {
             while (last_achievement->next) {
                 last_achievement = last_achievement->next;
             }
+
+            /* Sorted by unlock time: the next pages only hold older unlocks */
+            if (unlocked_since > 0 && last_achievement->unlocked_timestamp < unlocked_since) {
+                free_memory((void **)&response_json);
+                break;
+            }
         }
 
         /* Check for continuation token in pagingInfo */
@@ -591,3 +629,31 @@ xbox_achievement_t *xbox_get_game_achievements(const game_t *game) {
 
     return all_achievements;
 }
+
+xbox_achievement_t *xbox_get_game_achievements(const game_t *game) {
+
+    if (!game) {
+        return NULL;
+    }
+
+    return fetch_achievements(game, "", 0);
+}
+
+xbox_achievement_t *xbox_get_game_achievements_unlocked_since(const game_t *game, int64_t since) {
+
+    if (!game) {
+        return NULL;
+    }
+
+    obs_log(LOG_DEBUG, "[XboxClient] Fetching achievements of game %s unlocked since %lld", game->id, (long long)since);
+
+    return fetch_achievements(game, XBOX_ACHIEVEMENTS_UNLOCKED_QUERY, since);
+}
+
+void xbox_prewarm_connections(void) {
+
+    const size_t count = sizeof(XBOX_PREWARM_URLS) / sizeof(XBOX_PREWARM_URLS[0]);
+    const size_t ready = http_prewarm(XBOX_PREWARM_URLS, count);
+
+    obs_log(LOG_DEBUG, "[XboxClient] %zu of %zu Xbox endpoint(s) warmed", ready, count);
+}
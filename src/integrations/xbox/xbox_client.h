@@ -40,6 +40,24 @@ game_t *xbox_get_current_game(void);
  */
 xbox_achievement_t *xbox_get_game_achievements(const game_t *game);
 
+/**
+ * @brief Retrieves the achievements of a game unlocked since a given time.
+ *
+ * Used to catch up after a reconnection without downloading the whole catalog:
+ * only unlocked achievements are requested, most recent first, and the paging
+ * stops once the unlocks get older than @p since. The list may still contain a
+ * few older unlocks from the last page.
+ *
+ * @param game  Game for which achievements should be fetched (may be NULL).
+ * @param since Unix timestamp of the last unlock already known, or 0 for all
+ *              the unlocked achievements.
+ *
+ * @return Head of a newly allocated linked list of achievements, or NULL if
+ *         none or on error. The caller owns the returned list and must free it
+ *         with @ref xbox_free_achievement.
+ */
+xbox_achievement_t *xbox_get_game_achievements_unlocked_since(const game_t *game, int64_t since);
+
 /**
  * @brief Fetches a cover image URL for a given game.
  *
@@ -66,6 +84,20 @@ char *xbox_get_game_cover(const game_t *game);
  */
 char *xbox_fetch_gamerpic();
 
+/**
+ * @brief Warms the DNS entries and TLS sessions of the Xbox services and image CDNs.
+ *
+ * Called in the background once the RTA socket is connected and subscribed,
+ * so that the requests made on the next title change (achievements, cover,
+ * icons) find the DNS entries cached and resume the TLS sessions instead of
+ * paying the full setup one host after the other. No connection is kept open
+ * for them: each still opens its own TCP connection.
+ *
+ * Blocks until every host has answered or failed (see @ref http_prewarm): do
+ * not call it from the lws thread.
+ */
+void xbox_prewarm_connections(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -9,6 +9,9 @@
  *  - Adds the XBL3.0 Authorization header during the handshake.
  *  - Subscribes to presence and achievement progression channels.
  *  - Parses incoming RTA messages and emits higher-level events.
+ *  - Keeps the session across short outages: on reconnection, the title is
+ *    confirmed through presence and only the unlocks missed meanwhile are
+ *    fetched.
  *
  * Threading:
  *  - The monitor runs a background pthread that calls lws_service().
@@ -32,16 +35,22 @@
 
 #include "xbox_client.h"
 #include "xbox_session.h"
+#include "xbox_title_cache.h"
+#include "rta_keepalive.h"
 
 #include <libwebsockets.h>
+#include <util/platform.h>
 #include <util/thread_compat.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 #include "external/cjson/cJSON.h"
 
+#include "common/types.h"
+#include "diagnostics/memory_accounting.h"
 #include "io/state.h"
 #include "integrations/xbox/oauth/xbox-live.h"
+#include "util/worker_pool.h"
 
 #include <text/parsers.h>
 
@@ -58,6 +67,14 @@
 #define INITIAL_RETRY_DELAY_MS 1000
 #define MAX_RETRY_DELAY_MS 60000
 
+/** Outage after which the session kept across reconnections is dropped (and the overlay cleared). */
+#define SESSION_RETENTION_MS 300000
+
+/** Window of the permessage-deflate streams (2^10 bytes): a few KB of zlib state per direction. */
+#define DEFLATE_WINDOW_BITS "10"
+/** zlib memLevel of the outgoing stream; only small control messages are sent. */
+#define DEFLATE_MEM_LEVEL "1"
+
 /**
  * @brief Subscription node for game-played events.
  */
@@ -98,6 +115,29 @@ typedef struct session_ready_subscription {
 
 static session_ready_subscription_t *g_session_ready_subscriptions = NULL;
 
+/**
+ * @brief Subscription node for connection health events.
+ */
+typedef struct health_changed_subscription {
+    on_xbox_health_changed_t            callback;
+    struct health_changed_subscription *next;
+} health_changed_subscription_t;
+
+/**
+ * Connection health and its subscribers. Unlike the other state of this module,
+ * they are read from other threads (e.g. the UI), hence the dedicated mutex.
+ */
+static pthread_mutex_t                g_health_mutex                  = PTHREAD_MUTEX_INITIALIZER;
+static xbox_connection_health_t       g_health                        = {.round_trip_ms = -1};
+static health_changed_subscription_t *g_health_changed_subscriptions = NULL;
+
+/**
+ * Serializes xbox_monitoring_start() and xbox_monitoring_stop(): the warm-up
+ * task starts the monitor while a sign-in or a settings change may restart it
+ * from another thread. Never taken by the monitor thread, which they join.
+ */
+static pthread_mutex_t g_lifecycle_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 /**
  * @brief Monitor thread state.
  *
@@ -120,6 +160,9 @@ typedef struct monitoring_context {
     /** Background thread running lws_service() */
     pthread_t thread;
 
+    /** Background thread warming the DNS and TLS session caches for the Xbox endpoints, off the lws thread */
+    worker_pool_t *prewarm_pool;
+
     /** True while monitoring is active */
     bool running;
 
@@ -146,6 +189,48 @@ typedef struct monitoring_context {
     char  *rx_buffer;
     size_t rx_buffer_size;
     size_t rx_buffer_used;
+
+    /** Keepalive and compression settings, read when monitoring starts */
+    rta_connection_configuration_t configuration;
+
+    /**
+     * Idle ping and hang-up delays of libwebsockets.
+     *
+     * Derived from @c configuration so that lws only steps in when our own
+     * keepalive could not (e.g. the pong timeout check is starved).
+     */
+    lws_retry_bo_t retry_policy;
+
+    /** True when a ping must be written at the next writeable callback */
+    bool            ping_requested;
+    /** True once a dead connection has been asked to close */
+    bool            dropping;
+    /** Ping pacing of the current connection */
+    rta_keepalive_t keepalive;
+
+    /** Nominal delay before the next reconnection attempt */
+    int retry_delay_ms;
+
+    /** True once a first connection has been established: the next ones are reconnections */
+    bool established_once;
+
+    /**
+     * State of the generator spreading the reconnection delays.
+     *
+     * Seeded per process from the clock and the address space layout, so
+     * that clients dropped together do not retry in lockstep.
+     */
+    uint32_t jitter_state;
+
+    /**
+     * Time (os_gettime_ns) at which the connection holding the current session
+     * was lost, or 0 while connected.
+     *
+     * The session is kept across short outages and resynchronized on
+     * reconnection; it is only dropped once the outage exceeds
+     * SESSION_RETENTION_MS.
+     */
+    uint64_t disconnected_at_ns;
 } monitoring_context_t;
 
 static monitoring_context_t *g_monitoring_context = NULL;
@@ -153,11 +238,6 @@ static monitoring_context_t *g_monitoring_context = NULL;
 /* Keeps track of the game, achievements and gamerscore */
 static xbox_session_t g_current_session;
 
-static const lws_retry_bo_t retry_policy = {
-    .secs_since_valid_ping   = 10, /* send ping after 10s idle */
-    .secs_since_valid_hangup = 20, /* hang up if no response after 20s */
-};
-
 /**
  * @brief Build the WebSocket "Authorization" header value for a given Xbox identity.
  *
@@ -285,6 +365,92 @@ static void notify_session_ready(void) {
     }
 }
 
+/**
+ * @brief Invoke all registered health subscribers with the current health.
+ */
+static void notify_health_changed(void) {
+
+    pthread_mutex_lock(&g_health_mutex);
+
+    const xbox_connection_health_t health = g_health;
+
+    for (health_changed_subscription_t *node = g_health_changed_subscriptions; node; node = node->next) {
+        node->callback(&health);
+    }
+
+    pthread_mutex_unlock(&g_health_mutex);
+}
+
+/**
+ * @brief Update the connection flag of the health, resetting the round trip on disconnection.
+ *
+ * Every connection established after the first one counts as a reconnection.
+ */
+static void set_health_connected(bool connected) {
+
+    pthread_mutex_lock(&g_health_mutex);
+
+    g_health.connected = connected;
+
+    if (!connected) {
+        g_health.round_trip_ms = -1;
+    } else if (g_monitoring_context->established_once) {
+        g_health.reconnect_count++;
+    }
+
+    pthread_mutex_unlock(&g_health_mutex);
+
+    if (connected) {
+        if (g_monitoring_context->established_once) {
+            obs_log(LOG_INFO, "[XboxMonitor] Connection reestablished");
+        }
+
+        g_monitoring_context->established_once = true;
+    }
+
+    g_monitoring_context->ping_requested = false;
+    g_monitoring_context->dropping       = false;
+
+    rta_keepalive_reset(&g_monitoring_context->keepalive, &g_monitoring_context->configuration, os_gettime_ns());
+
+    notify_health_changed();
+}
+
+/**
+ * @brief Ping the connection once it has been idle long enough, and drop it if
+ * the ping went unanswered.
+ *
+ * Called from the service loop; the ping itself is written from the
+ * LWS_CALLBACK_CLIENT_WRITEABLE callback. A dropped connection goes through
+ * LWS_CALLBACK_CLIENT_CLOSED and the usual reconnection path.
+ */
+static void service_keepalive(monitoring_context_t *ctx) {
+
+    if (!ctx->connected || !ctx->wsi || ctx->ping_requested || ctx->dropping) {
+        return;
+    }
+
+    const uint64_t now_ns = os_gettime_ns();
+
+    if (rta_keepalive_is_dead(&ctx->keepalive, now_ns)) {
+        obs_log(LOG_WARNING,
+                "[XboxMonitor] No pong within %d s, dropping the connection",
+                ctx->configuration.pong_timeout);
+
+        ctx->dropping = true;
+        lws_set_timeout(ctx->wsi, PENDING_TIMEOUT_USER_OK, LWS_TO_KILL_ASYNC);
+        return;
+    }
+
+    if (!rta_keepalive_is_ping_due(&ctx->keepalive, now_ns)) {
+        return;
+    }
+
+    ctx->ping_requested = true;
+
+    lws_callback_on_writable(ctx->wsi);
+}
+
 /**
  * @brief Send a JSON-ish RTA control message over the websocket.
  *
@@ -484,17 +650,15 @@ static void xbox_change_game(game_t *game) {
     /*
      * Notify subscribers that a new game is being loaded BEFORE starting the
      * session change.  This ensures achievement_cycle sets g_session_ready=false
-     * before the prefetch thread can complete and fire the session-ready event.
-     * If notify_game_played were called after xbox_session_change_game, the
-     * prefetch thread could finish synchronously (all icons already cached) and
-     * fire notify_session_ready before notify_game_played runs, causing
+     * before xbox_session_change_game fires the session-ready event.
+     * If notify_game_played were called after xbox_session_change_game,
+     * notify_session_ready would run before notify_game_played, causing
      * achievement_cycle to reset g_session_ready back to false and clear the
      * display just after it had been populated.
      */
     notify_game_played(game);
 
-    /* Change the game: fetch achievements, notify session-ready, and prefetch
-     * icons in the background. */
+    /* Change the game: fetch achievements and notify session-ready. */
     xbox_session_change_game(&g_current_session, game, &notify_session_ready);
 
     /* Now let's subscribe to the new achievements */
@@ -525,7 +689,10 @@ static void on_achievement_progress_received(const xbox_achievement_progress_t *
             progress->progress_state);
 
     if (strcasecmp(progress->progress_state, "Achieved") == 0) {
-        xbox_session_unlock_achievement(&g_current_session, progress);
+        /* A repeated unlock must not reach the cycle, the grid or the event stream twice */
+        if (!xbox_session_unlock_achievement(&g_current_session, progress)) {
+            return;
+        }
     } else if (strcasecmp(progress->progress_state, "InProgress") == 0) {
         xbox_session_progress_achievement(&g_current_session, progress);
     }
@@ -533,19 +700,123 @@ static void on_achievement_progress_received(const xbox_achievement_progress_t *
     notify_achievements_progressed(progress);
 }
 
+/**
+ * @brief Drop the session (game, achievements and gamerscore) and clear the overlay.
+ */
+static void drop_session(void) {
+
+    g_monitoring_context->disconnected_at_ns = 0;
+
+    xbox_session_clear(&g_current_session);
+
+    notify_game_played(NULL);
+}
+
+/**
+ * @brief Remember when the connection holding the current session was lost.
+ */
+static void retain_session(void) {
+
+    if (g_current_session.game && g_monitoring_context->disconnected_at_ns == 0) {
+        g_monitoring_context->disconnected_at_ns = os_gettime_ns();
+    }
+}
+
+/**
+ * @brief Drop the retained session once the outage lasts longer than SESSION_RETENTION_MS.
+ */
+static void expire_retained_session(monitoring_context_t *ctx) {
+
+    if (ctx->connected || ctx->disconnected_at_ns == 0) {
+        return;
+    }
+
+    if (os_gettime_ns() - ctx->disconnected_at_ns < (uint64_t)SESSION_RETENTION_MS * 1000000ULL) {
+        return;
+    }
+
+    obs_log(LOG_INFO, "[XboxMonitor] Disconnected for more than %d s, dropping the session", SESSION_RETENTION_MS / 1000);
+
+    drop_session();
+}
+
+/**
+ * @brief Catch up with the unlocks missed while disconnected, then resubscribe.
+ *
+ * Only the achievements unlocked since the last known unlock are fetched; each
+ * missed one goes through the regular progress path, so the gamerscore and the
+ * listeners are updated as if the RTA event had been received.
+ */
+static void resync_session(void) {
+
+    const int64_t since = xbox_session_get_last_unlock_timestamp(&g_current_session);
+
+    xbox_achievement_t          *unlocked = xbox_get_game_achievements_unlocked_since(g_current_session.game, since);
+    xbox_achievement_progress_t *missed   = xbox_session_find_missed_unlocks(&g_current_session, unlocked);
+
+    int missed_count = 0;
+
+    for (xbox_achievement_progress_t *progress = missed; progress; progress = progress->next) {
+        on_achievement_progress_received(progress);
+        missed_count++;
+    }
+
+    obs_log(LOG_INFO,
+            "[XboxMonitor] Session of %s resumed, %d unlock(s) missed while disconnected",
+            g_current_session.game->title,
+            missed_count);
+
+    xbox_free_achievement_progress(&missed);
+    xbox_free_achievement(&unlocked);
+
+    xbox_achievements_progress_subscribe(&g_current_session);
+}
+
+/**
+ * @brief Worker task warming the DNS and TLS session caches for the Xbox endpoints.
+ */
+static void prewarm_task(void *data) {
+
+    UNUSED_PARAMETER(data);
+
+    xbox_prewarm_connections();
+}
+
+/**
+ * @brief Warm the DNS and TLS session caches for the Xbox endpoints in the background.
+ *
+ * The next title change (achievements, cover, icons) then finds the DNS
+ * entries cached and resumes the TLS sessions, without holding the lws thread
+ * (and the pings of the connection) for the time of the handshakes. The
+ * connections themselves are not reused: the REST calls open their own.
+ */
+static void schedule_prewarm(void) {
+
+    if (!g_monitoring_context->prewarm_pool) {
+        return;
+    }
+
+    /* A prewarm still queued from a previous connection is redundant */
+    worker_pool_cancel_pending(g_monitoring_context->prewarm_pool);
+    worker_pool_submit(g_monitoring_context->prewarm_pool, prewarm_task, NULL, NULL);
+}
+
 /**
  * @brief Called when the websocket transitions to a connected state.
  *
  * Fetches the initial gamerscore, sets up subscriptions, and notifies listeners.
+ * After a reconnection, a session still playing the same title is resumed with
+ * a delta sync instead of being reloaded.
  */
 static void on_websocket_connected() {
 
-    g_monitoring_context->connected = true;
-
-    int64_t gamerscore_value;
-    xbox_fetch_gamerscore(&gamerscore_value);
+    g_monitoring_context->connected          = true;
+    g_monitoring_context->disconnected_at_ns = 0;
 
     if (!g_current_session.gamerscore) {
+        int64_t gamerscore_value = 0;
+        xbox_fetch_gamerscore(&gamerscore_value);
+
         g_current_session.gamerscore             = bzalloc(sizeof(gamerscore_t));
         g_current_session.gamerscore->base_value = (int)gamerscore_value;
     }
@@ -558,16 +829,30 @@ static void on_websocket_connected() {
      * session-ready notifications arrive, so the gamertag source never
      * briefly shows "Not connected". */
     notify_connection_changed(NULL);
+    set_health_connected(true);
 
     /* Immediately retrieves the game being played, if any */
     game_t *current_game = xbox_get_current_game();
-    xbox_change_game(current_game);
-    free_game(&current_game);
 
-    /* And retrieves the achievements, if any */
-    if (g_current_session.game != NULL) {
-        xbox_achievements_progress_subscribe(&g_current_session);
+    if (xbox_session_is_game_played(&g_current_session, current_game)) {
+        resync_session();
+        free_game(&current_game);
+    } else {
+        /* The new connection holds no subscription for a title kept from before
+         * the outage, so there is nothing to unsubscribe from */
+        free_game(&g_current_session.game);
+
+        xbox_change_game(current_game);
+        free_game(&current_game);
+
+        /* And retrieves the achievements, if any */
+        if (g_current_session.game != NULL) {
+            xbox_achievements_progress_subscribe(&g_current_session);
+        }
     }
+
+    /* Once subscribed: the pre-warming blocks for up to several seconds */
+    schedule_prewarm();
 }
 
 /**
@@ -578,11 +863,16 @@ static void on_websocket_disconnected() {
     g_monitoring_context->connected = false;
     g_monitoring_context->wsi       = NULL;
 
-    xbox_session_clear(&g_current_session);
-
     notify_connection_changed(NULL);
+    set_health_connected(false);
 
-    notify_game_played(NULL);
+    if (!g_monitoring_context->running) {
+        drop_session();
+        return;
+    }
+
+    /* Keep the game and achievements on screen: a short outage is resynchronized on reconnection */
+    retain_session();
 }
 
 /**
@@ -594,6 +884,38 @@ static void on_websocket_error(const char *in) {
     g_monitoring_context->wsi       = NULL;
 
     notify_connection_changed(in ? (char *)in : "Connection error");
+    set_health_connected(false);
+
+    retain_session();
+}
+
+/**
+ * @brief Resolve the game named by a presence message.
+ *
+ * RTA presence only carries the title id: the title is looked up in the title
+ * cache, and the REST presence call (which also fills the cache) is only made
+ * on a miss.
+ *
+ * @param game_id Title id of the presence message, or NULL when no game is played.
+ *
+ * @return Newly allocated game, or NULL if no game is played.
+ */
+static game_t *resolve_presence_game(const char *game_id) {
+
+    if (!game_id) {
+        return NULL;
+    }
+
+    game_t *game = xbox_title_cache_resolve(game_id);
+
+    if (game) {
+        obs_log(LOG_DEBUG, "[XboxMonitor] Title %s resolved from the cache: %s", game_id, game->title);
+        return game;
+    }
+
+    obs_log(LOG_DEBUG, "[XboxMonitor] Title %s not cached, querying the presence", game_id);
+
+    return xbox_get_current_game();
 }
 
 /**
@@ -651,7 +973,12 @@ static void on_buffer_received(const char *buffer) {
             goto cleanup;
         }
 
-        game = xbox_get_current_game();
+        if (g_current_session.game == NULL && game_id == NULL) {
+            obs_log(LOG_DEBUG, "[XboxMonitor] Still no game played");
+            goto cleanup;
+        }
+
+        game = resolve_presence_game(game_id);
         on_game_update_received(game);
         goto cleanup;
     }
@@ -672,6 +999,24 @@ cleanup:
     free_json_memory((void **)&root);
 }
 
+/**
+ * @brief Keep the zlib state of a compressed connection small.
+ *
+ * The streams are created lazily on the first frame, so the options still
+ * apply once the connection is established. Without the extension (not
+ * negotiated, or not compiled in) this does nothing.
+ */
+static void bound_deflate_memory(struct lws *wsi) {
+
+#if !defined(LWS_WITHOUT_EXTENSIONS)
+    if (lws_set_extension_option(wsi, "permessage-deflate", "mem_level", DEFLATE_MEM_LEVEL) == 0) {
+        obs_log(LOG_DEBUG, "[XboxMonitor] permessage-deflate negotiated");
+    }
+#else
+    UNUSED_PARAMETER(wsi);
+#endif
+}
+
 /**
  * @brief libwebsockets callback for websocket events.
  */
@@ -709,6 +1054,7 @@ static int websocket_callback(struct lws *wsi, enum lws_callback_reasons reason,
 
     case LWS_CALLBACK_CLIENT_ESTABLISHED:
         obs_log(LOG_INFO, "[XboxMonitor] WebSocket connection established");
+        bound_deflate_memory(wsi);
         on_websocket_connected();
         break;
 
@@ -717,7 +1063,7 @@ static int websocket_callback(struct lws *wsi, enum lws_callback_reasons reason,
         size_t needed = ctx->rx_buffer_used + len + 1;
         if (needed > ctx->rx_buffer_size) {
             size_t new_size   = needed * 2;
-            char  *new_buffer = (char *)brealloc(ctx->rx_buffer, new_size);
+            char  *new_buffer = (char *)memory_realloc(MEMORY_TAG_NET, ctx->rx_buffer, new_size);
             if (!new_buffer) {
                 obs_log(LOG_ERROR, "[XboxMonitor] Failed to allocate receive buffer");
                 return -1;
@@ -730,6 +1076,17 @@ static int websocket_callback(struct lws *wsi, enum lws_callback_reasons reason,
         memcpy(ctx->rx_buffer + ctx->rx_buffer_used, in, len);
         ctx->rx_buffer_used += len;
 
+        const uint64_t received_ns = os_gettime_ns();
+
+        pthread_mutex_lock(&g_health_mutex);
+        g_health.last_message_ns = received_ns;
+        pthread_mutex_unlock(&g_health_mutex);
+
+        /* Traffic proves the connection alive: no ping needed for a while, and
+         * the connection is good enough to restart the backoff from scratch */
+        rta_keepalive_on_activity(&ctx->keepalive, received_ns);
+        ctx->retry_delay_ms = INITIAL_RETRY_DELAY_MS;
+
         /* Check if this is the final fragment */
         if (lws_is_final_fragment(wsi)) {
             ctx->rx_buffer[ctx->rx_buffer_used] = '\0';
@@ -754,8 +1111,34 @@ static int websocket_callback(struct lws *wsi, enum lws_callback_reasons reason,
          * here prepares the next connection attempt (reconnect) to use fresh
          * credentials.
          */
+        {
+            const int64_t round_trip_ms = rta_keepalive_on_pong(&ctx->keepalive, os_gettime_ns());
+
+            if (round_trip_ms >= 0) {
+                pthread_mutex_lock(&g_health_mutex);
+                g_health.round_trip_ms = round_trip_ms;
+                pthread_mutex_unlock(&g_health_mutex);
+
+                ctx->retry_delay_ms = INITIAL_RETRY_DELAY_MS;
+                notify_health_changed();
+            }
+        }
+
         refresh_token_if_needed();
         break;
+
+    case LWS_CALLBACK_CLIENT_WRITEABLE:
+        if (ctx->ping_requested) {
+            unsigned char ping[LWS_PRE + 1];
+
+            ctx->ping_requested = false;
+
+            if (lws_write(wsi, ping + LWS_PRE, 0, LWS_WRITE_PING) >= 0) {
+                rta_keepalive_on_ping_sent(&ctx->keepalive, os_gettime_ns());
+            }
+        }
+        break;
+
     case LWS_CALLBACK_CLIENT_CONNECTION_ERROR:
         obs_log(LOG_ERROR, "[XboxMonitor] Connection error: %s", in ? (char *)in : "unknown");
         on_websocket_error(in ? (char *)in : "Connection error");
@@ -788,6 +1171,23 @@ static const struct lws_protocols protocols[] = {
     {NULL, NULL, 0, 0, 0, NULL, 0},
 };
 
+#if !defined(LWS_WITHOUT_EXTENSIONS)
+/**
+ * @brief Extensions offered during the handshake.
+ *
+ * RTA frames are small, repetitive JSON documents that compress well. Both
+ * windows are capped so that a connection never holds more than a few KB of
+ * zlib state; a server refusing the caps simply leaves the connection
+ * uncompressed.
+ */
+static const struct lws_extension extensions[] = {
+    {"permessage-deflate",
+     lws_extension_callback_pm_deflate,
+     "permessage-deflate; client_max_window_bits=" DEFLATE_WINDOW_BITS "; server_max_window_bits=" DEFLATE_WINDOW_BITS},
+    {NULL, NULL, NULL},
+};
+#endif
+
 /**
  * @brief Background thread entry point.
  *
@@ -795,10 +1195,30 @@ static const struct lws_protocols protocols[] = {
  * initial fetch of the current game, then runs the websocket event loop until
  * stopped.
  */
+/**
+ * @brief Draw the next value of the reconnection jitter generator (xorshift32).
+ */
+static unsigned int next_jitter_random(monitoring_context_t *ctx) {
+
+    uint32_t x = ctx->jitter_state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    ctx->jitter_state = x;
+
+    return x;
+}
+
 static void *monitoring_thread(void *arg) {
 
     monitoring_context_t *ctx = arg;
 
+    if (!thread_set_class(THREAD_CLASS_NETWORK, "XboxMonitor")) {
+        obs_log(LOG_WARNING, "[XboxMonitor] Could not apply the thread priority");
+    }
+
     struct lws_context_creation_info info;
     memset(&info, 0, sizeof(info));
 
@@ -807,6 +1227,21 @@ static void *monitoring_thread(void *arg) {
     info.user      = ctx;
     info.options   = LWS_SERVER_OPTION_DO_SSL_GLOBAL_INIT;
 
+    if (ctx->configuration.compression_enabled) {
+#if !defined(LWS_WITHOUT_EXTENSIONS)
+        info.extensions = extensions;
+#else
+        obs_log(LOG_INFO, "[XboxMonitor] libwebsockets built without extensions, compression unavailable");
+#endif
+    }
+
+    /* Our keepalive pings first and gives up after the pong timeout; lws' own
+     * idle ping and hang-up only act as a backstop past those delays */
+    const int backstop_secs = ctx->configuration.max_ping_interval + 2 * ctx->configuration.pong_timeout;
+
+    ctx->retry_policy.secs_since_valid_ping   = (uint16_t)backstop_secs;
+    ctx->retry_policy.secs_since_valid_hangup = (uint16_t)(backstop_secs + ctx->configuration.pong_timeout);
+
     ctx->context = lws_create_context(&info);
 
     if (!ctx->context) {
@@ -826,7 +1261,7 @@ static void *monitoring_thread(void *arg) {
     ccinfo.host                  = ccinfo.address;
     ccinfo.origin                = ccinfo.address;
     ccinfo.protocol              = PROTOCOL;
-    ccinfo.retry_and_idle_policy = &retry_policy;
+    ccinfo.retry_and_idle_policy = &ctx->retry_policy;
     ccinfo.ssl_connection        = LCCSCF_USE_SSL | LCCSCF_ALLOW_SELFSIGNED | LCCSCF_SKIP_SERVER_CERT_HOSTNAME_CHECK;
 
     obs_log(LOG_DEBUG, "[XboxMonitor] Connecting to wss://%s:%d%s", RTA_HOST, RTA_PORT, RTA_PATH);
@@ -843,18 +1278,24 @@ static void *monitoring_thread(void *arg) {
     }
 
     /* Start at 1 second */
-    int retry_delay_ms = INITIAL_RETRY_DELAY_MS;
+    ctx->retry_delay_ms = INITIAL_RETRY_DELAY_MS;
 
     /* Service the WebSocket connection */
     while (ctx->running && ctx->context) {
         lws_service(ctx->context, LOOP_CHECK_MS);
 
+        service_keepalive(ctx);
+
+        expire_retained_session(ctx);
+
         /* Reconnect if the connection was lost */
         if (ctx->running && !ctx->wsi && ctx->context) {
-            obs_log(LOG_INFO, "[XboxMonitor] Connection lost, retrying in %d ms...", retry_delay_ms);
+            const int delay_ms = rta_reconnect_delay_with_jitter(ctx->retry_delay_ms, next_jitter_random(ctx));
 
-            /* Sleep for retry_delay_ms while keeping lws alive (50ms increments) */
-            int iterations = retry_delay_ms / LOOP_CHECK_MS;
+            obs_log(LOG_INFO, "[XboxMonitor] Connection lost, retrying in %d ms...", delay_ms);
+
+            /* Sleep for delay_ms while keeping lws alive (50ms increments) */
+            int iterations = delay_ms / LOOP_CHECK_MS;
             for (int i = 0; i < iterations && ctx->running; i++) {
                 sleep_ms(LOOP_CHECK_MS);
             }
@@ -863,20 +1304,15 @@ static void *monitoring_thread(void *arg) {
 
             ctx->wsi = lws_client_connect_via_info(&ccinfo);
 
+            /* Back off until the new connection proves alive (first frame or
+             * pong), so that a handshake rejected over and over (e.g. expired
+             * credentials) does not turn into a reconnection storm */
+            ctx->retry_delay_ms = rta_reconnect_next_delay(ctx->retry_delay_ms, MAX_RETRY_DELAY_MS);
+
             if (!ctx->wsi) {
                 obs_log(LOG_WARNING,
-                        "[XboxMonitor] Reconnect attempt failed, next retry in %d ms",
-                        retry_delay_ms * 2 > MAX_RETRY_DELAY_MS ? MAX_RETRY_DELAY_MS : retry_delay_ms * 2);
-
-                /* Double the delay, capped at max */
-                retry_delay_ms = retry_delay_ms * 2;
-                if (retry_delay_ms > MAX_RETRY_DELAY_MS) {
-                    retry_delay_ms = MAX_RETRY_DELAY_MS;
-                }
-            } else {
-                obs_log(LOG_INFO, "[XboxMonitor] Connection reestablished");
-                /* Reset delay on successful connection attempt */
-                retry_delay_ms = INITIAL_RETRY_DELAY_MS;
+                        "[XboxMonitor] Reconnect attempt failed, next retry in about %d ms",
+                        ctx->retry_delay_ms);
             }
         }
     }
@@ -895,7 +1331,10 @@ static void *monitoring_thread(void *arg) {
 //  Public API
 //  --------------------------------------------------------------------------------------------------------------------
 
-bool xbox_monitoring_start() {
+/**
+ * @brief Start the monitor thread (see xbox_monitoring_start()). Called with g_lifecycle_mutex held.
+ */
+static bool start_monitoring(void) {
 
     bool succeeded = false;
 
@@ -920,14 +1359,28 @@ bool xbox_monitoring_start() {
 
     char *authorization_header = build_authorization_header(identity);
 
+    pthread_mutex_lock(&g_health_mutex);
+    g_health = (xbox_connection_health_t){.round_trip_ms = -1};
+    pthread_mutex_unlock(&g_health_mutex);
+
+    rta_connection_configuration_t *configuration = state_get_rta_connection_configuration();
+    g_monitoring_context->configuration           = *configuration;
+    bfree(configuration);
+
+    const uint64_t seed                = os_gettime_ns() ^ (uint64_t)(uintptr_t)g_monitoring_context;
+    g_monitoring_context->jitter_state = (uint32_t)(seed ^ (seed >> 32)) | 1u;
+
     g_monitoring_context->identity   = identity;
     g_monitoring_context->running    = true;
     g_monitoring_context->connected  = false;
     g_monitoring_context->auth_token = authorization_header;
 
+    /* Owned by the context from now on: freed once, with it */
+    identity = NULL;
+
     /* Allocate initial receive buffer */
     g_monitoring_context->rx_buffer_size = 4096;
-    g_monitoring_context->rx_buffer      = (char *)bmalloc(g_monitoring_context->rx_buffer_size);
+    g_monitoring_context->rx_buffer      = (char *)memory_malloc(MEMORY_TAG_NET, g_monitoring_context->rx_buffer_size);
     g_monitoring_context->rx_buffer_used = 0;
 
     if (!g_monitoring_context->rx_buffer) {
@@ -935,6 +1388,9 @@ bool xbox_monitoring_start() {
         goto error;
     }
 
+    /* Optional: without it, the requests simply start cold */
+    g_monitoring_context->prewarm_pool = worker_pool_create("XboxPrewarm", THREAD_CLASS_BACKGROUND, 1);
+
     if (pthread_create(&g_monitoring_context->thread, NULL, monitoring_thread, g_monitoring_context) != 0) {
         obs_log(LOG_ERROR, "[XboxMonitor] Failed to create monitor thread");
         goto error;
@@ -946,16 +1402,25 @@ bool xbox_monitoring_start() {
 
 error:
     free_identity(&identity);
-    free_identity(&g_monitoring_context->identity);
-    free_memory((void **)&g_monitoring_context->rx_buffer);
-    free_memory((void **)&g_monitoring_context->auth_token);
-    free_memory((void **)&g_monitoring_context);
+
+    /* NULL when there was no identity or the allocation failed */
+    if (g_monitoring_context) {
+        worker_pool_destroy(&g_monitoring_context->prewarm_pool);
+        free_identity(&g_monitoring_context->identity);
+        memory_free(g_monitoring_context->rx_buffer);
+        g_monitoring_context->rx_buffer = NULL;
+        free_memory((void **)&g_monitoring_context->auth_token);
+        free_memory((void **)&g_monitoring_context);
+    }
 
 done:
     return succeeded;
 }
 
-void xbox_monitoring_stop(void) {
+/**
+ * @brief Stop and join the monitor thread (see xbox_monitoring_stop()). Called with g_lifecycle_mutex held.
+ */
+static void stop_monitoring(void) {
 
     if (!g_monitoring_context) {
         return;
@@ -973,14 +1438,47 @@ void xbox_monitoring_stop(void) {
         pthread_join(g_monitoring_context->thread, NULL);
     }
 
+    /* No connection can schedule a prewarm anymore */
+    worker_pool_destroy(&g_monitoring_context->prewarm_pool);
+
+    /* A session retained through an outage has no connection left to close */
+    if (g_current_session.game) {
+        drop_session();
+    }
+
+    xbox_session_clear(&g_current_session);
+    xbox_title_cache_clear();
+
     free_identity(&g_monitoring_context->identity);
-    free_memory((void **)&g_monitoring_context->rx_buffer);
+    memory_free(g_monitoring_context->rx_buffer);
+    g_monitoring_context->rx_buffer = NULL;
     free_memory((void **)&g_monitoring_context->auth_token);
     free_memory((void **)&g_monitoring_context);
 
+    pthread_mutex_lock(&g_health_mutex);
+    g_health.connected     = false;
+    g_health.round_trip_ms = -1;
+    pthread_mutex_unlock(&g_health_mutex);
+
+    notify_health_changed();
+
     obs_log(LOG_INFO, "[XboxMonitor] Monitor stopped");
 }
 
+bool xbox_monitoring_start() {
+    pthread_mutex_lock(&g_lifecycle_mutex);
+    const bool started = start_monitoring();
+    pthread_mutex_unlock(&g_lifecycle_mutex);
+
+    return started;
+}
+
+void xbox_monitoring_stop(void) {
+    pthread_mutex_lock(&g_lifecycle_mutex);
+    stop_monitoring();
+    pthread_mutex_unlock(&g_lifecycle_mutex);
+}
+
 bool xbox_monitoring_is_active(void) {
     if (!g_monitoring_context) {
         return false;
@@ -989,6 +1487,13 @@ bool xbox_monitoring_is_active(void) {
     return g_monitoring_context->running;
 }
 
+void xbox_monitoring_get_health(xbox_connection_health_t *health) {
+
+    pthread_mutex_lock(&g_health_mutex);
+    *health = g_health;
+    pthread_mutex_unlock(&g_health_mutex);
+}
+
 const game_t *get_current_game() {
     return g_current_session.game;
 }
@@ -1096,6 +1601,28 @@ void xbox_subscribe_session_ready(const on_xbox_session_ready_t callback) {
     g_session_ready_subscriptions = new_node;
 }
 
+void xbox_subscribe_health_changed(const on_xbox_health_changed_t callback) {
+
+    pthread_mutex_lock(&g_health_mutex);
+
+    if (!callback) {
+        health_changed_subscription_t *node = g_health_changed_subscriptions;
+        while (node) {
+            health_changed_subscription_t *next = node->next;
+            bfree(node);
+            node = next;
+        }
+        g_health_changed_subscriptions = NULL;
+    } else {
+        health_changed_subscription_t *new_node = bzalloc(sizeof(health_changed_subscription_t));
+        new_node->callback                      = callback;
+        new_node->next                          = g_health_changed_subscriptions;
+        g_health_changed_subscriptions          = new_node;
+    }
+
+    pthread_mutex_unlock(&g_health_mutex);
+}
+
 #else /* !HAVE_LIBWEBSOCKETS */
 
 /* Stub implementations when libwebsockets is not available */
@@ -1117,6 +1644,10 @@ const gamerscore_t *get_current_gamerscore(void) {
     return NULL;
 }
 
+void xbox_monitoring_get_health(xbox_connection_health_t *health) {
+    *health = (xbox_connection_health_t){.round_trip_ms = -1};
+}
+
 const game_t *get_current_game() {
     return NULL;
 }
@@ -1141,4 +1672,8 @@ void xbox_subscribe_session_ready(const on_xbox_session_ready_t callback) {
     (void)callback;
 }
 
+void xbox_subscribe_health_changed(const on_xbox_health_changed_t callback) {
+    (void)callback;
+}
+
 #endif /* HAVE_LIBWEBSOCKETS */
@@ -2,6 +2,7 @@
 
 #include <stdbool.h>
 #include "common/types.h"
+#include "integrations/xbox/entities/xbox_connection_health.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -61,10 +62,20 @@ typedef void (*on_xbox_connection_changed_t)(bool connected, const char *error_m
  * @brief Callback invoked when the session is fully ready.
  *
  * "Ready" means the current game's achievements have been fetched and sorted.
- * Icon prefetching may still be in progress in the background.
+ * Their icons are prefetched afterwards by the monitoring service.
  */
 typedef void (*on_xbox_session_ready_t)(void);
 
+/**
+ * @brief Callback invoked when the connection health changes.
+ *
+ * Fired on connection, disconnection and after each ping/pong round trip
+ * (every few seconds while connected).
+ *
+ * @param health Current health (borrowed; valid during the call).
+ */
+typedef void (*on_xbox_health_changed_t)(const xbox_connection_health_t *health);
+
 /**
  * @brief Get the most recently cached gamerscore snapshot.
  *
@@ -101,7 +112,9 @@ const xbox_achievement_t *get_current_game_achievements(void);
 /**
  * @brief Start monitoring the Xbox Live RTA endpoint.
  *
- * Uses authorization data from the current persisted state.
+ * Uses authorization data from the current persisted state. May be called
+ * from any thread but the monitor's own (i.e. not from its callbacks): starts
+ * and stops are serialized.
  *
  * @return true if monitoring started successfully; false otherwise.
  */
@@ -109,6 +122,8 @@ bool xbox_monitoring_start(void);
 
 /**
  * @brief Stop monitoring the Xbox Live RTA endpoint.
+ *
+ * Joins the monitor thread: same threading rules as xbox_monitoring_start().
  */
 void xbox_monitoring_stop(void);
 
@@ -119,6 +134,15 @@ void xbox_monitoring_stop(void);
  */
 bool xbox_monitoring_is_active(void);
 
+/**
+ * @brief Get the current connection health.
+ *
+ * Threading: safe to call from any thread.
+ *
+ * @param health Receives the health (must not be NULL).
+ */
+void xbox_monitoring_get_health(xbox_connection_health_t *health);
+
 /**
  * @brief Subscribe to game-played events.
  *
@@ -156,6 +180,16 @@ void xbox_subscribe_connected_changed(on_xbox_connection_changed_t callback);
  */
 void xbox_subscribe_session_ready(on_xbox_session_ready_t callback);
 
+/**
+ * @brief Subscribe to connection health events.
+ *
+ * Unlike the other subscriptions, this one may be changed from any thread
+ * while monitoring runs. Passing NULL clears/unsubscribes the callbacks.
+ *
+ * @param callback Callback invoked when the connection health changes.
+ */
+void xbox_subscribe_health_changed(on_xbox_health_changed_t callback);
+
 #ifdef __cplusplus
 }
 #endif
@@ -3,12 +3,11 @@
 #include <diagnostics/log.h>
 
 #include "common/types.h"
-#include "io/cache.h"
 #include "util/bmem.h"
 #include "integrations/xbox/xbox_client.h"
 #include "integrations/xbox/contracts/xbox_achievement.h"
 #include "integrations/xbox/contracts/xbox_achievement_progress.h"
-#include "integrations/xbox/contracts/xbox_unlocked_achievement.h"
+#include "time/time.h"
 
 #include <errno.h>
 #include <time.h>
@@ -16,89 +15,6 @@
 #include <stdlib.h>
 #include <string.h>
 
-//  --------------------------------------------------------------------------------------------------------------------
-//  Icon prefetch helpers
-//  --------------------------------------------------------------------------------------------------------------------
-
-/**
- * @brief Context passed to the prefetch background thread.
- */
-typedef struct prefetch_context {
-    /** Deep-copied achievement list. Freed by the thread when done. */
-    xbox_achievement_t *achievements;
-} prefetch_context_t;
-
-/**
- * @brief Download a single achievement icon to the local file cache.
- */
-static bool download_icon_to_cache(const xbox_achievement_t *achievement) {
-
-    if (!achievement->icon_url || achievement->icon_url[0] == '\0') {
-        return false;
-    }
-
-    /* Build the composite id matching what achievement_icon.c uses */
-    char id[256];
-    snprintf(id, sizeof(id), "%s_%s", achievement->service_config_id, achievement->id);
-
-    return cache_download(achievement->icon_url, "achievement_icon", id, NULL, 0);
-}
-
-/**
- * @brief Background thread entry point: prefetches all achievement icons.
- */
-static void *prefetch_icons_thread(void *arg) {
-
-    prefetch_context_t *ctx          = arg;
-    xbox_achievement_t *achievements = ctx->achievements;
-    int                 count        = 0;
-
-    for (const xbox_achievement_t *achievement = achievements; achievement != NULL; achievement = achievement->next) {
-        if (download_icon_to_cache(achievement)) {
-            /* Keep a small throttle between successful downloads to avoid
-             * hammering the endpoint while still completing prefetch quickly. */
-            sleep_ms(150);
-        }
-        count++;
-    }
-
-    obs_log(LOG_INFO, "[XboxSession] Finished prefetching %d achievement icons", count);
-
-    xbox_free_achievement(&achievements);
-    free_memory((void **)&ctx);
-    return NULL;
-}
-
-/**
- * @brief Starts a background thread to prefetch all achievement icons.
- */
-static void prefetch_achievement_icons(const xbox_achievement_t *achievements) {
-
-    if (!achievements) {
-        return;
-    }
-
-    xbox_achievement_t *copy = xbox_copy_achievement(achievements);
-
-    if (!copy) {
-        obs_log(LOG_WARNING, "[XboxSession] Failed to copy achievements for icon prefetch");
-        return;
-    }
-
-    prefetch_context_t *ctx = bzalloc(sizeof(prefetch_context_t));
-    ctx->achievements       = copy;
-
-    pthread_t thread;
-    if (pthread_create(&thread, NULL, prefetch_icons_thread, ctx) == 0) {
-        pthread_detach(thread);
-        obs_log(LOG_INFO, "[XboxSession] Started background icon prefetch thread");
-    } else {
-        obs_log(LOG_ERROR, "[XboxSession] Failed to create icon prefetch thread");
-        xbox_free_achievement(&copy);
-        free_memory((void **)&ctx);
-    }
-}
-
 //  --------------------------------------------------------------------------------------------------------------------
 //  Private functions.
 //  --------------------------------------------------------------------------------------------------------------------
@@ -170,18 +86,16 @@ void xbox_session_change_game(xbox_session_t *session, game_t *game, xbox_sessio
     xbox_sort_achievements(&session->achievements);
 
     /* Session is considered ready as soon as achievements are fetched/sorted.
-     * Icon prefetching continues in the background and should not block the cycle. */
+     * The icons are prefetched by the monitoring service (asset_prefetch.h). */
     if (on_ready) {
         on_ready();
     }
-
-    prefetch_achievement_icons(session->achievements);
 }
 
-void xbox_session_unlock_achievement(xbox_session_t *session, const xbox_achievement_progress_t *progress) {
+bool xbox_session_unlock_achievement(xbox_session_t *session, const xbox_achievement_progress_t *progress) {
 
     if (!session || !progress) {
-        return;
+        return false;
     }
 
     xbox_achievement_t *achievement = find_achievement_by_id(progress, session->achievements);
@@ -190,7 +104,15 @@ void xbox_session_unlock_achievement(xbox_session_t *session, const xbox_achieve
         obs_log(LOG_ERROR,
                 "[XboxSession] Failed to unlock achievement %s: not found in the game's achievements",
                 progress->id ? progress->id : "(null)");
-        return;
+        return false;
+    }
+
+    /* A repeated "Achieved" event must neither move the unlock time nor reorder the list */
+    if (achievement->unlocked_timestamp != 0) {
+        obs_log(LOG_DEBUG,
+                "[XboxSession] Achievement %s already unlocked; event ignored",
+                progress->id ? progress->id : "(null)");
+        return false;
     }
 
     /* Updates the achievement status */
@@ -200,7 +122,7 @@ void xbox_session_unlock_achievement(xbox_session_t *session, const xbox_achieve
     /* Xbox sends "0001-01-01T00:00:00" (parsed as 0) as the null unlock date.
      * Fall back to the current time so the achievement is never treated as locked. */
     achievement->unlocked_timestamp = (progress->unlocked_timestamp > 0) ? progress->unlocked_timestamp
-                                                                         : (int64_t)time(NULL);
+                                                                         : (int64_t)now();
 
     /* Clear in-progress tracking — the achievement is now complete. */
     free_memory((void **)&achievement->progression_current);
@@ -213,16 +135,11 @@ void xbox_session_unlock_achievement(xbox_session_t *session, const xbox_achieve
         obs_log(LOG_ERROR,
                 "[XboxSession] Failed to unlock achievement %s: no reward found",
                 progress->id ? progress->id : "(null)");
-        return;
+        return true;
     }
 
     obs_log(LOG_DEBUG, "[XboxSession] Found reward %s", reward->value);
 
-    gamerscore_t *gamerscore = session->gamerscore;
-
-    xbox_unlocked_achievement_t *unlocked_achievement = bzalloc(sizeof(xbox_unlocked_achievement_t));
-    unlocked_achievement->id                          = bstrdup(progress->id);
-
     long  parsed_value = 0;
     char *endptr       = NULL;
     errno              = 0;
@@ -239,25 +156,20 @@ void xbox_session_unlock_achievement(xbox_session_t *session, const xbox_achieve
         parsed_value = 0;
     }
 
-    unlocked_achievement->value = (int)parsed_value;
-
-    xbox_unlocked_achievement_t *unlocked_achievements = gamerscore->unlocked_achievements;
-
-    if (!unlocked_achievements) {
-        gamerscore->unlocked_achievements = unlocked_achievement;
-    } else {
-        xbox_unlocked_achievement_t *last_unlocked_achievement = unlocked_achievements;
-        while (last_unlocked_achievement->next) {
-            last_unlocked_achievement = last_unlocked_achievement->next;
-        }
-        last_unlocked_achievement->next = unlocked_achievement;
+    if (!gamerscore_add_unlocked_achievement(session->gamerscore, progress->id, (int)parsed_value)) {
+        obs_log(LOG_DEBUG,
+                "[XboxSession] Achievement %s already counted; gamerscore unchanged",
+                progress->id ? progress->id : "(null)");
+        return true;
     }
 
     obs_log(LOG_INFO,
             "[XboxSession] Achievement unlocked: %s (%d G) — gamerscore now %d",
             achievement->name,
-            unlocked_achievement->value,
+            (int)parsed_value,
             xbox_session_compute_gamerscore(session));
+
+    return true;
 }
 
 void xbox_session_progress_achievement(xbox_session_t *session, const xbox_achievement_progress_t *progress) {
@@ -288,6 +200,61 @@ void xbox_session_progress_achievement(xbox_session_t *session, const xbox_achie
             achievement->progression_current);
 }
 
+int64_t xbox_session_get_last_unlock_timestamp(const xbox_session_t *session) {
+
+    if (!session) {
+        return 0;
+    }
+
+    const xbox_achievement_t *latest = xbox_find_latest_unlocked_achievement(session->achievements);
+
+    return latest ? latest->unlocked_timestamp : 0;
+}
+
+xbox_achievement_progress_t *xbox_session_find_missed_unlocks(const xbox_session_t     *session,
+                                                              const xbox_achievement_t *unlocked) {
+
+    if (!session) {
+        return NULL;
+    }
+
+    xbox_achievement_progress_t *missed = NULL;
+    xbox_achievement_progress_t *last   = NULL;
+
+    for (const xbox_achievement_t *remote = unlocked; remote; remote = remote->next) {
+
+        if (remote->unlocked_timestamp == 0 || !remote->id) {
+            continue;
+        }
+
+        xbox_achievement_t *local = session->achievements;
+
+        while (local && strcasecmp(local->id, remote->id) != 0) {
+            local = local->next;
+        }
+
+        if (!local || local->unlocked_timestamp != 0) {
+            continue;
+        }
+
+        xbox_achievement_progress_t *progress = bzalloc(sizeof(xbox_achievement_progress_t));
+        progress->id                          = bstrdup(remote->id);
+        progress->service_config_id           = bstrdup(local->service_config_id);
+        progress->progress_state              = bstrdup("Achieved");
+        progress->unlocked_timestamp          = remote->unlocked_timestamp;
+
+        if (last) {
+            last->next = progress;
+        } else {
+            missed = progress;
+        }
+
+        last = progress;
+    }
+
+    return missed;
+}
+
 void xbox_session_clear(xbox_session_t *session) {
 
     if (!session) {
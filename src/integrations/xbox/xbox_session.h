@@ -3,6 +3,7 @@
 #include "common/types.h"
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -36,8 +37,7 @@ bool xbox_session_is_game_played(xbox_session_t *session, const game_t *game);
 /**
  * @brief Callback type invoked when session achievements are loaded.
  *
- * Called once the game achievements are fetched and sorted, before icon
- * prefetching finishes.
+ * Called once the game achievements are fetched and sorted.
  */
 typedef void (*xbox_session_ready_callback_t)(void);
 
@@ -47,8 +47,7 @@ typedef void (*xbox_session_ready_callback_t)(void);
  * Implementations typically free/replace the previous @c session->game and reset
  * cached session state derived from that game (e.g., achievements list and
  * gamerscore).  @p on_ready is invoked as soon as achievements are loaded so
- * UI sources can start cycling immediately; icon prefetching then continues in
- * the background.
+ * UI sources can start cycling immediately.
  *
  * Ownership:
  *  - The session makes its own copy of @p game. The caller retains ownership of
@@ -68,13 +67,49 @@ void xbox_session_change_game(xbox_session_t *session, game_t *game, xbox_sessio
  * Updates session-derived state (achievement list, unlocked achievements,
  * gamerscore deltas, etc.) based on the provided progress event.
  *
+ * An achievement already unlocked in the session is left untouched: Xbox may
+ * deliver the same "Achieved" event several times.
+ *
  * @param session Session to update.
  * @param progress Progress information for the achievement being unlocked.
+ *
+ * @return true if the achievement was newly unlocked; false if it was already
+ *         unlocked, unknown to the session or an argument is NULL.
  */
-void xbox_session_unlock_achievement(xbox_session_t *session, const xbox_achievement_progress_t *progress);
+bool xbox_session_unlock_achievement(xbox_session_t *session, const xbox_achievement_progress_t *progress);
 
 void xbox_session_progress_achievement(xbox_session_t *session, const xbox_achievement_progress_t *progress);
 
+/**
+ * @brief Gets the time of the most recent unlock known to the session.
+ *
+ * Used as the starting point of a catch-up after a reconnection.
+ *
+ * @param session Session to inspect.
+ *
+ * @return Unix timestamp of the latest unlocked achievement, or 0 if none.
+ */
+int64_t xbox_session_get_last_unlock_timestamp(const xbox_session_t *session);
+
+/**
+ * @brief Lists the unlocks the session has missed.
+ *
+ * Compares achievements reported as unlocked by the service (e.g. fetched after
+ * a reconnection) with the session and builds an "Achieved" progress entry for
+ * each one still locked in the session, ready to be applied with
+ * @ref xbox_session_unlock_achievement. Achievements unknown to the session are
+ * ignored.
+ *
+ * @param session  Session to compare against.
+ * @param unlocked Achievements unlocked according to the service.
+ *
+ * @return Newly allocated list of progress entries, or NULL if nothing was
+ *         missed. The caller owns the list and must free it with
+ *         @ref xbox_free_achievement_progress.
+ */
+xbox_achievement_progress_t *xbox_session_find_missed_unlocks(const xbox_session_t     *session,
+                                                              const xbox_achievement_t *unlocked);
+
 /**
  * @brief Clears all session state.
  *
@@ -0,0 +1,82 @@
+#include "integrations/xbox/xbox_title_cache.h"
+
+#include <util/thread_compat.h>
+#include <string.h>
+
+static pthread_mutex_t g_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** Cached titles; the slot at @c g_next is the oldest one once the cache is full. */
+static game_t *g_titles[XBOX_TITLE_CACHE_CAPACITY];
+static size_t  g_next = 0;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Private functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Find the slot holding @p title_id. Must be called with the mutex held.
+ */
+static game_t **find_slot(const char *title_id) {
+
+    for (size_t i = 0; i < XBOX_TITLE_CACHE_CAPACITY; i++) {
+        if (g_titles[i] && g_titles[i]->id && strcasecmp(g_titles[i]->id, title_id) == 0) {
+            return &g_titles[i];
+        }
+    }
+
+    return NULL;
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public API
+//  --------------------------------------------------------------------------------------------------------------------
+
+void xbox_title_cache_put(const game_t *game) {
+
+    if (!game || !game->id) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_mutex);
+
+    game_t **slot = find_slot(game->id);
+
+    if (!slot) {
+        slot   = &g_titles[g_next];
+        g_next = (g_next + 1) % XBOX_TITLE_CACHE_CAPACITY;
+    }
+
+    free_game(slot);
+    *slot = copy_game(game);
+
+    pthread_mutex_unlock(&g_mutex);
+}
+
+game_t *xbox_title_cache_resolve(const char *title_id) {
+
+    if (!title_id) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&g_mutex);
+
+    game_t **slot = find_slot(title_id);
+    game_t  *game = slot ? copy_game(*slot) : NULL;
+
+    pthread_mutex_unlock(&g_mutex);
+
+    return game;
+}
+
+void xbox_title_cache_clear(void) {
+
+    pthread_mutex_lock(&g_mutex);
+
+    for (size_t i = 0; i < XBOX_TITLE_CACHE_CAPACITY; i++) {
+        free_game(&g_titles[i]);
+    }
+
+    g_next = 0;
+
+    pthread_mutex_unlock(&g_mutex);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "common/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file xbox_title_cache.h
+ * @brief In-memory cache of the Xbox titles already resolved.
+ *
+ * RTA presence messages only carry the title id of the game being played. The
+ * title name used to be obtained with a REST presence call on every game
+ * change; the titles returned by that call are now remembered here, so that a
+ * presence message for a known title is resolved locally and the achievements
+ * fetch starts one round trip earlier.
+ *
+ * The cache holds the last XBOX_TITLE_CACHE_CAPACITY titles while the Xbox
+ * monitoring runs; the oldest entry is evicted first, and the whole cache is
+ * cleared when the monitoring stops (sign-out, plugin unload).
+ *
+ * Thread safety:
+ *   All functions may be called from any thread.
+ */
+
+/** Number of titles kept. */
+#define XBOX_TITLE_CACHE_CAPACITY 32
+
+/**
+ * @brief Remember a resolved title.
+ *
+ * Replaces the entry of the same id, if any.
+ *
+ * @param game Game to remember (ignored if NULL or without id). The cache keeps
+ *             its own copy.
+ */
+void xbox_title_cache_put(const game_t *game);
+
+/**
+ * @brief Resolve a title id from the cache.
+ *
+ * @param title_id Title id, as found in an RTA presence message.
+ *
+ * @return Newly allocated copy of the cached game, or NULL on a cache miss.
+ *         The caller owns the returned object and must free it with
+ *         @ref free_game.
+ */
+game_t *xbox_title_cache_resolve(const char *title_id);
+
+/**
+ * @brief Forget every cached title.
+ *
+ * Called when the Xbox monitoring stops.
+ */
+void xbox_title_cache_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
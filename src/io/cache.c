@@ -22,12 +22,43 @@
 #define CACHE_MAX_PATH PATH_MAX
 
 #include <diagnostics/log.h>
+#include <diagnostics/memory_accounting.h>
 #include <net/http/http.h>
 
+#include "io/image_request.h"
+
 #include "common/memory.h"
+#include "util/thread_compat.h"
 
 #define CACHE_DIRECTORY "cache"
 
+/** Prefix of every cached file name. */
+#define CACHE_FILE_PREFIX "obs_achievement_tracker_"
+
+/** Length of the "_<source-hash>.png" tail of a cached file name. */
+#define CACHE_FILE_HASH_SUFFIX_LENGTH (sizeof("_00000000.png") - 1)
+
+/** Size above which the oldest files are evicted at startup. */
+#define CACHE_MAX_BYTES (128ULL * 1024 * 1024)
+
+/** Size the eviction brings the cache down to, so that it does not run on every startup. */
+#define CACHE_TARGET_BYTES (96ULL * 1024 * 1024)
+
+/** Suffix of the temporary files the downloads are written to before being renamed. */
+#define CACHE_PARTIAL_SUFFIX "part"
+
+/*
+ * The cache directory is resolved and created once, then reused by every
+ * lookup: each cache_build_path() used to call os_mkdirs(), i.e. one more
+ * syscall per icon on top of the stat of the cached file itself.
+ */
+static pthread_mutex_t g_mutex                     = PTHREAD_MUTEX_INITIALIZER;
+static char            g_cache_dir[CACHE_MAX_PATH] = {0};
+static bool            g_cache_dir_ready           = false;
+
+/** Makes the temporary file names unique across concurrent downloads. */
+static unsigned int g_partial_counter = 0;
+
 static uint32_t cache_hash_source(const char *source) {
     /* FNV-1a 32-bit: small, stable, and sufficient for cache keying. */
     const unsigned char *p = (const unsigned char *)(source ? source : "");
@@ -43,23 +74,379 @@ static uint32_t cache_hash_source(const char *source) {
 
 static bool get_cache_dir(char *buf, size_t buf_size) {
 
-    char *cache_dir = obs_module_config_path(CACHE_DIRECTORY);
+    pthread_mutex_lock(&g_mutex);
 
-    if (!cache_dir) {
-        if (buf && buf_size > 0) {
-            buf[0] = '\0';
+    if (!g_cache_dir_ready) {
+        char *cache_dir = obs_module_config_path(CACHE_DIRECTORY);
+
+        if (cache_dir) {
+            os_mkdirs(cache_dir);
+            snprintf(g_cache_dir, sizeof(g_cache_dir), "%s", cache_dir);
+            g_cache_dir_ready = true;
+            bfree(cache_dir);
         }
+    }
 
+    const bool ready = g_cache_dir_ready;
+
+    if (buf && buf_size > 0) {
+        snprintf(buf, buf_size, "%s", ready ? g_cache_dir : "");
+    }
+
+    pthread_mutex_unlock(&g_mutex);
+
+    return ready;
+}
+
+/**
+ * @brief Forget the resolved cache directory so that the next lookup creates it again.
+ *
+ * Called when a file cannot be created, e.g. because the directory was deleted
+ * while OBS was running.
+ */
+static void invalidate_cache_dir(void) {
+    pthread_mutex_lock(&g_mutex);
+    g_cache_dir_ready = false;
+    pthread_mutex_unlock(&g_mutex);
+}
+
+/**
+ * @brief Write a downloaded file next to its final path, then rename it into place.
+ *
+ * Readers (the image sources, a concurrent download of the same resource)
+ * never see a partially written file, and an interrupted download leaves a
+ * temporary file behind instead of a truncated image.
+ *
+ * This costs one rename per download on top of writing in place: the gain is
+ * atomicity, not fewer syscalls.
+ */
+static bool write_file_atomically(const char *path, const uint8_t *data, size_t size) {
+
+    pthread_mutex_lock(&g_mutex);
+    const unsigned int partial_id = ++g_partial_counter;
+    pthread_mutex_unlock(&g_mutex);
+
+    char partial_path[CACHE_MAX_PATH];
+    snprintf(partial_path, sizeof(partial_path), "%s.%u.%s", path, partial_id, CACHE_PARTIAL_SUFFIX);
+
+    FILE *file = fopen(partial_path, "wb");
+    if (!file) {
+        invalidate_cache_dir();
+        obs_log(LOG_ERROR, "[Cache] Failed to create file '%s'", partial_path);
+        return false;
+    }
+
+    const size_t written = fwrite(data, sizeof(uint8_t), size, file);
+    const bool   closed  = fclose(file) == 0;
+
+    if (written != size || !closed) {
+        obs_log(LOG_ERROR, "[Cache] Failed to write '%s' (%zu of %zu bytes written)", partial_path, written, size);
+        remove(partial_path);
+        return false;
+    }
+
+    if (os_safe_replace(path, partial_path, NULL) != 0) {
+        obs_log(LOG_ERROR, "[Cache] Failed to move '%s' into place", partial_path);
+        remove(partial_path);
         return false;
     }
 
-    os_mkdirs(cache_dir);
-    snprintf(buf, buf_size, "%s", cache_dir);
-    bfree(cache_dir);
     return true;
 }
 
-void cache_build_path(const char *type, const char *id, const char *source, char *out_path, size_t path_size) {
+/**
+ * @brief Whether a cache directory entry is a leftover temporary file.
+ */
+static bool is_partial_file(const char *name) {
+
+    const size_t name_length   = strlen(name);
+    const size_t suffix_length = strlen("." CACHE_PARTIAL_SUFFIX);
+
+    return name_length > suffix_length && strcmp(name + name_length - suffix_length, "." CACHE_PARTIAL_SUFFIX) == 0;
+}
+
+/**
+ * @brief Cached file found by the compaction scan.
+ */
+typedef struct cache_entry {
+    /** File name (owned). */
+    char *name;
+
+    /**
+     * Length of the "<type>_<id>_<size>px" part of the name, which identifies
+     * the resource at one size; 0 if the name does not follow the convention.
+     */
+    size_t key_length;
+
+    uint64_t size;
+    time_t   modified;
+
+    /** Set once the file has been deleted by the compaction. */
+    bool removed;
+} cache_entry_t;
+
+/**
+ * @brief Whether a name ends with the "_<size>px" part of the cache key.
+ */
+static bool has_size_suffix(const char *name, size_t length) {
+
+    if (length < 4 || strncmp(name + length - 2, "px", 2) != 0) {
+        return false;
+    }
+
+    size_t digits = 0;
+
+    while (digits < length - 2 && name[length - 3 - digits] >= '0' && name[length - 3 - digits] <= '9') {
+        digits++;
+    }
+
+    return digits > 0 && digits < length - 2 && name[length - 3 - digits] == '_';
+}
+
+/**
+ * @brief Length of the part of a cached file name that identifies the resource.
+ *
+ * Two versions of the same image (same type, id and size bucket, different
+ * source URL) only differ by their source hash. The same image at two sizes
+ * has two keys: both files stay, since two sources may display them.
+ *
+ * @param legacy Set when the name follows the convention used before the size
+ *               was part of the key: no lookup builds it anymore.
+ */
+static size_t cache_key_length(const char *name, bool *legacy) {
+
+    const size_t name_length = strlen(name);
+
+    *legacy = false;
+
+    if (strncmp(name, CACHE_FILE_PREFIX, strlen(CACHE_FILE_PREFIX)) != 0 ||
+        name_length <= strlen(CACHE_FILE_PREFIX) + CACHE_FILE_HASH_SUFFIX_LENGTH ||
+        strcmp(name + name_length - 4, ".png") != 0) {
+        return 0;
+    }
+
+    const size_t key_length = name_length - CACHE_FILE_HASH_SUFFIX_LENGTH;
+
+    if (!has_size_suffix(name, key_length)) {
+        *legacy = true;
+        return 0;
+    }
+
+    return key_length;
+}
+
+/** Orders the entries by resource, most recent version first. */
+static int compare_by_key_then_newest(const void *a, const void *b) {
+
+    const cache_entry_t *left  = a;
+    const cache_entry_t *right = b;
+
+    if (left->key_length != right->key_length) {
+        return left->key_length < right->key_length ? -1 : 1;
+    }
+
+    const int by_key = strncmp(left->name, right->name, left->key_length);
+    if (by_key != 0) {
+        return by_key;
+    }
+
+    return left->modified == right->modified ? 0 : (left->modified > right->modified ? -1 : 1);
+}
+
+/** Orders the entries by download time, oldest first. */
+static int compare_by_oldest(const void *a, const void *b) {
+
+    const cache_entry_t *left  = a;
+    const cache_entry_t *right = b;
+
+    return left->modified == right->modified ? 0 : (left->modified < right->modified ? -1 : 1);
+}
+
+static bool remove_entry(const char *cache_dir, cache_entry_t *entry) {
+
+    char path_buf[CACHE_MAX_PATH];
+    snprintf(path_buf, sizeof(path_buf), "%s/%s", cache_dir, entry->name);
+
+    entry->removed = remove(path_buf) == 0;
+    return entry->removed;
+}
+
+/**
+ * @brief Delete the files the cache will never serve again, then the oldest ones above the size budget.
+ *
+ * When an image URL changes (new gamerpic, updated cover), the new version is
+ * downloaded under a new source hash and the previous one would otherwise
+ * stay on disk forever.
+ *
+ * @return Number of bytes freed; the number of deleted files is written to
+ *         @p out_removed. @p entries is reordered.
+ */
+static uint64_t compact_cache(const char *cache_dir, cache_entry_t *entries, size_t count, uint64_t total_bytes,
+                              size_t *out_removed) {
+
+    uint64_t freed   = 0;
+    size_t   removed = 0;
+
+    /* Superseded versions: keep the most recent file of each resource and size */
+    qsort(entries, count, sizeof(cache_entry_t), compare_by_key_then_newest);
+
+    for (size_t i = 1; i < count; i++) {
+        const cache_entry_t *previous = &entries[i - 1];
+        cache_entry_t       *entry    = &entries[i];
+
+        if (entry->key_length == 0 || entry->key_length != previous->key_length ||
+            strncmp(entry->name, previous->name, entry->key_length) != 0) {
+            continue;
+        }
+
+        if (remove_entry(cache_dir, entry)) {
+            freed += entry->size;
+            removed++;
+        }
+    }
+
+    /* Size budget: evict the oldest downloads */
+    if (total_bytes - freed > CACHE_MAX_BYTES) {
+        qsort(entries, count, sizeof(cache_entry_t), compare_by_oldest);
+
+        for (size_t i = 0; i < count && total_bytes - freed > CACHE_TARGET_BYTES; i++) {
+            if (!entries[i].removed && remove_entry(cache_dir, &entries[i])) {
+                freed += entries[i].size;
+                removed++;
+            }
+        }
+    }
+
+    *out_removed = removed;
+    return freed;
+}
+
+void cache_init(void) {
+
+    char cache_dir[CACHE_MAX_PATH] = {0};
+
+    if (!get_cache_dir(cache_dir, sizeof(cache_dir))) {
+        obs_log(LOG_ERROR, "[Cache] Failed to resolve the OBS module cache directory");
+        return;
+    }
+
+    os_dir_t *dir = os_opendir(cache_dir);
+
+    if (!dir) {
+        obs_log(LOG_WARNING, "[Cache] Failed to open '%s'", cache_dir);
+        return;
+    }
+
+    size_t discarded = 0;
+    char   path_buf[CACHE_MAX_PATH];
+
+    struct os_dirent *entry;
+
+    while ((entry = os_readdir(dir)) != NULL) {
+        if (entry->directory)
+            continue;
+
+        snprintf(path_buf, sizeof(path_buf), "%s/%s", cache_dir, entry->d_name);
+
+        struct stat st;
+        if (stat(path_buf, &st) != 0)
+            continue;
+
+        if (st.st_size == 0 || is_partial_file(entry->d_name)) {
+            if (remove(path_buf) == 0)
+                discarded++;
+        }
+    }
+
+    os_closedir(dir);
+
+    obs_log(LOG_INFO, "[Cache] Discarded %zu zero-byte or partial file(s)", discarded);
+}
+
+void cache_compact(void) {
+
+    char cache_dir[CACHE_MAX_PATH] = {0};
+
+    if (!get_cache_dir(cache_dir, sizeof(cache_dir))) {
+        return;
+    }
+
+    os_dir_t *dir = os_opendir(cache_dir);
+
+    if (!dir) {
+        obs_log(LOG_WARNING, "[Cache] Failed to open '%s'", cache_dir);
+        return;
+    }
+
+    size_t         file_count  = 0;
+    size_t         capacity    = 0;
+    size_t         stale       = 0;
+    uint64_t       total_bytes = 0;
+    uint64_t       stale_bytes = 0;
+    cache_entry_t *entries     = NULL;
+    char           path_buf[CACHE_MAX_PATH];
+
+    struct os_dirent *entry;
+
+    while ((entry = os_readdir(dir)) != NULL) {
+        /* The downloads run meanwhile: their temporary files are not cached files yet */
+        if (entry->directory || is_partial_file(entry->d_name))
+            continue;
+
+        snprintf(path_buf, sizeof(path_buf), "%s/%s", cache_dir, entry->d_name);
+
+        struct stat st;
+        if (stat(path_buf, &st) != 0 || st.st_size == 0)
+            continue;
+
+        bool         legacy     = false;
+        const size_t key_length = cache_key_length(entry->d_name, &legacy);
+
+        if (legacy) {
+            if (remove(path_buf) == 0) {
+                stale++;
+                stale_bytes += (uint64_t)st.st_size;
+            }
+            continue;
+        }
+
+        if (file_count == capacity) {
+            capacity = capacity ? capacity * 2 : 256;
+            entries  = brealloc(entries, capacity * sizeof(cache_entry_t));
+        }
+
+        entries[file_count] = (cache_entry_t){
+            .name       = bstrdup(entry->d_name),
+            .key_length = key_length,
+            .size       = (uint64_t)st.st_size,
+            .modified   = st.st_mtime,
+        };
+
+        file_count++;
+        total_bytes += (uint64_t)st.st_size;
+    }
+
+    os_closedir(dir);
+
+    size_t         evicted     = 0;
+    const uint64_t freed_bytes = compact_cache(cache_dir, entries, file_count, total_bytes, &evicted);
+
+    for (size_t i = 0; i < file_count; i++) {
+        bfree(entries[i].name);
+    }
+
+    bfree(entries);
+
+    obs_log(LOG_INFO,
+            "[Cache] %zu cached file(s), %llu KiB; evicted %zu superseded, unsized or old file(s) (%llu KiB)",
+            file_count - evicted,
+            (unsigned long long)((total_bytes - freed_bytes) / 1024),
+            stale + evicted,
+            (unsigned long long)((stale_bytes + freed_bytes) / 1024));
+}
+
+void cache_build_path(const char *type, const char *id, uint32_t size, const char *source, char *out_path,
+                      size_t path_size) {
 
     char     cache_dir[CACHE_MAX_PATH] = {0};
     uint32_t source_hash               = cache_hash_source(source);
@@ -79,24 +466,35 @@ void cache_build_path(const char *type, const char *id, const char *source, char
     if (sep)
         snprintf(out_path,
                  path_size,
-                 "%s%cobs_achievement_tracker_%s_%s_%08x.png",
+                 "%s%cobs_achievement_tracker_%s_%s_%upx_%08x.png",
                  cache_dir,
                  sep,
                  type,
                  id,
+                 size,
                  source_hash);
     else
-        snprintf(out_path, path_size, "%sobs_achievement_tracker_%s_%s_%08x.png", cache_dir, type, id, source_hash);
+        snprintf(out_path,
+                 path_size,
+                 "%sobs_achievement_tracker_%s_%s_%upx_%08x.png",
+                 cache_dir,
+                 type,
+                 id,
+                 size,
+                 source_hash);
 }
 
-bool cache_download(const char *url, const char *type, const char *id, char *out_path, size_t path_size) {
-
-    if (!url || url[0] == '\0') {
-        return false;
-    }
+/**
+ * @brief Download a resource to its cache file unless it is already there.
+ *
+ * @param url            URL to download, already sized by image_request_plan_sized_url().
+ * @param requested_size Size requested in @p url, or 0 if it is not sized.
+ */
+static bool download_to_cache(const char *url, const char *type, const char *id, uint32_t requested_size,
+                              char *out_path, size_t path_size) {
 
     char path_buf[1024];
-    cache_build_path(type, id, url, path_buf, sizeof(path_buf));
+    cache_build_path(type, id, requested_size, url, path_buf, sizeof(path_buf));
 
     if (path_buf[0] == '\0') {
         obs_log(LOG_ERROR, "[Cache] Failed to resolve the OBS module cache directory");
@@ -145,24 +543,35 @@ bool cache_download(const char *url, const char *type, const char *id, char *out
 
     if (size == 0) {
         obs_log(LOG_WARNING, "[Cache] Downloaded zero bytes from '%s'", download_url);
-        free_memory((void **)&data);
+        memory_free(data);
         return false;
     }
 
     /* Write to disk */
-    FILE *file = fopen(path_buf, "wb");
-    if (!file) {
-        obs_log(LOG_ERROR, "[Cache] Failed to create file '%s'", path_buf);
-        free_memory((void **)&data);
+    const bool saved = write_file_atomically(path_buf, data, size);
+    memory_free(data);
+
+    if (!saved) {
         return false;
     }
 
-    size_t written = fwrite(data, sizeof(uint8_t), size, file);
-    fflush(file);
-    fclose(file);
-    free_memory((void **)&data);
-
-    obs_log(LOG_INFO, "[Cache] Saved '%s' (%zu bytes written)", path_buf, written);
+    obs_log(LOG_INFO, "[Cache] Saved '%s' (%zu bytes written)", path_buf, size);
 
     return true;
 }
+
+bool cache_download(const char *url, const char *type, const char *id, char *out_path, size_t path_size) {
+
+    if (!url || url[0] == '\0') {
+        return false;
+    }
+
+    /* The size is part of the cache key: each bucket has its own file */
+    uint32_t   requested_size = 0;
+    char      *planned_url    = image_request_plan_sized_url(type, url, &requested_size);
+    const bool downloaded     = download_to_cache(planned_url, type, id, requested_size, out_path, path_size);
+
+    bfree(planned_url);
+
+    return downloaded;
+}
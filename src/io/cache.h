@@ -2,6 +2,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -17,27 +18,55 @@ extern "C" {
  * that the path convention is defined in exactly one place.
  *
  * Cache path format:
- *   `<OBS module config dir>/cache/obs_achievement_tracker_<type>_<id>_<source-hash>.png`
+ *   `<OBS module config dir>/cache/obs_achievement_tracker_<type>_<id>_<size>px_<source-hash>.png`
  *
  * Thread safety:
  *   All functions are safe to call from any thread. Two concurrent downloads
  *   targeting the same cache path are benign (last writer wins, file is
- *   atomically replaced).
+ *   atomically replaced). Downloads are written to a temporary file renamed
+ *   into place, so a cached file is never seen partially written.
  */
 
+/**
+ * @brief Prepare the cache directory for the session.
+ *
+ * Creates the cache directory if needed and scans it once, discarding the
+ * zero-byte files and the temporary files left behind by interrupted
+ * downloads so that later lookups only ever see usable entries.
+ *
+ * Meant to run on a background warm-up task before any download starts;
+ * every other function works without it.
+ */
+void cache_init(void);
+
+/**
+ * @brief Delete the cached files that are no longer worth keeping.
+ *
+ * The older versions of an image whose URL changed (same type, id and size)
+ * are deleted, as well as the files named before the size was part of the
+ * key; above 128 MiB, the oldest downloads are evicted down to 96 MiB.
+ * Evicted images are downloaded again when next needed.
+ *
+ * Not needed for the overlay to show up: meant to run on a background task
+ * once the previous session is restored. Safe while downloads are running.
+ */
+void cache_compact(void);
+
 /**
  * @brief Build the canonical cache file path for a given type, id, and source URL.
  *
  * Writes the path into @p out_path using the naming convention:
- * `<OBS module config dir>/cache/obs_achievement_tracker_<type>_<id>_<source-hash>.png`
+ * `<OBS module config dir>/cache/obs_achievement_tracker_<type>_<id>_<size>px_<source-hash>.png`
  *
  * @param type       Category suffix (e.g. "achievement_icon", "gamerpic", "game_cover").
  * @param id         Unique identifier for this resource.
+ * @param size       Size the image is requested at, or 0 if it is not resized.
  * @param source     Source URL used to derive a stable hash for cache busting.
  * @param out_path   Destination buffer for the resulting path.
  * @param path_size  Size of @p out_path in bytes.
  */
-void cache_build_path(const char *type, const char *id, const char *source, char *out_path, size_t path_size);
+void cache_build_path(const char *type, const char *id, uint32_t size, const char *source, char *out_path,
+                      size_t path_size);
 
 /**
  * @brief Download a remote resource to the local file cache (if not already cached).
@@ -45,6 +74,9 @@ void cache_build_path(const char *type, const char *id, const char *source, char
  * Builds the cache path from @p type, @p id, and @p url, checks whether the file
  * already exists on disk, and downloads it from @p url only when necessary.
  *
+ * Images served by a resizing CDN are requested at the display size of the
+ * sources of @p type (see image_request.h); the size is part of the cache key.
+ *
  * On success the resulting file path is written into @p out_path (if non-NULL)
  * so that the caller can use it immediately (e.g. for texture creation).
  *
@@ -0,0 +1,297 @@
+#include "io/image_request.h"
+
+#include <obs-module.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "util/thread_compat.h"
+
+/** Number of size buckets between IMAGE_REQUEST_MIN_SIZE and IMAGE_REQUEST_MAX_SIZE. */
+#define BUCKET_COUNT 5
+
+/** Maximum number of image types tracked. */
+#define MAX_IMAGE_TYPES 8
+
+/** Longest URL rewritten; longer ones are requested unchanged. */
+#define MAX_URL_LENGTH 4096
+
+/**
+ * @brief Displays declared for one image type, counted per bucket.
+ */
+typedef struct image_type_displays {
+    char type[32];
+    int  counts[BUCKET_COUNT];
+} image_type_displays_t;
+
+/** Hosts resizing the images according to the w and h query parameters. */
+static const char *const RESIZING_HOSTS[] = {
+    "images-eds-ssl.xboxlive.com",
+    "store-images.s-microsoft.com",
+};
+
+static pthread_mutex_t       g_mutex = PTHREAD_MUTEX_INITIALIZER;
+static image_type_displays_t g_displays[MAX_IMAGE_TYPES];
+static size_t                g_display_count = 0;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Private functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+static int bucket_index(uint32_t size) {
+
+    uint32_t bucket = IMAGE_REQUEST_MIN_SIZE;
+    int      index  = 0;
+
+    while (bucket < size && index < BUCKET_COUNT - 1) {
+        bucket *= 2;
+        index++;
+    }
+
+    return index;
+}
+
+/**
+ * @brief Find the displays of a type. Must be called with the mutex held.
+ *
+ * @param create Whether to add the type when it is not tracked yet.
+ */
+static image_type_displays_t *find_displays(const char *type, bool create) {
+
+    for (size_t i = 0; i < g_display_count; i++) {
+        if (strcmp(g_displays[i].type, type) == 0) {
+            return &g_displays[i];
+        }
+    }
+
+    if (!create || g_display_count == MAX_IMAGE_TYPES) {
+        return NULL;
+    }
+
+    image_type_displays_t *displays = &g_displays[g_display_count++];
+    memset(displays, 0, sizeof(*displays));
+    snprintf(displays->type, sizeof(displays->type), "%s", type);
+
+    return displays;
+}
+
+/**
+ * @brief Add @p delta displays to a bucket of a type. Must be called with the mutex held.
+ *
+ * @return Whether the type is tracked (false when the table is full).
+ */
+static bool count_display_locked(const char *type, int index, int delta) {
+
+    image_type_displays_t *displays = find_displays(type, delta > 0);
+
+    if (displays && displays->counts[index] + delta >= 0) {
+        displays->counts[index] += delta;
+    }
+
+    return displays != NULL;
+}
+
+static void update_display(const char *type, uint32_t width, uint32_t height, int delta) {
+
+    if (!type) {
+        return;
+    }
+
+    const int index = bucket_index(width > height ? width : height);
+
+    pthread_mutex_lock(&g_mutex);
+    count_display_locked(type, index, delta);
+    pthread_mutex_unlock(&g_mutex);
+}
+
+/**
+ * @brief Move the display of a source to the bucket of its current state. Must be called with the mutex held.
+ */
+static void sync_display_locked(image_request_display_t *display) {
+
+    const uint32_t size   = display->width > display->height ? display->width : display->height;
+    int            bucket = display->active && size > 0 ? bucket_index(size) : -1;
+
+    if (bucket == display->counted_bucket) {
+        return;
+    }
+
+    if (display->counted_bucket >= 0) {
+        count_display_locked(display->type, display->counted_bucket, -1);
+    }
+
+    if (bucket >= 0 && !count_display_locked(display->type, bucket, 1)) {
+        bucket = -1;
+    }
+
+    display->counted_bucket = bucket;
+}
+
+static bool is_resizing_host(const char *url) {
+
+    const char *scheme_end = strstr(url, "://");
+
+    if (!scheme_end) {
+        return false;
+    }
+
+    const char *host = scheme_end + 3;
+
+    for (size_t i = 0; i < sizeof(RESIZING_HOSTS) / sizeof(RESIZING_HOSTS[0]); i++) {
+        const size_t host_length = strlen(RESIZING_HOSTS[i]);
+
+        if (strncmp(host, RESIZING_HOSTS[i], host_length) == 0 &&
+            (host[host_length] == '/' || host[host_length] == '?' || host[host_length] == '\0')) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Whether a query parameter sets the width or the height.
+ */
+static bool is_size_parameter(const char *parameter, size_t length) {
+    return length >= 2 && (parameter[0] == 'w' || parameter[0] == 'h') && parameter[1] == '=';
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public API
+//  --------------------------------------------------------------------------------------------------------------------
+
+void image_request_display_init(image_request_display_t *display, const char *type, uint32_t width, uint32_t height) {
+
+    if (!display) {
+        return;
+    }
+
+    display->type           = type;
+    display->width          = width;
+    display->height         = height;
+    display->active         = false;
+    display->counted_bucket = -1;
+}
+
+void image_request_display_set_size(image_request_display_t *display, uint32_t width, uint32_t height) {
+
+    if (!display || !display->type || (display->width == width && display->height == height)) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_mutex);
+
+    display->width  = width;
+    display->height = height;
+    sync_display_locked(display);
+
+    pthread_mutex_unlock(&g_mutex);
+}
+
+void image_request_display_set_active(image_request_display_t *display, bool active) {
+
+    if (!display || !display->type) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_mutex);
+
+    display->active = active;
+    sync_display_locked(display);
+
+    pthread_mutex_unlock(&g_mutex);
+}
+
+void image_request_add_display(const char *type, uint32_t width, uint32_t height) {
+    update_display(type, width, height, 1);
+}
+
+void image_request_remove_display(const char *type, uint32_t width, uint32_t height) {
+    update_display(type, width, height, -1);
+}
+
+uint32_t image_request_bucket(uint32_t size) {
+    return (uint32_t)IMAGE_REQUEST_MIN_SIZE << bucket_index(size);
+}
+
+uint32_t image_request_get_size(const char *type) {
+
+    if (!type) {
+        return 0;
+    }
+
+    uint32_t size = 0;
+
+    pthread_mutex_lock(&g_mutex);
+
+    const image_type_displays_t *displays = find_displays(type, false);
+
+    for (int i = BUCKET_COUNT - 1; displays && i >= 0; i--) {
+        if (displays->counts[i] > 0) {
+            size = (uint32_t)IMAGE_REQUEST_MIN_SIZE << i;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&g_mutex);
+
+    return size;
+}
+
+char *image_request_plan_url(const char *type, const char *url) {
+    return image_request_plan_sized_url(type, url, NULL);
+}
+
+char *image_request_plan_sized_url(const char *type, const char *url, uint32_t *out_size) {
+
+    if (out_size) {
+        *out_size = 0;
+    }
+
+    if (!url) {
+        return NULL;
+    }
+
+    const uint32_t size = image_request_get_size(type);
+
+    if (size == 0 || !is_resizing_host(url) || strlen(url) >= MAX_URL_LENGTH) {
+        return bstrdup(url);
+    }
+
+    if (out_size) {
+        *out_size = size;
+    }
+
+    /* Copy the URL without its own size parameters, then append ours */
+    char        planned[MAX_URL_LENGTH + 32];
+    const char *query = strchr(url, '?');
+    size_t      used  = query ? (size_t)(query - url) : strlen(url);
+
+    memcpy(planned, url, used);
+
+    char separator = '?';
+
+    for (const char *parameter = query ? query + 1 : NULL; parameter && *parameter;) {
+        const char  *end    = strchr(parameter, '&');
+        const size_t length = end ? (size_t)(end - parameter) : strlen(parameter);
+
+        if (length > 0 && !is_size_parameter(parameter, length)) {
+            planned[used++] = separator;
+            memcpy(planned + used, parameter, length);
+            used += length;
+            separator = '&';
+        }
+
+        parameter = end ? end + 1 : NULL;
+    }
+
+    snprintf(planned + used, sizeof(planned) - used, "%cw=%u&h=%u", separator, size, size);
+
+    return bstrdup(planned);
+}
+
+void image_request_reset(void) {
+    pthread_mutex_lock(&g_mutex);
+    g_display_count = 0;
+    pthread_mutex_unlock(&g_mutex);
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file image_request.h
+ * @brief Picks the resolution at which the images are downloaded.
+ *
+ * The Xbox image CDNs resize on the fly when the URL carries `w`/`h` query
+ * parameters. Without them, gamerpics and covers come at full resolution
+ * (often 1080 px or more) to be drawn in a 200 px box: the download, the
+ * cache file, the PNG decode and the texture are all several times larger
+ * than what is displayed.
+ *
+ * The image sources declare their display size per image type; the requests
+ * for that type then ask for the largest size shown, rounded up to a few
+ * buckets so that the cached files stay shared between similar sizes.
+ * Images served by other hosts are requested unchanged.
+ *
+ * A source tracks its display with an @ref image_request_display_t: the size
+ * it is drawn at in the output (its own size scaled by the scene item
+ * transform), counted only while the source is in the program.
+ *
+ * Thread safety:
+ *   All functions may be called from any thread.
+ */
+
+/** Smallest size requested. The buckets double from there. */
+#define IMAGE_REQUEST_MIN_SIZE 100
+
+/** Largest size requested (5 buckets: 100, 200, 400, 800, 1600). */
+#define IMAGE_REQUEST_MAX_SIZE 1600
+
+/**
+ * @brief Display of one source instance, counted while it is active.
+ *
+ * Initialized by @ref image_request_display_init, then only updated through
+ * the image_request_display_* functions.
+ */
+typedef struct image_request_display {
+
+    /** Cache category of the images (e.g. "gamerpic"). */
+    const char *type;
+
+    /** Size the source is drawn at in the output, in pixels. */
+    uint32_t width;
+    uint32_t height;
+
+    /** Whether the source is in the program (OBS @c activate / @c deactivate). */
+    bool active;
+
+    /** Bucket the display is counted in, or -1 while it is not counted. */
+    int counted_bucket;
+
+} image_request_display_t;
+
+/**
+ * @brief Initialize the display of a source instance, inactive.
+ *
+ * @param display Display to initialize.
+ * @param type    Cache category of the images, a string that outlives the display.
+ * @param width   Initial display width, in pixels.
+ * @param height  Initial display height, in pixels.
+ */
+void image_request_display_init(image_request_display_t *display, const char *type, uint32_t width, uint32_t height);
+
+/**
+ * @brief Update the size a source is drawn at in the output.
+ *
+ * Meant to be called on every render: nothing is locked while the size is
+ * unchanged. Must not be called from several threads at once for the same
+ * display.
+ */
+void image_request_display_set_size(image_request_display_t *display, uint32_t width, uint32_t height);
+
+/**
+ * @brief Count the display while the source is in the program, and only then.
+ */
+void image_request_display_set_active(image_request_display_t *display, bool active);
+
+/**
+ * @brief Declare a display of a fixed size, counted until it is removed.
+ *
+ * Call @ref image_request_remove_display with the same values to withdraw it.
+ * The sources use an @ref image_request_display_t instead, which follows their
+ * output size and their activation.
+ *
+ * @param type   Cache category of the images (e.g. "gamerpic").
+ * @param width  Display width of the source, in pixels.
+ * @param height Display height of the source, in pixels.
+ */
+void image_request_add_display(const char *type, uint32_t width, uint32_t height);
+
+/**
+ * @brief Withdraw a display declared by @ref image_request_add_display.
+ */
+void image_request_remove_display(const char *type, uint32_t width, uint32_t height);
+
+/**
+ * @brief Round a display size up to its bucket.
+ *
+ * @return The smallest bucket not below @p size, clamped to
+ *         @ref IMAGE_REQUEST_MAX_SIZE.
+ */
+uint32_t image_request_bucket(uint32_t size);
+
+/**
+ * @brief Get the size requested for a type.
+ *
+ * @return The bucket of the largest side of the largest display of @p type,
+ *         or 0 if no source displays it.
+ */
+uint32_t image_request_get_size(const char *type);
+
+/**
+ * @brief Build the URL to download an image of a type.
+ *
+ * On the resizing CDNs, replaces any `w`/`h` parameters by the size returned
+ * by @ref image_request_get_size. Other URLs, and all the URLs of a type no
+ * source displays, are returned unchanged.
+ *
+ * @param type Cache category of the image.
+ * @param url  Image URL as returned by the service.
+ *
+ * @return Newly allocated URL (free with bfree()), or NULL if @p url is NULL.
+ */
+char *image_request_plan_url(const char *type, const char *url);
+
+/**
+ * @brief Same as @ref image_request_plan_url, also reporting the size requested.
+ *
+ * @param out_size Receives the size written in the URL, or 0 if the URL is
+ *                 returned unchanged. May be NULL.
+ */
+char *image_request_plan_sized_url(const char *type, const char *url, uint32_t *out_size);
+
+/**
+ * @brief Forget every declared display (used by the tests).
+ */
+void image_request_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,565 @@
+#include "io/snapshot.h"
+
+#include <obs-module.h>
+#include <diagnostics/log.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "common/memory.h"
+#include "util/thread_compat.h"
+
+/**
+ * @file snapshot.c
+ * @brief Binary encoding and persistence of the warm-start snapshot.
+ *
+ * Layout (all integers little-endian):
+ *
+ *   magic "ATSN" | u32 version | u32 source
+ *   u8 has_identity [ str name | str avatar_url | u32 score ]
+ *   u8 has_game     [ str id | str title | str console_name | str cover_url ]
+ *   str current_achievement_id
+ *   u32 count       { str id | str name | str description | str icon_url | str measured_progress
+ *                     | u8 is_secret | u32 value | i64 unlocked_timestamp | u32 source } * count
+ *   u32 fnv1a(all preceding bytes)
+ *
+ * Strings are a u32 byte length followed by the bytes (no terminator); the
+ * length SNAPSHOT_NULL_STRING encodes a NULL pointer.
+ */
+
+#define SNAPSHOT_FILE "achievements-tracker-snapshot.bin"
+#define SNAPSHOT_TEMPORARY_SUFFIX ".tmp"
+
+#define SNAPSHOT_MAGIC "ATSN"
+#define SNAPSHOT_VERSION 1u
+#define SNAPSHOT_NULL_STRING 0xFFFFFFFFu
+
+/** Upper bound on the number of achievements accepted when decoding. */
+#define SNAPSHOT_MAX_ACHIEVEMENTS 10000u
+
+/** Serializes snapshot_save() calls coming from different monitor threads. */
+static pthread_mutex_t g_save_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** Checksum of the last snapshot written by this process (0 = none). */
+static uint32_t g_last_saved_checksum = 0;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//	Encoding
+//  --------------------------------------------------------------------------------------------------------------------
+
+typedef struct snapshot_writer {
+    uint8_t *data;
+    size_t   size;
+    size_t   capacity;
+    bool     failed;
+} snapshot_writer_t;
+
+typedef struct snapshot_reader {
+    const uint8_t *data;
+    size_t         size;
+    size_t         offset;
+    bool           failed;
+} snapshot_reader_t;
+
+static uint32_t snapshot_checksum(const uint8_t *data, size_t size) {
+    /* FNV-1a 32-bit, same function the cache uses for its keys. */
+    uint32_t h = 2166136261u;
+
+    for (size_t i = 0; i < size; i++) {
+        h ^= (uint32_t)data[i];
+        h *= 16777619u;
+    }
+
+    return h;
+}
+
+static void write_bytes(snapshot_writer_t *writer, const void *bytes, size_t count) {
+
+    if (writer->failed) {
+        return;
+    }
+
+    if (writer->size + count > writer->capacity) {
+        size_t capacity = writer->capacity ? writer->capacity : 4096;
+
+        while (capacity < writer->size + count) {
+            capacity *= 2;
+        }
+
+        uint8_t *data = brealloc(writer->data, capacity);
+
+        if (!data) {
+            writer->failed = true;
+            return;
+        }
+
+        writer->data     = data;
+        writer->capacity = capacity;
+    }
+
+    memcpy(writer->data + writer->size, bytes, count);
+    writer->size += count;
+}
+
+static void write_u8(snapshot_writer_t *writer, uint8_t value) {
+    write_bytes(writer, &value, 1);
+}
+
+static void write_u32(snapshot_writer_t *writer, uint32_t value) {
+    const uint8_t bytes[4] = {
+        (uint8_t)(value),
+        (uint8_t)(value >> 8),
+        (uint8_t)(value >> 16),
+        (uint8_t)(value >> 24),
+    };
+    write_bytes(writer, bytes, sizeof(bytes));
+}
+
+static void write_i64(snapshot_writer_t *writer, int64_t value) {
+    const uint64_t bits = (uint64_t)value;
+    write_u32(writer, (uint32_t)(bits & 0xFFFFFFFFu));
+    write_u32(writer, (uint32_t)(bits >> 32));
+}
+
+static void write_string(snapshot_writer_t *writer, const char *value) {
+
+    if (!value) {
+        write_u32(writer, SNAPSHOT_NULL_STRING);
+        return;
+    }
+
+    const size_t length = strlen(value);
+    write_u32(writer, (uint32_t)length);
+    write_bytes(writer, value, length);
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//	Decoding
+//  --------------------------------------------------------------------------------------------------------------------
+
+static const uint8_t *read_bytes(snapshot_reader_t *reader, size_t count) {
+
+    if (reader->failed || count > reader->size - reader->offset) {
+        reader->failed = true;
+        return NULL;
+    }
+
+    const uint8_t *bytes = reader->data + reader->offset;
+    reader->offset += count;
+
+    return bytes;
+}
+
+static uint8_t read_u8(snapshot_reader_t *reader) {
+    const uint8_t *bytes = read_bytes(reader, 1);
+    return bytes ? bytes[0] : 0;
+}
+
+static uint32_t read_u32(snapshot_reader_t *reader) {
+    const uint8_t *bytes = read_bytes(reader, 4);
+
+    if (!bytes) {
+        return 0;
+    }
+
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+static int64_t read_i64(snapshot_reader_t *reader) {
+    const uint64_t low  = read_u32(reader);
+    const uint64_t high = read_u32(reader);
+    return (int64_t)(low | (high << 32));
+}
+
+static char *read_string(snapshot_reader_t *reader) {
+    const uint32_t length = read_u32(reader);
+
+    if (reader->failed || length == SNAPSHOT_NULL_STRING) {
+        return NULL;
+    }
+
+    const uint8_t *bytes = read_bytes(reader, length);
+
+    if (!bytes) {
+        return NULL;
+    }
+
+    char *value = bmalloc((size_t)length + 1);
+    memcpy(value, bytes, length);
+    value[length] = '\0';
+
+    return value;
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//	File helpers
+//  --------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Build the full path to the snapshot file.
+ *
+ * @return Newly allocated path (caller must bfree()), or NULL on failure.
+ */
+static char *get_snapshot_path(void) {
+    return obs_module_config_path(SNAPSHOT_FILE);
+}
+
+static bool write_file(const char *path, const uint8_t *data, size_t size) {
+
+    char temporary_path[1024];
+    snprintf(temporary_path, sizeof(temporary_path), "%s%s", path, SNAPSHOT_TEMPORARY_SUFFIX);
+
+    FILE *file = fopen(temporary_path, "wb");
+
+    if (!file) {
+        obs_log(LOG_WARNING, "[Snapshot] Failed to create '%s'", temporary_path);
+        return false;
+    }
+
+    const size_t written = fwrite(data, 1, size, file);
+    const bool   flushed = fflush(file) == 0;
+    fclose(file);
+
+    if (written != size || !flushed) {
+        obs_log(LOG_WARNING, "[Snapshot] Failed to write '%s'", temporary_path);
+        remove(temporary_path);
+        return false;
+    }
+
+#ifdef _WIN32
+    /* rename() does not replace an existing file on Windows. */
+    remove(path);
+#endif
+
+    if (rename(temporary_path, path) != 0) {
+        obs_log(LOG_WARNING, "[Snapshot] Failed to replace '%s'", path);
+        remove(temporary_path);
+        return false;
+    }
+
+    return true;
+}
+
+#ifndef _WIN32
+
+static snapshot_t *read_file(const char *path) {
+
+    const int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        return NULL;
+    }
+
+    struct stat st;
+
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return NULL;
+    }
+
+    const size_t size    = (size_t)st.st_size;
+    void        *mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (mapping == MAP_FAILED) {
+        return NULL;
+    }
+
+    snapshot_t *snapshot = snapshot_decode(mapping, size);
+    munmap(mapping, size);
+
+    return snapshot;
+}
+
+#else
+
+static snapshot_t *read_file(const char *path) {
+
+    FILE *file = fopen(path, "rb");
+
+    if (!file) {
+        return NULL;
+    }
+
+    snapshot_t *snapshot = NULL;
+    uint8_t    *data     = NULL;
+
+    if (fseek(file, 0, SEEK_END) != 0) {
+        goto cleanup;
+    }
+
+    const long size = ftell(file);
+
+    if (size <= 0 || fseek(file, 0, SEEK_SET) != 0) {
+        goto cleanup;
+    }
+
+    data = bmalloc((size_t)size);
+
+    if (fread(data, 1, (size_t)size, file) == (size_t)size) {
+        snapshot = snapshot_decode(data, (size_t)size);
+    }
+
+cleanup:
+    bfree(data);
+    fclose(file);
+
+    return snapshot;
+}
+
+#endif
+
+//  --------------------------------------------------------------------------------------------------------------------
+//	Public functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+uint8_t *snapshot_encode(const snapshot_t *snapshot, size_t *out_size) {
+
+    if (!snapshot || !out_size) {
+        return NULL;
+    }
+
+    snapshot_writer_t writer = {0};
+
+    write_bytes(&writer, SNAPSHOT_MAGIC, 4);
+    write_u32(&writer, SNAPSHOT_VERSION);
+    write_u32(&writer, (uint32_t)snapshot->source);
+
+    const identity_t *identity = snapshot->identity;
+    write_u8(&writer, identity ? 1 : 0);
+
+    if (identity) {
+        write_string(&writer, identity->name);
+        write_string(&writer, identity->avatar_url);
+        write_u32(&writer, identity->score);
+    }
+
+    const game_t *game = snapshot->game;
+    write_u8(&writer, game ? 1 : 0);
+
+    if (game) {
+        write_string(&writer, game->id);
+        write_string(&writer, game->title);
+        write_string(&writer, game->console_name);
+        write_string(&writer, game->cover_url);
+    }
+
+    write_string(&writer, snapshot->current_achievement_id);
+
+    write_u32(&writer, (uint32_t)count_achievements(snapshot->achievements));
+
+    for (const achievement_t *a = snapshot->achievements; a != NULL; a = a->next) {
+        write_string(&writer, a->id);
+        write_string(&writer, a->name);
+        write_string(&writer, a->description);
+        write_string(&writer, a->icon_url);
+        write_string(&writer, a->measured_progress);
+        write_u8(&writer, a->is_secret ? 1 : 0);
+        write_u32(&writer, (uint32_t)a->value);
+        write_i64(&writer, a->unlocked_timestamp);
+        write_u32(&writer, (uint32_t)a->source);
+    }
+
+    if (!writer.failed) {
+        write_u32(&writer, snapshot_checksum(writer.data, writer.size));
+    }
+
+    if (writer.failed) {
+        bfree(writer.data);
+        return NULL;
+    }
+
+    *out_size = writer.size;
+
+    return writer.data;
+}
+
+snapshot_t *snapshot_decode(const uint8_t *data, size_t size) {
+
+    /* Magic + version + source + flags + checksum is the smallest valid file. */
+    if (!data || size < 4 + 4 + 4 + 1 + 1 + 4 + 4 + 4) {
+        return NULL;
+    }
+
+    if (memcmp(data, SNAPSHOT_MAGIC, 4) != 0) {
+        return NULL;
+    }
+
+    snapshot_reader_t checksum_reader = {.data = data, .size = size, .offset = size - 4};
+
+    if (read_u32(&checksum_reader) != snapshot_checksum(data, size - 4)) {
+        obs_log(LOG_WARNING, "[Snapshot] Discarding snapshot with an invalid checksum");
+        return NULL;
+    }
+
+    /* Everything but the trailing checksum is payload. */
+    snapshot_reader_t reader = {.data = data, .size = size - 4, .offset = 4};
+
+    if (read_u32(&reader) != SNAPSHOT_VERSION) {
+        obs_log(LOG_INFO, "[Snapshot] Ignoring snapshot from another plugin version");
+        return NULL;
+    }
+
+    snapshot_t *snapshot = bzalloc(sizeof(snapshot_t));
+    snapshot->source     = (identity_source_t)read_u32(&reader);
+
+    if (read_u8(&reader)) {
+        identity_t *identity = bzalloc(sizeof(identity_t));
+        identity->source     = snapshot->source;
+        identity->name       = read_string(&reader);
+        identity->avatar_url = read_string(&reader);
+        identity->score      = read_u32(&reader);
+        snapshot->identity   = identity;
+    }
+
+    if (read_u8(&reader)) {
+        game_t *game       = alloc_game();
+        game->id           = read_string(&reader);
+        game->title        = read_string(&reader);
+        game->console_name = read_string(&reader);
+        game->cover_url    = read_string(&reader);
+        snapshot->game     = game;
+    }
+
+    snapshot->current_achievement_id = read_string(&reader);
+
+    const uint32_t count = read_u32(&reader);
+
+    if (count > SNAPSHOT_MAX_ACHIEVEMENTS) {
+        reader.failed = true;
+    }
+
+    achievement_t *previous = NULL;
+
+    for (uint32_t i = 0; i < count && !reader.failed; i++) {
+        achievement_t *a      = alloc_achievement();
+        a->id                 = read_string(&reader);
+        a->name               = read_string(&reader);
+        a->description        = read_string(&reader);
+        a->icon_url           = read_string(&reader);
+        a->measured_progress  = read_string(&reader);
+        a->is_secret          = read_u8(&reader) != 0;
+        a->value              = (int)read_u32(&reader);
+        a->unlocked_timestamp = read_i64(&reader);
+        a->source             = (achievement_source_t)read_u32(&reader);
+
+        if (previous) {
+            previous->next = a;
+        } else {
+            snapshot->achievements = a;
+        }
+        previous = a;
+    }
+
+    if (reader.failed || reader.offset != reader.size) {
+        obs_log(LOG_WARNING, "[Snapshot] Discarding malformed snapshot");
+        free_snapshot(&snapshot);
+        return NULL;
+    }
+
+    return snapshot;
+}
+
+bool snapshot_save(const snapshot_t *snapshot) {
+
+    size_t   size = 0;
+    uint8_t *data = snapshot_encode(snapshot, &size);
+
+    if (!data) {
+        return false;
+    }
+
+    char *path = get_snapshot_path();
+
+    if (!path) {
+        bfree(data);
+        return false;
+    }
+
+    /* The checksum covers the whole payload, so it doubles as a cheap way to
+     * skip rewriting a snapshot that has not changed. */
+    snapshot_reader_t checksum_reader = {.data = data, .size = size, .offset = size - 4};
+    const uint32_t    checksum        = read_u32(&checksum_reader);
+
+    bool saved = true;
+
+    pthread_mutex_lock(&g_save_mutex);
+
+    if (checksum != g_last_saved_checksum) {
+        saved = write_file(path, data, size);
+
+        if (saved) {
+            g_last_saved_checksum = checksum;
+            obs_log(LOG_DEBUG, "[Snapshot] Saved %zu bytes to '%s'", size, path);
+        }
+    }
+
+    pthread_mutex_unlock(&g_save_mutex);
+
+    bfree(path);
+    bfree(data);
+
+    return saved;
+}
+
+snapshot_t *snapshot_load(void) {
+
+    char *path = get_snapshot_path();
+
+    if (!path) {
+        return NULL;
+    }
+
+    snapshot_t *snapshot = read_file(path);
+
+    if (snapshot) {
+        obs_log(LOG_INFO,
+                "[Snapshot] Loaded snapshot of '%s' (%d achievements)",
+                snapshot->game && snapshot->game->title ? snapshot->game->title : "(no game)",
+                count_achievements(snapshot->achievements));
+    }
+
+    bfree(path);
+
+    return snapshot;
+}
+
+void snapshot_delete(void) {
+
+    char *path = get_snapshot_path();
+
+    if (!path) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_save_mutex);
+    remove(path);
+    g_last_saved_checksum = 0;
+    pthread_mutex_unlock(&g_save_mutex);
+
+    bfree(path);
+}
+
+void free_snapshot(snapshot_t **snapshot) {
+
+    if (!snapshot || !*snapshot) {
+        return;
+    }
+
+    snapshot_t *current = *snapshot;
+
+    free_identity_t(&current->identity);
+    free_game(&current->game);
+    free_achievement(&current->achievements);
+    free_memory((void **)&current->current_achievement_id);
+
+    bfree(current);
+    *snapshot = NULL;
+}
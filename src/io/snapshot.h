@@ -0,0 +1,119 @@
+#pragma once
+
+#include "common/achievement.h"
+#include "common/game.h"
+#include "common/identity.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file snapshot.h
+ * @brief Compact on-disk snapshot of the last displayed overlay state.
+ *
+ * The snapshot captures everything the sources need to render immediately at
+ * OBS launch, before any monitor has connected: the active identity (including
+ * its gamerscore), the current game, the generic achievements list and the
+ * achievement the display cycle was showing.
+ *
+ * The file is stored next to the persisted state:
+ *   `<OBS module config dir>/achievements-tracker-snapshot.bin`
+ *
+ * It uses a small length-prefixed binary encoding terminated by an FNV-1a
+ * checksum, so a torn or foreign file is rejected instead of half-loaded. On
+ * POSIX systems the file is memory-mapped when loaded; on Windows it is read
+ * in a single call.
+ *
+ * Thread safety:
+ *   @ref snapshot_save may be called from any monitor thread; concurrent calls
+ *   are serialized internally.
+ */
+
+/**
+ * @brief Overlay state captured by a snapshot.
+ *
+ * All members are owned by the snapshot and released by @ref free_snapshot.
+ */
+typedef struct snapshot {
+    /** Integration that produced @ref game (and @ref identity when present). */
+    identity_source_t source;
+    /** Active identity (name, avatar and score), or NULL. */
+    identity_t       *identity;
+    /** Game being played, or NULL. */
+    game_t           *game;
+    /** Generic achievements list for @ref game, or NULL. */
+    achievement_t    *achievements;
+    /** Identifier of the achievement the display cycle was showing, or NULL. */
+    char             *current_achievement_id;
+} snapshot_t;
+
+/**
+ * @brief Serialize a snapshot into a newly allocated buffer.
+ *
+ * @param snapshot Snapshot to encode. Must not be NULL.
+ * @param out_size Receives the size of the returned buffer in bytes.
+ *
+ * @return Newly allocated buffer (caller must bfree()), or NULL on failure.
+ */
+uint8_t *snapshot_encode(const snapshot_t *snapshot, size_t *out_size);
+
+/**
+ * @brief Deserialize a snapshot previously produced by @ref snapshot_encode.
+ *
+ * The input is fully validated (magic, version, bounds and checksum); any
+ * inconsistency makes the whole snapshot invalid.
+ *
+ * @param data Encoded bytes.
+ * @param size Number of bytes in @p data.
+ *
+ * @return Newly allocated snapshot (caller must free with @ref free_snapshot),
+ *         or NULL if @p data is not a valid snapshot.
+ */
+snapshot_t *snapshot_decode(const uint8_t *data, size_t size);
+
+/**
+ * @brief Persist a snapshot to the module config directory.
+ *
+ * The file is written to a temporary path and then renamed over the previous
+ * snapshot. Writing is skipped when the encoded bytes are identical to the
+ * last snapshot saved by this process.
+ *
+ * @param snapshot Snapshot to persist. Must not be NULL.
+ *
+ * @return true if the snapshot is on disk after this call; false on failure.
+ */
+bool snapshot_save(const snapshot_t *snapshot);
+
+/**
+ * @brief Load the snapshot persisted by a previous session.
+ *
+ * @return Newly allocated snapshot (caller must free with @ref free_snapshot),
+ *         or NULL if there is no valid snapshot on disk.
+ */
+snapshot_t *snapshot_load(void);
+
+/**
+ * @brief Delete the persisted snapshot, if any.
+ *
+ * Used when the overlay state is intentionally cleared (e.g. on sign-out) so
+ * that the next launch does not resurrect it.
+ */
+void snapshot_delete(void);
+
+/**
+ * @brief Free a snapshot and all the data it owns.
+ *
+ * Safe to call with NULL or with @c *snapshot == NULL.
+ *
+ * @param snapshot Address of the snapshot pointer; set to NULL on return.
+ */
+void free_snapshot(snapshot_t **snapshot);
+
+#ifdef __cplusplus
+}
+#endif
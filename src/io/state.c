@@ -6,6 +6,7 @@
 #include <util/platform.h>
 
 #include "crypto/crypto.h"
+#include "util/thread_compat.h"
 #include "util/uuid.h"
 
 #define PERSIST_FILE "achievements-tracker-state.json"
@@ -18,6 +19,7 @@
 #define DEVICE_SERIAL_NUMBER "device_serial_number"
 #define DEVICE_KEYS "device_keys"
 #define DEVICE_TOKEN "device_token"
+#define DEVICE_TOKEN_EXPIRY "device_token_expiry"
 #define DEVICE_CODE "device_code"
 
 #define SISU_TOKEN "sisu_token"
@@ -88,6 +90,13 @@
 /* Stored as int: 0 = not set (default: enabled), 1 = enabled, 2 = disabled. */
 #define CYCLE_AUTO_CYCLE_ENABLED       "cycle_auto_cycle_enabled"
 
+/* Keepalive and compression of the Xbox RTA websocket. */
+#define RTA_PING_INTERVAL              "rta_ping_interval"
+#define RTA_MAX_PING_INTERVAL          "rta_max_ping_interval"
+#define RTA_PONG_TIMEOUT               "rta_pong_timeout"
+/* Stored as int: 0 = not set (default: enabled), 1 = enabled, 2 = disabled. */
+#define RTA_COMPRESSION_ENABLED        "rta_compression_enabled"
+
 /* Global auto-visibility durations shared by all sources. */
 #define AUTO_VISIBILITY_SHARED_SHOW_DURATION "auto_visibility_shared_show_duration"
 #define AUTO_VISIBILITY_SHARED_HIDE_DURATION "auto_visibility_shared_hide_duration"
@@ -99,11 +108,27 @@
  * The state is backed by an OBS obs_data_t object loaded from and saved to
  * JSON on disk. Most getters return pointers to strings owned by this object.
  *
- * @note This must be initialized by calling io_load() before any state_* APIs
- *       are used.
+ * @note The state is loaded from disk on first access, either by io_load() or
+ *       by the first state_* API called. Always go through get_state().
  */
 static obs_data_t *g_state = NULL;
 
+/**
+ * @brief Guards @ref g_state, its saves and the save deferral flags.
+ *
+ * obs_data_t is not thread-safe, and the state is accessed from the OBS
+ * thread (source updates), the warm-up task and the monitor threads (token
+ * refreshes): every public function holds this mutex from its first access to
+ * the state to its save. The static helpers below expect it held.
+ */
+static pthread_mutex_t g_state_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** @brief When true, save_state() only records that the state changed. */
+static bool g_saves_deferred = false;
+
+/** @brief True when a save was skipped while saves were deferred. */
+static bool g_save_pending = false;
+
 /**
  * @brief Build the full path to the persisted JSON state file.
  *
@@ -170,7 +195,8 @@ static obs_data_t *load_state(void) {
  * @brief Persist the current state to disk.
  *
  * Uses obs_data_save_json_safe() to write the JSON file with a temporary file and
- * backup.
+ * backup. While saves are deferred (see io_defer_saves()), the write is
+ * postponed until io_commit_deferred_saves(). Called with g_state_mutex held.
  *
  * @param data State object to save. No-op if NULL.
  */
@@ -180,6 +206,11 @@ static void save_state(obs_data_t *data) {
         return;
     }
 
+    if (g_saves_deferred) {
+        g_save_pending = true;
+        return;
+    }
+
     char *path = get_state_path();
 
     if (!path) {
@@ -190,42 +221,85 @@ static void save_state(obs_data_t *data) {
     bfree(path);
 }
 
+/**
+ * @brief Return the in-memory state, loading it from disk on first access.
+ *
+ * Whichever thread touches the state first (a source registration reading its
+ * persisted configuration, or the background warm-up task) performs the load;
+ * any other thread waits for it on g_state_mutex, which the caller holds.
+ *
+ * @return The state object owned by this module, or NULL on allocation failure.
+ */
+static obs_data_t *get_state(void) {
+
+    if (!g_state) {
+        g_state = load_state();
+    }
+
+    return g_state;
+}
+
 void io_load(void) {
-    g_state = load_state();
+    pthread_mutex_lock(&g_state_mutex);
+    get_state();
+    pthread_mutex_unlock(&g_state_mutex);
+}
 
-    /* Read values */
-    const char *token     = obs_data_get_string(g_state, "oauth_token");
-    int64_t     last_sync = obs_data_get_int(g_state, "last_sync_unix");
+void io_defer_saves(void) {
+    pthread_mutex_lock(&g_state_mutex);
+    g_saves_deferred = true;
+    pthread_mutex_unlock(&g_state_mutex);
+}
+
+void io_commit_deferred_saves(void) {
+    pthread_mutex_lock(&g_state_mutex);
+
+    const bool pending = g_save_pending;
+    g_saves_deferred   = false;
+    g_save_pending     = false;
 
-    (void)token;
-    (void)last_sync;
+    if (pending) {
+        save_state(get_state());
+    }
+
+    pthread_mutex_unlock(&g_state_mutex);
 }
 
 void io_cleanup(void) {
+    io_commit_deferred_saves();
+
+    pthread_mutex_lock(&g_state_mutex);
+
     if (g_state) {
         obs_data_release(g_state);
         g_state = NULL;
     }
+
+    pthread_mutex_unlock(&g_state_mutex);
 }
 
 void state_clear(void) {
+    pthread_mutex_lock(&g_state_mutex);
+
     /* Considering how sensitive the Xbox live API appears, let's always keep the UUID / Serial / Keys constant */
     /*obs_data_set_string(g_state, DEVICE_UUID, "");*/
     /*obs_data_set_string(g_state, DEVICE_SERIAL_NUMBER, "");*/
     /*obs_data_set_string(g_state, DEVICE_KEYS, "");*/
 
-    obs_data_set_string(g_state, DEVICE_CODE, "");
-    obs_data_set_string(g_state, USER_ACCESS_TOKEN, "");
-    obs_data_set_int(g_state, USER_ACCESS_TOKEN_EXPIRY, 0);
-    obs_data_set_string(g_state, USER_REFRESH_TOKEN, "");
-    obs_data_set_string(g_state, XBOX_TOKEN_EXPIRY, "");
-    obs_data_set_string(g_state, DEVICE_TOKEN, "");
-    obs_data_set_string(g_state, XBOX_IDENTITY_GTG, "");
-    obs_data_set_string(g_state, XBOX_IDENTITY_UHS, "");
-    obs_data_set_string(g_state, XBOX_IDENTITY_ID, "");
-    obs_data_set_string(g_state, XBOX_TOKEN, "");
-    obs_data_set_string(g_state, XBOX_TOKEN_EXPIRY, "");
-    save_state(g_state);
+    obs_data_set_string(get_state(), DEVICE_CODE, "");
+    obs_data_set_string(get_state(), USER_ACCESS_TOKEN, "");
+    obs_data_set_int(get_state(), USER_ACCESS_TOKEN_EXPIRY, 0);
+    obs_data_set_string(get_state(), USER_REFRESH_TOKEN, "");
+    obs_data_set_string(get_state(), XBOX_TOKEN_EXPIRY, "");
+    obs_data_set_string(get_state(), DEVICE_TOKEN, "");
+    obs_data_set_string(get_state(), XBOX_IDENTITY_GTG, "");
+    obs_data_set_string(get_state(), XBOX_IDENTITY_UHS, "");
+    obs_data_set_string(get_state(), XBOX_IDENTITY_ID, "");
+    obs_data_set_string(get_state(), XBOX_TOKEN, "");
+    obs_data_set_string(get_state(), XBOX_TOKEN_EXPIRY, "");
+    save_state(get_state());
+
+    pthread_mutex_unlock(&g_state_mutex);
 }
 
 /**
@@ -238,11 +312,11 @@ static const char *create_device_uuid() {
     char new_device_uuid[37];
     uuid_get_random(new_device_uuid);
 
-    obs_data_set_string(g_state, DEVICE_UUID, new_device_uuid);
-    save_state(g_state);
+    obs_data_set_string(get_state(), DEVICE_UUID, new_device_uuid);
+    save_state(get_state());
 
     /* Retrieves it from the state */
-    return obs_data_get_string(g_state, DEVICE_UUID);
+    return obs_data_get_string(get_state(), DEVICE_UUID);
 }
 
 /**
@@ -255,11 +329,11 @@ static const char *create_device_serial_number() {
     char new_device_serial_number[37];
     uuid_get_random(new_device_serial_number);
 
-    obs_data_set_string(g_state, DEVICE_SERIAL_NUMBER, new_device_serial_number);
-    save_state(g_state);
+    obs_data_set_string(get_state(), DEVICE_SERIAL_NUMBER, new_device_serial_number);
+    save_state(get_state());
 
     /* Retrieves it from the state */
-    return obs_data_get_string(g_state, DEVICE_SERIAL_NUMBER);
+    return obs_data_get_string(get_state(), DEVICE_SERIAL_NUMBER);
 }
 
 /**
@@ -276,24 +350,26 @@ static const char *create_device_keys() {
 
     char *serialized_keys = crypto_to_string(device_key, true);
 
-    obs_data_set_string(g_state, DEVICE_KEYS, serialized_keys);
-    save_state(g_state);
+    obs_data_set_string(get_state(), DEVICE_KEYS, serialized_keys);
+    save_state(get_state());
 
     bfree(serialized_keys);
     EVP_PKEY_free(device_key);
 
     /* Retrieves it from the state */
-    return obs_data_get_string(g_state, DEVICE_KEYS);
+    return obs_data_get_string(get_state(), DEVICE_KEYS);
 }
 
 device_t *state_get_device(void) {
 
+    pthread_mutex_lock(&g_state_mutex);
+
     /* Retrieves the device UUID & serial number */
-    const char *device_uuid          = obs_data_get_string(g_state, DEVICE_UUID);
-    const char *device_serial_number = obs_data_get_string(g_state, DEVICE_SERIAL_NUMBER);
+    const char *device_uuid          = obs_data_get_string(get_state(), DEVICE_UUID);
+    const char *device_serial_number = obs_data_get_string(get_state(), DEVICE_SERIAL_NUMBER);
 
     /* Retrieves the device's public & private keys */
-    const char *device_keys = obs_data_get_string(g_state, DEVICE_KEYS);
+    const char *device_keys = obs_data_get_string(get_state(), DEVICE_KEYS);
 
     if (!device_uuid || strlen(device_uuid) == 0) {
         obs_log(LOG_INFO, "No device UUID found. Creating new one");
@@ -314,6 +390,7 @@ device_t *state_get_device(void) {
 
     if (!device_evp_pkeys) {
         obs_log(LOG_ERROR, "Could not load device keys from state");
+        pthread_mutex_unlock(&g_state_mutex);
         return NULL;
     }
 
@@ -322,46 +399,68 @@ device_t *state_get_device(void) {
     device->serial_number = bstrdup(device_serial_number);
     device->keys          = device_evp_pkeys;
 
+    pthread_mutex_unlock(&g_state_mutex);
+
     return device;
 }
 
 void state_set_device_token(const token_t *device_token) {
-    obs_data_set_string(g_state, DEVICE_TOKEN, device_token->value);
-    save_state(g_state);
+    pthread_mutex_lock(&g_state_mutex);
+
+    obs_data_set_string(get_state(), DEVICE_TOKEN, device_token->value);
+    obs_data_set_int(get_state(), DEVICE_TOKEN_EXPIRY, device_token->expires);
+    save_state(get_state());
+
+    pthread_mutex_unlock(&g_state_mutex);
 }
 
 token_t *state_get_device_token(void) {
 
-    const char *device_token = obs_data_get_string(g_state, DEVICE_TOKEN);
+    pthread_mutex_lock(&g_state_mutex);
+
+    const char *device_token = obs_data_get_string(get_state(), DEVICE_TOKEN);
 
     if (!device_token || strlen(device_token) == 0) {
         obs_log(LOG_INFO, "No device token found in the cache");
+        pthread_mutex_unlock(&g_state_mutex);
         return NULL;
     }
 
     token_t *token = bzalloc(sizeof(token_t));
     token->value   = bstrdup(device_token);
+    token->expires = obs_data_get_int(get_state(), DEVICE_TOKEN_EXPIRY);
+
+    pthread_mutex_unlock(&g_state_mutex);
 
     return token;
 }
 
 void state_set_sisu_token(const token_t *sisu_token) {
-    obs_data_set_string(g_state, SISU_TOKEN, sisu_token->value);
-    save_state(g_state);
+    pthread_mutex_lock(&g_state_mutex);
+
+    obs_data_set_string(get_state(), SISU_TOKEN, sisu_token->value);
+    save_state(get_state());
+
+    pthread_mutex_unlock(&g_state_mutex);
 }
 
 token_t *state_get_sisu_token(void) {
 
-    const char *sisu_token = obs_data_get_string(g_state, SISU_TOKEN);
+    pthread_mutex_lock(&g_state_mutex);
+
+    const char *sisu_token = obs_data_get_string(get_state(), SISU_TOKEN);
 
     if (!sisu_token || strlen(sisu_token) == 0) {
         obs_log(LOG_INFO, "No sisu token found in the cache");
+        pthread_mutex_unlock(&g_state_mutex);
         return NULL;
     }
 
     token_t *token = bzalloc(sizeof(token_t));
     token->value   = bstrdup(sisu_token);
 
+    pthread_mutex_unlock(&g_state_mutex);
+
     return token;
 }
 
@@ -371,23 +470,34 @@ void state_set_user_token(const char *device_code, const token_t *user_token, co
         return;
     }
 
-    obs_data_set_string(g_state, DEVICE_CODE, device_code);
-    obs_data_set_string(g_state, USER_ACCESS_TOKEN, user_token->value);
-    obs_data_set_int(g_state, USER_ACCESS_TOKEN_EXPIRY, user_token->expires);
-    obs_data_set_string(g_state, USER_REFRESH_TOKEN, refresh_token->value);
-    save_state(g_state);
+    pthread_mutex_lock(&g_state_mutex);
+
+    obs_data_set_string(get_state(), DEVICE_CODE, device_code);
+    obs_data_set_string(get_state(), USER_ACCESS_TOKEN, user_token->value);
+    obs_data_set_int(get_state(), USER_ACCESS_TOKEN_EXPIRY, user_token->expires);
+    obs_data_set_string(get_state(), USER_REFRESH_TOKEN, refresh_token->value);
+    save_state(get_state());
+
+    pthread_mutex_unlock(&g_state_mutex);
 }
 
 char *state_get_device_code(void) {
 
-    const char *device_code = obs_data_get_string(g_state, DEVICE_CODE);
+    pthread_mutex_lock(&g_state_mutex);
+
+    const char *device_code = obs_data_get_string(get_state(), DEVICE_CODE);
 
     if (!device_code || strlen(device_code) == 0) {
         obs_log(LOG_INFO, "No device code found in the cache");
+        pthread_mutex_unlock(&g_state_mutex);
         return NULL;
     }
 
-    return bstrdup(device_code);
+    char *copy = bstrdup(device_code);
+
+    pthread_mutex_unlock(&g_state_mutex);
+
+    return copy;
 }
 
 void state_set_gamerscore_configuration(const gamerscore_configuration_t *gamerscore_configuration) {
@@ -396,41 +506,47 @@ void state_set_gamerscore_configuration(const gamerscore_configuration_t *gamers
         return;
     }
 
-    obs_data_set_int(g_state, GAMERSCORE_CONFIGURATION_TOP_COLOR, gamerscore_configuration->top_color);
-    obs_data_set_int(g_state, GAMERSCORE_CONFIGURATION_BOTTOM_COLOR, gamerscore_configuration->bottom_color);
-    obs_data_set_int(g_state, GAMERSCORE_CONFIGURATION_SIZE, gamerscore_configuration->font_size);
-    obs_data_set_string(g_state, GAMERSCORE_CONFIGURATION_FONT_FACE, gamerscore_configuration->font_face);
-    obs_data_set_string(g_state, GAMERSCORE_CONFIGURATION_FONT_STYLE, gamerscore_configuration->font_style);
-    obs_data_set_bool(g_state,
+    pthread_mutex_lock(&g_state_mutex);
+
+    obs_data_set_int(get_state(), GAMERSCORE_CONFIGURATION_TOP_COLOR, gamerscore_configuration->top_color);
+    obs_data_set_int(get_state(), GAMERSCORE_CONFIGURATION_BOTTOM_COLOR, gamerscore_configuration->bottom_color);
+    obs_data_set_int(get_state(), GAMERSCORE_CONFIGURATION_SIZE, gamerscore_configuration->font_size);
+    obs_data_set_string(get_state(), GAMERSCORE_CONFIGURATION_FONT_FACE, gamerscore_configuration->font_face);
+    obs_data_set_string(get_state(), GAMERSCORE_CONFIGURATION_FONT_STYLE, gamerscore_configuration->font_style);
+    obs_data_set_bool(get_state(),
                       GAMERSCORE_CONFIGURATION_AUTO_VISIBILITY_ENABLED,
                       gamerscore_configuration->auto_visibility.enabled);
-    obs_data_set_double(g_state,
+    obs_data_set_double(get_state(),
                         GAMERSCORE_CONFIGURATION_AUTO_VISIBILITY_SHOW_DURATION,
                         gamerscore_configuration->auto_visibility.show_duration);
-    obs_data_set_double(g_state,
+    obs_data_set_double(get_state(),
                         GAMERSCORE_CONFIGURATION_AUTO_VISIBILITY_HIDE_DURATION,
                         gamerscore_configuration->auto_visibility.hide_duration);
-    obs_data_set_double(g_state,
+    obs_data_set_double(get_state(),
                         GAMERSCORE_CONFIGURATION_AUTO_VISIBILITY_FADE_DURATION,
                         gamerscore_configuration->auto_visibility.fade_duration);
 
-    save_state(g_state);
+    save_state(get_state());
+
+    pthread_mutex_unlock(&g_state_mutex);
 }
 
 gamerscore_configuration_t *state_get_gamerscore_configuration() {
 
-    uint32_t    top_color               = (uint32_t)obs_data_get_int(g_state, GAMERSCORE_CONFIGURATION_TOP_COLOR);
-    uint32_t    bottom_color            = (uint32_t)obs_data_get_int(g_state, GAMERSCORE_CONFIGURATION_BOTTOM_COLOR);
-    uint32_t    size                    = (uint32_t)obs_data_get_int(g_state, GAMERSCORE_CONFIGURATION_SIZE);
-    const char *font_face               = obs_data_get_string(g_state, GAMERSCORE_CONFIGURATION_FONT_FACE);
-    const char *font_style              = obs_data_get_string(g_state, GAMERSCORE_CONFIGURATION_FONT_STYLE);
-    bool        auto_visibility_enabled = obs_data_get_bool(g_state, GAMERSCORE_CONFIGURATION_AUTO_VISIBILITY_ENABLED);
+    pthread_mutex_lock(&g_state_mutex);
+
+    uint32_t    top_color               = (uint32_t)obs_data_get_int(get_state(), GAMERSCORE_CONFIGURATION_TOP_COLOR);
+    uint32_t    bottom_color            = (uint32_t)obs_data_get_int(get_state(), GAMERSCORE_CONFIGURATION_BOTTOM_COLOR);
+    uint32_t    size                    = (uint32_t)obs_data_get_int(get_state(), GAMERSCORE_CONFIGURATION_SIZE);
+    const char *font_face               = obs_data_get_string(get_state(), GAMERSCORE_CONFIGURATION_FONT_FACE);
+    const char *font_style              = obs_data_get_string(get_state(), GAMERSCORE_CONFIGURATION_FONT_STYLE);
+    bool        auto_visibility_enabled = obs_data_get_bool(get_state(), GAMERSCORE_CONFIGURATION_AUTO_VISIBILITY_ENABLED);
     float       auto_visibility_show_duration =
-        (float)obs_data_get_double(g_state, GAMERSCORE_CONFIGURATION_AUTO_VISIBILITY_SHOW_DURATION);
+        (float)obs_data_get_double(get_state(), GAMERSCORE_CONFIGURATION_AUTO_VISIBILITY_SHOW_DURATION);
     float auto_visibility_hide_duration =
-        (float)obs_data_get_double(g_state, GAMERSCORE_CONFIGURATION_AUTO_VISIBILITY_HIDE_DURATION);
+        (float)obs_data_get_double(get_state(), GAMERSCORE_CONFIGURATION_AUTO_VISIBILITY_HIDE_DURATION);
     float auto_visibility_fade_duration =
-        (float)obs_data_get_double(g_state, GAMERSCORE_CONFIGURATION_AUTO_VISIBILITY_FADE_DURATION);
+        (float)obs_data_get_double(get_state(), GAMERSCORE_CONFIGURATION_AUTO_VISIBILITY_FADE_DURATION);
 
     gamerscore_configuration_t *gamerscore_configuration = bzalloc(sizeof(gamerscore_configuration_t));
 
@@ -450,6 +566,8 @@ gamerscore_configuration_t *state_get_gamerscore_configuration() {
                                                                   ? auto_visibility_fade_duration
                                                                   : AUTO_VISIBILITY_DEFAULT_SHARED_FADE_DURATION;
 
+    pthread_mutex_unlock(&g_state_mutex);
+
     return gamerscore_configuration;
 }
 
@@ -459,39 +577,45 @@ void state_set_gamertag_configuration(const gamertag_configuration_t *configurat
         return;
     }
 
-    obs_data_set_int(g_state, GAMERTAG_CONFIGURATION_TOP_COLOR, configuration->top_color);
-    obs_data_set_int(g_state, GAMERTAG_CONFIGURATION_BOTTOM_COLOR, configuration->bottom_color);
-    obs_data_set_int(g_state, GAMERTAG_CONFIGURATION_SIZE, configuration->font_size);
-    obs_data_set_string(g_state, GAMERTAG_CONFIGURATION_FONT_FACE, configuration->font_face);
-    obs_data_set_string(g_state, GAMERTAG_CONFIGURATION_FONT_STYLE, configuration->font_style);
-    obs_data_set_bool(g_state, GAMERTAG_CONFIGURATION_AUTO_VISIBILITY_ENABLED, configuration->auto_visibility.enabled);
-    obs_data_set_double(g_state,
+    pthread_mutex_lock(&g_state_mutex);
+
+    obs_data_set_int(get_state(), GAMERTAG_CONFIGURATION_TOP_COLOR, configuration->top_color);
+    obs_data_set_int(get_state(), GAMERTAG_CONFIGURATION_BOTTOM_COLOR, configuration->bottom_color);
+    obs_data_set_int(get_state(), GAMERTAG_CONFIGURATION_SIZE, configuration->font_size);
+    obs_data_set_string(get_state(), GAMERTAG_CONFIGURATION_FONT_FACE, configuration->font_face);
+    obs_data_set_string(get_state(), GAMERTAG_CONFIGURATION_FONT_STYLE, configuration->font_style);
+    obs_data_set_bool(get_state(), GAMERTAG_CONFIGURATION_AUTO_VISIBILITY_ENABLED, configuration->auto_visibility.enabled);
+    obs_data_set_double(get_state(),
                         GAMERTAG_CONFIGURATION_AUTO_VISIBILITY_SHOW_DURATION,
                         configuration->auto_visibility.show_duration);
-    obs_data_set_double(g_state,
+    obs_data_set_double(get_state(),
                         GAMERTAG_CONFIGURATION_AUTO_VISIBILITY_HIDE_DURATION,
                         configuration->auto_visibility.hide_duration);
-    obs_data_set_double(g_state,
+    obs_data_set_double(get_state(),
                         GAMERTAG_CONFIGURATION_AUTO_VISIBILITY_FADE_DURATION,
                         configuration->auto_visibility.fade_duration);
 
-    save_state(g_state);
+    save_state(get_state());
+
+    pthread_mutex_unlock(&g_state_mutex);
 }
 
 gamertag_configuration_t *state_get_gamertag_configuration() {
 
-    uint32_t    top_color               = (uint32_t)obs_data_get_int(g_state, GAMERTAG_CONFIGURATION_TOP_COLOR);
-    uint32_t    bottom_color            = (uint32_t)obs_data_get_int(g_state, GAMERTAG_CONFIGURATION_BOTTOM_COLOR);
-    uint32_t    size                    = (uint32_t)obs_data_get_int(g_state, GAMERTAG_CONFIGURATION_SIZE);
-    const char *font_face               = obs_data_get_string(g_state, GAMERTAG_CONFIGURATION_FONT_FACE);
-    const char *font_style              = obs_data_get_string(g_state, GAMERTAG_CONFIGURATION_FONT_STYLE);
-    bool        auto_visibility_enabled = obs_data_get_bool(g_state, GAMERTAG_CONFIGURATION_AUTO_VISIBILITY_ENABLED);
+    pthread_mutex_lock(&g_state_mutex);
+
+    uint32_t    top_color               = (uint32_t)obs_data_get_int(get_state(), GAMERTAG_CONFIGURATION_TOP_COLOR);
+    uint32_t    bottom_color            = (uint32_t)obs_data_get_int(get_state(), GAMERTAG_CONFIGURATION_BOTTOM_COLOR);
+    uint32_t    size                    = (uint32_t)obs_data_get_int(get_state(), GAMERTAG_CONFIGURATION_SIZE);
+    const char *font_face               = obs_data_get_string(get_state(), GAMERTAG_CONFIGURATION_FONT_FACE);
+    const char *font_style              = obs_data_get_string(get_state(), GAMERTAG_CONFIGURATION_FONT_STYLE);
+    bool        auto_visibility_enabled = obs_data_get_bool(get_state(), GAMERTAG_CONFIGURATION_AUTO_VISIBILITY_ENABLED);
     float       auto_visibility_show_duration =
-        (float)obs_data_get_double(g_state, GAMERTAG_CONFIGURATION_AUTO_VISIBILITY_SHOW_DURATION);
+        (float)obs_data_get_double(get_state(), GAMERTAG_CONFIGURATION_AUTO_VISIBILITY_SHOW_DURATION);
     float auto_visibility_hide_duration =
-        (float)obs_data_get_double(g_state, GAMERTAG_CONFIGURATION_AUTO_VISIBILITY_HIDE_DURATION);
+        (float)obs_data_get_double(get_state(), GAMERTAG_CONFIGURATION_AUTO_VISIBILITY_HIDE_DURATION);
     float auto_visibility_fade_duration =
-        (float)obs_data_get_double(g_state, GAMERTAG_CONFIGURATION_AUTO_VISIBILITY_FADE_DURATION);
+        (float)obs_data_get_double(get_state(), GAMERTAG_CONFIGURATION_AUTO_VISIBILITY_FADE_DURATION);
 
     gamertag_configuration_t *configuration = bzalloc(sizeof(gamertag_configuration_t));
 
@@ -511,6 +635,8 @@ gamertag_configuration_t *state_get_gamertag_configuration() {
                                                        ? auto_visibility_fade_duration
                                                        : AUTO_VISIBILITY_DEFAULT_SHARED_FADE_DURATION;
 
+    pthread_mutex_unlock(&g_state_mutex);
+
     return configuration;
 }
 
@@ -520,50 +646,56 @@ void state_set_achievement_name_configuration(const achievement_name_configurati
         return;
     }
 
-    obs_data_set_int(g_state, ACHIEVEMENT_NAME_CONFIGURATION_ACTIVE_TOP_COLOR, configuration->active_top_color);
-    obs_data_set_int(g_state, ACHIEVEMENT_NAME_CONFIGURATION_ACTIVE_BOTTOM_COLOR, configuration->active_bottom_color);
-    obs_data_set_int(g_state, ACHIEVEMENT_NAME_CONFIGURATION_INACTIVE_TOP_COLOR, configuration->inactive_top_color);
-    obs_data_set_int(g_state,
+    pthread_mutex_lock(&g_state_mutex);
+
+    obs_data_set_int(get_state(), ACHIEVEMENT_NAME_CONFIGURATION_ACTIVE_TOP_COLOR, configuration->active_top_color);
+    obs_data_set_int(get_state(), ACHIEVEMENT_NAME_CONFIGURATION_ACTIVE_BOTTOM_COLOR, configuration->active_bottom_color);
+    obs_data_set_int(get_state(), ACHIEVEMENT_NAME_CONFIGURATION_INACTIVE_TOP_COLOR, configuration->inactive_top_color);
+    obs_data_set_int(get_state(),
                      ACHIEVEMENT_NAME_CONFIGURATION_INACTIVE_BOTTOM_COLOR,
                      configuration->inactive_bottom_color);
-    obs_data_set_int(g_state, ACHIEVEMENT_NAME_CONFIGURATION_SIZE, configuration->font_size);
-    obs_data_set_string(g_state, ACHIEVEMENT_NAME_CONFIGURATION_FONT_FACE, configuration->font_face);
-    obs_data_set_string(g_state, ACHIEVEMENT_NAME_CONFIGURATION_FONT_STYLE, configuration->font_style);
-    obs_data_set_bool(g_state,
+    obs_data_set_int(get_state(), ACHIEVEMENT_NAME_CONFIGURATION_SIZE, configuration->font_size);
+    obs_data_set_string(get_state(), ACHIEVEMENT_NAME_CONFIGURATION_FONT_FACE, configuration->font_face);
+    obs_data_set_string(get_state(), ACHIEVEMENT_NAME_CONFIGURATION_FONT_STYLE, configuration->font_style);
+    obs_data_set_bool(get_state(),
                       ACHIEVEMENT_NAME_CONFIGURATION_AUTO_VISIBILITY_ENABLED,
                       configuration->auto_visibility.enabled);
-    obs_data_set_double(g_state,
+    obs_data_set_double(get_state(),
                         ACHIEVEMENT_NAME_CONFIGURATION_AUTO_VISIBILITY_SHOW_DURATION,
                         configuration->auto_visibility.show_duration);
-    obs_data_set_double(g_state,
+    obs_data_set_double(get_state(),
                         ACHIEVEMENT_NAME_CONFIGURATION_AUTO_VISIBILITY_HIDE_DURATION,
                         configuration->auto_visibility.hide_duration);
-    obs_data_set_double(g_state,
+    obs_data_set_double(get_state(),
                         ACHIEVEMENT_NAME_CONFIGURATION_AUTO_VISIBILITY_FADE_DURATION,
                         configuration->auto_visibility.fade_duration);
 
-    save_state(g_state);
+    save_state(get_state());
+
+    pthread_mutex_unlock(&g_state_mutex);
 }
 
 achievement_name_configuration_t *state_get_achievement_name_configuration() {
 
-    uint32_t active_top_color = (uint32_t)obs_data_get_int(g_state, ACHIEVEMENT_NAME_CONFIGURATION_ACTIVE_TOP_COLOR);
+    pthread_mutex_lock(&g_state_mutex);
+
+    uint32_t active_top_color = (uint32_t)obs_data_get_int(get_state(), ACHIEVEMENT_NAME_CONFIGURATION_ACTIVE_TOP_COLOR);
     uint32_t active_bottom_color =
-        (uint32_t)obs_data_get_int(g_state, ACHIEVEMENT_NAME_CONFIGURATION_ACTIVE_BOTTOM_COLOR);
+        (uint32_t)obs_data_get_int(get_state(), ACHIEVEMENT_NAME_CONFIGURATION_ACTIVE_BOTTOM_COLOR);
     uint32_t inactive_top_color =
-        (uint32_t)obs_data_get_int(g_state, ACHIEVEMENT_NAME_CONFIGURATION_INACTIVE_TOP_COLOR);
+        (uint32_t)obs_data_get_int(get_state(), ACHIEVEMENT_NAME_CONFIGURATION_INACTIVE_TOP_COLOR);
     uint32_t inactive_bottom_color =
-        (uint32_t)obs_data_get_int(g_state, ACHIEVEMENT_NAME_CONFIGURATION_INACTIVE_BOTTOM_COLOR);
-    uint32_t    size              = (uint32_t)obs_data_get_int(g_state, ACHIEVEMENT_NAME_CONFIGURATION_SIZE);
-    const char *font_face         = obs_data_get_string(g_state, ACHIEVEMENT_NAME_CONFIGURATION_FONT_FACE);
-    const char *font_style        = obs_data_get_string(g_state, ACHIEVEMENT_NAME_CONFIGURATION_FONT_STYLE);
-    bool  auto_visibility_enabled = obs_data_get_bool(g_state, ACHIEVEMENT_NAME_CONFIGURATION_AUTO_VISIBILITY_ENABLED);
+        (uint32_t)obs_data_get_int(get_state(), ACHIEVEMENT_NAME_CONFIGURATION_INACTIVE_BOTTOM_COLOR);
+    uint32_t    size              = (uint32_t)obs_data_get_int(get_state(), ACHIEVEMENT_NAME_CONFIGURATION_SIZE);
+    const char *font_face         = obs_data_get_string(get_state(), ACHIEVEMENT_NAME_CONFIGURATION_FONT_FACE);
+    const char *font_style        = obs_data_get_string(get_state(), ACHIEVEMENT_NAME_CONFIGURATION_FONT_STYLE);
+    bool  auto_visibility_enabled = obs_data_get_bool(get_state(), ACHIEVEMENT_NAME_CONFIGURATION_AUTO_VISIBILITY_ENABLED);
     float auto_visibility_show_duration =
-        (float)obs_data_get_double(g_state, ACHIEVEMENT_NAME_CONFIGURATION_AUTO_VISIBILITY_SHOW_DURATION);
+        (float)obs_data_get_double(get_state(), ACHIEVEMENT_NAME_CONFIGURATION_AUTO_VISIBILITY_SHOW_DURATION);
     float auto_visibility_hide_duration =
-        (float)obs_data_get_double(g_state, ACHIEVEMENT_NAME_CONFIGURATION_AUTO_VISIBILITY_HIDE_DURATION);
+        (float)obs_data_get_double(get_state(), ACHIEVEMENT_NAME_CONFIGURATION_AUTO_VISIBILITY_HIDE_DURATION);
     float auto_visibility_fade_duration =
-        (float)obs_data_get_double(g_state, ACHIEVEMENT_NAME_CONFIGURATION_AUTO_VISIBILITY_FADE_DURATION);
+        (float)obs_data_get_double(get_state(), ACHIEVEMENT_NAME_CONFIGURATION_AUTO_VISIBILITY_FADE_DURATION);
 
     achievement_name_configuration_t *configuration = bzalloc(sizeof(achievement_name_configuration_t));
 
@@ -585,6 +717,8 @@ achievement_name_configuration_t *state_get_achievement_name_configuration() {
                                                        ? auto_visibility_fade_duration
                                                        : AUTO_VISIBILITY_DEFAULT_SHARED_FADE_DURATION;
 
+    pthread_mutex_unlock(&g_state_mutex);
+
     return configuration;
 }
 
@@ -594,56 +728,62 @@ void state_set_achievement_description_configuration(const achievement_descripti
         return;
     }
 
-    obs_data_set_int(g_state, ACHIEVEMENT_DESCRIPTION_CONFIGURATION_ACTIVE_TOP_COLOR, configuration->active_top_color);
-    obs_data_set_int(g_state,
+    pthread_mutex_lock(&g_state_mutex);
+
+    obs_data_set_int(get_state(), ACHIEVEMENT_DESCRIPTION_CONFIGURATION_ACTIVE_TOP_COLOR, configuration->active_top_color);
+    obs_data_set_int(get_state(),
                      ACHIEVEMENT_DESCRIPTION_CONFIGURATION_ACTIVE_BOTTOM_COLOR,
                      configuration->active_bottom_color);
-    obs_data_set_int(g_state,
+    obs_data_set_int(get_state(),
                      ACHIEVEMENT_DESCRIPTION_CONFIGURATION_INACTIVE_TOP_COLOR,
                      configuration->inactive_top_color);
-    obs_data_set_int(g_state,
+    obs_data_set_int(get_state(),
                      ACHIEVEMENT_DESCRIPTION_CONFIGURATION_INACTIVE_BOTTOM_COLOR,
                      configuration->inactive_bottom_color);
-    obs_data_set_int(g_state, ACHIEVEMENT_DESCRIPTION_CONFIGURATION_SIZE, configuration->font_size);
-    obs_data_set_string(g_state, ACHIEVEMENT_DESCRIPTION_CONFIGURATION_FONT_FACE, configuration->font_face);
-    obs_data_set_string(g_state, ACHIEVEMENT_DESCRIPTION_CONFIGURATION_FONT_STYLE, configuration->font_style);
-    obs_data_set_bool(g_state,
+    obs_data_set_int(get_state(), ACHIEVEMENT_DESCRIPTION_CONFIGURATION_SIZE, configuration->font_size);
+    obs_data_set_string(get_state(), ACHIEVEMENT_DESCRIPTION_CONFIGURATION_FONT_FACE, configuration->font_face);
+    obs_data_set_string(get_state(), ACHIEVEMENT_DESCRIPTION_CONFIGURATION_FONT_STYLE, configuration->font_style);
+    obs_data_set_bool(get_state(),
                       ACHIEVEMENT_DESCRIPTION_CONFIGURATION_AUTO_VISIBILITY_ENABLED,
                       configuration->auto_visibility.enabled);
-    obs_data_set_double(g_state,
+    obs_data_set_double(get_state(),
                         ACHIEVEMENT_DESCRIPTION_CONFIGURATION_AUTO_VISIBILITY_SHOW_DURATION,
                         configuration->auto_visibility.show_duration);
-    obs_data_set_double(g_state,
+    obs_data_set_double(get_state(),
                         ACHIEVEMENT_DESCRIPTION_CONFIGURATION_AUTO_VISIBILITY_HIDE_DURATION,
                         configuration->auto_visibility.hide_duration);
-    obs_data_set_double(g_state,
+    obs_data_set_double(get_state(),
                         ACHIEVEMENT_DESCRIPTION_CONFIGURATION_AUTO_VISIBILITY_FADE_DURATION,
                         configuration->auto_visibility.fade_duration);
 
-    save_state(g_state);
+    save_state(get_state());
+
+    pthread_mutex_unlock(&g_state_mutex);
 }
 
 achievement_description_configuration_t *state_get_achievement_description_configuration() {
 
+    pthread_mutex_lock(&g_state_mutex);
+
     uint32_t active_top_color =
-        (uint32_t)obs_data_get_int(g_state, ACHIEVEMENT_DESCRIPTION_CONFIGURATION_ACTIVE_TOP_COLOR);
+        (uint32_t)obs_data_get_int(get_state(), ACHIEVEMENT_DESCRIPTION_CONFIGURATION_ACTIVE_TOP_COLOR);
     uint32_t active_bottom_color =
-        (uint32_t)obs_data_get_int(g_state, ACHIEVEMENT_DESCRIPTION_CONFIGURATION_ACTIVE_BOTTOM_COLOR);
+        (uint32_t)obs_data_get_int(get_state(), ACHIEVEMENT_DESCRIPTION_CONFIGURATION_ACTIVE_BOTTOM_COLOR);
     uint32_t inactive_top_color =
-        (uint32_t)obs_data_get_int(g_state, ACHIEVEMENT_DESCRIPTION_CONFIGURATION_INACTIVE_TOP_COLOR);
+        (uint32_t)obs_data_get_int(get_state(), ACHIEVEMENT_DESCRIPTION_CONFIGURATION_INACTIVE_TOP_COLOR);
     uint32_t inactive_bottom_color =
-        (uint32_t)obs_data_get_int(g_state, ACHIEVEMENT_DESCRIPTION_CONFIGURATION_INACTIVE_BOTTOM_COLOR);
-    uint32_t    size       = (uint32_t)obs_data_get_int(g_state, ACHIEVEMENT_DESCRIPTION_CONFIGURATION_SIZE);
-    const char *font_face  = obs_data_get_string(g_state, ACHIEVEMENT_DESCRIPTION_CONFIGURATION_FONT_FACE);
-    const char *font_style = obs_data_get_string(g_state, ACHIEVEMENT_DESCRIPTION_CONFIGURATION_FONT_STYLE);
+        (uint32_t)obs_data_get_int(get_state(), ACHIEVEMENT_DESCRIPTION_CONFIGURATION_INACTIVE_BOTTOM_COLOR);
+    uint32_t    size       = (uint32_t)obs_data_get_int(get_state(), ACHIEVEMENT_DESCRIPTION_CONFIGURATION_SIZE);
+    const char *font_face  = obs_data_get_string(get_state(), ACHIEVEMENT_DESCRIPTION_CONFIGURATION_FONT_FACE);
+    const char *font_style = obs_data_get_string(get_state(), ACHIEVEMENT_DESCRIPTION_CONFIGURATION_FONT_STYLE);
     bool        auto_visibility_enabled =
-        obs_data_get_bool(g_state, ACHIEVEMENT_DESCRIPTION_CONFIGURATION_AUTO_VISIBILITY_ENABLED);
+        obs_data_get_bool(get_state(), ACHIEVEMENT_DESCRIPTION_CONFIGURATION_AUTO_VISIBILITY_ENABLED);
     float auto_visibility_show_duration =
-        (float)obs_data_get_double(g_state, ACHIEVEMENT_DESCRIPTION_CONFIGURATION_AUTO_VISIBILITY_SHOW_DURATION);
+        (float)obs_data_get_double(get_state(), ACHIEVEMENT_DESCRIPTION_CONFIGURATION_AUTO_VISIBILITY_SHOW_DURATION);
     float auto_visibility_hide_duration =
-        (float)obs_data_get_double(g_state, ACHIEVEMENT_DESCRIPTION_CONFIGURATION_AUTO_VISIBILITY_HIDE_DURATION);
+        (float)obs_data_get_double(get_state(), ACHIEVEMENT_DESCRIPTION_CONFIGURATION_AUTO_VISIBILITY_HIDE_DURATION);
     float auto_visibility_fade_duration =
-        (float)obs_data_get_double(g_state, ACHIEVEMENT_DESCRIPTION_CONFIGURATION_AUTO_VISIBILITY_FADE_DURATION);
+        (float)obs_data_get_double(get_state(), ACHIEVEMENT_DESCRIPTION_CONFIGURATION_AUTO_VISIBILITY_FADE_DURATION);
 
     achievement_description_configuration_t *configuration = bzalloc(sizeof(achievement_description_configuration_t));
 
@@ -665,6 +805,8 @@ achievement_description_configuration_t *state_get_achievement_description_confi
                                                        ? auto_visibility_fade_duration
                                                        : AUTO_VISIBILITY_DEFAULT_SHARED_FADE_DURATION;
 
+    pthread_mutex_unlock(&g_state_mutex);
+
     return configuration;
 }
 
@@ -674,41 +816,47 @@ void state_set_achievements_count_configuration(const achievements_count_configu
         return;
     }
 
-    obs_data_set_int(g_state, ACHIEVEMENTS_COUNT_CONFIGURATION_TOP_COLOR, configuration->top_color);
-    obs_data_set_int(g_state, ACHIEVEMENTS_COUNT_CONFIGURATION_BOTTOM_COLOR, configuration->bottom_color);
-    obs_data_set_int(g_state, ACHIEVEMENTS_COUNT_CONFIGURATION_SIZE, configuration->font_size);
-    obs_data_set_string(g_state, ACHIEVEMENTS_COUNT_CONFIGURATION_FONT_FACE, configuration->font_face);
-    obs_data_set_string(g_state, ACHIEVEMENTS_COUNT_CONFIGURATION_FONT_STYLE, configuration->font_style);
-    obs_data_set_bool(g_state,
+    pthread_mutex_lock(&g_state_mutex);
+
+    obs_data_set_int(get_state(), ACHIEVEMENTS_COUNT_CONFIGURATION_TOP_COLOR, configuration->top_color);
+    obs_data_set_int(get_state(), ACHIEVEMENTS_COUNT_CONFIGURATION_BOTTOM_COLOR, configuration->bottom_color);
+    obs_data_set_int(get_state(), ACHIEVEMENTS_COUNT_CONFIGURATION_SIZE, configuration->font_size);
+    obs_data_set_string(get_state(), ACHIEVEMENTS_COUNT_CONFIGURATION_FONT_FACE, configuration->font_face);
+    obs_data_set_string(get_state(), ACHIEVEMENTS_COUNT_CONFIGURATION_FONT_STYLE, configuration->font_style);
+    obs_data_set_bool(get_state(),
                       ACHIEVEMENTS_COUNT_CONFIGURATION_AUTO_VISIBILITY_ENABLED,
                       configuration->auto_visibility.enabled);
-    obs_data_set_double(g_state,
+    obs_data_set_double(get_state(),
                         ACHIEVEMENTS_COUNT_CONFIGURATION_AUTO_VISIBILITY_SHOW_DURATION,
                         configuration->auto_visibility.show_duration);
-    obs_data_set_double(g_state,
+    obs_data_set_double(get_state(),
                         ACHIEVEMENTS_COUNT_CONFIGURATION_AUTO_VISIBILITY_HIDE_DURATION,
                         configuration->auto_visibility.hide_duration);
-    obs_data_set_double(g_state,
+    obs_data_set_double(get_state(),
                         ACHIEVEMENTS_COUNT_CONFIGURATION_AUTO_VISIBILITY_FADE_DURATION,
                         configuration->auto_visibility.fade_duration);
 
-    save_state(g_state);
+    save_state(get_state());
+
+    pthread_mutex_unlock(&g_state_mutex);
 }
 
 achievements_count_configuration_t *state_get_achievements_count_configuration() {
 
-    uint32_t    top_color        = (uint32_t)obs_data_get_int(g_state, ACHIEVEMENTS_COUNT_CONFIGURATION_TOP_COLOR);
-    uint32_t    bottom_color     = (uint32_t)obs_data_get_int(g_state, ACHIEVEMENTS_COUNT_CONFIGURATION_BOTTOM_COLOR);
-    uint32_t    size             = (uint32_t)obs_data_get_int(g_state, ACHIEVEMENTS_COUNT_CONFIGURATION_SIZE);
-    const char *font_face        = obs_data_get_string(g_state, ACHIEVEMENTS_COUNT_CONFIGURATION_FONT_FACE);
-    const char *font_style       = obs_data_get_string(g_state, ACHIEVEMENTS_COUNT_CONFIGURATION_FONT_STYLE);
-    bool auto_visibility_enabled = obs_data_get_bool(g_state, ACHIEVEMENTS_COUNT_CONFIGURATION_AUTO_VISIBILITY_ENABLED);
+    pthread_mutex_lock(&g_state_mutex);
+
+    uint32_t    top_color        = (uint32_t)obs_data_get_int(get_state(), ACHIEVEMENTS_COUNT_CONFIGURATION_TOP_COLOR);
+    uint32_t    bottom_color     = (uint32_t)obs_data_get_int(get_state(), ACHIEVEMENTS_COUNT_CONFIGURATION_BOTTOM_COLOR);
+    uint32_t    size             = (uint32_t)obs_data_get_int(get_state(), ACHIEVEMENTS_COUNT_CONFIGURATION_SIZE);
+    const char *font_face        = obs_data_get_string(get_state(), ACHIEVEMENTS_COUNT_CONFIGURATION_FONT_FACE);
+    const char *font_style       = obs_data_get_string(get_state(), ACHIEVEMENTS_COUNT_CONFIGURATION_FONT_STYLE);
+    bool auto_visibility_enabled = obs_data_get_bool(get_state(), ACHIEVEMENTS_COUNT_CONFIGURATION_AUTO_VISIBILITY_ENABLED);
     float auto_visibility_show_duration =
-        (float)obs_data_get_double(g_state, ACHIEVEMENTS_COUNT_CONFIGURATION_AUTO_VISIBILITY_SHOW_DURATION);
+        (float)obs_data_get_double(get_state(), ACHIEVEMENTS_COUNT_CONFIGURATION_AUTO_VISIBILITY_SHOW_DURATION);
     float auto_visibility_hide_duration =
-        (float)obs_data_get_double(g_state, ACHIEVEMENTS_COUNT_CONFIGURATION_AUTO_VISIBILITY_HIDE_DURATION);
+        (float)obs_data_get_double(get_state(), ACHIEVEMENTS_COUNT_CONFIGURATION_AUTO_VISIBILITY_HIDE_DURATION);
     float auto_visibility_fade_duration =
-        (float)obs_data_get_double(g_state, ACHIEVEMENTS_COUNT_CONFIGURATION_AUTO_VISIBILITY_FADE_DURATION);
+        (float)obs_data_get_double(get_state(), ACHIEVEMENTS_COUNT_CONFIGURATION_AUTO_VISIBILITY_FADE_DURATION);
 
     achievements_count_configuration_t *configuration = bzalloc(sizeof(achievements_count_configuration_t));
 
@@ -728,81 +876,104 @@ achievements_count_configuration_t *state_get_achievements_count_configuration()
                                                        ? auto_visibility_fade_duration
                                                        : AUTO_VISIBILITY_DEFAULT_SHARED_FADE_DURATION;
 
+    pthread_mutex_unlock(&g_state_mutex);
+
     return configuration;
 }
 
 token_t *state_get_user_token(void) {
 
-    const char *user_token = obs_data_get_string(g_state, USER_ACCESS_TOKEN);
+    pthread_mutex_lock(&g_state_mutex);
+
+    const char *user_token = obs_data_get_string(get_state(), USER_ACCESS_TOKEN);
 
     if (!user_token || strlen(user_token) == 0) {
         obs_log(LOG_INFO, "No user token found in the cache");
+        pthread_mutex_unlock(&g_state_mutex);
         return NULL;
     }
 
     token_t *token = bzalloc(sizeof(token_t));
     token->value   = bstrdup(user_token);
 
+    pthread_mutex_unlock(&g_state_mutex);
+
     return token;
 }
 
 token_t *state_get_user_refresh_token(void) {
-    const char *refresh_token = obs_data_get_string(g_state, USER_REFRESH_TOKEN);
+    pthread_mutex_lock(&g_state_mutex);
+
+    const char *refresh_token = obs_data_get_string(get_state(), USER_REFRESH_TOKEN);
 
     if (!refresh_token || strlen(refresh_token) == 0) {
         obs_log(LOG_INFO, "No refresh token found in the cache");
+        pthread_mutex_unlock(&g_state_mutex);
         return NULL;
     }
 
     token_t *token = bzalloc(sizeof(token_t));
     token->value   = bstrdup(refresh_token);
 
+    pthread_mutex_unlock(&g_state_mutex);
+
     return token;
 }
 
 void state_set_xbox_identity(const xbox_identity_t *xbox_identity) {
-    obs_data_set_string(g_state, XBOX_IDENTITY_GTG, xbox_identity->gamertag);
-    obs_data_set_string(g_state, XBOX_IDENTITY_ID, xbox_identity->xid);
-    obs_data_set_string(g_state, XBOX_IDENTITY_UHS, xbox_identity->uhs);
-    obs_data_set_string(g_state, XBOX_TOKEN, xbox_identity->token->value);
-    obs_data_set_int(g_state, XBOX_TOKEN_EXPIRY, xbox_identity->token->expires);
-    save_state(g_state);
+    pthread_mutex_lock(&g_state_mutex);
+
+    obs_data_set_string(get_state(), XBOX_IDENTITY_GTG, xbox_identity->gamertag);
+    obs_data_set_string(get_state(), XBOX_IDENTITY_ID, xbox_identity->xid);
+    obs_data_set_string(get_state(), XBOX_IDENTITY_UHS, xbox_identity->uhs);
+    obs_data_set_string(get_state(), XBOX_TOKEN, xbox_identity->token->value);
+    obs_data_set_int(get_state(), XBOX_TOKEN_EXPIRY, xbox_identity->token->expires);
+    save_state(get_state());
+
+    pthread_mutex_unlock(&g_state_mutex);
 }
 
 xbox_identity_t *state_get_xbox_identity(void) {
 
-    const char *gtg = obs_data_get_string(g_state, XBOX_IDENTITY_GTG);
+    pthread_mutex_lock(&g_state_mutex);
+
+    const char *gtg = obs_data_get_string(get_state(), XBOX_IDENTITY_GTG);
 
     if (!gtg || strlen(gtg) == 0) {
         obs_log(LOG_INFO, "No gamertag found in the cache");
+        pthread_mutex_unlock(&g_state_mutex);
         return NULL;
     }
 
-    const char *xid = obs_data_get_string(g_state, XBOX_IDENTITY_ID);
+    const char *xid = obs_data_get_string(get_state(), XBOX_IDENTITY_ID);
 
     if (!xid || strlen(xid) == 0) {
         obs_log(LOG_INFO, "No user ID found in the cache");
+        pthread_mutex_unlock(&g_state_mutex);
         return NULL;
     }
 
-    const char *uhs = obs_data_get_string(g_state, XBOX_IDENTITY_UHS);
+    const char *uhs = obs_data_get_string(get_state(), XBOX_IDENTITY_UHS);
 
     if (!uhs || strlen(uhs) == 0) {
         obs_log(LOG_INFO, "No user hash found in the cache");
+        pthread_mutex_unlock(&g_state_mutex);
         return NULL;
     }
 
-    const char *xbox_token = obs_data_get_string(g_state, XBOX_TOKEN);
+    const char *xbox_token = obs_data_get_string(get_state(), XBOX_TOKEN);
 
     if (!xbox_token || strlen(xbox_token) == 0) {
         obs_log(LOG_INFO, "No xbox token found in the cache");
+        pthread_mutex_unlock(&g_state_mutex);
         return NULL;
     }
 
-    int64_t xbox_token_expiry = (int64_t)obs_data_get_int(g_state, XBOX_TOKEN_EXPIRY);
+    int64_t xbox_token_expiry = (int64_t)obs_data_get_int(get_state(), XBOX_TOKEN_EXPIRY);
 
     if (xbox_token_expiry == 0) {
         obs_log(LOG_INFO, "No xbox token expiry found in the cache");
+        pthread_mutex_unlock(&g_state_mutex);
         return NULL;
     }
 
@@ -818,6 +989,8 @@ xbox_identity_t *state_get_xbox_identity(void) {
     identity->uhs             = bstrdup(uhs);
     identity->token           = token;
 
+    pthread_mutex_unlock(&g_state_mutex);
+
     return identity;
 }
 
@@ -867,29 +1040,43 @@ void state_set_achievement_cycle_timings(const achievement_cycle_timings_t *timi
         return;
     }
 
-    obs_data_set_int(g_state, CYCLE_LAST_UNLOCKED_DURATION, timings->last_unlocked_duration);
-    obs_data_set_int(g_state, CYCLE_LOCKED_EACH_DURATION, timings->locked_achievement_duration);
-    obs_data_set_int(g_state, CYCLE_LOCKED_TOTAL_DURATION, timings->locked_cycle_total_duration);
+    pthread_mutex_lock(&g_state_mutex);
+
+    obs_data_set_int(get_state(), CYCLE_LAST_UNLOCKED_DURATION, timings->last_unlocked_duration);
+    obs_data_set_int(get_state(), CYCLE_LOCKED_EACH_DURATION, timings->locked_achievement_duration);
+    obs_data_set_int(get_state(), CYCLE_LOCKED_TOTAL_DURATION, timings->locked_cycle_total_duration);
 
-    save_state(g_state);
+    save_state(get_state());
+
+    pthread_mutex_unlock(&g_state_mutex);
 }
 
 void state_set_auto_cycle_enabled(bool enabled) {
-    obs_data_set_int(g_state, CYCLE_AUTO_CYCLE_ENABLED, enabled ? 1 : 2);
-    save_state(g_state);
+    pthread_mutex_lock(&g_state_mutex);
+
+    obs_data_set_int(get_state(), CYCLE_AUTO_CYCLE_ENABLED, enabled ? 1 : 2);
+    save_state(get_state());
+
+    pthread_mutex_unlock(&g_state_mutex);
 }
 
 bool state_get_auto_cycle_enabled(void) {
-    int value = (int)obs_data_get_int(g_state, CYCLE_AUTO_CYCLE_ENABLED);
+    pthread_mutex_lock(&g_state_mutex);
+
+    int value = (int)obs_data_get_int(get_state(), CYCLE_AUTO_CYCLE_ENABLED);
     /* 2 = explicitly disabled; anything else (0 = unset, 1 = enabled) → enabled */
+    pthread_mutex_unlock(&g_state_mutex);
+
     return value != 2;
 }
 
 achievement_cycle_timings_t *state_get_achievement_cycle_timings(void) {
 
-    int last_unlocked = (int)obs_data_get_int(g_state, CYCLE_LAST_UNLOCKED_DURATION);
-    int locked_each   = (int)obs_data_get_int(g_state, CYCLE_LOCKED_EACH_DURATION);
-    int locked_total  = (int)obs_data_get_int(g_state, CYCLE_LOCKED_TOTAL_DURATION);
+    pthread_mutex_lock(&g_state_mutex);
+
+    int last_unlocked = (int)obs_data_get_int(get_state(), CYCLE_LAST_UNLOCKED_DURATION);
+    int locked_each   = (int)obs_data_get_int(get_state(), CYCLE_LOCKED_EACH_DURATION);
+    int locked_total  = (int)obs_data_get_int(get_state(), CYCLE_LOCKED_TOTAL_DURATION);
 
     achievement_cycle_timings_t *timings = bzalloc(sizeof(achievement_cycle_timings_t));
 
@@ -900,27 +1087,80 @@ achievement_cycle_timings_t *state_get_achievement_cycle_timings(void) {
     timings->locked_cycle_total_duration = locked_total > 0 ? locked_total
                                                             : ACHIEVEMENT_CYCLE_DEFAULT_LOCKED_TOTAL_DURATION;
 
+    pthread_mutex_unlock(&g_state_mutex);
+
     return timings;
 }
 
+void state_set_rta_connection_configuration(const rta_connection_configuration_t *configuration) {
+
+    if (!configuration) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_state_mutex);
+
+    obs_data_set_int(get_state(), RTA_PING_INTERVAL, configuration->ping_interval);
+    obs_data_set_int(get_state(), RTA_MAX_PING_INTERVAL, configuration->max_ping_interval);
+    obs_data_set_int(get_state(), RTA_PONG_TIMEOUT, configuration->pong_timeout);
+    obs_data_set_int(get_state(), RTA_COMPRESSION_ENABLED, configuration->compression_enabled ? 1 : 2);
+
+    save_state(get_state());
+
+    pthread_mutex_unlock(&g_state_mutex);
+}
+
+rta_connection_configuration_t *state_get_rta_connection_configuration(void) {
+
+    pthread_mutex_lock(&g_state_mutex);
+
+    int ping_interval     = (int)obs_data_get_int(get_state(), RTA_PING_INTERVAL);
+    int max_ping_interval = (int)obs_data_get_int(get_state(), RTA_MAX_PING_INTERVAL);
+    int pong_timeout      = (int)obs_data_get_int(get_state(), RTA_PONG_TIMEOUT);
+    int compression       = (int)obs_data_get_int(get_state(), RTA_COMPRESSION_ENABLED);
+
+    rta_connection_configuration_t *configuration = bzalloc(sizeof(rta_connection_configuration_t));
+
+    configuration->ping_interval       = ping_interval > 0 ? ping_interval : RTA_CONNECTION_DEFAULT_PING_INTERVAL;
+    configuration->max_ping_interval   = max_ping_interval > 0 ? max_ping_interval
+                                                               : RTA_CONNECTION_DEFAULT_MAX_PING_INTERVAL;
+    configuration->pong_timeout        = pong_timeout > 0 ? pong_timeout : RTA_CONNECTION_DEFAULT_PONG_TIMEOUT;
+    configuration->compression_enabled = compression != 2;
+
+    /* The interval only ever stretches */
+    if (configuration->max_ping_interval < configuration->ping_interval) {
+        configuration->max_ping_interval = configuration->ping_interval;
+    }
+
+    pthread_mutex_unlock(&g_state_mutex);
+
+    return configuration;
+}
+
 void state_set_auto_visibility_durations(const auto_visibility_durations_t *durations) {
 
     if (!durations) {
         return;
     }
 
-    obs_data_set_double(g_state, AUTO_VISIBILITY_SHARED_SHOW_DURATION, durations->show_duration);
-    obs_data_set_double(g_state, AUTO_VISIBILITY_SHARED_HIDE_DURATION, durations->hide_duration);
-    obs_data_set_double(g_state, AUTO_VISIBILITY_SHARED_FADE_DURATION, durations->fade_duration);
+    pthread_mutex_lock(&g_state_mutex);
+
+    obs_data_set_double(get_state(), AUTO_VISIBILITY_SHARED_SHOW_DURATION, durations->show_duration);
+    obs_data_set_double(get_state(), AUTO_VISIBILITY_SHARED_HIDE_DURATION, durations->hide_duration);
+    obs_data_set_double(get_state(), AUTO_VISIBILITY_SHARED_FADE_DURATION, durations->fade_duration);
 
-    save_state(g_state);
+    save_state(get_state());
+
+    pthread_mutex_unlock(&g_state_mutex);
 }
 
 auto_visibility_durations_t *state_get_auto_visibility_durations(void) {
 
-    float show = (float)obs_data_get_double(g_state, AUTO_VISIBILITY_SHARED_SHOW_DURATION);
-    float hide = (float)obs_data_get_double(g_state, AUTO_VISIBILITY_SHARED_HIDE_DURATION);
-    float fade = (float)obs_data_get_double(g_state, AUTO_VISIBILITY_SHARED_FADE_DURATION);
+    pthread_mutex_lock(&g_state_mutex);
+
+    float show = (float)obs_data_get_double(get_state(), AUTO_VISIBILITY_SHARED_SHOW_DURATION);
+    float hide = (float)obs_data_get_double(get_state(), AUTO_VISIBILITY_SHARED_HIDE_DURATION);
+    float fade = (float)obs_data_get_double(get_state(), AUTO_VISIBILITY_SHARED_FADE_DURATION);
 
     auto_visibility_durations_t *d = bzalloc(sizeof(auto_visibility_durations_t));
 
@@ -928,5 +1168,7 @@ auto_visibility_durations_t *state_get_auto_visibility_durations(void) {
     d->hide_duration = hide > 0.0f ? hide : AUTO_VISIBILITY_DEFAULT_SHARED_HIDE_DURATION;
     d->fade_duration = fade > 0.0f ? fade : AUTO_VISIBILITY_DEFAULT_SHARED_FADE_DURATION;
 
+    pthread_mutex_unlock(&g_state_mutex);
+
     return d;
 }
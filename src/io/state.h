@@ -12,15 +12,37 @@ extern "C" {
  * The implementation typically initializes the internal state cache (device,
  * tokens, identity, etc.) by reading from the configured storage location.
  *
- * This function is expected to be called during plugin initialization before
- * accessing any state_* getters.
+ * Safe to call from any thread and idempotent. The state_* APIs load the state
+ * themselves on first access, so calling this up front only moves the disk
+ * read off the path of the first getter.
+ *
+ * Every state_* function is safe to call from any thread: they are serialized,
+ * saves included, by a single lock.
  */
 void io_load(void);
 
+/**
+ * @brief Postpone writing the state to disk.
+ *
+ * Setters keep updating the in-memory state but the file is no longer
+ * rewritten on every change. Used during plugin load, where each source
+ * registration persists its normalized configuration, so that OBS's startup
+ * thread does not pay for one file write per source.
+ */
+void io_defer_saves(void);
+
+/**
+ * @brief Stop deferring saves and write the state once if anything changed.
+ *
+ * Safe to call from any thread, and when saves are not deferred.
+ */
+void io_commit_deferred_saves(void);
+
 /**
  * @brief Clean up and free the persisted plugin state.
  *
- * This function releases all memory associated with the global state object.
+ * This function releases all memory associated with the global state object,
+ * writing any deferred save first.
  * Should be called during plugin shutdown (obs_module_unload).
  */
 void io_cleanup(void);
@@ -79,6 +101,9 @@ void state_set_device_token(const token_t *device_token);
 /**
  * @brief Get the currently stored device token.
  *
+ * Tokens stored before their expiry was persisted are returned with an
+ * @c expires of 0, i.e. already expired.
+ *
  * @return Newly allocated device token (caller must free with state_free_token()),
  *         or NULL if none is set.
  */
@@ -286,6 +311,29 @@ void state_set_achievement_cycle_timings(const achievement_cycle_timings_t *timi
  */
 achievement_cycle_timings_t *state_get_achievement_cycle_timings(void);
 
+/**
+ * @brief Persist the keepalive and compression settings of the Xbox RTA websocket.
+ *
+ * Read when the Xbox monitoring starts.
+ *
+ * @param configuration Settings to store. May be NULL (no-op).
+ */
+void state_set_rta_connection_configuration(const rta_connection_configuration_t *configuration);
+
+/**
+ * @brief Get the keepalive and compression settings of the Xbox RTA websocket.
+ *
+ * Returns a newly allocated structure with defaults applied for any value that
+ * has not been persisted yet (or is out of range):
+ * - ping_interval:       10 s
+ * - max_ping_interval:   60 s (never below ping_interval)
+ * - pong_timeout:        8 s
+ * - compression_enabled: true
+ *
+ * @return Newly allocated configuration structure. Caller must free with bfree().
+ */
+rta_connection_configuration_t *state_get_rta_connection_configuration(void);
+
 /**
  * @brief Clear all in-memory state (and typically any persisted state).
  *
@@ -1,7 +1,10 @@
 #include <obs-module.h>
 #include <diagnostics/log.h>
+#include <diagnostics/memory_accounting.h>
+#include <util/platform.h>
 
 #include "sources/common/achievement_cycle.h"
+#include "sources/common/source_activity.h"
 #include "ui/xbox_account_config.h"
 #include "ui/achievement_tracker_config.h"
 #include "sources/gamerpic.h"
@@ -9,24 +12,150 @@
 #include "sources/gamerscore.h"
 #include "sources/gamertag.h"
 
+#include "io/cache.h"
 #include "io/state.h"
 #include "sources/achievement_name.h"
 #include "sources/achievement_description.h"
 #include "sources/achievement_icon.h"
+#include "sources/achievement_grid.h"
+#include "sources/achievement_progress.h"
 #include "sources/achievements_count.h"
 #include "drawing/image.h"
+#include "drawing/progress_bar.h"
+#include "integrations/asset_prefetch.h"
 #include "integrations/monitoring_service.h"
+#include "integrations/xbox/oauth/xbox-live.h"
+#include "net/http/http.h"
+#include "net/obs_websocket/obs_websocket_vendor.h"
+#include "time/clock.h"
+#include "util/arena.h"
+#include "util/thread_compat.h"
 
 OBS_DECLARE_MODULE()
 OBS_MODULE_USE_DEFAULT_LOCALE(PLUGIN_NAME, "en-US")
 
+/** Time obs_module_unload() is expected to stay under, in milliseconds. */
+#define SHUTDOWN_BUDGET_MS 500
+
+/** Interval between two memory reports in the OBS log, in seconds. */
+#define MEMORY_REPORT_INTERVAL_S 3600.0f
+
+/** Background task running the slow part of the initialization. */
+static pthread_t g_warm_up_thread;
+static bool      g_warm_up_started = false;
+
+/**
+ * @brief Asynchronous warm-up phase of the plugin initialization.
+ *
+ * Everything here touches the disk, crypto or the network and is not needed
+ * for OBS to register the sources, so it runs off OBS's startup thread. The
+ * sources render their defaults (or nothing) until the snapshot is restored or
+ * the monitors report live data, exactly as they would while waiting for a
+ * connection.
+ *
+ * @param arg Non-NULL when running on its own thread; NULL when run
+ *            synchronously on OBS's thread, whose priority must not change.
+ */
+static void *warm_up(void *arg) {
+
+    const bool own_thread = arg != NULL;
+
+    /* Not the background class: the monitor threads started below would inherit
+     * it, and an unprivileged thread cannot raise its priority back */
+    if (own_thread && !thread_set_class(THREAD_CLASS_NETWORK, "WarmUp")) {
+        obs_log(LOG_WARNING, "Could not apply the priority of the warm-up thread");
+    }
+
+    const uint64_t started_at = os_gettime_ns();
+
+    /* Write once the configurations normalized by the source registrations */
+    io_commit_deferred_saves();
+
+    /* Apply any user-configured timing values persisted from a previous session */
+    achievement_cycle_timings_t *timings = state_get_achievement_cycle_timings();
+    if (timings) {
+        achievement_cycle_set_timings((float)timings->last_unlocked_duration,
+                                      (float)timings->locked_achievement_duration,
+                                      (float)timings->locked_cycle_total_duration);
+        bfree(timings);
+    }
+
+    /* Apply the persisted auto-cycle toggle (defaults to enabled when not yet saved) */
+    achievement_cycle_set_auto_cycle(state_get_auto_cycle_enabled());
+
+    /* Generate the device keys on first launch, or parse the persisted ones, so
+     * that neither the first sign-in nor the first token refresh pays for it */
+    device_t *device = state_get_device();
+    state_free_device(&device);
+
+    cache_init();
+
+    /* Render the previous session's overlay until the monitors report live data */
+    monitoring_restore_snapshot();
+    monitoring_start();
+
+    obs_log(LOG_INFO, "Warm-up completed in %.1f ms", (double)(os_gettime_ns() - started_at) / 1000000.0);
+
+    /* The monitor threads are started: the compaction can run in the background
+     * class without them inheriting it */
+    if (own_thread && !thread_set_class(THREAD_CLASS_BACKGROUND, "CacheCompact")) {
+        obs_log(LOG_WARNING, "Could not apply the priority of the cache compaction");
+    }
+
+    cache_compact();
+
+    return NULL;
+}
+
+/**
+ * @brief Defer the icon prefetch while none of the plugin's sources is on screen.
+ *
+ * The monitors keep running so the overlay is current as soon as it shows up.
+ */
+static void on_source_activity_changed(bool visible) {
+    asset_prefetch_set_deferred(!visible);
+}
+
+/**
+ * @brief OBS tick callback logging the memory report once per interval.
+ *
+ * On long streams, comparing the hourly reports shows a leak or a regression
+ * long before it becomes a problem.
+ */
+static void log_memory_report_periodically(void *param, float seconds) {
+    (void)param;
+
+    static float elapsed = 0.0f;
+
+    elapsed += seconds;
+
+    if (elapsed >= MEMORY_REPORT_INTERVAL_S) {
+        elapsed = 0.0f;
+        memory_log_report("hourly");
+    }
+}
+
 bool obs_module_load(void) {
+    const uint64_t started_at = os_gettime_ns();
+
     obs_log(LOG_INFO, "Loading plugin (version %s)", PLUGIN_VERSION);
-    io_load();
+
+    /* Before any thread parses JSON: lets the parsers build their cJSON trees in scratch arenas */
+    arena_install_json_hooks();
+
+    /* Debugging aid: soak-test the display cycle and the fades at an accelerated pace */
+    const double time_factor = clock_use_accelerated_from_environment();
+
+    if (time_factor != 1.0) {
+        obs_log(LOG_WARNING, "Time runs %.1fx faster (ACHIEVEMENTS_TRACKER_TIME_FACTOR is set)", time_factor);
+    }
+
+    /* The source registrations persist their normalized configuration: write it
+     * once from the warm-up task instead of once per source on this thread */
+    io_defer_saves();
 
     xbox_account_config_register();
     achievement_tracker_config_register();
-    monitoring_start();
 
     xbox_gamerpic_source_register();
     game_cover_source_register();
@@ -36,49 +165,102 @@ bool obs_module_load(void) {
     /* Initialize the shared achievement display cycle before registering achievement sources */
     achievement_cycle_init();
 
-    /* Apply any user-configured timing values persisted from a previous session */
-    {
-        achievement_cycle_timings_t *timings = state_get_achievement_cycle_timings();
-        if (timings) {
-            achievement_cycle_set_timings((float)timings->last_unlocked_duration,
-                                          (float)timings->locked_achievement_duration,
-                                          (float)timings->locked_cycle_total_duration);
-            bfree(timings);
-        }
-    }
-
-    /* Apply the persisted auto-cycle toggle (defaults to enabled when not yet saved) */
-    achievement_cycle_set_auto_cycle(state_get_auto_cycle_enabled());
-
     xbox_achievement_name_source_register();
     xbox_achievement_description_source_register();
     xbox_achievement_icon_source_register();
+    xbox_achievement_grid_source_register();
+    xbox_achievement_progress_source_register();
     xbox_achievements_count_source_register();
 
-    obs_log(LOG_INFO, "Plugin loaded successfully (version %s)", PLUGIN_VERSION);
+    /* No scene is loaded yet: prefetch once a tracker source shows up */
+    asset_prefetch_set_deferred(!source_activity_is_visible());
+    source_activity_subscribe(&on_source_activity_changed);
+
+    /* Mirror every event from the start so the external overlay snapshot is complete */
+    obs_websocket_vendor_init();
+
+    obs_add_tick_callback(log_memory_report_periodically, NULL);
+
+    g_warm_up_started = pthread_create(&g_warm_up_thread, NULL, warm_up, &g_warm_up_started) == 0;
+
+    if (!g_warm_up_started) {
+        obs_log(LOG_WARNING, "Failed to start the warm-up task: initializing synchronously");
+        warm_up(NULL);
+    }
+
+    obs_log(LOG_INFO,
+            "Plugin loaded successfully in %.1f ms (version %s)",
+            (double)(os_gettime_ns() - started_at) / 1000000.0,
+            PLUGIN_VERSION);
 
     return true;
 }
 
+void obs_module_post_load(void) {
+    /* obs-websocket exposes its vendor API once every module is loaded */
+    obs_websocket_vendor_register();
+}
+
 void obs_module_unload(void) {
+    const uint64_t started_at = os_gettime_ns();
+
+    /* Abort the HTTP requests in flight so that every background thread below
+     * returns within a few tens of milliseconds instead of hitting its timeout */
+    http_cancel_all();
+
+    obs_remove_tick_callback(log_memory_report_periodically, NULL);
+
+    /* The warm-up task may still be starting the monitors */
+    if (g_warm_up_started) {
+        pthread_join(g_warm_up_thread, NULL);
+        g_warm_up_started = false;
+    }
+
+    /* A sign-in completing now would start the Xbox monitor: let it finish first */
+    xbox_live_stop();
+
+    /* Capture the latest cycle position before the cycle is torn down */
+    monitoring_save_snapshot();
+
+    /* Join the monitor threads (and their icon prefetch) before tearing down
+     * the sources and the cycle their callbacks write to */
+    monitoring_stop();
+
+    source_activity_unsubscribe(&on_source_activity_changed);
+
     xbox_account_config_unregister();
     achievement_tracker_config_unregister();
 
+    obs_websocket_vendor_unregister();
     achievement_cycle_destroy();
     image_cleanup();
+    progress_bar_cleanup();
 
     /* Clean up source configurations */
     xbox_achievement_name_source_cleanup();
     xbox_achievement_description_source_cleanup();
     xbox_achievement_icon_source_cleanup();
+    xbox_achievement_grid_source_cleanup();
+    xbox_achievement_progress_source_cleanup();
     xbox_achievements_count_source_cleanup();
     game_cover_source_cleanup();
     xbox_gamerpic_source_cleanup();
     xbox_gamerscore_source_cleanup();
     xbox_gamertag_source_cleanup();
 
-    monitoring_stop();
+    /* Nothing can issue a request anymore */
+    http_shutdown();
+
     io_cleanup();
 
-    obs_log(LOG_INFO, "Plugin unloaded");
+    /* The integrations and sources are gone: what is still live points at a leak */
+    memory_log_report("unload");
+
+    const double elapsed_ms = (double)(os_gettime_ns() - started_at) / 1000000.0;
+
+    if (elapsed_ms > SHUTDOWN_BUDGET_MS) {
+        obs_log(LOG_WARNING, "Plugin unloaded in %.1f ms (over the %d ms budget)", elapsed_ms, SHUTDOWN_BUDGET_MS);
+    } else {
+        obs_log(LOG_INFO, "Plugin unloaded in %.1f ms", elapsed_ms);
+    }
 }
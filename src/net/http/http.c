@@ -2,6 +2,8 @@
 
 #include <obs-module.h>
 #include <diagnostics/log.h>
+#include <diagnostics/memory_accounting.h>
+#include <util/thread_compat.h>
 
 #include <curl/curl.h>
 #include <string.h>
@@ -9,6 +11,9 @@
 #define VERBOSE 0L
 #define DEFAULT_USER_AGENT "achievements-tracker-obs-plugin/1.0"
 
+/** Timeout of a pre-warming request, in seconds. */
+#define PREWARM_TIMEOUT_S 10L
+
 /**
  * @brief Growable NUL-terminated character buffer used for HTTP response bodies.
  */
@@ -73,7 +78,7 @@ static size_t curl_write_image_cb(void *contents, size_t size, size_t nmemb, voi
             new_capacity *= 2;
         }
 
-        uint8_t *new_data = brealloc(buf->data, new_capacity);
+        uint8_t *new_data = memory_realloc(MEMORY_TAG_CACHE, buf->data, new_capacity);
         if (!new_data) {
             return 0; /* Out of memory */
         }
@@ -88,6 +93,265 @@ static size_t curl_write_image_cb(void *contents, size_t size, size_t nmemb, voi
     return realsize;
 }
 
+static pthread_mutex_t g_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** @brief Set once by http_cancel_all(); polled by every request in flight. */
+static bool g_cancelled = false;
+
+/*
+ * Every request runs on its own easy and multi handles, which used to mean a
+ * new DNS lookup and a full TLS handshake per request. The share handle gives
+ * all of them a common DNS cache and TLS session cache, so that the requests
+ * to a host already reached (or pre-warmed by http_prewarm()) skip the lookup
+ * and resume the TLS session.
+ *
+ * The connection cache is not shared: requests run concurrently on several
+ * threads, which libcurl does not support for shared connections.
+ */
+static CURLSH         *g_share = NULL;
+static pthread_mutex_t g_share_locks[CURL_LOCK_DATA_LAST];
+
+static void lock_share(CURL *curl, curl_lock_data data, curl_lock_access access, void *userptr) {
+    (void)curl;
+    (void)access;
+    (void)userptr;
+    pthread_mutex_lock(&g_share_locks[data]);
+}
+
+static void unlock_share(CURL *curl, curl_lock_data data, void *userptr) {
+    (void)curl;
+    (void)userptr;
+    pthread_mutex_unlock(&g_share_locks[data]);
+}
+
+/**
+ * @brief Get the share handle, creating it on first use.
+ *
+ * @return The share handle, or NULL if it cannot be created (the requests
+ *         then work as before, without sharing anything).
+ */
+static CURLSH *get_share(void) {
+
+    pthread_mutex_lock(&g_mutex);
+
+    if (!g_share) {
+        CURLSH *share = curl_share_init();
+
+        if (share) {
+            for (int i = 0; i < CURL_LOCK_DATA_LAST; i++) {
+                pthread_mutex_init(&g_share_locks[i], NULL);
+            }
+
+            curl_share_setopt(share, CURLSHOPT_LOCKFUNC, lock_share);
+            curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, unlock_share);
+            curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+            curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+
+            g_share = share;
+        }
+    }
+
+    CURLSH *share = g_share;
+
+    pthread_mutex_unlock(&g_mutex);
+
+    return share;
+}
+
+/**
+ * @brief Attach a request to the shared DNS and TLS session caches.
+ */
+static void apply_connection_options(CURL *curl) {
+
+    CURLSH *share = get_share();
+
+    if (share) {
+        curl_easy_setopt(curl, CURLOPT_SHARE, share);
+    }
+}
+
+/**
+ * @brief Run a configured easy handle to completion unless requests are cancelled.
+ *
+ * Drives the transfer through a private multi handle instead of
+ * curl_easy_perform() so that the cancellation flag is checked at least every
+ * HTTP_CANCEL_CHECK_MS, including while connecting or waiting for the server.
+ *
+ * @param curl Configured easy handle.
+ *
+ * @return The transfer result, or CURLE_ABORTED_BY_CALLBACK when cancelled.
+ */
+static CURLcode perform_request(CURL *curl) {
+
+    if (http_is_cancelled()) {
+        return CURLE_ABORTED_BY_CALLBACK;
+    }
+
+    apply_connection_options(curl);
+
+    CURLM *multi = curl_multi_init();
+
+    if (!multi) {
+        return CURLE_OUT_OF_MEMORY;
+    }
+
+    if (curl_multi_add_handle(multi, curl) != CURLM_OK) {
+        curl_multi_cleanup(multi);
+        return CURLE_FAILED_INIT;
+    }
+
+    CURLcode result  = CURLE_OK;
+    int      running = 1;
+
+    while (running) {
+
+        if (http_is_cancelled()) {
+            result = CURLE_ABORTED_BY_CALLBACK;
+            break;
+        }
+
+        CURLMcode code = curl_multi_perform(multi, &running);
+
+        if (code == CURLM_OK && running) {
+            code = curl_multi_poll(multi, NULL, 0, HTTP_CANCEL_CHECK_MS, NULL);
+        }
+
+        if (code != CURLM_OK) {
+            obs_log(LOG_WARNING, "curl multi failed: %s", curl_multi_strerror(code));
+            result = CURLE_RECV_ERROR;
+            break;
+        }
+    }
+
+    if (!running) {
+        int      remaining = 0;
+        CURLMsg *message;
+
+        while ((message = curl_multi_info_read(multi, &remaining)) != NULL) {
+            if (message->msg == CURLMSG_DONE && message->easy_handle == curl) {
+                result = message->data.result;
+            }
+        }
+    }
+
+    curl_multi_remove_handle(multi, curl);
+    curl_multi_cleanup(multi);
+
+    return result;
+}
+
+void http_cancel_all(void) {
+    pthread_mutex_lock(&g_mutex);
+    g_cancelled = true;
+    pthread_mutex_unlock(&g_mutex);
+}
+
+bool http_is_cancelled(void) {
+
+    pthread_mutex_lock(&g_mutex);
+    const bool cancelled = g_cancelled;
+    pthread_mutex_unlock(&g_mutex);
+
+    return cancelled;
+}
+
+size_t http_prewarm(const char *const *urls, size_t count) {
+
+    if (!urls || count == 0 || http_is_cancelled()) {
+        return 0;
+    }
+
+    CURLM *multi = curl_multi_init();
+
+    if (!multi) {
+        return 0;
+    }
+
+    CURL **handles = bzalloc(count * sizeof(CURL *));
+
+    for (size_t i = 0; i < count; i++) {
+        CURL *curl = curl_easy_init();
+
+        if (!curl) {
+            continue;
+        }
+
+        /* A HEAD request: the body is not needed, only the DNS entry and TLS session it leaves in the caches */
+        curl_easy_setopt(curl, CURLOPT_URL, urls[i]);
+        curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT, PREWARM_TIMEOUT_S);
+        curl_easy_setopt(curl, CURLOPT_USERAGENT, DEFAULT_USER_AGENT);
+        apply_connection_options(curl);
+
+        if (curl_multi_add_handle(multi, curl) != CURLM_OK) {
+            curl_easy_cleanup(curl);
+            continue;
+        }
+
+        handles[i] = curl;
+    }
+
+    /* Every handshake runs at the same time */
+    int running = 1;
+
+    while (running && !http_is_cancelled()) {
+        CURLMcode code = curl_multi_perform(multi, &running);
+
+        if (code == CURLM_OK && running) {
+            code = curl_multi_poll(multi, NULL, 0, HTTP_CANCEL_CHECK_MS, NULL);
+        }
+
+        if (code != CURLM_OK) {
+            break;
+        }
+    }
+
+    size_t   warmed    = 0;
+    int      remaining = 0;
+    CURLMsg *message;
+
+    while ((message = curl_multi_info_read(multi, &remaining)) != NULL) {
+        if (message->msg == CURLMSG_DONE && message->data.result == CURLE_OK) {
+            warmed++;
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (handles[i]) {
+            curl_multi_remove_handle(multi, handles[i]);
+            curl_easy_cleanup(handles[i]);
+        }
+    }
+
+    bfree(handles);
+    curl_multi_cleanup(multi);
+
+    obs_log(LOG_DEBUG, "[HTTP] Pre-warmed %zu of %zu host(s)", warmed, count);
+
+    return warmed;
+}
+
+void http_shutdown(void) {
+
+    pthread_mutex_lock(&g_mutex);
+    CURLSH *share = g_share;
+    g_share       = NULL;
+    pthread_mutex_unlock(&g_mutex);
+
+    if (!share) {
+        return;
+    }
+
+    if (curl_share_cleanup(share) != CURLSHE_OK) {
+        obs_log(LOG_WARNING, "[HTTP] Shared caches still in use at shutdown");
+        return;
+    }
+
+    for (int i = 0; i < CURL_LOCK_DATA_LAST; i++) {
+        pthread_mutex_destroy(&g_share_locks[i]);
+    }
+}
+
 char *http_post_form(const char *url, const char *post_fields, long *out_http_code) {
     if (out_http_code)
         *out_http_code = 0;
@@ -114,7 +378,7 @@ char *http_post_form(const char *url, const char *post_fields, long *out_http_co
     curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
     curl_easy_setopt(curl, CURLOPT_FAILONERROR, 0L);
 
-    CURLcode res = curl_easy_perform(curl);
+    CURLcode res = perform_request(curl);
 
     if (res != CURLE_OK) {
         obs_log(LOG_WARNING, "curl POST form failed: %s", curl_easy_strerror(res));
@@ -191,7 +455,7 @@ char *http_post(const char *url, const char *body, const char *extra_headers, lo
     curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
     curl_easy_setopt(curl, CURLOPT_FAILONERROR, 0L);
 
-    CURLcode res = curl_easy_perform(curl);
+    CURLcode res = perform_request(curl);
     if (res != CURLE_OK) {
         obs_log(LOG_WARNING, "curl POST failed: %s", curl_easy_strerror(res));
         curl_slist_free_all(headers);
@@ -267,7 +531,7 @@ char *http_post_json(const char *url, const char *json_body, const char *extra_h
     curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
     curl_easy_setopt(curl, CURLOPT_FAILONERROR, 0L);
 
-    CURLcode res = curl_easy_perform(curl);
+    CURLcode res = perform_request(curl);
 
     if (res != CURLE_OK) {
         obs_log(LOG_WARNING, "curl POST json failed: %s", curl_easy_strerror(res));
@@ -349,7 +613,7 @@ char *http_get(const char *url, const char *extra_headers, const char *post_fiel
     if (post_fields)
         curl_easy_setopt(curl, CURLOPT_POSTFIELDS, post_fields);
 
-    CURLcode res = curl_easy_perform(curl);
+    CURLcode res = perform_request(curl);
 
     if (res != CURLE_OK) {
         obs_log(LOG_WARNING, "curl GET failed: %s", curl_easy_strerror(res));
@@ -553,7 +817,7 @@ bool http_download(const char *url, uint8_t **out_data, size_t *out_size) {
     curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
     curl_easy_setopt(curl, CURLOPT_USERAGENT, DEFAULT_USER_AGENT);
 
-    CURLcode res = curl_easy_perform(curl);
+    CURLcode res = perform_request(curl);
 
     long http_code = 0;
     curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
@@ -562,13 +826,13 @@ bool http_download(const char *url, uint8_t **out_data, size_t *out_size) {
 
     if (res != CURLE_OK) {
         obs_log(LOG_ERROR, "Download failed: %s", curl_easy_strerror(res));
-        bfree(buf.data);
+        memory_free(buf.data);
         return false;
     }
 
     if (http_code < 200 || http_code >= 300) {
         obs_log(LOG_ERROR, "Download failed: server returned HTTP %ld for '%s'", http_code, url);
-        bfree(buf.data);
+        memory_free(buf.data);
         return false;
     }
 
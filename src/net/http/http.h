@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 
@@ -8,6 +9,58 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Abort every in-flight request and fail all future ones.
+ *
+ * Used on plugin unload so that threads blocked in a request (token refresh,
+ * REST calls, image downloads) return within @ref HTTP_CANCEL_CHECK_MS instead
+ * of waiting for the 30 s request timeout. Cancelled requests fail the same way
+ * as a network error. Irreversible; safe to call from any thread.
+ */
+void http_cancel_all(void);
+
+/**
+ * @brief Check whether @ref http_cancel_all has been called.
+ *
+ * Lets long-running loops built on top of HTTP (polling, prefetching) stop
+ * between requests.
+ *
+ * @return true once requests are cancelled.
+ */
+bool http_is_cancelled(void);
+
+/** Maximum delay, in milliseconds, between a cancellation and the request returning. */
+#define HTTP_CANCEL_CHECK_MS 50
+
+/**
+ * @brief Warm the DNS cache and TLS session cache for a set of hosts.
+ *
+ * All requests share one DNS cache and TLS session cache. This sends a HEAD
+ * request to every URL at once, so that the DNS lookups and TLS handshakes
+ * happen in parallel and the next requests to the same hosts find the address
+ * cached and resume the TLS session instead of a full handshake.
+ *
+ * No connection is kept open: the connection cache is not shared (see
+ * http.c), so the next requests still open their own TCP connection, only
+ * without the lookup and with an abbreviated TLS handshake.
+ *
+ * Blocks until every request has completed (at most a few seconds) or
+ * requests are cancelled: call it from a background thread.
+ *
+ * @param urls  URLs on the hosts to connect to (the responses are ignored).
+ * @param count Number of URLs.
+ *
+ * @return Number of hosts successfully reached.
+ */
+size_t http_prewarm(const char *const *urls, size_t count);
+
+/**
+ * @brief Release the shared DNS and TLS session caches.
+ *
+ * Meant for plugin unload, once no thread can issue a request anymore.
+ */
+void http_shutdown(void);
+
 /**
  * @brief POST application/x-www-form-urlencoded data.
  *
@@ -68,8 +121,8 @@ char *http_get(const char *url, const char *extra_headers, const char *post_fiel
 /**
  * @brief Download a resource into a raw byte buffer.
  *
- * The returned buffer is allocated with OBS' allocator and must be freed with
- * bfree().
+ * The returned buffer is accounted to the cache memory tag and must be freed
+ * with memory_free() (see memory_accounting.h).
  *
  * @param url      Resource URL.
  * @param out_data Receives a newly allocated buffer containing the downloaded bytes.
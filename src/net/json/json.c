@@ -1,5 +1,7 @@
 #include "net/json/json.h"
 
+#include "util/arena.h"
+
 #include <obs-module.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -107,24 +109,6 @@ long *json_read_long(const char *json, const char *key) {
     return out_value;
 }
 
-/**
- * @brief Duplicate a character range into a newly allocated NUL-terminated string.
- *
- * @param start First character in the range (inclusive).
- * @param end   One past the last character in the range (exclusive).
- * @return Newly allocated string (caller must bfree()), or NULL on invalid range.
- */
-static char *dup_range(const char *start, const char *end) {
-    if (!start || !end || end < start)
-        return NULL;
-
-    size_t len = (size_t)(end - start);
-    char  *out = bzalloc(len + 1);
-    memcpy(out, start, len);
-    out[len] = '\0';
-    return out;
-}
-
 /**
  * @brief Extract an object value (as a JSON substring) for a given key.
  *
@@ -132,34 +116,26 @@ static char *dup_range(const char *start, const char *end) {
  * Handles nested objects and skips over quoted strings so braces inside strings
  * don't affect depth counting.
  *
- * @param json JSON text.
- * @param key  Object key to extract.
- * @return Newly allocated JSON substring (caller must bfree()), or NULL on failure.
+ * @param scratch Arena receiving the substring.
+ * @param json    JSON text.
+ * @param key     Object key to extract.
+ * @return JSON substring allocated from @p scratch, or NULL on failure.
  */
-static char *json_read_object_subjson(const char *json, const char *key) {
+static char *json_read_object_subjson(arena_t *scratch, const char *json, const char *key) {
     if (!json || !key)
         return NULL;
 
-    const size_t needle_cap = strlen(key) + 3; /* quotes + NUL */
-    char        *needle     = bzalloc(needle_cap);
-    if (!needle)
+    char needle[260];
+    if (snprintf(needle, sizeof(needle), "\"%s\"", key) >= (int)sizeof(needle))
         return NULL;
 
-    snprintf(needle, needle_cap, "\"%s\"", key);
-
     const char *p = strstr(json, needle);
-    if (!p) {
-        bfree(needle);
+    if (!p)
         return NULL;
-    }
 
     p = strchr(p + strlen(needle), ':');
-    if (!p) {
-        bfree(needle);
+    if (!p)
         return NULL;
-    }
-
-    bfree(needle);
 
     p++; /* after ':' */
     while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')
@@ -198,7 +174,7 @@ static char *json_read_object_subjson(const char *json, const char *key) {
 
         if (depth == 0) {
             const char *end = p; /* one past '}' */
-            return dup_range(start, end);
+            return arena_strndup(scratch, start, (size_t)(end - start));
         }
     }
 
@@ -212,8 +188,10 @@ char *json_read_string_from_path(const char *json, const char *path) {
     const char *seg_start = path;
     const char *seg_end   = path;
 
-    char *current_json = NULL; /* allocated when we descend */
-    char *result       = NULL;
+    /* The intermediate objects only live until the value is read */
+    arena_t *scratch      = NULL;
+    char    *current_json = NULL; /* allocated from scratch when we descend */
+    char    *result       = NULL;
 
     while (1) {
         while (*seg_end && *seg_end != '.')
@@ -236,13 +214,12 @@ char *json_read_string_from_path(const char *json, const char *path) {
             result = json_read_string(use_json, key);
             goto cleanup;
         } else {
-            char *next_json = json_read_object_subjson(use_json, key);
-            if (!next_json)
-                goto cleanup;
+            if (!scratch)
+                scratch = arena_create(strlen(json) + 1);
 
-            if (current_json)
-                bfree(current_json);
-            current_json = next_json;
+            current_json = json_read_object_subjson(scratch, use_json, key);
+            if (!current_json)
+                goto cleanup;
 
             seg_end++; /* skip '.' */
             seg_start = seg_end;
@@ -250,8 +227,7 @@ char *json_read_string_from_path(const char *json, const char *path) {
     }
 
 cleanup:
-    if (current_json)
-        bfree(current_json);
+    arena_destroy(&scratch);
 
     return result;
 }
@@ -0,0 +1,193 @@
+#include "net/obs_websocket/obs_websocket_vendor.h"
+
+#include <obs-module.h>
+#include <callback/calldata.h>
+#include <callback/proc.h>
+#include <diagnostics/log.h>
+
+#include "integrations/event_stream.h"
+#include "integrations/monitoring_service.h"
+#include "sources/common/achievement_cycle.h"
+
+#define VENDOR_NAME "achievements-tracker"
+
+/**
+ * @brief Request callback layout expected by obs-websocket's "vendor_request_register" procedure.
+ *
+ * Mirrors @c obs_websocket_request_callback from obs-websocket-api.h; the
+ * structure is copied by obs-websocket during the call.
+ */
+typedef struct vendor_request_callback {
+    void (*callback)(obs_data_t *request_data, obs_data_t *response_data, void *priv_data);
+    void *priv_data;
+} vendor_request_callback_t;
+
+/** obs-websocket's vendor proc handler, or NULL when obs-websocket is not available. */
+static proc_handler_t *g_vendor_ph = NULL;
+
+/** Opaque vendor handle returned by "vendor_register". */
+static void *g_vendor = NULL;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Private functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+static proc_handler_t *get_vendor_proc_handler(void) {
+
+    calldata_t cd;
+    calldata_init(&cd);
+
+    proc_handler_t *ph = NULL;
+
+    if (proc_handler_call(obs_get_proc_handler(), "obs_websocket_api_get_ph", &cd)) {
+        ph = calldata_ptr(&cd, "ph");
+    }
+
+    calldata_free(&cd);
+
+    return ph;
+}
+
+static void emit_event(const char *event_type, const char *json) {
+
+    obs_data_t *event_data = obs_data_create_from_json(json);
+
+    if (!event_data) {
+        return;
+    }
+
+    calldata_t cd;
+    calldata_init(&cd);
+    calldata_set_ptr(&cd, "vendor", g_vendor);
+    calldata_set_string(&cd, "type", event_type);
+    calldata_set_ptr(&cd, "data", event_data);
+
+    proc_handler_call(g_vendor_ph, "vendor_event_emit", &cd);
+
+    calldata_free(&cd);
+    obs_data_release(event_data);
+}
+
+static void on_get_snapshot(obs_data_t *request_data, obs_data_t *response_data, void *priv_data) {
+    UNUSED_PARAMETER(request_data);
+    UNUSED_PARAMETER(priv_data);
+
+    char       *json     = event_stream_get_snapshot();
+    obs_data_t *snapshot = obs_data_create_from_json(json);
+
+    if (snapshot) {
+        obs_data_apply(response_data, snapshot);
+        obs_data_release(snapshot);
+    }
+
+    bfree(json);
+}
+
+static bool register_request(const char *request_type, vendor_request_callback_t callback) {
+
+    calldata_t cd;
+    calldata_init(&cd);
+    calldata_set_ptr(&cd, "vendor", g_vendor);
+    calldata_set_string(&cd, "type", request_type);
+    calldata_set_ptr(&cd, "callback", &callback);
+
+    proc_handler_call(g_vendor_ph, "vendor_request_register", &cd);
+    const bool success = calldata_bool(&cd, "success");
+
+    calldata_free(&cd);
+
+    return success;
+}
+
+static bool unregister_request(const char *request_type) {
+
+    calldata_t cd;
+    calldata_init(&cd);
+    calldata_set_ptr(&cd, "vendor", g_vendor);
+    calldata_set_string(&cd, "type", request_type);
+
+    proc_handler_call(g_vendor_ph, "vendor_request_unregister", &cd);
+    const bool success = calldata_bool(&cd, "success");
+
+    calldata_free(&cd);
+
+    return success;
+}
+
+static void on_game_played(const game_t *game) {
+    event_stream_game_changed(game);
+}
+
+static void on_session_ready(void) {
+    event_stream_achievements_loaded(monitoring_get_current_game_achievements());
+}
+
+static void on_achievement_updated(const achievement_t *achievement) {
+    event_stream_achievement_updated(achievement);
+}
+
+static void on_cycle_moved(const achievement_t *achievement) {
+    event_stream_cycle_moved(achievement);
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public API
+//  --------------------------------------------------------------------------------------------------------------------
+
+void obs_websocket_vendor_init(void) {
+
+    monitoring_subscribe_game_played(on_game_played);
+    monitoring_subscribe_session_ready(on_session_ready);
+    monitoring_subscribe_achievement_updated(on_achievement_updated);
+    achievement_cycle_subscribe(on_cycle_moved);
+}
+
+void obs_websocket_vendor_register(void) {
+
+    g_vendor_ph = get_vendor_proc_handler();
+
+    if (!g_vendor_ph) {
+        obs_log(LOG_INFO, "[WebSocketVendor] obs-websocket not available: achievement events are not published");
+        return;
+    }
+
+    calldata_t cd;
+    calldata_init(&cd);
+    calldata_set_string(&cd, "name", VENDOR_NAME);
+
+    proc_handler_call(g_vendor_ph, "vendor_register", &cd);
+    g_vendor = calldata_ptr(&cd, "vendor");
+
+    calldata_free(&cd);
+
+    if (!g_vendor) {
+        obs_log(LOG_WARNING, "[WebSocketVendor] Failed to register the %s vendor", VENDOR_NAME);
+        g_vendor_ph = NULL;
+        return;
+    }
+
+    if (!register_request("GetSnapshot", (vendor_request_callback_t){.callback = on_get_snapshot})) {
+        obs_log(LOG_WARNING, "[WebSocketVendor] Failed to register the GetSnapshot request");
+    }
+
+    event_stream_set_sink(emit_event);
+
+    obs_log(LOG_INFO, "[WebSocketVendor] Publishing achievement events as vendor %s", VENDOR_NAME);
+}
+
+void obs_websocket_vendor_unregister(void) {
+
+    monitoring_unsubscribe_game_played(on_game_played);
+    monitoring_unsubscribe_session_ready(on_session_ready);
+    monitoring_unsubscribe_achievement_updated(on_achievement_updated);
+    achievement_cycle_unsubscribe(on_cycle_moved);
+    event_stream_cleanup();
+
+    /* obs-websocket outlives the module: it must not keep a callback into it */
+    if (g_vendor && !unregister_request("GetSnapshot")) {
+        obs_log(LOG_WARNING, "[WebSocketVendor] Failed to unregister the GetSnapshot request");
+    }
+
+    g_vendor    = NULL;
+    g_vendor_ph = NULL;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file obs_websocket_vendor.h
+ * @brief Publishes the achievement event stream over obs-websocket.
+ *
+ * Registers the "achievements-tracker" vendor with obs-websocket (v5) so that
+ * browser-source overlays and stream-deck tools receive the events described
+ * in event_stream.h over the OBS websocket they already use, instead of
+ * polling:
+ *
+ *   - Events are emitted as vendor events (@c VendorEvent with
+ *     @c vendorName "achievements-tracker"); clients receive them when they
+ *     subscribe to the @c Vendors event category.
+ *   - The @c GetSnapshot vendor request returns the full current state with
+ *     its generation number.
+ *
+ * The vendor API is reached through obs-websocket's proc handler, so there is
+ * no build-time dependency: when obs-websocket is not installed, registration
+ * is skipped and the plugin works as before.
+ *
+ * Lifecycle:
+ *   Call @ref obs_websocket_vendor_init from @c obs_module_load, before the
+ *   monitors start, so the snapshot sees every event;
+ *   @ref obs_websocket_vendor_register from @c obs_module_post_load (the
+ *   vendor API is only available once obs-websocket is loaded); and
+ *   @ref obs_websocket_vendor_unregister from @c obs_module_unload.
+ */
+
+/**
+ * @brief Feed the monitoring and display cycle events to the event stream.
+ *
+ * Call after achievement_cycle_init().
+ */
+void obs_websocket_vendor_init(void);
+
+/**
+ * @brief Register the vendor and start emitting the events.
+ */
+void obs_websocket_vendor_register(void);
+
+/**
+ * @brief Stop emitting events and release the event stream.
+ *
+ * Call after the monitors have been stopped and before
+ * achievement_cycle_destroy().
+ */
+void obs_websocket_vendor_unregister(void);
+
+#ifdef __cplusplus
+}
+#endif
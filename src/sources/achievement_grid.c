@@ -0,0 +1,1086 @@
+#include "sources/achievement_grid.h"
+
+/**
+ * @file achievement_grid.c
+ * @brief OBS source drawing every achievement of the current game as a grid.
+ *
+ * Design notes:
+ *  - The icons are baked into one atlas texture (a texrender kept across
+ *    frames): locked ones in greyscale, unlocked ones in colour. The grid is
+ *    then drawn from that single texture in a single draw call: the quads of
+ *    the visible icons, progress bars and highlight are written to one
+ *    dynamic vertex buffer, and a scroll only changes where they are.
+ *  - The atlas is updated incrementally: the model (see
+ *    achievement_grid_model.h) marks the cells whose icon or unlock state
+ *    changed, and at most ATLAS_LOADS_PER_FRAME of them are redrawn per frame.
+ *  - The icons are downloaded to the cache by a worker, never on the
+ *    graphics thread.
+ *  - The atlas is kept while the sources are hidden, so that showing them
+ *    again does not bake every icon anew.
+ */
+
+#include <obs-module.h>
+#include <graphics/graphics.h>
+#include <graphics/vec2.h>
+#include <graphics/vec3.h>
+#include <graphics/vec4.h>
+#include <util/platform.h>
+#include <util/thread_compat.h>
+#include <diagnostics/log.h>
+#include <diagnostics/memory_accounting.h>
+#include <math.h>
+
+#include "common/achievement.h"
+#include "drawing/image.h"
+#include "integrations/monitoring_service.h"
+#include "io/cache.h"
+#include "io/image_request.h"
+#include "sources/common/achievement_grid_model.h"
+#include "sources/common/image_source.h"
+#include "sources/common/source_activity.h"
+#include "util/worker_pool.h"
+#include "time/clock.h"
+
+/** Size of an icon in the atlas, in pixels. */
+#define ATLAS_CELL_SIZE 64
+
+/** Number of icons per row of the atlas (2048 px). */
+#define ATLAS_COLUMNS 32
+
+/** Maximum number of rows of the atlas (8192 px, 4096 achievements). */
+#define ATLAS_MAX_ROWS 128
+
+/** Maximum number of icons decoded and baked into the atlas per frame. */
+#define ATLAS_LOADS_PER_FRAME 8
+
+#define SETTING_COLUMNS         "grid_columns"
+#define SETTING_ROWS            "grid_rows"
+#define SETTING_CELL_SIZE       "grid_cell_size"
+#define SETTING_SPACING         "grid_spacing"
+#define SETTING_SCROLL_SPEED    "grid_scroll_speed"
+#define SETTING_HIGHLIGHT_COLOR "grid_highlight_color"
+
+/** Gold, in the ABGR layout of the OBS color properties. */
+#define DEFAULT_HIGHLIGHT_COLOR 0xFF00D7FF
+
+/** Background of the progress bars: black at 60% (ABGR). */
+#define PROGRESS_BACKGROUND_COLOR 0x99000000
+
+/** Color of the icon quads: the atlas texels are drawn unchanged (ABGR). */
+#define ICON_COLOR 0xFFFFFFFF
+
+/** Quads drawn per cell at most: the icon, the progress bar and its background, the four sides of the highlight. */
+#define QUADS_PER_CELL 7
+
+#define VERTICES_PER_QUAD 6
+
+/**
+ * @brief Per-instance data of an Achievement Grid source.
+ */
+typedef struct achievement_grid_source {
+    obs_source_t           *source;
+    uint32_t                columns;
+    uint32_t                rows;
+    uint32_t                cell_size;
+    uint32_t                spacing;
+    /** Scroll speed, in pixels per second (0 disables the scroll). */
+    float                   scroll_speed;
+    /** Highlight color (ABGR). */
+    uint32_t                highlight_color;
+    /** Current scroll position, in pixels from the first row. */
+    float                   scroll_offset;
+    /** Size of a cell in the output, declared to pick the icons' download resolution. */
+    image_request_display_t display;
+} achievement_grid_source_t;
+
+/**
+ * @brief Visible part of a cell, in source coordinates.
+ */
+typedef struct grid_slot {
+    size_t index;
+    float  x;
+    /** Top of the cell (may be above the source when scrolling). */
+    float  y;
+    /** Part of the cell hidden above the source. */
+    float  hidden_top;
+    /** Visible height of the cell. */
+    float  visible_height;
+} grid_slot_t;
+
+typedef void (*grid_slot_visitor_t)(const achievement_grid_source_t *source, const grid_slot_t *slot, void *context);
+
+/**
+ * @brief Triangles of the frame, written into the dynamic vertex buffer.
+ */
+typedef struct grid_batch {
+    struct vec3 *points;
+    uint32_t    *colors;
+    struct vec2 *uvs;
+    /** Number of vertices written. */
+    size_t       count;
+    size_t       capacity;
+} grid_batch_t;
+
+/**
+ * @brief Cells of the current game, and whether a download task is queued.
+ *
+ * Written by the monitoring callbacks and the download task, read by the
+ * render. Protected by g_mutex.
+ */
+static pthread_mutex_t          g_mutex           = PTHREAD_MUTEX_INITIALIZER;
+static achievement_grid_model_t g_model           = {.highlighted = -1};
+static bool                     g_download_queued = false;
+
+/**
+ * @brief Single joinable worker running the icon downloads.
+ */
+static worker_pool_t *g_download_pool = NULL;
+
+/**
+ * @brief Atlas of the icons. Graphics thread only.
+ */
+static gs_texrender_t *g_atlas      = NULL;
+static uint32_t        g_atlas_rows = 0;
+
+/** Number of cells, as of the last render. Graphics thread only. */
+static size_t g_cell_count = 0;
+
+/**
+ * @brief Effect and vertex buffer drawing the grid. Graphics thread only.
+ */
+static gs_effect_t     *g_effect                = NULL;
+static bool             g_effect_load_attempted = false;
+static gs_vertbuffer_t *g_vertex_buffer         = NULL;
+static size_t           g_vertex_capacity       = 0;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Private functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+static int64_t atlas_bytes(uint32_t rows) {
+    return (int64_t)ATLAS_COLUMNS * ATLAS_CELL_SIZE * rows * ATLAS_CELL_SIZE * 4;
+}
+
+static uint32_t atlas_rows_for(size_t cell_count) {
+    const size_t rows = (cell_count + ATLAS_COLUMNS - 1) / ATLAS_COLUMNS;
+    return rows > ATLAS_MAX_ROWS ? ATLAS_MAX_ROWS : (uint32_t)rows;
+}
+
+static uint32_t grid_rows_for(const achievement_grid_source_t *source, size_t cell_count) {
+    const size_t capacity = (size_t)ATLAS_COLUMNS * ATLAS_MAX_ROWS;
+    const size_t count    = cell_count > capacity ? capacity : cell_count;
+    return (uint32_t)((count + source->columns - 1) / source->columns);
+}
+
+static float grid_pitch(const achievement_grid_source_t *source) {
+    return (float)(source->cell_size + source->spacing);
+}
+
+static uint32_t grid_width(const achievement_grid_source_t *source) {
+    return source->columns * source->cell_size + (source->columns - 1) * source->spacing;
+}
+
+static uint32_t grid_height(const achievement_grid_source_t *source) {
+    return source->rows * source->cell_size + (source->rows - 1) * source->spacing;
+}
+
+/**
+ * @brief Destroy the atlas. Must be called inside the graphics context.
+ */
+static void destroy_atlas(void) {
+
+    if (!g_atlas) {
+        return;
+    }
+
+    gs_texrender_destroy(g_atlas);
+    memory_account(MEMORY_TAG_GPU, -atlas_bytes(g_atlas_rows));
+
+    g_atlas      = NULL;
+    g_atlas_rows = 0;
+}
+
+static int64_t vertex_buffer_bytes(size_t capacity) {
+    return (int64_t)(capacity * (sizeof(struct vec3) + sizeof(uint32_t) + sizeof(struct vec2)));
+}
+
+/**
+ * @brief Destroy the vertex buffer. Must be called inside the graphics context.
+ */
+static void destroy_vertex_buffer(void) {
+
+    if (!g_vertex_buffer) {
+        return;
+    }
+
+    gs_vertexbuffer_destroy(g_vertex_buffer);
+    memory_account(MEMORY_TAG_GPU, -vertex_buffer_bytes(g_vertex_capacity));
+
+    g_vertex_buffer   = NULL;
+    g_vertex_capacity = 0;
+}
+
+/**
+ * @brief Create the vertex buffer for a number of vertices, if it cannot hold them yet.
+ *
+ * Only grows: the instances share it, and the largest grid sets its size.
+ * Must be called inside the graphics context.
+ *
+ * @return True if the buffer holds at least @p capacity vertices.
+ */
+static bool ensure_vertex_buffer(size_t capacity) {
+
+    if (g_vertex_buffer && g_vertex_capacity >= capacity) {
+        return true;
+    }
+
+    destroy_vertex_buffer();
+
+    struct gs_vb_data *data = gs_vbdata_create();
+    data->num               = capacity;
+    data->points            = bzalloc(capacity * sizeof(struct vec3));
+    data->colors            = bzalloc(capacity * sizeof(uint32_t));
+    data->num_tex           = 1;
+    data->tvarray           = bzalloc(sizeof(struct gs_tvertarray));
+    data->tvarray[0].width  = 2;
+    data->tvarray[0].array  = bzalloc(capacity * sizeof(struct vec2));
+
+    /* Takes ownership of the data */
+    g_vertex_buffer = gs_vertexbuffer_create(data, GS_DYNAMIC);
+
+    if (!g_vertex_buffer) {
+        obs_log(LOG_ERROR, "[Achievement Grid] Failed to create the vertex buffer");
+        return false;
+    }
+
+    g_vertex_capacity = capacity;
+    memory_account(MEMORY_TAG_GPU, vertex_buffer_bytes(capacity));
+
+    return true;
+}
+
+/**
+ * @brief Create the grid effect on first use.
+ *
+ * Draws textured and solid quads in the same call: the quads sample the atlas
+ * and are tinted by their vertex color, and a negative texture coordinate
+ * marks a solid quad.
+ */
+static void load_effect(void) {
+
+    if (g_effect || g_effect_load_attempted) {
+        return;
+    }
+
+    g_effect_load_attempted = true;
+
+    const char *effect_code = "uniform float4x4 ViewProj;\n"
+                              "uniform texture2d image;\n"
+                              "\n"
+                              "sampler_state def_sampler {\n"
+                              "    Filter   = Linear;\n"
+                              "    AddressU = Clamp;\n"
+                              "    AddressV = Clamp;\n"
+                              "};\n"
+                              "\n"
+                              "struct VertInOut {\n"
+                              "    float4 pos   : POSITION;\n"
+                              "    float4 color : COLOR;\n"
+                              "    float2 uv    : TEXCOORD0;\n"
+                              "};\n"
+                              "\n"
+                              "VertInOut VSDefault(VertInOut vert_in)\n"
+                              "{\n"
+                              "    VertInOut vert_out;\n"
+                              "    vert_out.pos   = mul(float4(vert_in.pos.xyz, 1.0), ViewProj);\n"
+                              "    vert_out.color = vert_in.color;\n"
+                              "    vert_out.uv    = vert_in.uv;\n"
+                              "    return vert_out;\n"
+                              "}\n"
+                              "\n"
+                              "float4 PSGrid(VertInOut vert_in) : TARGET\n"
+                              "{\n"
+                              "    float4 texel = image.Sample(def_sampler, saturate(vert_in.uv));\n"
+                              "    return (vert_in.uv.x < 0.0 ? float4(1.0, 1.0, 1.0, 1.0) : texel) * vert_in.color;\n"
+                              "}\n"
+                              "\n"
+                              "technique Draw\n"
+                              "{\n"
+                              "    pass\n"
+                              "    {\n"
+                              "        vertex_shader = VSDefault(vert_in);\n"
+                              "        pixel_shader  = PSGrid(vert_in);\n"
+                              "    }\n"
+                              "}\n";
+
+    char *error_string = NULL;
+    g_effect           = gs_effect_create(effect_code, "achievement_grid_effect", &error_string);
+
+    if (error_string) {
+        obs_log(LOG_ERROR, "[Achievement Grid] Effect compile error: %s", error_string);
+        bfree(error_string);
+    }
+}
+
+/**
+ * @brief Append a quad (two triangles) to the batch.
+ *
+ * @param u0 Texture coordinates of the top-left corner; negative for a solid quad.
+ */
+static void add_quad(grid_batch_t *batch, float x, float y, float width, float height, float u0, float v0, float u1,
+                     float v1, uint32_t color) {
+
+    if (batch->count + VERTICES_PER_QUAD > batch->capacity) {
+        return;
+    }
+
+    const float xs[VERTICES_PER_QUAD] = {x, x + width, x, x + width, x + width, x};
+    const float ys[VERTICES_PER_QUAD] = {y, y, y + height, y, y + height, y + height};
+    const float us[VERTICES_PER_QUAD] = {u0, u1, u0, u1, u1, u0};
+    const float vs[VERTICES_PER_QUAD] = {v0, v0, v1, v0, v1, v1};
+
+    for (size_t i = 0; i < VERTICES_PER_QUAD; i++) {
+        vec3_set(&batch->points[batch->count], xs[i], ys[i], 0.0f);
+        vec2_set(&batch->uvs[batch->count], us[i], vs[i]);
+        batch->colors[batch->count] = color;
+        batch->count++;
+    }
+}
+
+/**
+ * @brief Fill a rectangle of the current effect with a solid color.
+ *
+ * Must be called inside a pass of the solid effect.
+ */
+static void fill_rect(gs_eparam_t *color_param, uint32_t color, float x, float y, float width, float height) {
+
+    if (width < 1.0f || height < 1.0f) {
+        return;
+    }
+
+    struct vec4 value;
+    vec4_from_rgba(&value, color);
+    gs_effect_set_vec4(color_param, &value);
+
+    gs_matrix_push();
+    gs_matrix_translate3f(x, y, 0.0f);
+    gs_draw_sprite(NULL, 0, (uint32_t)(width + 0.5f), (uint32_t)(height + 0.5f));
+    gs_matrix_pop();
+}
+
+/**
+ * @brief Create the atlas for a number of rows, if it does not have them yet.
+ *
+ * Must be called inside the graphics context.
+ *
+ * @return True if a new, empty atlas was created.
+ */
+static bool ensure_atlas(uint32_t rows) {
+
+    if (rows == 0) {
+        destroy_atlas();
+        return false;
+    }
+
+    if (g_atlas && g_atlas_rows == rows) {
+        return false;
+    }
+
+    destroy_atlas();
+
+    g_atlas = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+
+    if (!g_atlas) {
+        obs_log(LOG_ERROR, "[Achievement Grid] Failed to create the icon atlas");
+        return false;
+    }
+
+    g_atlas_rows = rows;
+    memory_account(MEMORY_TAG_GPU, atlas_bytes(rows));
+
+    /* Start from transparent cells */
+    if (gs_texrender_begin(g_atlas, ATLAS_COLUMNS * ATLAS_CELL_SIZE, rows * ATLAS_CELL_SIZE)) {
+        struct vec4 transparent;
+        vec4_zero(&transparent);
+        gs_clear(GS_CLEAR_COLOR, &transparent, 0.0f, 0);
+        gs_texrender_end(g_atlas);
+    }
+
+    obs_log(LOG_DEBUG, "[Achievement Grid] Created a %u-row icon atlas", rows);
+
+    return true;
+}
+
+/**
+ * @brief Redraw cells of the atlas from their cached icons.
+ *
+ * The atlas keeps its content: only the given cells are overwritten. Must be
+ * called inside the graphics context.
+ */
+static void bake_cells(const achievement_grid_dirty_cell_t *cells, size_t count) {
+
+    gs_texrender_reset(g_atlas);
+
+    if (!gs_texrender_begin(g_atlas, ATLAS_COLUMNS * ATLAS_CELL_SIZE, g_atlas_rows * ATLAS_CELL_SIZE)) {
+        return;
+    }
+
+    gs_ortho(0.0f,
+             (float)(ATLAS_COLUMNS * ATLAS_CELL_SIZE),
+             0.0f,
+             (float)(g_atlas_rows * ATLAS_CELL_SIZE),
+             -100.0f,
+             100.0f);
+
+    /* Overwrite the cells, transparent pixels included */
+    gs_blend_state_push();
+    gs_blend_function(GS_BLEND_ONE, GS_BLEND_ZERO);
+
+    gs_effect_t *solid       = obs_get_base_effect(OBS_EFFECT_SOLID);
+    gs_eparam_t *color_param = gs_effect_get_param_by_name(solid, "color");
+
+    for (size_t i = 0; i < count; i++) {
+        const achievement_grid_dirty_cell_t *cell = &cells[i];
+
+        if (cell->index >= (size_t)g_atlas_rows * ATLAS_COLUMNS) {
+            continue;
+        }
+
+        const float x = (float)(cell->index % ATLAS_COLUMNS * ATLAS_CELL_SIZE);
+        const float y = (float)(cell->index / ATLAS_COLUMNS * ATLAS_CELL_SIZE);
+
+        while (gs_effect_loop(solid, "Solid")) {
+            fill_rect(color_param, 0, x, y, ATLAS_CELL_SIZE, ATLAS_CELL_SIZE);
+        }
+
+        if (cell->cache_path[0] == '\0') {
+            continue;
+        }
+
+        gs_texture_t *icon = gs_texture_create_from_file(cell->cache_path);
+
+        if (!icon) {
+            obs_log(LOG_WARNING,
+                    "[Achievement Grid] Failed to create texture from the cache file '%s'",
+                    cell->cache_path);
+            continue;
+        }
+
+        gs_matrix_push();
+        gs_matrix_translate3f(x, y, 0.0f);
+
+        if (cell->unlocked) {
+            draw_texture(icon, ATLAS_CELL_SIZE, ATLAS_CELL_SIZE, NULL);
+        } else {
+            draw_texture_greyscale(icon, ATLAS_CELL_SIZE, ATLAS_CELL_SIZE, NULL);
+        }
+
+        gs_matrix_pop();
+
+        gs_texture_destroy(icon);
+    }
+
+    gs_blend_state_pop();
+
+    gs_texrender_end(g_atlas);
+}
+
+/**
+ * @brief Bring the atlas up to date with the model. Graphics thread only.
+ */
+static void update_atlas(void) {
+
+    achievement_grid_dirty_cell_t cells[ATLAS_LOADS_PER_FRAME];
+
+    pthread_mutex_lock(&g_mutex);
+
+    g_cell_count = g_model.count;
+
+    if (ensure_atlas(atlas_rows_for(g_cell_count))) {
+        achievement_grid_model_mark_all_dirty(&g_model);
+    }
+
+    const size_t count = g_atlas ? achievement_grid_model_take_dirty(&g_model, cells, ATLAS_LOADS_PER_FRAME) : 0;
+
+    pthread_mutex_unlock(&g_mutex);
+
+    if (count > 0) {
+        bake_cells(cells, count);
+    }
+}
+
+/**
+ * @brief Call a visitor for the visible part of every visible cell.
+ *
+ * When the rows do not fit, the grid scrolls and wraps around: the first row
+ * follows the last one.
+ */
+static void visit_visible_cells(const achievement_grid_source_t *source, grid_slot_visitor_t visitor, void *context) {
+
+    const uint32_t total_rows = grid_rows_for(source, g_cell_count);
+    const float    pitch      = grid_pitch(source);
+    const float    height     = (float)grid_height(source);
+    const bool     scrolling  = total_rows > source->rows && source->scroll_speed > 0.0f;
+
+    uint32_t first_row = 0;
+    float    first_y   = 0.0f;
+    uint32_t row_count = total_rows < source->rows ? total_rows : source->rows;
+
+    if (scrolling) {
+        first_row = (uint32_t)(source->scroll_offset / pitch) % total_rows;
+        first_y   = (float)first_row * pitch - source->scroll_offset;
+        row_count = source->rows + 1;
+    }
+
+    for (uint32_t row = 0; row < row_count; row++) {
+        const uint32_t content_row = (first_row + row) % total_rows;
+        const float    y           = first_y + (float)row * pitch;
+        const float    top         = fmaxf(y, 0.0f);
+        const float    bottom      = fminf(y + (float)source->cell_size, height);
+
+        if (bottom <= top) {
+            continue;
+        }
+
+        for (uint32_t column = 0; column < source->columns; column++) {
+            const size_t index = (size_t)content_row * source->columns + column;
+
+            if (index >= g_cell_count || index >= (size_t)g_atlas_rows * ATLAS_COLUMNS) {
+                break;
+            }
+
+            const grid_slot_t slot = {
+                .index          = index,
+                .x              = (float)column * pitch,
+                .y              = y,
+                .hidden_top     = top - y,
+                .visible_height = bottom - top,
+            };
+
+            visitor(source, &slot, context);
+        }
+    }
+}
+
+/**
+ * @brief Add a solid rectangle of a cell to the batch, clipped to its visible part.
+ */
+static void add_cell_rect(grid_batch_t *batch, uint32_t color, const grid_slot_t *slot, float x, float y, float width,
+                          float height) {
+
+    const float top    = fmaxf(y, slot->y + slot->hidden_top);
+    const float bottom = fminf(y + height, slot->y + slot->hidden_top + slot->visible_height);
+
+    if (width < 1.0f || bottom - top < 1.0f) {
+        return;
+    }
+
+    add_quad(batch, x, top, width, bottom - top, -1.0f, -1.0f, -1.0f, -1.0f, color);
+}
+
+/**
+ * @brief Add the icon of a cell, then its progress bar and highlight border, to the batch.
+ *
+ * The icon is taken from the atlas and clipped to the source. Must be called
+ * with g_mutex held.
+ */
+static void add_cell(const achievement_grid_source_t *source, const grid_slot_t *slot, void *context) {
+
+    grid_batch_t *batch = context;
+    const float   size  = (float)source->cell_size;
+    const float   scale = size / ATLAS_CELL_SIZE;
+
+    const float atlas_width  = (float)(ATLAS_COLUMNS * ATLAS_CELL_SIZE);
+    const float atlas_height = (float)(g_atlas_rows * ATLAS_CELL_SIZE);
+    const float atlas_x      = (float)(slot->index % ATLAS_COLUMNS * ATLAS_CELL_SIZE);
+    const float atlas_y      = (float)(slot->index / ATLAS_COLUMNS * ATLAS_CELL_SIZE);
+
+    add_quad(batch,
+             slot->x,
+             slot->y + slot->hidden_top,
+             size,
+             slot->visible_height,
+             atlas_x / atlas_width,
+             (atlas_y + slot->hidden_top / scale) / atlas_height,
+             (atlas_x + ATLAS_CELL_SIZE) / atlas_width,
+             (atlas_y + (slot->hidden_top + slot->visible_height) / scale) / atlas_height,
+             ICON_COLOR);
+
+    if (slot->index >= g_model.count) {
+        return;
+    }
+
+    const achievement_grid_cell_t *cell = &g_model.cells[slot->index];
+
+    if (cell->unlocked_timestamp == 0 && cell->progress >= 0.0f) {
+        const float bar_height = fmaxf(2.0f, size / 12.0f);
+        const float bar_y      = slot->y + size - bar_height;
+
+        add_cell_rect(batch, PROGRESS_BACKGROUND_COLOR, slot, slot->x, bar_y, size, bar_height);
+        add_cell_rect(batch, source->highlight_color, slot, slot->x, bar_y, size * cell->progress, bar_height);
+    }
+
+    if ((int)slot->index == g_model.highlighted) {
+        const float    border = fmaxf(2.0f, size / 16.0f);
+        const uint32_t color  = source->highlight_color;
+
+        add_cell_rect(batch, color, slot, slot->x, slot->y, size, border);
+        add_cell_rect(batch, color, slot, slot->x, slot->y + size - border, size, border);
+        add_cell_rect(batch, color, slot, slot->x, slot->y, border, size);
+        add_cell_rect(batch, color, slot, slot->x + size - border, slot->y, border, size);
+    }
+}
+
+/**
+ * @brief Worker task downloading the icons waiting in the model.
+ *
+ * Downloads one icon at a time until none is waiting, so that an update
+ * arriving meanwhile is picked up by the same task.
+ */
+static void download_task(void *arg) {
+
+    UNUSED_PARAMETER(arg);
+
+    achievement_grid_download_t download;
+
+    while (!worker_pool_is_stopping(g_download_pool)) {
+        pthread_mutex_lock(&g_mutex);
+
+        if (!achievement_grid_model_take_pending(&g_model, &download)) {
+            g_download_queued = false;
+            pthread_mutex_unlock(&g_mutex);
+            return;
+        }
+
+        pthread_mutex_unlock(&g_mutex);
+
+        /* The path is written on a cache hit too: the file tells whether the icon is there */
+        char cache_path[1024] = "";
+        cache_download(download.icon_url, "achievement_icon", download.id, cache_path, sizeof(cache_path));
+
+        pthread_mutex_lock(&g_mutex);
+        achievement_grid_model_icon_downloaded(&g_model, &download, os_file_exists(cache_path) ? cache_path : NULL);
+        pthread_mutex_unlock(&g_mutex);
+
+        achievement_grid_download_free(&download);
+    }
+
+    pthread_mutex_lock(&g_mutex);
+    g_download_queued = false;
+    pthread_mutex_unlock(&g_mutex);
+}
+
+/**
+ * @brief Release a download task that was dropped before running.
+ */
+static void discard_download_task(void *arg) {
+
+    UNUSED_PARAMETER(arg);
+
+    pthread_mutex_lock(&g_mutex);
+    g_download_queued = false;
+    pthread_mutex_unlock(&g_mutex);
+}
+
+/**
+ * @brief Queue the download task, unless it is already queued or running.
+ */
+static void schedule_downloads(void) {
+
+    pthread_mutex_lock(&g_mutex);
+    const bool must_queue = g_download_pool && !g_download_queued;
+    g_download_queued     = g_download_queued || must_queue;
+    pthread_mutex_unlock(&g_mutex);
+
+    if (must_queue && !worker_pool_submit(g_download_pool, download_task, discard_download_task, NULL)) {
+        obs_log(LOG_ERROR, "[Achievement Grid] Failed to queue the icon downloads");
+
+        pthread_mutex_lock(&g_mutex);
+        g_download_queued = false;
+        pthread_mutex_unlock(&g_mutex);
+    }
+}
+
+/**
+ * @brief Apply a list of achievements and download the new icons.
+ */
+static void update_grid(const achievement_t *achievements) {
+
+    pthread_mutex_lock(&g_mutex);
+    const size_t pending = achievement_grid_model_update(&g_model, achievements);
+    const size_t count   = g_model.count;
+    pthread_mutex_unlock(&g_mutex);
+
+    obs_log(LOG_DEBUG, "[Achievement Grid] %zu achievements, %zu icons to download", count, pending);
+
+    if (pending > 0) {
+        schedule_downloads();
+    }
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//	Event handlers
+//  --------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Monitoring service callback invoked when a new game is played.
+ *
+ * @param game Current game, or NULL when no game is played anymore.
+ */
+static void on_game_played(const game_t *game) {
+
+    update_grid(game ? monitoring_get_current_game_achievements() : NULL);
+}
+
+/**
+ * @brief Monitoring service callback invoked when the achievements change.
+ *
+ * An unlock re-sorts the list: the model keeps the cells in place and only
+ * redraws the unlocked one.
+ */
+static void on_achievements_changed(void) {
+
+    update_grid(monitoring_get_current_game_achievements());
+}
+
+/**
+ * @brief Monitoring service callback invoked when one achievement progresses.
+ */
+static void on_achievement_updated(const achievement_t *achievement) {
+
+    pthread_mutex_lock(&g_mutex);
+    achievement_grid_model_update_one(&g_model, achievement);
+    pthread_mutex_unlock(&g_mutex);
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//	Source callbacks
+//  --------------------------------------------------------------------------------------------------------------------
+
+/** @brief OBS callback returning the width of the grid. */
+static uint32_t source_get_width(void *data) {
+    const achievement_grid_source_t *source = data;
+    return grid_width(source);
+}
+
+/** @brief OBS callback returning the height of the grid. */
+static uint32_t source_get_height(void *data) {
+    const achievement_grid_source_t *source = data;
+    return grid_height(source);
+}
+
+/** @brief OBS callback returning the display name for this source type. */
+static const char *source_get_name(void *unused) {
+
+    UNUSED_PARAMETER(unused);
+
+    return "Achievement Grid";
+}
+
+/**
+ * @brief OBS callback invoked when source settings are updated.
+ */
+static void on_source_update(void *data, obs_data_t *settings) {
+
+    achievement_grid_source_t *source = data;
+
+    source->columns         = (uint32_t)obs_data_get_int(settings, SETTING_COLUMNS);
+    source->rows            = (uint32_t)obs_data_get_int(settings, SETTING_ROWS);
+    source->cell_size       = (uint32_t)obs_data_get_int(settings, SETTING_CELL_SIZE);
+    source->spacing         = (uint32_t)obs_data_get_int(settings, SETTING_SPACING);
+    source->scroll_speed    = (float)obs_data_get_int(settings, SETTING_SCROLL_SPEED);
+    source->highlight_color = (uint32_t)obs_data_get_int(settings, SETTING_HIGHLIGHT_COLOR);
+
+    if (source->columns == 0) {
+        source->columns = 1;
+    }
+
+    if (source->rows == 0) {
+        source->rows = 1;
+    }
+
+    if (source->cell_size == 0) {
+        source->cell_size = ATLAS_CELL_SIZE;
+    }
+
+    source->scroll_offset = 0.0f;
+}
+
+/**
+ * @brief OBS callback creating a new achievement grid source instance.
+ *
+ * @param settings Source settings.
+ * @param source   OBS source instance pointer.
+ * @return Newly allocated achievement_grid_source_t structure.
+ */
+static void *on_source_create(obs_data_t *settings, obs_source_t *source) {
+
+    achievement_grid_source_t *s = memory_alloc(MEMORY_TAG_RENDER, sizeof(achievement_grid_source_t));
+    s->source                    = source;
+
+    on_source_update(s, settings);
+
+    /* Sized on render, from the cell size and the transform; counted once in the program */
+    image_request_display_init(&s->display, "achievement_icon", s->cell_size, s->cell_size);
+
+    return s;
+}
+
+/**
+ * @brief OBS callback destroying an achievement grid source instance.
+ *
+ * The atlas and the cells are shared by all the instances and released during
+ * plugin unload.
+ */
+static void on_source_destroy(void *data) {
+
+    achievement_grid_source_t *source = data;
+
+    if (!source) {
+        return;
+    }
+
+    image_request_display_set_active(&source->display, false);
+
+    memory_free(source);
+}
+
+/**
+ * @brief OBS @c activate callback: count the grid's icon size while it is in the program.
+ */
+static void on_source_activate(void *data) {
+
+    achievement_grid_source_t *source = data;
+
+    if (source) {
+        image_request_display_set_active(&source->display, true);
+    }
+
+    source_activity_activate(data);
+}
+
+/**
+ * @brief OBS @c deactivate callback.
+ */
+static void on_source_deactivate(void *data) {
+
+    achievement_grid_source_t *source = data;
+
+    if (source) {
+        image_request_display_set_active(&source->display, false);
+    }
+
+    source_activity_deactivate(data);
+}
+
+/**
+ * @brief Declare the size of a cell in the output, picking up the cell size setting and the transform.
+ *
+ * The icons are baked into the atlas: a cell drawn larger than an atlas cell
+ * gains nothing from a larger download.
+ */
+static void update_display(achievement_grid_source_t *source) {
+
+    const source_size_t cell = image_source_get_output_size(
+        (source_size_t){.width = source->cell_size, .height = source->cell_size});
+
+    image_request_display_set_size(&source->display,
+                                   cell.width < ATLAS_CELL_SIZE ? cell.width : ATLAS_CELL_SIZE,
+                                   cell.height < ATLAS_CELL_SIZE ? cell.height : ATLAS_CELL_SIZE);
+}
+
+static void source_get_defaults(obs_data_t *settings) {
+    obs_data_set_default_int(settings, SETTING_COLUMNS, 8);
+    obs_data_set_default_int(settings, SETTING_ROWS, 4);
+    obs_data_set_default_int(settings, SETTING_CELL_SIZE, 64);
+    obs_data_set_default_int(settings, SETTING_SPACING, 8);
+    obs_data_set_default_int(settings, SETTING_SCROLL_SPEED, 20);
+    obs_data_set_default_int(settings, SETTING_HIGHLIGHT_COLOR, DEFAULT_HIGHLIGHT_COLOR);
+}
+
+/**
+ * @brief OBS callback to render the grid.
+ *
+ * Bakes the changed cells into the atlas, then draws the visible cells from
+ * it, with their progress bars and highlight on top, in a single draw call.
+ *
+ * @param data   Source instance data.
+ * @param effect Unused: the source draws with its own effects (OBS_SOURCE_CUSTOM_DRAW).
+ */
+static void on_source_video_render(void *data, gs_effect_t *effect) {
+
+    UNUSED_PARAMETER(effect);
+
+    achievement_grid_source_t *source = data;
+
+    if (!source) {
+        return;
+    }
+
+    update_display(source);
+    update_atlas();
+
+    gs_texture_t *atlas = g_atlas ? gs_texrender_get_texture(g_atlas) : NULL;
+
+    if (!atlas || g_cell_count == 0) {
+        return;
+    }
+
+    load_effect();
+
+    /* The scroll shows one more row, partly */
+    const size_t visible_cells = (size_t)source->columns * (source->rows + 1);
+
+    if (!g_effect || !ensure_vertex_buffer(visible_cells * QUADS_PER_CELL * VERTICES_PER_QUAD)) {
+        return;
+    }
+
+    struct gs_vb_data *vertices = gs_vertexbuffer_get_data(g_vertex_buffer);
+    grid_batch_t       batch    = {
+        .points   = vertices->points,
+        .colors   = vertices->colors,
+        .uvs      = vertices->tvarray[0].array,
+        .count    = 0,
+        .capacity = g_vertex_capacity,
+    };
+
+    pthread_mutex_lock(&g_mutex);
+    visit_visible_cells(source, add_cell, &batch);
+    pthread_mutex_unlock(&g_mutex);
+
+    if (batch.count == 0) {
+        return;
+    }
+
+    gs_vertexbuffer_flush(g_vertex_buffer);
+
+    /* The icons, progress bars and highlight: one texture, one draw */
+    gs_effect_set_texture(gs_effect_get_param_by_name(g_effect, "image"), atlas);
+    gs_load_vertexbuffer(g_vertex_buffer);
+    gs_load_indexbuffer(NULL);
+
+    while (gs_effect_loop(g_effect, "Draw")) {
+        gs_draw(GS_TRIS, 0, (uint32_t)batch.count);
+    }
+}
+
+/**
+ * @brief OBS callback for animation tick.
+ *
+ * Advances the scroll when the achievements do not fit in the grid.
+ */
+static void on_source_video_tick(void *data, float seconds) {
+
+    if (!source_activity_is_visible()) {
+        return;
+    }
+
+    seconds = clock_scale_frame(seconds);
+
+    achievement_grid_source_t *source = data;
+
+    if (!source) {
+        return;
+    }
+
+    const uint32_t total_rows = grid_rows_for(source, g_cell_count);
+
+    if (total_rows <= source->rows || source->scroll_speed <= 0.0f) {
+        source->scroll_offset = 0.0f;
+        return;
+    }
+
+    const float content_height = (float)total_rows * grid_pitch(source);
+
+    source->scroll_offset = fmodf(source->scroll_offset + source->scroll_speed * seconds, content_height);
+}
+
+/**
+ * @brief OBS callback constructing the properties UI for the achievement grid source.
+ *
+ * @param data Source instance data (unused).
+ * @return Newly created obs_properties_t structure containing the UI controls.
+ */
+static obs_properties_t *source_get_properties(void *data) {
+
+    UNUSED_PARAMETER(data);
+
+    obs_properties_t *p = obs_properties_create();
+
+    obs_properties_add_int(p, SETTING_COLUMNS, "Columns", 1, 32, 1);
+    obs_properties_add_int(p, SETTING_ROWS, "Rows", 1, 32, 1);
+    obs_properties_add_int(p, SETTING_CELL_SIZE, "Icon size", 16, 256, 1);
+    obs_properties_add_int(p, SETTING_SPACING, "Spacing", 0, 64, 1);
+    obs_properties_add_int(p, SETTING_SCROLL_SPEED, "Scroll speed (pixels per second, 0 to disable)", 0, 500, 1);
+    obs_properties_add_color(p, SETTING_HIGHLIGHT_COLOR, "Highlight and progress color");
+
+    return p;
+}
+
+/**
+ * @brief obs_source_info describing the Achievement Grid source.
+ */
+static struct obs_source_info xbox_achievement_grid_source_info = {
+    .id             = "xbox_achievement_grid_source",
+    .type           = OBS_SOURCE_TYPE_INPUT,
+    .output_flags   = OBS_SOURCE_VIDEO | OBS_SOURCE_CUSTOM_DRAW,
+    .get_name       = source_get_name,
+    .create         = on_source_create,
+    .destroy        = on_source_destroy,
+    .update         = on_source_update,
+    .get_defaults   = source_get_defaults,
+    .video_render   = on_source_video_render,
+    .get_properties = source_get_properties,
+    .get_width      = source_get_width,
+    .get_height     = source_get_height,
+    .video_tick     = on_source_video_tick,
+    .show           = source_activity_show,
+    .hide           = source_activity_hide,
+    .activate       = on_source_activate,
+    .deactivate     = on_source_deactivate,
+};
+
+/**
+ * @brief Get the obs_source_info for registration.
+ */
+static const struct obs_source_info *xbox_achievement_grid_source_get(void) {
+    return &xbox_achievement_grid_source_info;
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public API
+//  --------------------------------------------------------------------------------------------------------------------
+
+void xbox_achievement_grid_source_register(void) {
+
+    g_download_pool = worker_pool_create("Achievement Grid", THREAD_CLASS_IO, 1);
+
+    obs_register_source(xbox_achievement_grid_source_get());
+
+    monitoring_subscribe_game_played(&on_game_played);
+    monitoring_subscribe_achievements_changed(&on_achievements_changed);
+    monitoring_subscribe_achievement_updated(&on_achievement_updated);
+}
+
+void xbox_achievement_grid_source_cleanup(void) {
+
+    /* Wait for the running download before freeing the cells it writes to */
+    worker_pool_destroy(&g_download_pool);
+
+    obs_enter_graphics();
+    destroy_atlas();
+    destroy_vertex_buffer();
+
+    if (g_effect) {
+        gs_effect_destroy(g_effect);
+        g_effect = NULL;
+    }
+
+    g_effect_load_attempted = false;
+    obs_leave_graphics();
+
+    pthread_mutex_lock(&g_mutex);
+    achievement_grid_model_free(&g_model);
+    g_download_queued = false;
+    pthread_mutex_unlock(&g_mutex);
+}
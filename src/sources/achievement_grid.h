@@ -0,0 +1,44 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Register the Achievement Grid source with OBS.
+ *
+ * This function registers an OBS source that displays every achievement of the
+ * current game as a grid of icons. The source automatically updates when
+ * achievements are unlocked or progress by subscribing to monitoring service
+ * events.
+ *
+ * The source provides the following features:
+ * - Locked achievements in greyscale, unlocked ones in colour
+ * - A progress bar under the locked, measured achievements
+ * - A border around the latest unlocked achievement
+ * - Smooth scrolling when the achievements do not fit
+ * - Configurable columns, rows, cell size, spacing, speed and highlight color
+ *
+ * The icons are baked once into an atlas texture, and only the cells that
+ * change are redrawn: the whole grid is drawn from that one texture.
+ *
+ * This function should be called once during plugin initialization (typically in
+ * obs_module_load()) to make the source available in OBS.
+ *
+ * @note This function allocates resources and subscribes to monitoring callbacks.
+ *
+ * @see xbox_achievement_icon_source_register() for the icon of a single achievement
+ */
+void xbox_achievement_grid_source_register(void);
+
+/**
+ * @brief Clean up resources allocated by the achievement grid source.
+ *
+ * Stops the icon downloads, destroys the atlas texture and frees the cells.
+ * Should be called during plugin shutdown (obs_module_unload()).
+ */
+void xbox_achievement_grid_source_cleanup(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -3,11 +3,16 @@
 #include <obs-module.h>
 #include <util/thread_compat.h>
 #include <diagnostics/log.h>
+#include <diagnostics/memory_accounting.h>
 
 #include "common/achievement.h"
 #include "sources/common/achievement_cycle.h"
+#include "io/image_request.h"
 #include "sources/common/image_source.h"
+#include "sources/common/source_activity.h"
 #include "sources/common/visibility_cycle.h"
+#include "util/worker_pool.h"
+#include "time/clock.h"
 
 /**
  * @brief Global singleton achievement icon cache.
@@ -56,7 +61,7 @@ static icon_transition_state_t g_transition = {
 };
 
 /**
- * @brief Flag set by the download thread when image_source_download completes.
+ * @brief Flag set by the download task when the latest requested icon is cached.
  *
  * The OBS video tick checks this flag and applies the transition state on the
  * render thread, avoiding any blocking I/O on the graphics pipeline.
@@ -65,32 +70,76 @@ static icon_transition_state_t g_transition = {
 static pthread_mutex_t g_download_ready_mutex = PTHREAD_MUTEX_INITIALIZER;
 static volatile bool   g_download_ready       = false;
 
+/**
+ * @brief Identifier of the latest icon request, bumped on every request.
+ *
+ * A download task only publishes its result if no newer request was made in
+ * the meantime. Protected by g_download_ready_mutex.
+ */
+static uint32_t g_download_generation = 0;
+
+/**
+ * @brief Single joinable worker running the icon downloads.
+ *
+ * Joined by xbox_achievement_icon_source_cleanup() before the icons are freed,
+ * so no download can outlive the globals it writes to.
+ */
+static worker_pool_t *g_download_pool = NULL;
+
 /**
  * @brief Whether the achievement whose icon is being downloaded was unlocked.
  *
- * Written by the video tick thread before spawning the download, read back when
+ * Written by the video tick thread before queuing the download, read back when
  * the download completes.  Only accessed from one thread at a time (set before
- * pthread_create, read after g_download_ready is observed).
+ * queuing, read after g_download_ready is observed).
  */
 static bool g_pending_has_state_changed = false;
 
 /**
- * @brief Background thread entry point for downloading achievement icons.
+ * @brief A queued icon download.
+ *
+ * The task works on its own copy of the request instead of
+ * g_next_achievement_icon, which a newer request may rewrite at any time.
+ */
+typedef struct icon_download {
+    image_t  image;
+    uint32_t generation;
+} icon_download_t;
+
+/**
+ * @brief Worker task downloading an achievement icon to the cache.
  *
  * Calls image_source_download (which may perform HTTP I/O and file writes),
- * then signals completion via g_download_ready so the video tick can apply the
- * transition on the render thread.
+ * then, unless a newer icon was requested meanwhile, publishes the cache path
+ * into g_next_achievement_icon and signals completion via g_download_ready so
+ * the video tick can apply the transition on the render thread.
  *
- * @param arg Pointer to the image_t to download into (g_next_achievement_icon).
- * @return NULL (unused).
+ * @param arg Heap-allocated icon_download_t; freed by this task.
  */
-static void *download_thread_func(void *arg) {
-    image_t *image = arg;
-    image_source_download(image);
+static void download_task(void *arg) {
+    icon_download_t *download = arg;
+
+    image_source_download(&download->image);
+
     pthread_mutex_lock(&g_download_ready_mutex);
-    g_download_ready = true;
+    if (download->generation == g_download_generation) {
+        snprintf(g_next_achievement_icon->cache_path,
+                 sizeof(g_next_achievement_icon->cache_path),
+                 "%s",
+                 download->image.cache_path);
+        g_next_achievement_icon->must_reload = true;
+        g_download_ready                     = true;
+    }
     pthread_mutex_unlock(&g_download_ready_mutex);
-    return NULL;
+
+    bfree(download);
+}
+
+/**
+ * @brief Release a download that was dropped before running.
+ */
+static void discard_download_task(void *arg) {
+    bfree(arg);
 }
 
 /**
@@ -101,10 +150,12 @@ static void *download_thread_func(void *arg) {
  * reflects the correct visual state after the swap.
  */
 static void swap_achievement_icons(void) {
-    /* Swap the images */
+    /* Swap the images (a download task may be publishing into the next one) */
+    pthread_mutex_lock(&g_download_ready_mutex);
     image_t *tmp              = g_achievement_icon;
     g_achievement_icon        = g_next_achievement_icon;
     g_next_achievement_icon   = tmp;
+    pthread_mutex_unlock(&g_download_ready_mutex);
     /* Also swap the unlocked status */
     g_is_achievement_unlocked = g_transition.pending_is_unlocked;
 }
@@ -156,18 +207,29 @@ static void update_achievement_icon(const achievement_t *achievement) {
     g_transition.phase   = ICON_TRANSITION_NONE;
     g_transition.opacity = 1.0f;
 
-    //  Dispatch the download to a background thread so we never block the
-    //  OBS video/render thread with HTTP I/O.
+    //  Dispatch the download to the background worker so we never block the
+    //  OBS video/render thread with HTTP I/O. Only the latest request matters:
+    //  drop the ones still queued.
     g_transition.pending_is_unlocked = is_new_unlocked_achievement;
     g_pending_has_state_changed      = has_state_changed;
+
+    icon_download_t *download = bzalloc(sizeof(icon_download_t));
+
+    pthread_mutex_lock(&g_download_ready_mutex);
     snprintf(g_next_achievement_icon->id, sizeof(g_next_achievement_icon->id), "%s", achievement->id);
     snprintf(g_next_achievement_icon->url, sizeof(g_next_achievement_icon->url), "%s", achievement->icon_url);
+    download->image      = *g_next_achievement_icon;
+    download->generation = ++g_download_generation;
+    g_download_ready     = false;
+    pthread_mutex_unlock(&g_download_ready_mutex);
 
-    pthread_t thread;
-    if (pthread_create(&thread, NULL, download_thread_func, g_next_achievement_icon) == 0) {
-        pthread_detach(thread);
-    } else {
-        obs_log(LOG_ERROR, "[Achievement Icon] Failed to create download thread");
+    /* The copy must not own the texture of the next icon */
+    download->image.texture = NULL;
+
+    worker_pool_cancel_pending(g_download_pool);
+
+    if (!worker_pool_submit(g_download_pool, download_task, discard_download_task, download)) {
+        obs_log(LOG_ERROR, "[Achievement Icon] Failed to queue the icon download");
     }
 }
 
@@ -188,6 +250,24 @@ static void on_achievement_changed(const achievement_t *achievement) {
     update_achievement_icon(achievement);
 }
 
+/**
+ * @brief Release the icon textures while no tracker source is visible.
+ *
+ * Both icons keep their cache path: the displayed one is reloaded by the next
+ * render, the next one when it is swapped in.
+ */
+static void on_source_activity_changed(bool visible) {
+
+    if (visible) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_download_ready_mutex);
+    image_source_release(g_achievement_icon);
+    image_source_release(g_next_achievement_icon);
+    pthread_mutex_unlock(&g_download_ready_mutex);
+}
+
 //  --------------------------------------------------------------------------------------------------------------------
 //	Source callbacks
 //  --------------------------------------------------------------------------------------------------------------------
@@ -241,11 +321,14 @@ static void *on_source_create(obs_data_t *settings, obs_source_t *source) {
 
     UNUSED_PARAMETER(settings);
 
-    image_source_t *s = bzalloc(sizeof(image_source_t));
+    image_source_t *s = memory_alloc(MEMORY_TAG_RENDER, sizeof(image_source_t));
     s->source         = source;
     s->size.width     = 200;
     s->size.height    = 200;
 
+    /* The icons are downloaded at the largest size drawn by a source in the program */
+    image_request_display_init(&s->display, "achievement_icon", s->size.width, s->size.height);
+
     return s;
 }
 
@@ -266,7 +349,9 @@ static void on_source_destroy(void *data) {
         return;
     }
 
-    free_memory((void **)&source);
+    image_request_display_set_active(&source->display, false);
+
+    memory_free(source);
 }
 
 /**
@@ -306,6 +391,8 @@ static void on_source_video_render(void *data, gs_effect_t *effect) {
         return;
     }
 
+    image_source_update_display(source);
+
     /* Load image if needed (deferred load in graphics context) */
     image_source_reload_if_needed(g_achievement_icon);
 
@@ -353,6 +440,12 @@ static void on_source_video_tick(void *data, float seconds) {
 
     UNUSED_PARAMETER(data);
 
+    if (!source_activity_is_visible()) {
+        return;
+    }
+
+    seconds = clock_scale_frame(seconds);
+
     /* Check if a background download has completed */
     bool download_ready = lock_and_check_download_status();
     if (download_ready) {
@@ -444,6 +537,10 @@ static struct obs_source_info xbox_achievement_icon_source_info = {
     .get_width      = source_get_width,
     .get_height     = source_get_height,
     .video_tick     = on_source_video_tick,
+    .show           = source_activity_show,
+    .hide           = source_activity_hide,
+    .activate       = image_source_activate,
+    .deactivate     = image_source_deactivate,
 };
 
 /**
@@ -463,31 +560,42 @@ static const struct obs_source_info *xbox_achievement_icon_source_get(void) {
 
 void xbox_achievement_icon_source_register(void) {
 
-    g_achievement_icon        = bzalloc(sizeof(image_t));
+    g_achievement_icon        = memory_alloc(MEMORY_TAG_RENDER, sizeof(image_t));
     g_achievement_icon->id[0] = '\0';
     snprintf(g_achievement_icon->display_name, sizeof(g_achievement_icon->display_name), "Achievement Icon");
     snprintf(g_achievement_icon->type, sizeof(g_achievement_icon->type), "achievement_icon");
 
-    g_next_achievement_icon        = bzalloc(sizeof(image_t));
+    g_next_achievement_icon        = memory_alloc(MEMORY_TAG_RENDER, sizeof(image_t));
     g_next_achievement_icon->id[0] = '\0';
     snprintf(g_next_achievement_icon->display_name, sizeof(g_next_achievement_icon->display_name), "Achievement Icon");
     snprintf(g_next_achievement_icon->type, sizeof(g_next_achievement_icon->type), "achievement_icon");
 
+    g_download_pool = worker_pool_create("Achievement Icon", THREAD_CLASS_IO, 1);
+
     obs_register_source(xbox_achievement_icon_source_get());
 
     auto_visibility_register_config(&g_auto_visibility);
 
     achievement_cycle_subscribe(&on_achievement_changed);
+
+    source_activity_subscribe(&on_source_activity_changed);
 }
 
 void xbox_achievement_icon_source_cleanup(void) {
+    source_activity_unsubscribe(&on_source_activity_changed);
+
+    /* Wait for the running download before freeing the icons it writes to */
+    worker_pool_destroy(&g_download_pool);
+
     if (g_achievement_icon) {
         image_source_destroy(g_achievement_icon);
-        free_memory((void **)&g_achievement_icon);
+        memory_free(g_achievement_icon);
+        g_achievement_icon = NULL;
     }
 
     if (g_next_achievement_icon) {
         image_source_destroy(g_next_achievement_icon);
-        free_memory((void **)&g_next_achievement_icon);
+        memory_free(g_next_achievement_icon);
+        g_next_achievement_icon = NULL;
     }
 }
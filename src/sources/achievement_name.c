@@ -25,6 +25,7 @@
 
 #include "sources/common/achievement_cycle.h"
 #include "sources/common/text_source.h"
+#include "sources/common/source_activity.h"
 #include "sources/common/visibility_cycle.h"
 #include "common/achievement.h"
 
@@ -33,6 +34,7 @@
 #include <diagnostics/log.h>
 
 #include "io/state.h"
+#include "time/clock.h"
 
 #define NO_FLIP 0
 
@@ -336,6 +338,12 @@ static void on_source_video_render(void *data, gs_effect_t *effect) {
  */
 static void on_source_video_tick(void *data, float seconds) {
 
+    if (!source_activity_is_visible()) {
+        return;
+    }
+
+    seconds = clock_scale_frame(seconds);
+
     text_source_t *source = data;
 
     if (!source) {
@@ -406,6 +414,10 @@ static struct obs_source_info xbox_achievement_name_source = {
     .get_height     = source_get_height,
     .video_tick     = on_source_video_tick,
     .video_render   = on_source_video_render,
+    .show           = source_activity_show,
+    .hide           = source_activity_hide,
+    .activate       = source_activity_activate,
+    .deactivate     = source_activity_deactivate,
 };
 
 /**
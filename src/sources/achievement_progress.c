@@ -0,0 +1,295 @@
+#include "sources/achievement_progress.h"
+
+/**
+ * @file achievement_progress.c
+ * @brief OBS source drawing the progress of the current achievement as a bar.
+ *
+ * The progress string of the achievement ("5/10") is parsed once per update
+ * into a ratio; the bar itself is drawn by a pixel shader (see
+ * drawing/progress_bar.h). The video tick eases the displayed ratio towards
+ * the latest one (see achievement_progress_model.h), so that even counters
+ * updated many times per second move smoothly, without any text
+ * rasterization.
+ *
+ * The source follows the achievement shown by the other achievement sources:
+ * the achievement cycle is advanced by their video ticks.
+ */
+
+#include <obs-module.h>
+#include <util/thread_compat.h>
+#include <diagnostics/log.h>
+#include <diagnostics/memory_accounting.h>
+
+#include "common/achievement.h"
+#include "common/types.h"
+#include "drawing/progress_bar.h"
+#include "sources/common/achievement_cycle.h"
+#include "sources/common/achievement_progress_model.h"
+#include "sources/common/source_activity.h"
+#include "sources/common/visibility_cycle.h"
+#include "time/clock.h"
+
+#define SETTING_WIDTH            "progress_width"
+#define SETTING_HEIGHT           "progress_height"
+#define SETTING_FILL_COLOR       "progress_fill_color"
+#define SETTING_BACKGROUND_COLOR "progress_background_color"
+
+/** Xbox green, in the ABGR layout of the OBS color properties. */
+#define DEFAULT_FILL_COLOR 0xFF107C10
+
+/** Black at 60% (ABGR). */
+#define DEFAULT_BACKGROUND_COLOR 0x99000000
+
+/**
+ * @brief Per-instance data of an Achievement Progress source.
+ */
+typedef struct progress_source {
+    obs_source_t *source;
+    source_size_t size;
+    /** Colors (ABGR). */
+    uint32_t      fill_color;
+    uint32_t      background_color;
+} progress_source_t;
+
+/**
+ * @brief State of the bar, shared by all the instances.
+ *
+ * Written by the achievement cycle callback (from the monitor or the video
+ * thread) and the video tick, read by the render. Protected by g_progress_mutex.
+ */
+static pthread_mutex_t              g_progress_mutex = PTHREAD_MUTEX_INITIALIZER;
+static achievement_progress_model_t g_progress;
+
+static auto_visibility_config_t g_auto_visibility = {
+    .enabled       = false,
+    .show_duration = AUTO_VISIBILITY_DEFAULT_SHARED_SHOW_DURATION,
+    .hide_duration = AUTO_VISIBILITY_DEFAULT_SHARED_HIDE_DURATION,
+    .fade_duration = AUTO_VISIBILITY_DEFAULT_SHARED_FADE_DURATION,
+};
+
+//  --------------------------------------------------------------------------------------------------------------------
+//	Event handlers
+//  --------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Achievement cycle callback invoked when the displayed achievement changes or progresses.
+ *
+ * The bar is shown for a locked, measured achievement. When the achievement
+ * on display gets unlocked, the bar fills up while it fades out.
+ *
+ * @param achievement Achievement to display, or NULL.
+ */
+static void on_achievement_changed(const achievement_t *achievement) {
+
+    pthread_mutex_lock(&g_progress_mutex);
+    achievement_progress_model_set_achievement(&g_progress, achievement);
+    pthread_mutex_unlock(&g_progress_mutex);
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//	Source callbacks
+//  --------------------------------------------------------------------------------------------------------------------
+
+/** @brief OBS callback returning the configured source width. */
+static uint32_t source_get_width(void *data) {
+    const progress_source_t *s = data;
+    return s->size.width;
+}
+
+/** @brief OBS callback returning the configured source height. */
+static uint32_t source_get_height(void *data) {
+    const progress_source_t *s = data;
+    return s->size.height;
+}
+
+/** @brief OBS callback returning the display name for this source type. */
+static const char *source_get_name(void *unused) {
+
+    UNUSED_PARAMETER(unused);
+
+    return "Achievement (Progress)";
+}
+
+/**
+ * @brief OBS callback invoked when source settings are updated.
+ */
+static void on_source_update(void *data, obs_data_t *settings) {
+
+    progress_source_t *source = data;
+
+    source->size.width       = (uint32_t)obs_data_get_int(settings, SETTING_WIDTH);
+    source->size.height      = (uint32_t)obs_data_get_int(settings, SETTING_HEIGHT);
+    source->fill_color       = (uint32_t)obs_data_get_int(settings, SETTING_FILL_COLOR);
+    source->background_color = (uint32_t)obs_data_get_int(settings, SETTING_BACKGROUND_COLOR);
+
+    auto_visibility_update_toggle(settings, &g_auto_visibility);
+}
+
+/**
+ * @brief OBS callback creating a new achievement progress source instance.
+ *
+ * @param settings Source settings.
+ * @param source   OBS source instance pointer.
+ * @return Newly allocated progress_source_t structure.
+ */
+static void *on_source_create(obs_data_t *settings, obs_source_t *source) {
+
+    progress_source_t *s = memory_alloc(MEMORY_TAG_RENDER, sizeof(progress_source_t));
+    s->source            = source;
+
+    on_source_update(s, settings);
+
+    return s;
+}
+
+/**
+ * @brief OBS callback destroying an achievement progress source instance.
+ */
+static void on_source_destroy(void *data) {
+
+    progress_source_t *source = data;
+
+    if (!source) {
+        return;
+    }
+
+    memory_free(source);
+}
+
+static void source_get_defaults(obs_data_t *settings) {
+    obs_data_set_default_int(settings, SETTING_WIDTH, 400);
+    obs_data_set_default_int(settings, SETTING_HEIGHT, 24);
+    obs_data_set_default_int(settings, SETTING_FILL_COLOR, DEFAULT_FILL_COLOR);
+    obs_data_set_default_int(settings, SETTING_BACKGROUND_COLOR, DEFAULT_BACKGROUND_COLOR);
+    auto_visibility_set_defaults(settings);
+}
+
+/**
+ * @brief OBS callback to render the progress bar.
+ *
+ * @param data   Source instance data.
+ * @param effect Unused: the bar is drawn with its own effect.
+ */
+static void on_source_video_render(void *data, gs_effect_t *effect) {
+
+    UNUSED_PARAMETER(effect);
+
+    const progress_source_t *source = data;
+
+    if (!source) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_progress_mutex);
+    const float ratio         = g_progress.displayed_ratio;
+    const float model_opacity = g_progress.opacity;
+    pthread_mutex_unlock(&g_progress_mutex);
+
+    const float opacity = model_opacity * auto_visibility_get_opacity(&g_auto_visibility);
+
+    if (opacity <= 0.0f) {
+        return;
+    }
+
+    draw_progress_bar(source->size.width,
+                      source->size.height,
+                      ratio,
+                      source->fill_color,
+                      source->background_color,
+                      opacity);
+}
+
+/**
+ * @brief OBS callback for animation tick.
+ *
+ * Eases the displayed progress towards the latest one, and fades the bar in
+ * or out. The bar is shared: only the first instance ticked in a frame
+ * advances it.
+ */
+static void on_source_video_tick(void *data, float seconds) {
+
+    UNUSED_PARAMETER(data);
+
+    if (!source_activity_is_visible()) {
+        return;
+    }
+
+    seconds = clock_scale_frame(seconds);
+
+    pthread_mutex_lock(&g_progress_mutex);
+    achievement_progress_model_tick(&g_progress, obs_get_video_frame_time(), seconds);
+    pthread_mutex_unlock(&g_progress_mutex);
+}
+
+/**
+ * @brief OBS callback constructing the properties UI for the achievement progress source.
+ *
+ * @param data Source instance data (unused).
+ * @return Newly created obs_properties_t structure containing the UI controls.
+ */
+static obs_properties_t *source_get_properties(void *data) {
+
+    UNUSED_PARAMETER(data);
+
+    obs_properties_t *p = obs_properties_create();
+
+    obs_properties_add_int(p, SETTING_WIDTH, "Width", 16, 3840, 1);
+    obs_properties_add_int(p, SETTING_HEIGHT, "Height", 2, 256, 1);
+    obs_properties_add_color(p, SETTING_FILL_COLOR, "Progress color");
+    obs_properties_add_color(p, SETTING_BACKGROUND_COLOR, "Background color");
+    auto_visibility_add_toggle_property(p);
+
+    return p;
+}
+
+/**
+ * @brief obs_source_info describing the Achievement Progress source.
+ */
+static struct obs_source_info xbox_achievement_progress_source_info = {
+    .id             = "xbox_achievement_progress_source",
+    .type           = OBS_SOURCE_TYPE_INPUT,
+    .output_flags   = OBS_SOURCE_VIDEO | OBS_SOURCE_CUSTOM_DRAW,
+    .get_name       = source_get_name,
+    .create         = on_source_create,
+    .destroy        = on_source_destroy,
+    .update         = on_source_update,
+    .get_defaults   = source_get_defaults,
+    .video_render   = on_source_video_render,
+    .get_properties = source_get_properties,
+    .get_width      = source_get_width,
+    .get_height     = source_get_height,
+    .video_tick     = on_source_video_tick,
+    .show           = source_activity_show,
+    .hide           = source_activity_hide,
+    .activate       = source_activity_activate,
+    .deactivate     = source_activity_deactivate,
+};
+
+/**
+ * @brief Get the obs_source_info for registration.
+ */
+static const struct obs_source_info *xbox_achievement_progress_source_get(void) {
+    return &xbox_achievement_progress_source_info;
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public API
+//  --------------------------------------------------------------------------------------------------------------------
+
+void xbox_achievement_progress_source_register(void) {
+
+    obs_register_source(xbox_achievement_progress_source_get());
+
+    auto_visibility_register_config(&g_auto_visibility);
+
+    achievement_cycle_subscribe(&on_achievement_changed);
+}
+
+void xbox_achievement_progress_source_cleanup(void) {
+
+    achievement_cycle_unsubscribe(&on_achievement_changed);
+
+    pthread_mutex_lock(&g_progress_mutex);
+    achievement_progress_model_reset(&g_progress);
+    pthread_mutex_unlock(&g_progress_mutex);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Register the Achievement Progress source with OBS.
+ *
+ * This function registers an OBS source that displays the progress of the
+ * current achievement of the display cycle as a bar, when that achievement is
+ * measured (e.g. "5/10") and still locked. The source automatically updates
+ * when the achievement progresses, through the achievement cycle.
+ *
+ * The source provides the following features:
+ * - Shader-drawn bar: no text layout or texture upload on progress
+ * - Smooth animation between two progress updates
+ * - Fills up then fades out when the achievement is unlocked
+ * - Configurable dimensions and colors
+ *
+ * This function should be called once during plugin initialization (typically in
+ * obs_module_load()) to make the source available in OBS.
+ *
+ * @see xbox_achievement_name_source_register() for the name and progress as text
+ */
+void xbox_achievement_progress_source_register(void);
+
+/**
+ * @brief Clean up resources allocated by the achievement progress source.
+ *
+ * Should be called during plugin shutdown (obs_module_unload()).
+ */
+void xbox_achievement_progress_source_cleanup(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -6,6 +6,7 @@
  */
 
 #include "sources/common/text_source.h"
+#include "sources/common/source_activity.h"
 #include "sources/common/visibility_cycle.h"
 
 #include <graphics/graphics.h>
@@ -15,6 +16,7 @@
 #include "common/achievement.h"
 #include "io/state.h"
 #include "integrations/monitoring_service.h"
+#include "time/clock.h"
 
 #define NO_FLIP 0
 
@@ -172,6 +174,12 @@ static void on_source_video_render(void *data, gs_effect_t *effect) {
  */
 static void on_source_video_tick(void *data, float seconds) {
 
+    if (!source_activity_is_visible()) {
+        return;
+    }
+
+    seconds = clock_scale_frame(seconds);
+
     text_source_tick(data, &g_render_config, seconds);
 }
 
@@ -210,6 +218,10 @@ static struct obs_source_info xbox_achievements_count_source = {
     .get_height     = source_get_height,
     .video_tick     = on_source_video_tick,
     .video_render   = on_source_video_render,
+    .show           = source_activity_show,
+    .hide           = source_activity_hide,
+    .activate       = source_activity_activate,
+    .deactivate     = source_activity_deactivate,
 };
 
 /**
@@ -4,15 +4,29 @@
 #include <diagnostics/log.h>
 
 #include "common/achievement.h"
+#include "common/intern.h"
 #include "integrations/monitoring_service.h"
 
 #include <stdlib.h>
 
 #include "common/types.h"
+#include "util/thread_compat.h"
 
 /** Maximum number of subscribers that can be registered. */
 #define MAX_SUBSCRIBERS 16
 
+/**
+ * @brief Guards the cycle state.
+ *
+ * The cycle is driven by the monitoring callbacks (monitor threads), by the
+ * sources' video tick (graphics thread) and by the dialog (UI thread). The
+ * subscribers are notified with it held, so they must not call back into the
+ * cycle. Only monitoring_copy_current_game_achievements() is called with it
+ * held: the monitoring service notifies the cycle with its own lock held,
+ * never the other way round.
+ */
+static pthread_mutex_t g_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 /** Configurable duration to show the last unlocked achievement (seconds). */
 static float g_last_unlocked_duration = ACHIEVEMENT_CYCLE_DEFAULT_LAST_UNLOCKED_DURATION;
 
@@ -107,6 +121,8 @@ static void notify_subscribers(const achievement_t *achievement) {
  * If there are no unlocked achievements but there are locked ones,
  * immediately starts the locked rotation so sources display something
  * straight away rather than staying blank for g_last_unlocked_duration.
+ *
+ * Must be called with the mutex held.
  */
 static void reset_display_cycle(void) {
 
@@ -120,7 +136,7 @@ static void reset_display_cycle(void) {
     /* Free the old cached copy */
     free_achievement(&g_last_unlocked);
 
-    achievement_t *achievements = copy_achievement(monitoring_get_current_game_achievements());
+    achievement_t *achievements = monitoring_copy_current_game_achievements();
 
     /* Find the last unlocked achievement */
     const achievement_t *latest_unlocked = find_latest_unlocked_achievement(achievements);
@@ -176,7 +192,9 @@ static void on_connection_changed(bool is_connected, const char *error_message)
     UNUSED_PARAMETER(is_connected);
     UNUSED_PARAMETER(error_message);
 
+    pthread_mutex_lock(&g_mutex);
     reset_display_cycle();
+    pthread_mutex_unlock(&g_mutex);
 }
 
 /**
@@ -191,19 +209,25 @@ static void on_game_played(const game_t *game) {
 
     UNUSED_PARAMETER(game);
 
+    pthread_mutex_lock(&g_mutex);
+
     /* Mark the session as not ready until icons are prefetched */
     g_session_ready = false;
 
     /* Clear the display while icons are being prefetched */
     free_achievement(&g_last_unlocked);
     notify_subscribers(NULL);
+
+    pthread_mutex_unlock(&g_mutex);
 }
 
 /**
  * @brief Monitoring service callback invoked when achievements are updated.
  */
 static void on_achievements_changed(void) {
+    pthread_mutex_lock(&g_mutex);
     reset_display_cycle();
+    pthread_mutex_unlock(&g_mutex);
 }
 
 /**
@@ -214,8 +238,10 @@ static void on_achievements_changed(void) {
  */
 static void on_session_ready(void) {
 
+    pthread_mutex_lock(&g_mutex);
     g_session_ready = true;
     reset_display_cycle();
+    pthread_mutex_unlock(&g_mutex);
 }
 
 //  --------------------------------------------------------------------------------------------------------------------
@@ -225,6 +251,8 @@ static void on_session_ready(void) {
 /**
  * @brief Move the display to an adjacent achievement in the sorted list.
  *
+ * Must be called with the mutex held.
+ *
  * @param direction +1 for next, -1 for previous.
  */
 static void navigate(int direction) {
@@ -233,7 +261,7 @@ static void navigate(int direction) {
         return;
     }
 
-    achievement_t *achievements = copy_achievement(monitoring_get_current_game_achievements());
+    achievement_t *achievements = monitoring_copy_current_game_achievements();
     if (!achievements) {
         return;
     }
@@ -278,6 +306,8 @@ static void navigate(int direction) {
 /**
  * @brief Jump directly to a specific index in the sorted achievement list.
  *
+ * Must be called with the mutex held.
+ *
  * @param target_index Absolute index to jump to (0-based, from sorted list).
  */
 static void navigate_to_index(int target_index) {
@@ -286,7 +316,7 @@ static void navigate_to_index(int target_index) {
         return;
     }
 
-    achievement_t *achievements = copy_achievement(monitoring_get_current_game_achievements());
+    achievement_t *achievements = monitoring_copy_current_game_achievements();
     if (!achievements) {
         return;
     }
@@ -326,7 +356,10 @@ static void navigate_to_index(int target_index) {
 
 void achievement_cycle_init(void) {
 
+    pthread_mutex_lock(&g_mutex);
+
     if (g_initialized) {
+        pthread_mutex_unlock(&g_mutex);
         return;
     }
 
@@ -336,18 +369,23 @@ void achievement_cycle_init(void) {
     g_last_unlocked        = NULL;
     g_current_achievement  = NULL;
     g_subscriber_count     = 0;
+    g_initialized          = true;
 
+    pthread_mutex_unlock(&g_mutex);
+
+    /* Outside the lock: the monitoring service calls back with its own lock held */
     monitoring_subscribe_connection_changed(&on_connection_changed);
     monitoring_subscribe_game_played(&on_game_played);
     monitoring_subscribe_achievements_changed(&on_achievements_changed);
     monitoring_subscribe_session_ready(&on_session_ready);
-
-    g_initialized = true;
 }
 
 void achievement_cycle_destroy(void) {
 
+    pthread_mutex_lock(&g_mutex);
+
     if (!g_initialized) {
+        pthread_mutex_unlock(&g_mutex);
         return;
     }
 
@@ -359,6 +397,8 @@ void achievement_cycle_destroy(void) {
     g_subscriber_count    = 0;
     g_current_achievement = NULL;
     g_initialized         = false;
+
+    pthread_mutex_unlock(&g_mutex);
 }
 
 void achievement_cycle_subscribe(achievement_cycle_callback_t callback) {
@@ -367,7 +407,10 @@ void achievement_cycle_subscribe(achievement_cycle_callback_t callback) {
         return;
     }
 
+    pthread_mutex_lock(&g_mutex);
+
     if (g_subscriber_count >= MAX_SUBSCRIBERS) {
+        pthread_mutex_unlock(&g_mutex);
         obs_log(LOG_WARNING, "Achievement cycle: Maximum subscribers reached");
         return;
     }
@@ -375,6 +418,7 @@ void achievement_cycle_subscribe(achievement_cycle_callback_t callback) {
     /* Check for duplicates */
     for (int i = 0; i < g_subscriber_count; i++) {
         if (g_subscribers[i] == callback) {
+            pthread_mutex_unlock(&g_mutex);
             return;
         }
     }
@@ -386,6 +430,8 @@ void achievement_cycle_subscribe(achievement_cycle_callback_t callback) {
     if (g_session_ready) {
         callback(g_current_achievement);
     }
+
+    pthread_mutex_unlock(&g_mutex);
 }
 
 void achievement_cycle_unsubscribe(achievement_cycle_callback_t callback) {
@@ -394,6 +440,8 @@ void achievement_cycle_unsubscribe(achievement_cycle_callback_t callback) {
         return;
     }
 
+    pthread_mutex_lock(&g_mutex);
+
     for (int i = 0; i < g_subscriber_count; i++) {
         if (g_subscribers[i] == callback) {
             /* Shift the remaining callbacks down */
@@ -402,21 +450,27 @@ void achievement_cycle_unsubscribe(achievement_cycle_callback_t callback) {
             }
             g_subscriber_count--;
             g_subscribers[g_subscriber_count] = NULL;
-            return;
+            break;
         }
     }
+
+    pthread_mutex_unlock(&g_mutex);
 }
 
 void achievement_cycle_tick(float seconds) {
 
+    pthread_mutex_lock(&g_mutex);
+
     if (!g_initialized || !g_session_ready || !g_auto_cycle_enabled) {
+        pthread_mutex_unlock(&g_mutex);
         return;
     }
 
     /* Get the current achievements */
-    achievement_t *achievements = copy_achievement(monitoring_get_current_game_achievements());
+    achievement_t *achievements = monitoring_copy_current_game_achievements();
 
     if (!achievements) {
+        pthread_mutex_unlock(&g_mutex);
         return;
     }
 
@@ -492,6 +546,8 @@ void achievement_cycle_tick(float seconds) {
         break;
     }
 
+    pthread_mutex_unlock(&g_mutex);
+
     free_achievement(&achievements);
 }
 
@@ -499,26 +555,43 @@ const achievement_t *achievement_cycle_get_current(void) {
     return g_current_achievement;
 }
 
+char *achievement_cycle_get_current_id(void) {
+
+    pthread_mutex_lock(&g_mutex);
+    char *id = g_current_achievement ? intern_string(g_current_achievement->id) : NULL;
+    pthread_mutex_unlock(&g_mutex);
+
+    return id;
+}
+
 const achievement_t *achievement_cycle_get_last_unlocked(void) {
     return g_last_unlocked;
 }
 
 void achievement_cycle_navigate_next(void) {
+    pthread_mutex_lock(&g_mutex);
     navigate(+1);
+    pthread_mutex_unlock(&g_mutex);
 }
 
 void achievement_cycle_navigate_previous(void) {
+    pthread_mutex_lock(&g_mutex);
     navigate(-1);
+    pthread_mutex_unlock(&g_mutex);
 }
 
 void achievement_cycle_navigate_first_locked(void) {
 
+    pthread_mutex_lock(&g_mutex);
+
     if (!g_initialized || !g_session_ready) {
+        pthread_mutex_unlock(&g_mutex);
         return;
     }
 
-    achievement_t *achievements = copy_achievement(monitoring_get_current_game_achievements());
+    achievement_t *achievements = monitoring_copy_current_game_achievements();
     if (!achievements) {
+        pthread_mutex_unlock(&g_mutex);
         return;
     }
 
@@ -533,21 +606,28 @@ void achievement_cycle_navigate_first_locked(void) {
 
     if (first_locked_index >= total) {
         obs_log(LOG_DEBUG, "Achievement Cycle: No locked achievements to jump to");
+        pthread_mutex_unlock(&g_mutex);
         return;
     }
 
     obs_log(LOG_DEBUG, "Achievement Cycle: Jumping to first locked achievement at index %d", first_locked_index);
     navigate_to_index(first_locked_index);
+
+    pthread_mutex_unlock(&g_mutex);
 }
 
 void achievement_cycle_navigate_first_unlocked(void) {
 
+    pthread_mutex_lock(&g_mutex);
+
     if (!g_initialized || !g_session_ready) {
+        pthread_mutex_unlock(&g_mutex);
         return;
     }
 
-    achievement_t *achievements = copy_achievement(monitoring_get_current_game_achievements());
+    achievement_t *achievements = monitoring_copy_current_game_achievements();
     if (!achievements) {
+        pthread_mutex_unlock(&g_mutex);
         return;
     }
 
@@ -556,41 +636,103 @@ void achievement_cycle_navigate_first_unlocked(void) {
 
     if (unlocked_count == 0) {
         obs_log(LOG_DEBUG, "Achievement Cycle: No unlocked achievements to jump to");
+        pthread_mutex_unlock(&g_mutex);
         return;
     }
 
     obs_log(LOG_DEBUG, "Achievement Cycle: Jumping to first unlocked achievement (index 0)");
     navigate_to_index(0);
+
+    pthread_mutex_unlock(&g_mutex);
+}
+
+void achievement_cycle_navigate_to(const char *achievement_id) {
+
+    pthread_mutex_lock(&g_mutex);
+
+    if (!g_initialized || !g_session_ready || !achievement_id) {
+        pthread_mutex_unlock(&g_mutex);
+        return;
+    }
+
+    achievement_t *achievements = monitoring_copy_current_game_achievements();
+    if (!achievements) {
+        pthread_mutex_unlock(&g_mutex);
+        return;
+    }
+
+    sort_achievements(&achievements);
+
+    int target_index = -1;
+    int index        = 0;
+
+    for (const achievement_t *a = achievements; a != NULL; a = a->next, index++) {
+        if (a->id && strcmp(a->id, achievement_id) == 0) {
+            target_index = index;
+            break;
+        }
+    }
+
+    free_achievement(&achievements);
+
+    if (target_index < 0) {
+        obs_log(LOG_DEBUG, "Achievement Cycle: Achievement %s not found, keeping the current one", achievement_id);
+        pthread_mutex_unlock(&g_mutex);
+        return;
+    }
+
+    navigate_to_index(target_index);
+
+    pthread_mutex_unlock(&g_mutex);
 }
 
 void achievement_cycle_set_auto_cycle(bool enabled) {
+    pthread_mutex_lock(&g_mutex);
     g_auto_cycle_enabled = enabled;
+    pthread_mutex_unlock(&g_mutex);
+
     obs_log(LOG_DEBUG, "Achievement Cycle: auto-cycle %s", enabled ? "enabled" : "disabled");
 }
 
 bool achievement_cycle_is_auto_cycle_enabled(void) {
-    return g_auto_cycle_enabled;
+    pthread_mutex_lock(&g_mutex);
+    const bool enabled = g_auto_cycle_enabled;
+    pthread_mutex_unlock(&g_mutex);
+
+    return enabled;
 }
 
 void achievement_cycle_refresh_current(void) {
 
+    pthread_mutex_lock(&g_mutex);
+
     if (!g_session_ready || !g_current_achievement) {
+        pthread_mutex_unlock(&g_mutex);
         return;
     }
 
     /* Find the matching entry in the live list and re-notify subscribers so
      * they pick up any in-place field changes (e.g. measured_progress). */
-    const achievement_t *live = monitoring_get_current_game_achievements();
+    achievement_t *live = monitoring_copy_current_game_achievements();
     for (const achievement_t *a = live; a != NULL; a = a->next) {
         if (a->id && g_current_achievement->id && strcmp(a->id, g_current_achievement->id) == 0) {
-            notify_subscribers(a);
-            return;
+            achievement_t *copy = copy_achievement(a);
+            free_achievement(&g_last_unlocked);
+            g_last_unlocked = copy;
+            notify_subscribers(g_last_unlocked);
+            break;
         }
     }
+
+    pthread_mutex_unlock(&g_mutex);
+
+    free_achievement(&live);
 }
 
 void achievement_cycle_set_timings(float last_unlocked_secs, float locked_each_secs, float locked_total_secs) {
 
+    pthread_mutex_lock(&g_mutex);
+
     g_last_unlocked_duration = last_unlocked_secs >= ACHIEVEMENT_CYCLE_MIN_DURATION ? last_unlocked_secs
                                                                                     : ACHIEVEMENT_CYCLE_MIN_DURATION;
 
@@ -605,4 +747,6 @@ void achievement_cycle_set_timings(float last_unlocked_secs, float locked_each_s
             g_last_unlocked_duration,
             g_locked_each_duration,
             g_locked_total_duration);
+
+    pthread_mutex_unlock(&g_mutex);
 }
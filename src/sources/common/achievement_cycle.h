@@ -22,6 +22,10 @@ extern "C" {
  * - Show the last unlocked achievement for 60 seconds
  * - Rotate through random locked achievements (15 seconds each) for 60 seconds
  * - Repeat
+ *
+ * Thread safety:
+ *   All functions may be called from any thread. Subscribers are notified with
+ *   the cycle locked and must not call back into it.
  */
 
 /**
@@ -90,10 +94,21 @@ void achievement_cycle_tick(float seconds);
  * cycle state. This is useful for sources that need to query the current
  * achievement without waiting for a callback.
  *
+ * The achievement is replaced by the next cycle step: only dereference it
+ * from a subscriber callback. Other threads use @ref achievement_cycle_get_current_id.
+ *
  * @return The currently displayed achievement, or NULL if none.
  */
 const achievement_t *achievement_cycle_get_current(void);
 
+/**
+ * @brief Get the identifier of the currently displayed achievement.
+ *
+ * @return An interned reference to the identifier (release with
+ *         intern_release()), or NULL if none.
+ */
+char *achievement_cycle_get_current_id(void);
+
 /**
  * @brief Get the last unlocked achievement.
  *
@@ -155,6 +170,18 @@ void achievement_cycle_navigate_first_locked(void);
  */
 void achievement_cycle_navigate_first_unlocked(void);
 
+/**
+ * @brief Jump directly to the achievement with the given identifier.
+ *
+ * Used to resume the cycle where a previous session left it (see
+ * @ref monitoring_restore_snapshot). The achievement stays visible for a full
+ * interval before the automatic cycle resumes.
+ * No-op if the session is not ready or no achievement has this identifier.
+ *
+ * @param achievement_id Identifier of the achievement to display.
+ */
+void achievement_cycle_navigate_to(const char *achievement_id);
+
 /**
  * @brief Enable or disable the automatic achievement rotation.
  *
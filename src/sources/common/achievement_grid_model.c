@@ -0,0 +1,343 @@
+#include "sources/common/achievement_grid_model.h"
+
+#include <obs-module.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "common/intern.h"
+#include "diagnostics/memory_accounting.h"
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Private functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+static bool same_text(const char *left, const char *right) {
+
+    /* Interned strings compare by pointer; fall back to the text otherwise */
+    if (left == right) {
+        return true;
+    }
+
+    return left && right && strcmp(left, right) == 0;
+}
+
+/**
+ * @brief Find the cell of an achievement, starting the search at @p hint.
+ *
+ * Consecutive lookups are made in list order, and an unlock only moves one
+ * achievement: starting after the previous match finds most cells at once.
+ *
+ * @return Index of the cell, or -1.
+ */
+static int find_cell(const achievement_grid_cell_t *cells, size_t count, const char *id, size_t hint) {
+
+    for (size_t n = 0; n < count; n++) {
+        const size_t index = (hint + n) % count;
+
+        if (same_text(cells[index].id, id)) {
+            return (int)index;
+        }
+    }
+
+    return -1;
+}
+
+static void release_cell(achievement_grid_cell_t *cell) {
+    intern_release(&cell->id);
+    intern_release(&cell->icon_url);
+    memory_free(cell->cache_path);
+    cell->cache_path = NULL;
+}
+
+static void free_cells(achievement_grid_cell_t *cells, size_t count) {
+
+    for (size_t i = 0; i < count; i++) {
+        release_cell(&cells[i]);
+    }
+
+    memory_free(cells);
+}
+
+static bool has_icon(const achievement_t *achievement) {
+    return achievement->icon_url && achievement->icon_url[0] != '\0';
+}
+
+/**
+ * @brief Point a cell to a new icon, to be downloaded.
+ */
+static void reset_icon(achievement_grid_cell_t *cell, const achievement_t *achievement) {
+    intern_assign(&cell->icon_url, has_icon(achievement) ? achievement->icon_url : NULL);
+    memory_free(cell->cache_path);
+    cell->cache_path = NULL;
+    cell->icon_state = cell->icon_url ? ACHIEVEMENT_GRID_ICON_PENDING : ACHIEVEMENT_GRID_ICON_NONE;
+    cell->dirty      = true;
+}
+
+/**
+ * @brief Copy the state of an achievement into its cell.
+ */
+static void apply_achievement(achievement_grid_cell_t *cell, const achievement_t *achievement) {
+
+    const bool was_unlocked = cell->unlocked_timestamp != 0;
+    const bool is_unlocked  = achievement->unlocked_timestamp != 0;
+
+    cell->unlocked_timestamp = achievement->unlocked_timestamp;
+    cell->progress           = get_achievement_progress(achievement);
+
+    if (!same_text(cell->icon_url, has_icon(achievement) ? achievement->icon_url : NULL)) {
+        reset_icon(cell, achievement);
+    } else if (was_unlocked != is_unlocked && cell->icon_state == ACHIEVEMENT_GRID_ICON_READY) {
+        /* Locked icons are baked in greyscale: redraw the cell in colour */
+        cell->dirty = true;
+    }
+}
+
+static void update_highlight(achievement_grid_model_t *model) {
+
+    int64_t latest     = 0;
+    model->highlighted = -1;
+
+    for (size_t i = 0; i < model->count; i++) {
+        if (model->cells[i].unlocked_timestamp > latest) {
+            latest             = model->cells[i].unlocked_timestamp;
+            model->highlighted = (int)i;
+        }
+    }
+}
+
+/**
+ * @brief Whether a list holds exactly the achievements of the cells.
+ */
+static bool has_same_achievements(const achievement_grid_model_t *model, const achievement_t *achievements) {
+
+    if ((size_t)count_achievements(achievements) != model->count) {
+        return false;
+    }
+
+    size_t hint = 0;
+
+    for (const achievement_t *a = achievements; a; a = a->next) {
+        const int index = find_cell(model->cells, model->count, a->id, hint);
+
+        if (index < 0) {
+            return false;
+        }
+
+        hint = (size_t)index + 1;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Rebuild the cells in list order.
+ *
+ * The icons already downloaded for the previous cells are kept.
+ */
+static void rebuild(achievement_grid_model_t *model, const achievement_t *achievements) {
+
+    achievement_grid_cell_t *previous       = model->cells;
+    const size_t             previous_count = model->count;
+
+    model->count = (size_t)count_achievements(achievements);
+    model->cells = model->count > 0 ? memory_alloc(MEMORY_TAG_RENDER, model->count * sizeof(achievement_grid_cell_t))
+                                    : NULL;
+    model->generation++;
+
+    size_t index = 0;
+
+    for (const achievement_t *a = achievements; a; a = a->next, index++) {
+        achievement_grid_cell_t *cell = &model->cells[index];
+
+        cell->id = intern_string(a->id);
+        apply_achievement(cell, a);
+
+        const int known = previous_count > 0 ? find_cell(previous, previous_count, a->id, index) : -1;
+
+        if (known >= 0 && previous[known].icon_state == ACHIEVEMENT_GRID_ICON_READY &&
+            same_text(previous[known].icon_url, cell->icon_url)) {
+            cell->cache_path           = previous[known].cache_path;
+            cell->icon_state           = ACHIEVEMENT_GRID_ICON_READY;
+            previous[known].cache_path = NULL;
+        }
+
+        /* The cells moved: every one of them must be redrawn */
+        cell->dirty = true;
+    }
+
+    free_cells(previous, previous_count);
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public API
+//  --------------------------------------------------------------------------------------------------------------------
+
+size_t achievement_grid_model_update(achievement_grid_model_t *model, const achievement_t *achievements) {
+
+    if (!model) {
+        return 0;
+    }
+
+    if (has_same_achievements(model, achievements)) {
+        size_t hint = 0;
+
+        for (const achievement_t *a = achievements; a; a = a->next) {
+            const int index = find_cell(model->cells, model->count, a->id, hint);
+            apply_achievement(&model->cells[index], a);
+            hint = (size_t)index + 1;
+        }
+    } else {
+        rebuild(model, achievements);
+    }
+
+    update_highlight(model);
+
+    size_t pending = 0;
+
+    for (size_t i = 0; i < model->count; i++) {
+        if (model->cells[i].icon_state == ACHIEVEMENT_GRID_ICON_PENDING) {
+            pending++;
+        }
+    }
+
+    return pending;
+}
+
+bool achievement_grid_model_update_one(achievement_grid_model_t *model, const achievement_t *achievement) {
+
+    if (!model || !achievement || model->count == 0) {
+        return false;
+    }
+
+    const int index = find_cell(model->cells, model->count, achievement->id, 0);
+
+    if (index < 0) {
+        return false;
+    }
+
+    apply_achievement(&model->cells[index], achievement);
+    update_highlight(model);
+
+    return true;
+}
+
+bool achievement_grid_model_take_pending(achievement_grid_model_t *model, achievement_grid_download_t *download) {
+
+    if (!model || !download) {
+        return false;
+    }
+
+    for (size_t i = 0; i < model->count; i++) {
+        achievement_grid_cell_t *cell = &model->cells[i];
+
+        if (cell->icon_state != ACHIEVEMENT_GRID_ICON_PENDING) {
+            continue;
+        }
+
+        cell->icon_state     = ACHIEVEMENT_GRID_ICON_DOWNLOADING;
+        download->index      = i;
+        download->generation = model->generation;
+        download->id         = intern_string(cell->id);
+        download->icon_url   = intern_string(cell->icon_url);
+
+        return true;
+    }
+
+    return false;
+}
+
+void achievement_grid_model_icon_downloaded(achievement_grid_model_t          *model,
+                                            const achievement_grid_download_t *download,
+                                            const char                        *cache_path) {
+
+    if (!model || !download || download->generation != model->generation || download->index >= model->count) {
+        return;
+    }
+
+    achievement_grid_cell_t *cell = &model->cells[download->index];
+
+    if (cell->icon_state != ACHIEVEMENT_GRID_ICON_DOWNLOADING || !same_text(cell->id, download->id) ||
+        !same_text(cell->icon_url, download->icon_url)) {
+        return;
+    }
+
+    memory_free(cell->cache_path);
+    cell->cache_path = NULL;
+
+    if (cache_path && cache_path[0] != '\0') {
+        cell->cache_path = memory_strdup(MEMORY_TAG_RENDER, cache_path);
+        cell->icon_state = ACHIEVEMENT_GRID_ICON_READY;
+    } else {
+        cell->icon_state = ACHIEVEMENT_GRID_ICON_MISSING;
+    }
+
+    cell->dirty = true;
+}
+
+size_t achievement_grid_model_take_dirty(achievement_grid_model_t *model, achievement_grid_dirty_cell_t *cells,
+                                         size_t max) {
+
+    if (!model || !cells) {
+        return 0;
+    }
+
+    size_t taken = 0;
+
+    for (size_t i = 0; i < model->count && taken < max; i++) {
+        achievement_grid_cell_t *cell = &model->cells[i];
+
+        if (!cell->dirty) {
+            continue;
+        }
+
+        achievement_grid_dirty_cell_t *dirty = &cells[taken++];
+
+        dirty->index    = i;
+        dirty->unlocked = cell->unlocked_timestamp != 0;
+        snprintf(dirty->cache_path,
+                 sizeof(dirty->cache_path),
+                 "%s",
+                 cell->icon_state == ACHIEVEMENT_GRID_ICON_READY && cell->cache_path ? cell->cache_path : "");
+
+        /* A cell still downloading is cleared, not left with the icon of the
+         * previous cell, and drawn again once its icon is there */
+        cell->dirty = false;
+    }
+
+    return taken;
+}
+
+void achievement_grid_model_mark_all_dirty(achievement_grid_model_t *model) {
+
+    if (!model) {
+        return;
+    }
+
+    for (size_t i = 0; i < model->count; i++) {
+        model->cells[i].dirty = true;
+    }
+}
+
+void achievement_grid_model_free(achievement_grid_model_t *model) {
+
+    if (!model) {
+        return;
+    }
+
+    free_cells(model->cells, model->count);
+
+    model->cells       = NULL;
+    model->count       = 0;
+    model->highlighted = -1;
+    model->generation++;
+}
+
+void achievement_grid_download_free(achievement_grid_download_t *download) {
+
+    if (!download) {
+        return;
+    }
+
+    intern_release(&download->id);
+    intern_release(&download->icon_url);
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common/achievement.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file achievement_grid_model.h
+ * @brief Cells of the Achievement Grid source, kept apart from the rendering.
+ *
+ * The grid bakes every icon of the current game once into an atlas texture.
+ * This model decides which cells of the atlas must be (re)drawn:
+ *  - a new list with the same achievements (an unlock re-sorts the list)
+ *    keeps every cell in place, and only the cells whose unlock state or
+ *    icon changed are marked dirty;
+ *  - a list with other achievements rebuilds the cells in list order and
+ *    bumps the generation, so that downloads started for the previous list
+ *    are ignored when they complete.
+ *
+ * The icon downloads go through @ref achievement_grid_model_take_pending and
+ * @ref achievement_grid_model_icon_downloaded; the atlas updates through
+ * @ref achievement_grid_model_take_dirty.
+ *
+ * Thread safety:
+ *   None. The caller serializes the accesses (the grid source holds a mutex).
+ */
+
+/**
+ * @brief Download state of the icon of a cell.
+ */
+typedef enum achievement_grid_icon_state {
+    ACHIEVEMENT_GRID_ICON_NONE = 0,    /**< The achievement has no icon URL.           */
+    ACHIEVEMENT_GRID_ICON_PENDING,     /**< The icon must be downloaded.               */
+    ACHIEVEMENT_GRID_ICON_DOWNLOADING, /**< The icon was handed to a download task.    */
+    ACHIEVEMENT_GRID_ICON_READY,       /**< The icon is in the cache at @c cache_path. */
+    ACHIEVEMENT_GRID_ICON_MISSING,     /**< The download failed.                       */
+} achievement_grid_icon_state_t;
+
+/**
+ * @brief One achievement of the grid.
+ */
+typedef struct achievement_grid_cell {
+    /** Achievement identifier (interned). */
+    char                         *id;
+    /** Icon URL (interned), or NULL. */
+    char                         *icon_url;
+    /** Cached icon file, set once the icon is READY (owned). */
+    char                         *cache_path;
+    /** Unix timestamp of the unlock, or 0 if locked. */
+    int64_t                       unlocked_timestamp;
+    /** Completion in [0, 1], or negative if not measured (see get_achievement_progress()). */
+    float                         progress;
+    /** Download state of the icon. */
+    achievement_grid_icon_state_t icon_state;
+    /** Whether the atlas cell must be redrawn. */
+    bool                          dirty;
+} achievement_grid_cell_t;
+
+/**
+ * @brief The cells of the current game.
+ *
+ * Zero-initialize before the first use, and release with
+ * @ref achievement_grid_model_free.
+ */
+typedef struct achievement_grid_model {
+    /** Cells, in display order. */
+    achievement_grid_cell_t *cells;
+    /** Number of cells. */
+    size_t                   count;
+    /** Bumped every time the cells are rebuilt. */
+    uint32_t                 generation;
+    /** Index of the latest unlocked achievement, or -1 if none. */
+    int                      highlighted;
+} achievement_grid_model_t;
+
+/**
+ * @brief An icon handed to a download task.
+ *
+ * Release with @ref achievement_grid_download_free.
+ */
+typedef struct achievement_grid_download {
+    size_t   index;
+    uint32_t generation;
+    char    *id;
+    char    *icon_url;
+} achievement_grid_download_t;
+
+/**
+ * @brief A cell to redraw in the atlas.
+ */
+typedef struct achievement_grid_dirty_cell {
+    size_t index;
+    bool   unlocked;
+    /** Cached icon file; empty to clear the cell. */
+    char   cache_path[1024];
+} achievement_grid_dirty_cell_t;
+
+/**
+ * @brief Apply a new list of achievements.
+ *
+ * @param model        Model to update.
+ * @param achievements Head of the list of the current game (may be NULL).
+ *
+ * @return Number of icons waiting to be downloaded.
+ */
+size_t achievement_grid_model_update(achievement_grid_model_t *model, const achievement_t *achievements);
+
+/**
+ * @brief Apply the progress or the unlock of a single achievement.
+ *
+ * @return True if the achievement has a cell.
+ */
+bool achievement_grid_model_update_one(achievement_grid_model_t *model, const achievement_t *achievement);
+
+/**
+ * @brief Hand the next icon to download to a task.
+ *
+ * The cell goes to the DOWNLOADING state.
+ *
+ * @param model        Model to read.
+ * @param[out] download The icon to download, to release with @ref achievement_grid_download_free.
+ *
+ * @return False if no icon is waiting.
+ */
+bool achievement_grid_model_take_pending(achievement_grid_model_t *model, achievement_grid_download_t *download);
+
+/**
+ * @brief Record the result of a download.
+ *
+ * Ignored if the cells were rebuilt, or the icon changed, since the download
+ * was taken.
+ *
+ * @param model      Model to update.
+ * @param download   The download taken with @ref achievement_grid_model_take_pending.
+ * @param cache_path Cached icon file, or NULL / empty if the download failed.
+ */
+void achievement_grid_model_icon_downloaded(achievement_grid_model_t          *model,
+                                            const achievement_grid_download_t *download,
+                                            const char                        *cache_path);
+
+/**
+ * @brief Take the cells to redraw, clearing their dirty flag.
+ *
+ * A cell whose icon is not downloaded yet is returned without a cache path,
+ * to be cleared; it becomes dirty again when the download completes.
+ *
+ * @param model      Model to read.
+ * @param[out] cells Cells to redraw.
+ * @param max        Capacity of @p cells: the remaining ones stay dirty for the next call.
+ *
+ * @return Number of cells written.
+ */
+size_t achievement_grid_model_take_dirty(achievement_grid_model_t *model, achievement_grid_dirty_cell_t *cells,
+                                         size_t max);
+
+/**
+ * @brief Mark every cell dirty, e.g. after the atlas texture was lost.
+ */
+void achievement_grid_model_mark_all_dirty(achievement_grid_model_t *model);
+
+/**
+ * @brief Release the cells. The model can be reused afterwards.
+ */
+void achievement_grid_model_free(achievement_grid_model_t *model);
+
+/**
+ * @brief Release the strings of a download.
+ */
+void achievement_grid_download_free(achievement_grid_download_t *download);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,79 @@
+#include "sources/common/achievement_progress_model.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public API
+//  --------------------------------------------------------------------------------------------------------------------
+
+void achievement_progress_model_set_achievement(achievement_progress_model_t *model, const achievement_t *achievement) {
+
+    if (!model) {
+        return;
+    }
+
+    const float progress = get_achievement_progress(achievement);
+    const bool  measured = achievement && achievement->unlocked_timestamp == 0 && progress >= 0.0f;
+    const bool  same     = achievement && achievement->id && strcmp(model->achievement_id, achievement->id) == 0;
+
+    if (!same) {
+        const char *id = achievement && achievement->id ? achievement->id : "";
+        snprintf(model->achievement_id, sizeof(model->achievement_id), "%s", id);
+    }
+
+    if (measured) {
+        /* Another achievement: start from its own progress, not from the previous one */
+        model->must_jump      = !same;
+        model->target_ratio   = progress;
+        model->target_visible = true;
+    } else if (same && achievement->unlocked_timestamp != 0 && model->target_visible) {
+        model->target_ratio   = 1.0f;
+        model->target_visible = false;
+    } else {
+        model->target_visible = false;
+    }
+}
+
+bool achievement_progress_model_tick(achievement_progress_model_t *model, uint64_t frame_time_ns, float seconds) {
+
+    /* Every instance ticks: the first one of the frame advances the animation */
+    if (!model || frame_time_ns == model->frame_time_ns) {
+        return false;
+    }
+
+    model->frame_time_ns = frame_time_ns;
+
+    /* Nothing to animate from while the bar is hidden */
+    if (model->must_jump || model->opacity <= 0.0f) {
+        model->displayed_ratio = model->target_ratio;
+    } else {
+        const float step = 1.0f - expf(-ACHIEVEMENT_PROGRESS_EASING_RATE * seconds);
+
+        model->displayed_ratio += (model->target_ratio - model->displayed_ratio) * step;
+
+        if (fabsf(model->target_ratio - model->displayed_ratio) < 0.0005f) {
+            model->displayed_ratio = model->target_ratio;
+        }
+    }
+
+    model->must_jump = false;
+
+    const float fade_step = seconds / ACHIEVEMENT_PROGRESS_FADE_DURATION;
+
+    model->opacity = model->target_visible ? fminf(1.0f, model->opacity + fade_step)
+                                           : fmaxf(0.0f, model->opacity - fade_step);
+
+    return true;
+}
+
+void achievement_progress_model_reset(achievement_progress_model_t *model) {
+
+    if (!model) {
+        return;
+    }
+
+    model->achievement_id[0] = '\0';
+    model->target_visible    = false;
+}
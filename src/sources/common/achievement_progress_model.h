@@ -0,0 +1,84 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common/achievement.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file achievement_progress_model.h
+ * @brief Animated state of the Achievement Progress source, kept apart from the rendering.
+ *
+ * The bar follows the achievement shown by the achievement cycle:
+ *  - another measured, locked achievement makes the bar jump to its progress;
+ *  - a progress of the same achievement eases the bar towards the new value;
+ *  - the unlock of the achievement on display fills the bar while it fades
+ *    out; anything else (unmeasured, unlocked, no achievement) fades it out.
+ *
+ * Every source instance ticks the model on each frame: the animation only
+ * advances once per frame, whatever the number of instances.
+ *
+ * Thread safety:
+ *   None. The caller serializes the accesses (the progress source holds a mutex).
+ */
+
+/** Rate of the easing towards the latest progress, per second (~0.3 s to get there). */
+#define ACHIEVEMENT_PROGRESS_EASING_RATE 10.0f
+
+/** Duration of the fade when the bar shows up or goes away (in seconds). */
+#define ACHIEVEMENT_PROGRESS_FADE_DURATION 0.35f
+
+/**
+ * @brief State of the bar.
+ *
+ * Zero-initialize before the first use.
+ */
+typedef struct achievement_progress_model {
+    /** Achievement followed by the bar (copied), or empty. */
+    char     achievement_id[128];
+    /** Latest progress, in [0, 1]. */
+    float    target_ratio;
+    /** Whether the bar must show up (or stay visible). */
+    bool     target_visible;
+    /** Whether the next frame starts from the target instead of easing towards it. */
+    bool     must_jump;
+    /** Progress drawn, in [0, 1]. */
+    float    displayed_ratio;
+    /** Opacity of the bar, in [0, 1]. */
+    float    opacity;
+    /** Time of the latest frame the animation advanced for (see @ref achievement_progress_model_tick). */
+    uint64_t frame_time_ns;
+} achievement_progress_model_t;
+
+/**
+ * @brief Follow the achievement on display, or its progress.
+ *
+ * @param model       Model to update.
+ * @param achievement Achievement on display, or NULL.
+ */
+void achievement_progress_model_set_achievement(achievement_progress_model_t *model, const achievement_t *achievement);
+
+/**
+ * @brief Advance the animation for a frame.
+ *
+ * @param model         Model to update.
+ * @param frame_time_ns Time of the frame being rendered: later calls with the
+ *                      same time are ignored.
+ * @param seconds       Time elapsed since the previous frame.
+ *
+ * @return True if the animation advanced.
+ */
+bool achievement_progress_model_tick(achievement_progress_model_t *model, uint64_t frame_time_ns, float seconds);
+
+/**
+ * @brief Stop following the current achievement: the bar fades out.
+ */
+void achievement_progress_model_reset(achievement_progress_model_t *model);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,13 +1,39 @@
 #include "sources/common/image_source.h"
 
 #include <graphics/graphics.h>
+#include <graphics/matrix4.h>
+#include <math.h>
 #include <string.h>
 #include <stdlib.h>
 
 #include <diagnostics/log.h>
+#include <diagnostics/memory_accounting.h>
 
 #include "drawing/image.h"
 #include "io/cache.h"
+#include "sources/common/source_activity.h"
+
+/**
+ * @brief Estimated GPU footprint of a texture (4 bytes per pixel, no mipmaps).
+ *
+ * Must be called inside the graphics context.
+ */
+static int64_t texture_bytes(gs_texture_t *texture) {
+    return (int64_t)gs_texture_get_width(texture) * (int64_t)gs_texture_get_height(texture) * 4;
+}
+
+/**
+ * @brief Destroy the texture of an image and account its release.
+ *
+ * Must be called inside the graphics context.
+ */
+static void destroy_texture(image_t *image) {
+
+    memory_account(MEMORY_TAG_GPU, -texture_bytes(image->texture));
+
+    gs_texture_destroy(image->texture);
+    image->texture = NULL;
+}
 
 void image_source_download(image_t *image) {
 
@@ -43,13 +69,16 @@ void image_source_reload_if_needed(image_t *image) {
 
     /* Free existing texture */
     if (image->texture) {
-        gs_texture_destroy(image->texture);
-        image->texture = NULL;
+        destroy_texture(image);
     }
 
     /* Create new texture if we have a path */
     if (image->cache_path[0] != '\0') {
         image->texture = gs_texture_create_from_file(image->cache_path);
+
+        if (image->texture) {
+            memory_account(MEMORY_TAG_GPU, texture_bytes(image->texture));
+        }
     }
 
     obs_leave_graphics();
@@ -69,6 +98,61 @@ void image_source_reload_if_needed(image_t *image) {
     }
 }
 
+source_size_t image_source_get_output_size(source_size_t size) {
+
+    struct matrix4 transform;
+    gs_matrix_get(&transform);
+
+    /* Length of the transformed axes: the scale whatever the rotation */
+    const float scale_x = hypotf(transform.x.x, transform.x.y);
+    const float scale_y = hypotf(transform.y.x, transform.y.y);
+
+    /* The canvas is rescaled to the output resolution */
+    struct obs_video_info video_info;
+    float                 output_scale = 1.0f;
+
+    if (obs_get_video_info(&video_info) && video_info.base_width > 0) {
+        output_scale = (float)video_info.output_width / (float)video_info.base_width;
+    }
+
+    return (source_size_t){
+        .width  = (uint32_t)ceilf((float)size.width * scale_x * output_scale),
+        .height = (uint32_t)ceilf((float)size.height * scale_y * output_scale),
+    };
+}
+
+void image_source_update_display(image_source_t *source) {
+
+    if (!source) {
+        return;
+    }
+
+    const source_size_t output_size = image_source_get_output_size(source->size);
+    image_request_display_set_size(&source->display, output_size.width, output_size.height);
+}
+
+void image_source_activate(void *data) {
+
+    image_source_t *source = data;
+
+    if (source) {
+        image_request_display_set_active(&source->display, true);
+    }
+
+    source_activity_activate(data);
+}
+
+void image_source_deactivate(void *data) {
+
+    image_source_t *source = data;
+
+    if (source) {
+        image_request_display_set_active(&source->display, false);
+    }
+
+    source_activity_deactivate(data);
+}
+
 void image_source_render_active(image_t *image, source_size_t size, gs_effect_t *effect) {
 
     if (!image || !image->texture) {
@@ -113,8 +197,19 @@ void image_source_destroy(image_t *image) {
 
     if (image->texture) {
         obs_enter_graphics();
-        gs_texture_destroy(image->texture);
+        destroy_texture(image);
         obs_leave_graphics();
-        image->texture = NULL;
     }
 }
+
+void image_source_release(image_t *image) {
+
+    if (!image || !image->texture) {
+        return;
+    }
+
+    obs_enter_graphics();
+    destroy_texture(image);
+    image->must_reload = true;
+    obs_leave_graphics();
+}
@@ -5,6 +5,7 @@
 #include <stdint.h>
 
 #include "common/types.h"
+#include "io/image_request.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -47,6 +48,9 @@ typedef struct image_source {
     /** Display dimensions in pixels (width and height). */
     source_size_t size;
 
+    /** Size drawn in the output, declared to pick the download resolution. */
+    image_request_display_t display;
+
 } image_source_t;
 
 /**
@@ -156,6 +160,45 @@ void image_source_clear(image_t *image);
  */
 void image_source_reload_if_needed(image_t *image);
 
+/**
+ * @brief Get the size a source of @p size is drawn at in the output.
+ *
+ * Applies the scale of the current transform (the scene item's scale or
+ * bounds) and the output rescaling to the source size.
+ *
+ * @pre Must be called from the graphics thread, while the source renders.
+ *
+ * @param size Size of the source, in pixels.
+ * @return Size in output pixels, rounded up.
+ */
+source_size_t image_source_get_output_size(source_size_t size);
+
+/**
+ * @brief Declare the size a source is drawn at, to download its images at that size.
+ *
+ * @pre Must be called from the source's video_render callback.
+ *
+ * @param source Source being rendered.
+ */
+void image_source_update_display(image_source_t *source);
+
+/**
+ * @brief OBS @c activate callback of the image sources.
+ *
+ * Counts the source's display (see @ref image_request_display_set_active) and
+ * forwards to source_activity_activate().
+ *
+ * @param data The image_source_t instance.
+ */
+void image_source_activate(void *data);
+
+/**
+ * @brief OBS @c deactivate callback of the image sources.
+ *
+ * @param data The image_source_t instance.
+ */
+void image_source_deactivate(void *data);
+
 /**
  * @brief Render the cached texture at full opacity.
  *
@@ -234,6 +277,22 @@ void image_source_render_inactive_with_opacity(image_t *image, source_size_t siz
  */
 void image_source_destroy(image_t *image);
 
+/**
+ * @brief Release the texture while keeping the image, to save GPU memory.
+ *
+ * Used while no tracker source is visible. The texture is recreated from
+ * `cache_path` by the next image_source_reload_if_needed(), so the image
+ * shows up again as soon as the source is rendered. Safe to call even if no
+ * texture is loaded.
+ *
+ * **Thread Safety:** Handles graphics context internally, safe to call from any thread.
+ *
+ * @param image Image cache whose texture to release. May be NULL.
+ *
+ * @post `texture` is NULL and `must_reload` is true if a texture was released.
+ */
+void image_source_release(image_t *image);
+
 #ifdef __cplusplus
 }
 #endif
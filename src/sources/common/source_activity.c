@@ -0,0 +1,158 @@
+#include "sources/common/source_activity.h"
+
+#include <obs-module.h>
+#include <diagnostics/log.h>
+#include <util/thread_compat.h>
+
+/** Maximum number of subscribers that can be registered. */
+#define MAX_SUBSCRIBERS 8
+
+static pthread_mutex_t g_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** Number of sources shown (preview, program, projector...). */
+static int g_shown_count = 0;
+
+/** Number of sources in the program. */
+static int g_active_count = 0;
+
+static source_activity_callback_t g_subscribers[MAX_SUBSCRIBERS];
+static int                        g_subscriber_count = 0;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Private functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Visibility from the counters. Must be called with the mutex held.
+ */
+static bool is_visible_locked(void) {
+    return g_shown_count > 0 || g_active_count > 0;
+}
+
+/**
+ * @brief Apply a counter change and notify the subscribers if the visibility flipped.
+ */
+static void update_counter(int *counter, int delta) {
+
+    pthread_mutex_lock(&g_mutex);
+
+    const bool was_visible = is_visible_locked();
+
+    *counter += delta;
+
+    /* OBS pairs the callbacks, but never let a stray one wedge the counters */
+    if (*counter < 0) {
+        *counter = 0;
+    }
+
+    const bool visible = is_visible_locked();
+
+    source_activity_callback_t subscribers[MAX_SUBSCRIBERS];
+    const int                  subscriber_count = g_subscriber_count;
+
+    for (int i = 0; i < subscriber_count; i++) {
+        subscribers[i] = g_subscribers[i];
+    }
+
+    pthread_mutex_unlock(&g_mutex);
+
+    if (visible == was_visible) {
+        return;
+    }
+
+    obs_log(LOG_INFO, "[SourceActivity] %s", visible ? "A tracker source is visible" : "No tracker source visible");
+
+    for (int i = 0; i < subscriber_count; i++) {
+        subscribers[i](source_activity_is_visible());
+    }
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public API
+//  --------------------------------------------------------------------------------------------------------------------
+
+void source_activity_show(void *data) {
+    (void)data;
+    update_counter(&g_shown_count, 1);
+}
+
+void source_activity_hide(void *data) {
+    (void)data;
+    update_counter(&g_shown_count, -1);
+}
+
+void source_activity_activate(void *data) {
+    (void)data;
+    update_counter(&g_active_count, 1);
+}
+
+void source_activity_deactivate(void *data) {
+    (void)data;
+    update_counter(&g_active_count, -1);
+}
+
+bool source_activity_is_visible(void) {
+
+    pthread_mutex_lock(&g_mutex);
+    const bool visible = is_visible_locked();
+    pthread_mutex_unlock(&g_mutex);
+
+    return visible;
+}
+
+bool source_activity_is_active(void) {
+
+    pthread_mutex_lock(&g_mutex);
+    const bool active = g_active_count > 0;
+    pthread_mutex_unlock(&g_mutex);
+
+    return active;
+}
+
+void source_activity_subscribe(source_activity_callback_t callback) {
+
+    if (!callback) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_mutex);
+
+    for (int i = 0; i < g_subscriber_count; i++) {
+        if (g_subscribers[i] == callback) {
+            pthread_mutex_unlock(&g_mutex);
+            return;
+        }
+    }
+
+    if (g_subscriber_count >= MAX_SUBSCRIBERS) {
+        pthread_mutex_unlock(&g_mutex);
+        obs_log(LOG_WARNING, "[SourceActivity] Maximum subscribers reached");
+        return;
+    }
+
+    g_subscribers[g_subscriber_count++] = callback;
+
+    pthread_mutex_unlock(&g_mutex);
+}
+
+void source_activity_unsubscribe(source_activity_callback_t callback) {
+
+    if (!callback) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_mutex);
+
+    for (int i = 0; i < g_subscriber_count; i++) {
+        if (g_subscribers[i] == callback) {
+            for (int j = i; j < g_subscriber_count - 1; j++) {
+                g_subscribers[j] = g_subscribers[j + 1];
+            }
+            g_subscriber_count--;
+            g_subscribers[g_subscriber_count] = NULL;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&g_mutex);
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file source_activity.h
+ * @brief Tracks whether any tracker source is currently on screen.
+ *
+ * Every source forwards its OBS @c show / @c hide (displayed anywhere: preview,
+ * program, projector) and @c activate / @c deactivate (displayed in the
+ * program) callbacks here. While no source is visible, the plugin runs in a
+ * low-power mode:
+ *  - the video ticks skip the cycle and fade work;
+ *  - the image sources release their textures (reloaded from the file cache on
+ *    the next render);
+ *  - the asset prefetch is deferred.
+ * The monitors keep their connections, so the data is current as soon as a
+ * source shows up again.
+ *
+ * Thread safety:
+ *   All functions may be called from any thread. Subscribers are notified
+ *   outside of any lock, with the visibility read at notification time: two
+ *   transitions racing on different threads may notify the same value twice,
+ *   never a stale one last.
+ */
+
+/**
+ * @brief Callback invoked when the first source shows up or the last one goes away.
+ *
+ * @param visible True if at least one tracker source is visible.
+ */
+typedef void (*source_activity_callback_t)(bool visible);
+
+/**
+ * @brief A source is displayed (OBS @c show callback).
+ *
+ * @param data Source instance data (unused), so that the function can be used
+ *             as the obs_source_info callback directly.
+ */
+void source_activity_show(void *data);
+
+/**
+ * @brief A source is no longer displayed (OBS @c hide callback).
+ *
+ * @param data Source instance data (unused), so that the function can be used
+ *             as the obs_source_info callback directly.
+ */
+void source_activity_hide(void *data);
+
+/**
+ * @brief A source is displayed in the program (OBS @c activate callback).
+ *
+ * @param data Source instance data (unused), so that the function can be used
+ *             as the obs_source_info callback directly.
+ */
+void source_activity_activate(void *data);
+
+/**
+ * @brief A source is no longer displayed in the program (OBS @c deactivate callback).
+ *
+ * @param data Source instance data (unused), so that the function can be used
+ *             as the obs_source_info callback directly.
+ */
+void source_activity_deactivate(void *data);
+
+/**
+ * @brief Check whether at least one tracker source is visible.
+ */
+bool source_activity_is_visible(void);
+
+/**
+ * @brief Check whether at least one tracker source is in the program.
+ */
+bool source_activity_is_active(void);
+
+/**
+ * @brief Subscribe to visibility transitions.
+ *
+ * Duplicate subscriptions are ignored.
+ */
+void source_activity_subscribe(source_activity_callback_t callback);
+
+/**
+ * @brief Unsubscribe from visibility transitions.
+ */
+void source_activity_unsubscribe(source_activity_callback_t callback);
+
+#ifdef __cplusplus
+}
+#endif
@@ -7,6 +7,7 @@
 
 #include "drawing/color.h"
 #include "diagnostics/log.h"
+#include "diagnostics/memory_accounting.h"
 #include "sources/common/visibility_cycle.h"
 
 /**
@@ -231,7 +232,7 @@ text_source_t *text_source_create(obs_source_t *source, const char *name) {
         return NULL;
     }
 
-    text_source_t *text_source = bzalloc(sizeof(*text_source));
+    text_source_t *text_source = memory_alloc(MEMORY_TAG_RENDER, sizeof(*text_source));
 
     if (!text_source) {
         obs_log(LOG_ERROR, "[%s] Failed to create text source - invalid parameters", name);
@@ -291,7 +292,7 @@ void text_source_destroy(text_source_t *text_source) {
         text_source->name = NULL;
     }
 
-    bfree(text_source);
+    memory_free(text_source);
 }
 
 bool text_source_update_text(text_source_t *text_source, bool *force_reload, const text_source_config_t *config,
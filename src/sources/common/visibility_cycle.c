@@ -1,9 +1,10 @@
 #include "sources/common/visibility_cycle.h"
 
 #include <math.h>
-#include <util/platform.h>
 
-/** Nanoseconds-to-seconds conversion factor for os_gettime_ns(). */
+#include "time/clock.h"
+
+/** Nanoseconds-to-seconds conversion factor for clock_monotonic_ns(). */
 #define NS_TO_SECONDS 1000000000.0
 
 /* --------------------------------------------------------------------------
@@ -154,7 +155,7 @@ float auto_visibility_get_opacity(const auto_visibility_config_t *config) {
         return 1.0f;
     }
 
-    const double now_seconds = (double)os_gettime_ns() / NS_TO_SECONDS;
+    const double now_seconds = (double)clock_monotonic_ns() / NS_TO_SECONDS;
     float        phase_time  = (float)fmod(now_seconds, cycle);
 
     if (phase_time < show_duration) {
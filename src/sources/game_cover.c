@@ -19,8 +19,11 @@
 
 #include <obs-module.h>
 #include <diagnostics/log.h>
+#include <diagnostics/memory_accounting.h>
 
+#include "io/image_request.h"
 #include "sources/common/image_source.h"
+#include "sources/common/source_activity.h"
 #include "sources/common/visibility_cycle.h"
 #include "integrations/monitoring_service.h"
 #include "common/game.h"
@@ -43,6 +46,16 @@ static auto_visibility_config_t g_auto_visibility = {
 //	Event handlers
 //  --------------------------------------------------------------------------------------------------------------------
 
+/**
+ * @brief Release the cover texture while no tracker source is visible.
+ */
+static void on_source_activity_changed(bool visible) {
+
+    if (!visible) {
+        image_source_release(&g_game_cover);
+    }
+}
+
 /**
  * @brief Event handler called when a new game starts being played.
  *
@@ -109,11 +122,14 @@ static void *on_source_create(obs_data_t *settings, obs_source_t *source) {
 
     UNUSED_PARAMETER(settings);
 
-    image_source_t *s = bzalloc(sizeof(*s));
+    image_source_t *s = memory_alloc(MEMORY_TAG_RENDER, sizeof(*s));
     s->source         = source;
     s->size.width     = 800;
     s->size.height    = 200;
 
+    /* Counted once in the program, at the size the cover is drawn at in the output */
+    image_request_display_init(&s->display, "game_cover", s->size.width, s->size.height);
+
     return s;
 }
 
@@ -131,7 +147,9 @@ static void on_source_destroy(void *data) {
         return;
     }
 
-    bfree(source);
+    image_request_display_set_active(&source->display, false);
+
+    memory_free(source);
 }
 
 /**
@@ -163,6 +181,8 @@ static void on_source_video_render(void *data, gs_effect_t *effect) {
         return;
     }
 
+    image_source_update_display(source);
+
     /* Load image if needed (deferred load in graphics context) */
     image_source_reload_if_needed(&g_game_cover);
 
@@ -196,6 +216,10 @@ static struct obs_source_info game_cover_source_info = {
     .get_width      = source_get_width,
     .get_height     = source_get_height,
     .video_tick     = NULL,
+    .show           = source_activity_show,
+    .hide           = source_activity_hide,
+    .activate       = image_source_activate,
+    .deactivate     = image_source_deactivate,
 };
 
 /**
@@ -220,8 +244,11 @@ void game_cover_source_register(void) {
     auto_visibility_register_config(&g_auto_visibility);
 
     monitoring_subscribe_game_played(&on_game_played);
+
+    source_activity_subscribe(&on_source_activity_changed);
 }
 
 void game_cover_source_cleanup(void) {
+    source_activity_unsubscribe(&on_source_activity_changed);
     image_source_destroy(&g_game_cover);
 }
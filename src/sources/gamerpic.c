@@ -2,8 +2,11 @@
 
 #include <obs-module.h>
 #include <diagnostics/log.h>
+#include <diagnostics/memory_accounting.h>
 
+#include "io/image_request.h"
 #include "sources/common/image_source.h"
+#include "sources/common/source_activity.h"
 #include "sources/common/visibility_cycle.h"
 #include "common/memory.h"
 #include "integrations/monitoring_service.h"
@@ -26,6 +29,16 @@ static auto_visibility_config_t g_auto_visibility = {
 //	Event handlers
 //  --------------------------------------------------------------------------------------------------------------------
 
+/**
+ * @brief Release the gamerpic texture while no tracker source is visible.
+ */
+static void on_source_activity_changed(bool visible) {
+
+    if (!visible) {
+        image_source_release(&g_gamerpic);
+    }
+}
+
 static void on_active_identity_changed(const identity_t *identity) {
 
     if (!identity || !identity->avatar_url || identity->avatar_url[0] == '\0') {
@@ -82,11 +95,14 @@ static void *on_source_create(obs_data_t *settings, obs_source_t *source) {
 
     UNUSED_PARAMETER(settings);
 
-    image_source_t *s = bzalloc(sizeof(*s));
+    image_source_t *s = memory_alloc(MEMORY_TAG_RENDER, sizeof(*s));
     s->source         = source;
     s->size.width     = 800;
     s->size.height    = 200;
 
+    /* Download the images at the size this source is drawn at in the output, once in the program */
+    image_request_display_init(&s->display, "gamerpic", s->size.width, s->size.height);
+
     return s;
 }
 
@@ -104,7 +120,9 @@ static void on_source_destroy(void *data) {
         return;
     }
 
-    bfree(source);
+    image_request_display_set_active(&source->display, false);
+
+    memory_free(source);
 }
 
 /**
@@ -136,6 +154,8 @@ static void on_source_video_render(void *data, gs_effect_t *effect) {
         return;
     }
 
+    image_source_update_display(source);
+
     /* Load image if needed (deferred load in graphics context) */
     image_source_reload_if_needed(&g_gamerpic);
 
@@ -175,6 +195,10 @@ static struct obs_source_info xbox_gamerpic_source_info = {
     .get_width      = source_get_width,
     .get_height     = source_get_height,
     .video_tick     = NULL,
+    .show           = source_activity_show,
+    .hide           = source_activity_hide,
+    .activate       = image_source_activate,
+    .deactivate     = image_source_deactivate,
 };
 
 /**
@@ -199,8 +223,11 @@ void xbox_gamerpic_source_register(void) {
     auto_visibility_register_config(&g_auto_visibility);
 
     monitoring_subscribe_active_identity(on_active_identity_changed);
+
+    source_activity_subscribe(&on_source_activity_changed);
 }
 
 void xbox_gamerpic_source_cleanup(void) {
+    source_activity_unsubscribe(&on_source_activity_changed);
     image_source_destroy(&g_gamerpic);
 }
@@ -9,6 +9,7 @@
  */
 
 #include "sources/common/text_source.h"
+#include "sources/common/source_activity.h"
 #include "sources/common/visibility_cycle.h"
 
 #include <obs-module.h>
@@ -16,6 +17,7 @@
 
 #include "io/state.h"
 #include "integrations/monitoring_service.h"
+#include "time/clock.h"
 
 /** Current gamertag text to display. */
 static char g_gamertag[256];
@@ -79,7 +81,9 @@ static void *on_source_create(obs_data_t *settings, obs_source_t *source) {
      * briefly show "Not connected" when added to a scene after the monitor
      * has already connected.  The subscription callback won't fire again for
      * an already-established identity. */
-    update_gamertag(monitoring_get_current_active_identity());
+    identity_t *identity = monitoring_copy_current_active_identity();
+    update_gamertag(identity);
+    free_identity_t(&identity);
 
     return text_source_create(source, "Gamertag");
 }
@@ -123,6 +127,11 @@ static void on_source_video_render(void *data, gs_effect_t *effect) {
 }
 
 static void on_source_video_tick(void *data, float seconds) {
+    if (!source_activity_is_visible()) {
+        return;
+    }
+
+    seconds = clock_scale_frame(seconds);
     text_source_tick(data, &g_render_config, seconds);
 }
 
@@ -154,6 +163,10 @@ static struct obs_source_info xbox_gamertag_source = {
     .get_height     = source_get_height,
     .video_tick     = on_source_video_tick,
     .video_render   = on_source_video_render,
+    .show           = source_activity_show,
+    .hide           = source_activity_hide,
+    .activate       = source_activity_activate,
+    .deactivate     = source_activity_deactivate,
 };
 
 //  --------------------------------------------------------------------------------------------------------------------
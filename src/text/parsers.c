@@ -1,6 +1,7 @@
 #include "parsers.h"
 
 #include "text/convert.h"
+#include "util/arena.h"
 
 #include <obs-module.h>
 #include <cJSON.h>
@@ -21,18 +22,65 @@
 #define XBOX_ACHIEVEMENT_ICON_WIDTH  200
 #define XBOX_ACHIEVEMENT_ICON_HEIGHT 200
 
-static char *get_node_string(cJSON *json_root, int achievement_index, const char *property_name) {
+/** Initial scratch arena size per byte of JSON text: the cJSON tree is a few times larger than its text. */
+#define SCRATCH_BYTES_PER_JSON_BYTE 4
+#define SCRATCH_MIN_SIZE            4096
+
+/**
+ * @brief cJSON tree parsed for the duration of one message or page.
+ *
+ * The tree is allocated from a scratch arena and released with it in one go:
+ * only the values copied out of it (the returned records) outlive the parse.
+ */
+typedef struct scratch_json {
+    arena_t *arena;
+    /** Whether the tree lives in @c arena (false when the cJSON hooks are not installed). */
+    bool     in_arena;
+    cJSON   *root;
+} scratch_json_t;
+
+static cJSON *parse_scratch_json(scratch_json_t *scratch, const char *json_string) {
+
+    size_t arena_size = strlen(json_string) * SCRATCH_BYTES_PER_JSON_BYTE;
+
+    scratch->arena    = arena_create(arena_size > SCRATCH_MIN_SIZE ? arena_size : SCRATCH_MIN_SIZE);
+    scratch->in_arena = arena_json_begin(scratch->arena);
+    scratch->root     = cJSON_Parse(json_string);
+    arena_json_end();
+
+    return scratch->root;
+}
+
+static void release_scratch_json(scratch_json_t *scratch) {
+
+    if (!scratch->in_arena) {
+        free_json_memory((void **)&scratch->root);
+    }
+
+    scratch->root = NULL;
+    arena_destroy(&scratch->arena);
+}
+
+/**
+ * @brief Read a string property of an achievement.
+ *
+ * @return The value, borrowed from the tree, or NULL if missing.
+ */
+static const char *get_node_value(cJSON *json_root, int achievement_index, const char *property_name) {
 
     char property_key[512] = "";
     snprintf(property_key, sizeof(property_key), "/achievements/%d/%s", achievement_index, property_name);
 
     cJSON *property_node = cJSONUtils_GetPointer(json_root, property_key);
 
-    if (!property_node || !property_node->valuestring) {
-        return NULL;
-    }
+    return property_node ? property_node->valuestring : NULL;
+}
+
+static char *get_node_string(cJSON *json_root, int achievement_index, const char *property_name) {
+
+    const char *property_value = get_node_value(json_root, achievement_index, property_name);
 
-    return bstrdup(property_node->valuestring);
+    return property_value ? bstrdup(property_value) : NULL;
 }
 
 static char *append_icon_size_query(const char *url) {
@@ -62,28 +110,19 @@ static char *append_icon_size_query(const char *url) {
 
 static bool get_node_bool(cJSON *json_root, int achievement_index, const char *property_name) {
 
-    char *property_value = get_node_string(json_root, achievement_index, property_name);
-
-    if (!property_value) {
-        return false;
-    }
-
-    bool result = strcmp(property_value, "true") == 0;
-    free_memory((void **)&property_value);
+    const char *property_value = get_node_value(json_root, achievement_index, property_name);
 
-    return result;
+    return property_value && strcmp(property_value, "true") == 0;
 }
 
 static int64_t get_node_unix_timestamp(cJSON *json_root, int achievement_index, const char *property_name) {
 
-    int64_t result = 0;
-
-    char *property_value = get_node_string(json_root, achievement_index, property_name);
+    const char *property_value = get_node_value(json_root, achievement_index, property_name);
 
     obs_log(LOG_DEBUG, "%s=%s", property_name, property_value);
 
     if (!property_value || strlen(property_value) == 0) {
-        goto cleanup;
+        return 0;
     }
 
     int32_t fraction       = 0;
@@ -94,45 +133,29 @@ static int64_t get_node_unix_timestamp(cJSON *json_root, int achievement_index,
                 "Unable to convert property '%s' as a unix timestamp. Value: %s",
                 property_name,
                 property_value);
-        goto cleanup;
+        return 0;
     }
 
     obs_log(LOG_DEBUG, "%s=%" PRId64, property_name, unix_timestamp);
 
     /* If the achievement is locked, the date returned is 0001-01-01, which in unix timestamp is definitely negative */
     /* We assume a timestamp equal to 0 is a locked achievement */
-    result = unix_timestamp > 0 ? unix_timestamp : 0;
-
-cleanup:
-    free_memory((void **)&property_value);
-
-    return result;
+    return unix_timestamp > 0 ? unix_timestamp : 0;
 }
 
 static bool contains_node(const char *json_string, const char *node_key) {
 
-    cJSON *json_message  = NULL;
-    cJSON *node          = NULL;
-    bool   contains_node = false;
-
     if (!json_string || strlen(json_string) == 0) {
-        goto cleanup;
-    }
-
-    json_message = cJSON_Parse(json_string);
-
-    if (!json_message) {
-        goto cleanup;
+        return false;
     }
 
-    node = cJSONUtils_GetPointer(json_message, node_key);
-
-    contains_node = node != NULL;
+    scratch_json_t scratch      = {0};
+    cJSON         *json_message = parse_scratch_json(&scratch, json_string);
+    const bool     contains     = json_message && cJSONUtils_GetPointer(json_message, node_key) != NULL;
 
-cleanup:
-    free_json_memory((void **)&json_message);
+    release_scratch_json(&scratch);
 
-    return contains_node;
+    return contains;
 }
 
 //  --------------------------------------------------------------------------------------------------------------------
@@ -151,8 +174,7 @@ bool is_presence_message(const char *json_string) {
 
 char *parse_presence_game_id(const char *json_string) {
 
-    cJSON *json_root = NULL;
-    char  *game_id   = NULL;
+    char *game_id = NULL;
 
     if (!json_string || strlen(json_string) == 0) {
         return NULL;
@@ -160,10 +182,11 @@ char *parse_presence_game_id(const char *json_string) {
 
     obs_log(LOG_DEBUG, "[Parsers] Parsing presence game ID (%zu bytes)", strlen(json_string));
 
-    json_root = cJSON_Parse(json_string);
+    scratch_json_t scratch   = {0};
+    cJSON         *json_root = parse_scratch_json(&scratch, json_string);
 
     if (!json_root) {
-        return NULL;
+        goto cleanup;
     }
 
     char current_game_id[128] = "";
@@ -210,14 +233,13 @@ char *parse_presence_game_id(const char *json_string) {
     game_id = bstrdup(current_game_id);
 
 cleanup:
-    free_json_memory((void **)&json_root);
+    release_scratch_json(&scratch);
 
     return game_id;
 }
 
 xbox_achievement_progress_t *parse_achievement_progress(const char *json_string) {
 
-    cJSON                       *json_root            = NULL;
     xbox_achievement_progress_t *achievement_progress = NULL;
 
     if (!json_string || strlen(json_string) == 0) {
@@ -226,10 +248,11 @@ xbox_achievement_progress_t *parse_achievement_progress(const char *json_string)
 
     obs_log(LOG_DEBUG, "[Parsers] Parsing achievement progress (%zu bytes)", strlen(json_string));
 
-    json_root = cJSON_Parse(json_string);
+    scratch_json_t scratch   = {0};
+    cJSON         *json_root = parse_scratch_json(&scratch, json_string);
 
     if (!json_root) {
-        return NULL;
+        goto cleanup;
     }
 
     cJSON *service_config_node = cJSONUtils_GetPointer(json_root, "/serviceConfigId");
@@ -312,23 +335,24 @@ xbox_achievement_progress_t *parse_achievement_progress(const char *json_string)
     }
 
 cleanup:
-    free_json_memory((void **)&json_root);
+    release_scratch_json(&scratch);
 
     return achievement_progress;
 }
 
 xbox_achievement_t *parse_achievements(const char *json_string) {
 
-    cJSON              *json_root    = NULL;
     xbox_achievement_t *achievements = NULL;
 
     if (!json_string || strlen(json_string) == 0) {
         return NULL;
     }
 
-    json_root = cJSON_Parse(json_string);
+    scratch_json_t scratch   = {0};
+    cJSON         *json_root = parse_scratch_json(&scratch, json_string);
 
     if (!json_root) {
+        release_scratch_json(&scratch);
         return NULL;
     }
 
@@ -342,7 +366,7 @@ xbox_achievement_t *parse_achievements(const char *json_string) {
             break;
         }
 
-        xbox_achievement_t *achievement = bzalloc(sizeof(xbox_achievement_t));
+        xbox_achievement_t *achievement = xbox_alloc_achievement();
         achievement->id                 = id;
         achievement->service_config_id  = get_node_string(json_root, achievement_index, "serviceConfigId");
         achievement->name               = get_node_string(json_root, achievement_index, "name");
@@ -357,9 +381,8 @@ xbox_achievement_t *parse_achievements(const char *json_string) {
         achievement->progression_target =
             get_node_string(json_root, achievement_index, "progression/requirements/0/target");
 
-        char *icon_url        = get_node_string(json_root, achievement_index, "mediaAssets/0/url");
-        achievement->icon_url = append_icon_size_query(icon_url);
-        free_memory((void **)&icon_url);
+        achievement->icon_url =
+            append_icon_size_query(get_node_value(json_root, achievement_index, "mediaAssets/0/url"));
 
         /* Reads the media assets */
         xbox_media_asset_t *media_assets = NULL;
@@ -469,7 +492,45 @@ xbox_achievement_t *parse_achievements(const char *json_string) {
         }
     }
 
-    free_json_memory((void **)&json_root);
+    release_scratch_json(&scratch);
 
     return achievements;
 }
+
+device_code_poll_error_t parse_device_code_poll_error(const char *json_string) {
+
+    if (!json_string || *json_string == '\0') {
+        return DEVICE_CODE_POLL_ERROR_UNKNOWN;
+    }
+
+    scratch_json_t scratch   = {0};
+    cJSON         *json_root = parse_scratch_json(&scratch, json_string);
+
+    if (!json_root) {
+        release_scratch_json(&scratch);
+        return DEVICE_CODE_POLL_ERROR_UNKNOWN;
+    }
+
+    device_code_poll_error_t result     = DEVICE_CODE_POLL_ERROR_UNKNOWN;
+    cJSON                   *error_node = cJSONUtils_GetPointer(json_root, "/error");
+
+    if (error_node && error_node->valuestring) {
+        const char *error = error_node->valuestring;
+
+        if (strcmp(error, "authorization_pending") == 0) {
+            result = DEVICE_CODE_POLL_ERROR_AUTHORIZATION_PENDING;
+        } else if (strcmp(error, "slow_down") == 0) {
+            result = DEVICE_CODE_POLL_ERROR_SLOW_DOWN;
+        } else if (strcmp(error, "access_denied") == 0 || strcmp(error, "authorization_declined") == 0) {
+            result = DEVICE_CODE_POLL_ERROR_ACCESS_DENIED;
+        } else if (strcmp(error, "expired_token") == 0 || strcmp(error, "bad_verification_code") == 0) {
+            result = DEVICE_CODE_POLL_ERROR_EXPIRED_TOKEN;
+        } else {
+            result = DEVICE_CODE_POLL_ERROR_OTHER;
+        }
+    }
+
+    release_scratch_json(&scratch);
+
+    return result;
+}
@@ -73,6 +73,32 @@ xbox_achievement_progress_t *parse_achievement_progress(const char *json_string)
  */
 xbox_achievement_t *parse_achievements(const char *json_string);
 
+/**
+ * @brief Outcome of an unsuccessful device-code token poll (RFC 8628, section 3.5).
+ */
+typedef enum device_code_poll_error {
+    /** No recognizable error: transient failure (network, 5xx), keep polling. */
+    DEVICE_CODE_POLL_ERROR_UNKNOWN,
+    /** The user has not completed the authorization yet: keep polling. */
+    DEVICE_CODE_POLL_ERROR_AUTHORIZATION_PENDING,
+    /** Keep polling, with the interval increased by 5 seconds. */
+    DEVICE_CODE_POLL_ERROR_SLOW_DOWN,
+    /** The user declined the authorization: stop. */
+    DEVICE_CODE_POLL_ERROR_ACCESS_DENIED,
+    /** The device code expired: stop. */
+    DEVICE_CODE_POLL_ERROR_EXPIRED_TOKEN,
+    /** Any other OAuth error: stop. */
+    DEVICE_CODE_POLL_ERROR_OTHER,
+} device_code_poll_error_t;
+
+/**
+ * @brief Classify the error response of a device-code token poll.
+ *
+ * @param json_string NUL-terminated JSON string (may be NULL).
+ * @return The error carried by the "error" field of the response.
+ */
+device_code_poll_error_t parse_device_code_poll_error(const char *json_string);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,173 @@
+#include "time/clock.h"
+
+#include <util/platform.h>
+
+#include <stdlib.h>
+
+#include "util/thread_compat.h"
+
+#define NS_PER_SECOND 1000000000ULL
+
+/** Environment variable holding the acceleration factor selected at load. */
+#define TIME_FACTOR_VARIABLE "ACHIEVEMENTS_TRACKER_TIME_FACTOR"
+
+static pthread_mutex_t g_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static clock_mode_t g_mode   = CLOCK_MODE_REAL;
+static double       g_factor = 1.0;
+
+/*
+ * Outside the real mode, the time is derived from the origin taken when the
+ * mode was selected: the virtual monotonic and wall times at that instant,
+ * and the real monotonic time the acceleration is measured from.
+ */
+static uint64_t g_origin_real_ns    = 0;
+static uint64_t g_origin_virtual_ns = 0;
+static time_t   g_origin_unix_time  = 0;
+
+/** Time added by clock_advance_ns() since the origin (simulated mode). */
+static uint64_t g_simulated_elapsed_ns = 0;
+
+/**
+ * Difference between the monotonic time and the OS one in the real mode.
+ *
+ * Non-zero once the clock came back from another mode, so that the monotonic
+ * time continues from where that mode left it instead of going backwards.
+ */
+static int64_t g_real_offset_ns = 0;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Private functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Virtual time elapsed since the origin. Must be called with the mutex held.
+ */
+static uint64_t elapsed_since_origin_ns(void) {
+
+    switch (g_mode) {
+    case CLOCK_MODE_SIMULATED:
+        return g_simulated_elapsed_ns;
+    case CLOCK_MODE_ACCELERATED:
+        return (uint64_t)((double)(os_gettime_ns() - g_origin_real_ns) * g_factor);
+    case CLOCK_MODE_REAL:
+    default:
+        return 0;
+    }
+}
+
+static uint64_t monotonic_ns_locked(void) {
+    return g_mode == CLOCK_MODE_REAL ? (uint64_t)((int64_t)os_gettime_ns() + g_real_offset_ns)
+                                     : g_origin_virtual_ns + elapsed_since_origin_ns();
+}
+
+static time_t unix_time_locked(void) {
+    return g_mode == CLOCK_MODE_REAL ? time(NULL)
+                                     : g_origin_unix_time + (time_t)(elapsed_since_origin_ns() / NS_PER_SECOND);
+}
+
+/**
+ * @brief Start a new mode from the current virtual time. Must be called with the mutex held.
+ */
+static void switch_mode(clock_mode_t mode, double factor, time_t unix_time) {
+
+    const uint64_t virtual_ns  = monotonic_ns_locked();
+    const time_t   virtual_now = unix_time_locked();
+
+    g_origin_real_ns       = os_gettime_ns();
+    g_origin_virtual_ns    = virtual_ns;
+    g_real_offset_ns       = (int64_t)virtual_ns - (int64_t)g_origin_real_ns;
+    g_origin_unix_time     = unix_time ? unix_time : virtual_now;
+    g_simulated_elapsed_ns = 0;
+    g_factor               = factor;
+    g_mode                 = mode;
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public API
+//  --------------------------------------------------------------------------------------------------------------------
+
+uint64_t clock_monotonic_ns(void) {
+
+    pthread_mutex_lock(&g_mutex);
+    const uint64_t value = monotonic_ns_locked();
+    pthread_mutex_unlock(&g_mutex);
+
+    return value;
+}
+
+time_t clock_unix_time(void) {
+
+    pthread_mutex_lock(&g_mutex);
+    const time_t value = unix_time_locked();
+    pthread_mutex_unlock(&g_mutex);
+
+    return value;
+}
+
+float clock_scale_frame(float seconds) {
+
+    pthread_mutex_lock(&g_mutex);
+    const float scaled = g_mode == CLOCK_MODE_ACCELERATED ? (float)(seconds * g_factor) : seconds;
+    pthread_mutex_unlock(&g_mutex);
+
+    return scaled;
+}
+
+void clock_use_real(void) {
+    pthread_mutex_lock(&g_mutex);
+    switch_mode(CLOCK_MODE_REAL, 1.0, 0);
+    pthread_mutex_unlock(&g_mutex);
+}
+
+void clock_use_simulated(time_t unix_time) {
+    pthread_mutex_lock(&g_mutex);
+    switch_mode(CLOCK_MODE_SIMULATED, 0.0, unix_time);
+    pthread_mutex_unlock(&g_mutex);
+}
+
+void clock_advance_ns(uint64_t delta_ns) {
+
+    pthread_mutex_lock(&g_mutex);
+
+    if (g_mode == CLOCK_MODE_SIMULATED) {
+        g_simulated_elapsed_ns += delta_ns;
+    }
+
+    pthread_mutex_unlock(&g_mutex);
+}
+
+void clock_use_accelerated(double factor) {
+    pthread_mutex_lock(&g_mutex);
+    switch_mode(CLOCK_MODE_ACCELERATED, factor > 0.0 ? factor : 1.0, 0);
+    pthread_mutex_unlock(&g_mutex);
+}
+
+double clock_use_accelerated_from_environment(void) {
+
+    const char *value = getenv(TIME_FACTOR_VARIABLE);
+
+    if (!value || !*value) {
+        return 1.0;
+    }
+
+    char        *end    = NULL;
+    const double factor = strtod(value, &end);
+
+    if (end == value || *end != '\0' || !(factor > 0.0) || factor == 1.0) {
+        return 1.0;
+    }
+
+    clock_use_accelerated(factor);
+
+    return factor;
+}
+
+clock_mode_t clock_get_mode(void) {
+
+    pthread_mutex_lock(&g_mutex);
+    const clock_mode_t mode = g_mode;
+    pthread_mutex_unlock(&g_mutex);
+
+    return mode;
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file clock.h
+ * @brief Injectable clock behind the plugin's timing code.
+ *
+ * The display cycle, the auto show/hide fades, the source transitions and
+ * the token expiry read the time through this module instead of the OS, so
+ * that it can be swapped. The RTA keepalive and the network timeouts stay on
+ * the OS clock: they pace a real connection.
+ *  - Real (default): the OBS monotonic clock and the system wall clock.
+ *  - Simulated: the time only moves when @ref clock_advance_ns is called.
+ *    Tests and benchmarks run hours of cycling, fades and token expiry in
+ *    milliseconds.
+ *  - Accelerated: the real time multiplied by a factor, e.g. to soak-test a
+ *    whole evening of cycling in a few minutes inside OBS. Selected at load
+ *    by setting the ACHIEVEMENTS_TRACKER_TIME_FACTOR environment variable
+ *    (see @ref clock_use_accelerated_from_environment).
+ *
+ * The monotonic and wall clocks move together. Every mode continues the
+ * monotonic time from where the previous one left it, so it never goes
+ * backwards; back in the real mode, the wall clock is the system one again.
+ *
+ * Thread safety:
+ *   All functions may be called from any thread.
+ */
+
+/**
+ * @brief How the clock moves.
+ */
+typedef enum clock_mode {
+    /** Real time. */
+    CLOCK_MODE_REAL,
+    /** Frozen time, moved by @ref clock_advance_ns only. */
+    CLOCK_MODE_SIMULATED,
+    /** Real time multiplied by a factor. */
+    CLOCK_MODE_ACCELERATED,
+} clock_mode_t;
+
+/**
+ * @brief Monotonic time in nanoseconds (the replacement for os_gettime_ns()).
+ */
+uint64_t clock_monotonic_ns(void);
+
+/**
+ * @brief Wall-clock time in seconds since the Unix epoch (the replacement for time(NULL)).
+ */
+time_t clock_unix_time(void);
+
+/**
+ * @brief Scale the frame time handed by OBS to a source's video tick.
+ *
+ * @param seconds Real time elapsed since the previous frame.
+ *
+ * @return @p seconds multiplied by the acceleration factor, or unchanged in
+ *         the other modes (a simulated clock drives the ticks itself).
+ */
+float clock_scale_frame(float seconds);
+
+/**
+ * @brief Go back to the real time.
+ */
+void clock_use_real(void);
+
+/**
+ * @brief Freeze the time until @ref clock_advance_ns is called.
+ *
+ * @param unix_time Wall-clock time to start from, or 0 to keep the current one.
+ */
+void clock_use_simulated(time_t unix_time);
+
+/**
+ * @brief Move a simulated clock forward. Ignored in the other modes.
+ */
+void clock_advance_ns(uint64_t delta_ns);
+
+/**
+ * @brief Make the time flow @p factor times faster than the real time.
+ *
+ * @param factor Acceleration factor (values <= 0 are treated as 1).
+ */
+void clock_use_accelerated(double factor);
+
+/**
+ * @brief Select the accelerated mode when ACHIEVEMENTS_TRACKER_TIME_FACTOR is set.
+ *
+ * Debugging aid read once at plugin load. The variable holds the
+ * acceleration factor (e.g. "60" for one minute per second); a missing,
+ * invalid or non-positive value, or 1, keeps the real time.
+ *
+ * @return The factor applied, or 1 when the clock stays real.
+ */
+double clock_use_accelerated_from_environment(void);
+
+/**
+ * @brief Get the current mode.
+ */
+clock_mode_t clock_get_mode(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,7 +1,7 @@
 #include "time/time.h"
 
-#include <stddef.h>
+#include "time/clock.h"
 
 time_t now() {
-    return time(NULL);
+    return clock_unix_time();
 }
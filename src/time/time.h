@@ -11,8 +11,9 @@ extern "C" {
 /**
  * @brief Returns the current time as seconds since the Unix epoch.
  *
- * This is a small wrapper around the platform time source used by the project.
- * Primarily used to improve testability (can be stubbed in unit tests).
+ * This is a small wrapper around the injectable clock (see clock.h), so that
+ * it follows a simulated or accelerated clock. It can also be stubbed in unit
+ * tests.
  *
  * @return Current Unix timestamp in seconds.
  */
@@ -14,7 +14,9 @@
 #include <QLabel>
 #include <QPointer>
 #include <QPushButton>
+#include <QFontDatabase>
 #include <QSpinBox>
+#include <QTimer>
 #include <QVBoxLayout>
 #include <QWidget>
 
@@ -22,6 +24,7 @@ extern "C" {
 #include "sources/common/achievement_cycle.h"
 #include "sources/common/visibility_cycle.h"
 #include "io/state.h"
+#include "diagnostics/memory_accounting.h"
 }
 
 // ----------------------------------------------------------------------------
@@ -375,6 +378,47 @@ class AchievementTrackerDialog final : public QDialog {
         rootLayout->addSpacing(6);
         rootLayout->addLayout(visibilityForm);
 
+        // ---- Separator -------------------------------------------------------
+        auto *separator3 = new QFrame(this);
+        separator3->setFrameShape(QFrame::HLine);
+        separator3->setFrameShadow(QFrame::Sunken);
+        rootLayout->addSpacing(8);
+        rootLayout->addWidget(separator3);
+        rootLayout->addSpacing(8);
+
+        // ---- Memory section --------------------------------------------------
+        auto *memoryLabel = new QLabel("<b>Memory Usage</b>", this);
+
+        auto *memoryHelp = new QLabel(this);
+        memoryHelp->setWordWrap(true);
+        memoryHelp->setText("Memory used by the plugin, per subsystem. The same report is written to the OBS "
+                            "log every hour, so a steady growth over a long stream points at a leak.");
+
+        m_memoryReport = new QLabel(this);
+        m_memoryReport->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+        m_memoryReport->setTextInteractionFlags(Qt::TextSelectableByMouse);
+
+        auto *logMemoryButton = new QPushButton("Write to OBS Log", this);
+        logMemoryButton->setToolTip("Write the memory report to the OBS log");
+
+        auto *memoryButtonLayout = new QHBoxLayout();
+        memoryButtonLayout->addStretch();
+        memoryButtonLayout->addWidget(logMemoryButton);
+
+        connect(logMemoryButton, &QPushButton::clicked, this, []() { memory_log_report("requested"); });
+
+        /* Refresh the report while the dialog is open */
+        m_memoryTimer = new QTimer(this);
+        m_memoryTimer->setInterval(2000);
+        connect(m_memoryTimer, &QTimer::timeout, this, &AchievementTrackerDialog::refreshMemory);
+
+        rootLayout->addWidget(memoryLabel);
+        rootLayout->addSpacing(4);
+        rootLayout->addWidget(memoryHelp);
+        rootLayout->addSpacing(6);
+        rootLayout->addWidget(m_memoryReport);
+        rootLayout->addLayout(memoryButtonLayout);
+
         // ---- Buttons ---------------------------------------------------------
         auto *buttonBox = new QDialogButtonBox(this);
         m_saveButton    = buttonBox->addButton("Save", QDialogButtonBox::AcceptRole);
@@ -389,6 +433,7 @@ class AchievementTrackerDialog final : public QDialog {
         refreshBindings();
         loadTimings();
         loadVisibility();
+        refreshMemory();
     }
 
     void refreshBindings() {
@@ -413,6 +458,13 @@ class AchievementTrackerDialog final : public QDialog {
         bfree(timings);
     }
 
+    void refreshMemory() {
+        char report[1024];
+        memory_format_report(report, sizeof(report));
+
+        m_memoryReport->setText(QString::fromUtf8(report));
+    }
+
     void loadVisibility() {
         auto_visibility_durations_t *d = state_get_auto_visibility_durations();
         if (!d) {
@@ -426,6 +478,18 @@ class AchievementTrackerDialog final : public QDialog {
         bfree(d);
     }
 
+    protected:
+    void showEvent(QShowEvent *event) override {
+        QDialog::showEvent(event);
+        refreshMemory();
+        m_memoryTimer->start();
+    }
+
+    void hideEvent(QHideEvent *event) override {
+        m_memoryTimer->stop();
+        QDialog::hideEvent(event);
+    }
+
     private:
     void onSave() {
         achievement_cycle_timings_t timings;
@@ -477,6 +541,8 @@ class AchievementTrackerDialog final : public QDialog {
     QDoubleSpinBox *m_visShowSpin;
     QDoubleSpinBox *m_visHideSpin;
     QDoubleSpinBox *m_visFadeSpin;
+    QLabel         *m_memoryReport;
+    QTimer         *m_memoryTimer;
     QPushButton    *m_saveButton;
 };
 
@@ -4,15 +4,20 @@
 #include <obs-module.h>
 #include <diagnostics/log.h>
 
+#include <QCheckBox>
 #include <QDialog>
 #include <QDialogButtonBox>
 #include <QFormLayout>
 #include <QHBoxLayout>
+#include <QHideEvent>
 #include <QLabel>
 #include <QMessageBox>
+#include <QMetaObject>
 #include <QPointer>
 #include <QPushButton>
+#include <QShowEvent>
 #include <QSizePolicy>
+#include <QSpinBox>
 #include <QTimer>
 #include <QVBoxLayout>
 #include <QWidget>
@@ -21,6 +26,8 @@ extern "C" {
 #include "integrations/xbox/account_manager.h"
 }
 
+#include <util/platform.h>
+
 namespace {
 
 class XboxAccountDialog final : public QDialog {
@@ -28,10 +35,16 @@ class XboxAccountDialog final : public QDialog {
     explicit XboxAccountDialog(QWidget *parent = nullptr)
         : QDialog(parent),
           m_statusValue(new QLabel(this)),
+          m_connectionValue(new QLabel(this)),
           m_versionValue(new QLabel(this)),
           m_helpText(new QLabel(this)),
           m_accountButton(new QPushButton(this)),
-          m_refreshTimer(new QTimer(this)) {
+          m_pingIntervalSpin(new QSpinBox(this)),
+          m_maxPingIntervalSpin(new QSpinBox(this)),
+          m_pongTimeoutSpin(new QSpinBox(this)),
+          m_compressionCheck(new QCheckBox("Compress messages (permessage-deflate)", this)),
+          m_applyConnectionButton(new QPushButton("Apply", this)),
+          m_healthTimer(new QTimer(this)) {
         setWindowTitle("Xbox Account");
         setModal(false);
         setMinimumWidth(460);
@@ -49,6 +62,8 @@ class XboxAccountDialog final : public QDialog {
         m_statusValue->setWordWrap(true);
         m_statusValue->setMinimumHeight(m_statusValue->fontMetrics().height() * 2);
         m_statusValue->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
+        m_connectionValue->setTextInteractionFlags(Qt::TextSelectableByMouse);
+        m_connectionValue->setWordWrap(true);
         m_versionValue->setTextInteractionFlags(Qt::TextSelectableByMouse);
         m_helpText->setWordWrap(true);
         m_helpText->setAlignment(Qt::AlignLeft);
@@ -61,27 +76,126 @@ class XboxAccountDialog final : public QDialog {
         accountLayout->setContentsMargins(0, 0, 0, 0);
 
         formLayout->addRow("Status", m_statusValue);
+        formLayout->addRow("Connection", m_connectionValue);
         formLayout->addRow("Plugin version", m_versionValue);
         formLayout->addRow("Account", accountLayout);
 
+        // ---- Connection settings ---------------------------------------------
+        auto *connectionLabel = new QLabel("<b>Connection Settings</b>", this);
+
+        auto *connectionHelp = new QLabel(this);
+        connectionHelp->setWordWrap(true);
+        connectionHelp->setText("Keepalive of the real-time connection to Xbox Live. The ping interval stretches "
+                                "up to the maximum while the connection stays healthy. Applying restarts the "
+                                "connection.");
+
+        auto *connectionForm = new QFormLayout();
+        connectionForm->setLabelAlignment(Qt::AlignLeft);
+        connectionForm->setVerticalSpacing(6);
+        connectionForm->setFieldGrowthPolicy(QFormLayout::ExpandingFieldsGrow);
+
+        m_pingIntervalSpin->setRange(5, 300);
+        m_pingIntervalSpin->setSuffix(" s");
+        m_pingIntervalSpin->setToolTip("Seconds without traffic before a ping is sent.");
+
+        m_maxPingIntervalSpin->setRange(5, 300);
+        m_maxPingIntervalSpin->setSuffix(" s");
+        m_maxPingIntervalSpin->setToolTip("Longest interval between pings on a healthy connection.");
+
+        m_pongTimeoutSpin->setRange(2, 60);
+        m_pongTimeoutSpin->setSuffix(" s");
+        m_pongTimeoutSpin->setToolTip("Seconds to wait for the answer to a ping before reconnecting.");
+
+        auto *applyLayout = new QHBoxLayout();
+        applyLayout->addStretch(1);
+        applyLayout->addWidget(m_applyConnectionButton);
+        applyLayout->setContentsMargins(0, 0, 0, 0);
+
+        connectionForm->addRow("Ping interval", m_pingIntervalSpin);
+        connectionForm->addRow("Maximum ping interval", m_maxPingIntervalSpin);
+        connectionForm->addRow("Pong timeout", m_pongTimeoutSpin);
+        connectionForm->addRow("", m_compressionCheck);
+
+        /* The interval only ever stretches */
+        connect(m_pingIntervalSpin, &QSpinBox::valueChanged, this, [this](int value) {
+            m_maxPingIntervalSpin->setMinimum(value);
+        });
+
         rootLayout->addWidget(m_helpText);
         rootLayout->addSpacing(8);
         rootLayout->addLayout(formLayout);
+        rootLayout->addSpacing(8);
+        rootLayout->addWidget(connectionLabel);
+        rootLayout->addSpacing(4);
+        rootLayout->addWidget(connectionHelp);
+        rootLayout->addSpacing(6);
+        rootLayout->addLayout(connectionForm);
+        rootLayout->addLayout(applyLayout);
         rootLayout->addWidget(buttonBox);
 
         m_versionValue->setText(PLUGIN_VERSION);
 
         connect(buttonBox, &QDialogButtonBox::rejected, this, &QDialog::close);
         connect(m_accountButton, &QPushButton::clicked, this, &XboxAccountDialog::onAccountButtonClicked);
-        connect(m_refreshTimer, &QTimer::timeout, this, &XboxAccountDialog::refreshUi);
+        connect(m_applyConnectionButton, &QPushButton::clicked, this, &XboxAccountDialog::onApplyConnection);
+
+        /* Health is only notified on pongs and connection changes, which can be minutes apart: while the
+         * dialog is shown, the time of the last message (a copy under the monitor's lock) is re-read locally */
+        m_healthTimer->setInterval(1000);
+        connect(m_healthTimer, &QTimer::timeout, this, [this]() {
+            xbox_account_get_connection_health(&m_health);
+            renderHealth();
+        });
+
+        /* The UI is refreshed when the account or the connection changes, instead of polling */
+        xbox_account_set_listener(&XboxAccountDialog::onAccountChanged, &XboxAccountDialog::onHealthChanged, this);
+
+        xbox_connection_health_t health;
+        xbox_account_get_connection_health(&health);
 
-        m_refreshTimer->start(1000);
         refreshUi();
+        refreshHealth(health);
+        loadConnectionConfiguration();
+    }
+
+    ~XboxAccountDialog() override {
+        /* Once cleared, no callback can run anymore; queued refreshes are discarded with the dialog */
+        xbox_account_set_listener(nullptr, nullptr, nullptr);
+    }
+
+    protected:
+    void showEvent(QShowEvent *event) override {
+        QDialog::showEvent(event);
+        renderHealth();
+        m_healthTimer->start();
+    }
+
+    void hideEvent(QHideEvent *event) override {
+        m_healthTimer->stop();
+        QDialog::hideEvent(event);
     }
 
     private:
+    /** Called from the thread changing the account: the refresh is queued on the dialog's thread. */
+    static void onAccountChanged(void *data) {
+        auto *dialog = static_cast<XboxAccountDialog *>(data);
+
+        QMetaObject::invokeMethod(dialog, [dialog]() { dialog->refreshUi(); }, Qt::QueuedConnection);
+    }
+
+    /** Called from the Xbox monitor thread: the health is copied and rendered on the dialog's thread. */
+    static void onHealthChanged(const xbox_connection_health_t *health, void *data) {
+        auto                          *dialog = static_cast<XboxAccountDialog *>(data);
+        const xbox_connection_health_t copy   = *health;
+
+        QMetaObject::invokeMethod(dialog, [dialog, copy]() { dialog->refreshHealth(copy); }, Qt::QueuedConnection);
+    }
+
     void onAccountButtonClicked() {
-        if (xbox_account_is_signed_in()) {
+        if (xbox_account_is_signing_in()) {
+            xbox_account_cancel_sign_in();
+            refreshUi();
+        } else if (xbox_account_is_signed_in()) {
             xbox_account_sign_out();
             refreshUi();
         } else {
@@ -98,9 +212,42 @@ class XboxAccountDialog final : public QDialog {
         }
     }
 
+    void loadConnectionConfiguration() {
+        rta_connection_configuration_t configuration;
+        xbox_account_get_connection_configuration(&configuration);
+
+        m_pingIntervalSpin->setValue(configuration.ping_interval);
+        m_maxPingIntervalSpin->setValue(configuration.max_ping_interval);
+        m_pongTimeoutSpin->setValue(configuration.pong_timeout);
+        m_compressionCheck->setChecked(configuration.compression_enabled);
+    }
+
+    void onApplyConnection() {
+        rta_connection_configuration_t configuration;
+        configuration.ping_interval       = m_pingIntervalSpin->value();
+        configuration.max_ping_interval   = m_maxPingIntervalSpin->value();
+        configuration.pong_timeout        = m_pongTimeoutSpin->value();
+        configuration.compression_enabled = m_compressionCheck->isChecked();
+
+        xbox_account_set_connection_configuration(&configuration);
+
+        obs_log(LOG_INFO,
+                "Xbox Account: connection settings saved — ping=%ds, max_ping=%ds, pong_timeout=%ds, compression=%s",
+                configuration.ping_interval,
+                configuration.max_ping_interval,
+                configuration.pong_timeout,
+                configuration.compression_enabled ? "on" : "off");
+    }
+
     void refreshUi() {
         char status[1024];
 
+        if (xbox_account_is_signing_in()) {
+            m_statusValue->setText("Waiting for the sign-in to be completed in the browser...");
+            m_accountButton->setText("Cancel sign-in");
+            return;
+        }
+
         xbox_account_get_status_text(status, sizeof(status));
         m_statusValue->setText(QString::fromUtf8(status));
 
@@ -108,12 +255,51 @@ class XboxAccountDialog final : public QDialog {
         m_accountButton->setText(signedIn ? "Sign out from Xbox" : "Sign in with Xbox");
     }
 
+    void refreshHealth(const xbox_connection_health_t &health) {
+        m_health = health;
+        renderHealth();
+    }
+
+    /** Renders the latest health, the age of the last message computed now. */
+    void renderHealth() {
+        const xbox_connection_health_t &health = m_health;
+
+        if (!health.connected) {
+            m_connectionValue->setText(health.reconnect_count > 0
+                                           ? QString("Disconnected (%1 reconnects)").arg(health.reconnect_count)
+                                           : QString("Disconnected"));
+            return;
+        }
+
+        const QString roundTrip =
+            health.round_trip_ms >= 0 ? QString("%1 ms").arg(health.round_trip_ms) : QString("measuring...");
+
+        QString lastMessage = "none yet";
+
+        if (health.last_message_ns > 0) {
+            const uint64_t age_s = (os_gettime_ns() - health.last_message_ns) / 1000000000ULL;
+            lastMessage          = QString("%1 s ago").arg(age_s);
+        }
+
+        m_connectionValue->setText(QString("Connected, RTT %1, last message %2, %3 reconnects")
+                                       .arg(roundTrip, lastMessage)
+                                       .arg(health.reconnect_count));
+    }
+
     private:
     QLabel      *m_statusValue;
+    QLabel      *m_connectionValue;
     QLabel      *m_versionValue;
     QLabel      *m_helpText;
     QPushButton *m_accountButton;
-    QTimer      *m_refreshTimer;
+    QSpinBox    *m_pingIntervalSpin;
+    QSpinBox    *m_maxPingIntervalSpin;
+    QSpinBox    *m_pongTimeoutSpin;
+    QCheckBox   *m_compressionCheck;
+    QPushButton *m_applyConnectionButton;
+    QTimer      *m_healthTimer;
+
+    xbox_connection_health_t m_health = {};
 };
 
 QPointer<XboxAccountDialog> g_dialog;
@@ -0,0 +1,233 @@
+#include "util/arena.h"
+
+#include <obs-module.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cJSON.h"
+#include "diagnostics/memory_accounting.h"
+
+#if defined(_MSC_VER)
+#define ARENA_THREAD_LOCAL __declspec(thread)
+#else
+#define ARENA_THREAD_LOCAL _Thread_local
+#endif
+
+#define ARENA_DEFAULT_CHUNK_SIZE (64 * 1024)
+#define ARENA_ALIGNMENT          16
+#define ARENA_ALIGN(size)        (((size) + (ARENA_ALIGNMENT - 1)) & ~(size_t)(ARENA_ALIGNMENT - 1))
+
+/**
+ * @brief Block of arena memory; the allocations follow the (aligned) header.
+ */
+typedef struct arena_chunk {
+    struct arena_chunk *next;
+    size_t              capacity;
+    size_t              used;
+} arena_chunk_t;
+
+#define ARENA_CHUNK_HEADER_SIZE ARENA_ALIGN(sizeof(arena_chunk_t))
+
+struct arena {
+    /** Chunks, the one being filled first. */
+    arena_chunk_t *chunks;
+
+    /** Minimum capacity of a new chunk. */
+    size_t chunk_size;
+};
+
+/** Arena receiving the cJSON allocations of the current thread, if any. */
+static ARENA_THREAD_LOCAL arena_t *t_json_arena = NULL;
+
+static bool g_json_hooks_installed = false;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Private functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+static unsigned char *chunk_data(const arena_chunk_t *chunk) {
+    return (unsigned char *)chunk + ARENA_CHUNK_HEADER_SIZE;
+}
+
+static arena_chunk_t *create_chunk(size_t capacity) {
+
+    arena_chunk_t *chunk = memory_malloc(MEMORY_TAG_PARSE, ARENA_CHUNK_HEADER_SIZE + capacity);
+    chunk->next          = NULL;
+    chunk->capacity      = capacity;
+    chunk->used          = 0;
+
+    return chunk;
+}
+
+static void *json_malloc(size_t size) {
+    return t_json_arena ? arena_alloc(t_json_arena, size) : malloc(size);
+}
+
+static void json_free(void *pointer) {
+
+    /* Arena allocations are released with the arena */
+    if (t_json_arena && arena_owns(t_json_arena, pointer)) {
+        return;
+    }
+
+    free(pointer);
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public API
+//  --------------------------------------------------------------------------------------------------------------------
+
+arena_t *arena_create(size_t chunk_size) {
+
+    arena_t *arena    = bzalloc(sizeof(arena_t));
+    arena->chunk_size = ARENA_ALIGN(chunk_size ? chunk_size : ARENA_DEFAULT_CHUNK_SIZE);
+    arena->chunks     = create_chunk(arena->chunk_size);
+
+    return arena;
+}
+
+void *arena_alloc(arena_t *arena, size_t size) {
+
+    if (!arena) {
+        return NULL;
+    }
+
+    size = ARENA_ALIGN(size ? size : 1);
+
+    arena_chunk_t *chunk = arena->chunks;
+
+    if (chunk->capacity - chunk->used < size) {
+        /* Grow geometrically so large pages only need a few chunks */
+        size_t capacity = chunk->capacity * 2;
+
+        if (capacity < size) {
+            capacity = size;
+        }
+
+        chunk         = create_chunk(capacity);
+        chunk->next   = arena->chunks;
+        arena->chunks = chunk;
+    }
+
+    void *pointer = chunk_data(chunk) + chunk->used;
+    chunk->used += size;
+
+    return pointer;
+}
+
+char *arena_strndup(arena_t *arena, const char *text, size_t length) {
+
+    if (!arena || !text) {
+        return NULL;
+    }
+
+    char *copy = arena_alloc(arena, length + 1);
+    memcpy(copy, text, length);
+    copy[length] = '\0';
+
+    return copy;
+}
+
+char *arena_strdup(arena_t *arena, const char *text) {
+    return text ? arena_strndup(arena, text, strlen(text)) : NULL;
+}
+
+bool arena_owns(const arena_t *arena, const void *pointer) {
+
+    if (!arena || !pointer) {
+        return false;
+    }
+
+    const uintptr_t address = (uintptr_t)pointer;
+
+    for (const arena_chunk_t *chunk = arena->chunks; chunk; chunk = chunk->next) {
+        const uintptr_t start = (uintptr_t)chunk_data(chunk);
+
+        if (address >= start && address < start + chunk->capacity) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void arena_reset(arena_t *arena) {
+
+    if (!arena) {
+        return;
+    }
+
+    /* Keep the largest chunk: the next message most likely needs as much */
+    arena_chunk_t *largest = arena->chunks;
+
+    for (arena_chunk_t *chunk = arena->chunks; chunk; chunk = chunk->next) {
+        if (chunk->capacity > largest->capacity) {
+            largest = chunk;
+        }
+    }
+
+    arena_chunk_t *chunk = arena->chunks;
+
+    while (chunk) {
+        arena_chunk_t *next = chunk->next;
+
+        if (chunk != largest) {
+            memory_free(chunk);
+        }
+
+        chunk = next;
+    }
+
+    largest->next = NULL;
+    largest->used = 0;
+    arena->chunks = largest;
+}
+
+void arena_destroy(arena_t **arena) {
+
+    if (!arena || !*arena) {
+        return;
+    }
+
+    if (t_json_arena == *arena) {
+        t_json_arena = NULL;
+    }
+
+    arena_chunk_t *chunk = (*arena)->chunks;
+
+    while (chunk) {
+        arena_chunk_t *next = chunk->next;
+        memory_free(chunk);
+        chunk = next;
+    }
+
+    bfree(*arena);
+    *arena = NULL;
+}
+
+void arena_install_json_hooks(void) {
+
+    cJSON_Hooks hooks = {
+        .malloc_fn = json_malloc,
+        .free_fn   = json_free,
+    };
+
+    cJSON_InitHooks(&hooks);
+    g_json_hooks_installed = true;
+}
+
+bool arena_json_begin(arena_t *arena) {
+
+    if (!g_json_hooks_installed || !arena) {
+        return false;
+    }
+
+    t_json_arena = arena;
+    return true;
+}
+
+void arena_json_end(void) {
+    t_json_arena = NULL;
+}
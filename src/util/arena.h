@@ -0,0 +1,115 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file arena.h
+ * @brief Bump allocator for short-lived parse state.
+ *
+ * Parsing one achievements page or one RTA message creates hundreds of small
+ * allocations (cJSON nodes, key and value strings) that all die together when
+ * the message has been read. An arena hands them out from a few large chunks
+ * and releases them at once with @ref arena_reset or @ref arena_destroy;
+ * individual allocations are never freed.
+ *
+ * cJSON can allocate from an arena: once @ref arena_install_json_hooks has been
+ * called, every cJSON allocation made by a thread between
+ * @ref arena_json_begin and @ref arena_json_end comes from that thread's
+ * arena. Trees parsed in such a scope must not outlive it; the values kept
+ * from them must be copied to long-lived storage (bstrdup(), intern_string())
+ * before the arena is reset.
+ *
+ * Thread safety:
+ *   An arena belongs to a single thread. The cJSON scope is per thread, so
+ *   several threads may parse into their own arena concurrently.
+ */
+
+/** @brief Opaque arena. */
+typedef struct arena arena_t;
+
+/**
+ * @brief Create an arena.
+ *
+ * @param chunk_size Size of the first chunk in bytes. Larger chunks are added
+ *                   on demand; 0 selects a default.
+ *
+ * @return Newly allocated arena (free with @ref arena_destroy).
+ */
+arena_t *arena_create(size_t chunk_size);
+
+/**
+ * @brief Allocate @p size bytes, aligned for any type.
+ *
+ * The memory is not zeroed and stays valid until the next reset.
+ *
+ * @return Pointer into the arena, or NULL if @p arena is NULL.
+ */
+void *arena_alloc(arena_t *arena, size_t size);
+
+/**
+ * @brief Copy @p text into the arena.
+ *
+ * @return Arena copy of @p text, or NULL if @p arena or @p text is NULL.
+ */
+char *arena_strdup(arena_t *arena, const char *text);
+
+/**
+ * @brief Copy @p length bytes of @p text into the arena and NUL-terminate them.
+ *
+ * @return Arena copy, or NULL if @p arena or @p text is NULL.
+ */
+char *arena_strndup(arena_t *arena, const char *text, size_t length);
+
+/**
+ * @brief Check whether @p pointer was allocated from @p arena.
+ */
+bool arena_owns(const arena_t *arena, const void *pointer);
+
+/**
+ * @brief Release every allocation at once.
+ *
+ * Keeps the largest chunk for reuse, since the next message most likely
+ * needs as much, and frees the others.
+ *
+ * @param arena Arena to reset. No-op if NULL.
+ */
+void arena_reset(arena_t *arena);
+
+/**
+ * @brief Free the arena and set the caller's pointer to NULL.
+ *
+ * @param[in,out] arena Address of the arena. Safe to call with NULL.
+ */
+void arena_destroy(arena_t **arena);
+
+/**
+ * @brief Route the cJSON allocator through the arenas.
+ *
+ * Outside an @ref arena_json_begin scope, cJSON keeps using malloc() and
+ * free(). Must be called once, before any other thread uses cJSON.
+ */
+void arena_install_json_hooks(void);
+
+/**
+ * @brief Make the calling thread's cJSON allocations come from @p arena.
+ *
+ * @return true if cJSON now allocates from @p arena, in which case the trees
+ *         parsed until @ref arena_json_end are released with the arena and
+ *         must not be passed to cJSON_Delete(); false if the hooks are not
+ *         installed.
+ */
+bool arena_json_begin(arena_t *arena);
+
+/**
+ * @brief Restore malloc() for the calling thread's cJSON allocations.
+ */
+void arena_json_end(void);
+
+#ifdef __cplusplus
+}
+#endif
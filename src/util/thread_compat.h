@@ -10,10 +10,16 @@
  * library is required.
  *
  * Supported surface area:
- *   Types   : pthread_t, pthread_mutex_t
- *   Macros  : PTHREAD_MUTEX_INITIALIZER
+ *   Types   : pthread_t, pthread_mutex_t, pthread_cond_t
+ *   Macros  : PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER
  *   Functions: pthread_create, pthread_detach, pthread_join,
- *              pthread_mutex_lock, pthread_mutex_unlock
+ *              pthread_mutex_init, pthread_mutex_destroy,
+ *              pthread_mutex_lock, pthread_mutex_unlock,
+ *              pthread_cond_init, pthread_cond_destroy, pthread_cond_wait,
+ *              pthread_cond_signal, pthread_cond_broadcast
+ *
+ * It also provides @ref thread_set_class, which names the calling thread and
+ * lowers its CPU and I/O priority according to the kind of work it does.
  */
 
 #ifdef _WIN32
@@ -34,6 +40,8 @@ typedef HANDLE pthread_t;
 
 typedef CRITICAL_SECTION pthread_mutex_t;
 
+typedef CONDITION_VARIABLE pthread_cond_t;
+
 /* ---- PTHREAD_MUTEX_INITIALIZER ----
  *
  * CRITICAL_SECTION cannot be statically initialised with a constant, so we
@@ -46,6 +54,13 @@ typedef CRITICAL_SECTION pthread_mutex_t;
  */
 #define PTHREAD_MUTEX_INITIALIZER {NULL, 0, 0, NULL, NULL, 0}
 
+/* ---- PTHREAD_COND_INITIALIZER ----
+ *
+ * A zero-filled CONDITION_VARIABLE is a valid, initialised one
+ * (CONDITION_VARIABLE_INIT), so it can be initialised statically.
+ */
+#define PTHREAD_COND_INITIALIZER CONDITION_VARIABLE_INIT
+
 /* ---- Internal helpers ---- */
 
 /* Trampoline to bridge _beginthreadex's __stdcall to pthread's void* calling
@@ -103,6 +118,21 @@ static inline int pthread_join(pthread_t thread, void **retval) {
     return 0;
 }
 
+/* ---- pthread_mutex_init ---- */
+static inline int pthread_mutex_init(pthread_mutex_t *mutex, const void *attr) {
+    (void)attr;
+    InitializeCriticalSection(mutex);
+    return 0;
+}
+
+/* ---- pthread_mutex_destroy ---- */
+static inline int pthread_mutex_destroy(pthread_mutex_t *mutex) {
+    if (mutex->DebugInfo != NULL) {
+        DeleteCriticalSection(mutex);
+    }
+    return 0;
+}
+
 /* ---- pthread_mutex_lock ---- */
 static inline int pthread_mutex_lock(pthread_mutex_t *mutex) {
     _pthread_mutex_ensure_init(mutex);
@@ -116,8 +146,221 @@ static inline int pthread_mutex_unlock(pthread_mutex_t *mutex) {
     return 0;
 }
 
+/* ---- pthread_cond_init ---- */
+static inline int pthread_cond_init(pthread_cond_t *cond, const void *attr) {
+    (void)attr;
+    InitializeConditionVariable(cond);
+    return 0;
+}
+
+/* ---- pthread_cond_destroy ---- */
+static inline int pthread_cond_destroy(pthread_cond_t *cond) {
+    /* Win32 condition variables hold no resources. */
+    (void)cond;
+    return 0;
+}
+
+/* ---- pthread_cond_wait ---- */
+static inline int pthread_cond_wait(pthread_cond_t *cond, pthread_mutex_t *mutex) {
+    _pthread_mutex_ensure_init(mutex);
+    return SleepConditionVariableCS(cond, mutex, INFINITE) ? 0 : 1;
+}
+
+/* ---- pthread_cond_signal ---- */
+static inline int pthread_cond_signal(pthread_cond_t *cond) {
+    WakeConditionVariable(cond);
+    return 0;
+}
+
+/* ---- pthread_cond_broadcast ---- */
+static inline int pthread_cond_broadcast(pthread_cond_t *cond) {
+    WakeAllConditionVariable(cond);
+    return 0;
+}
+
 #else /* POSIX */
 
 #include <pthread.h>
 
 #endif /* _WIN32 */
+
+#include <stdbool.h>
+
+/* ---- Thread classes ----
+ *
+ * OBS encodes, renders and captures on the same machine as the plugin's
+ * background threads. Parsing large JSON payloads or decoding PNG files must
+ * never delay a frame, so each plugin thread declares what it does at the
+ * top of its entry point and the scheduler is told to favor everything else.
+ *
+ * Only the calling thread is changed, but on Linux and macOS the threads it
+ * creates afterwards inherit its settings. Lowering a priority is always
+ * allowed, including inside a container or a cgroup with a CPU quota, where
+ * the idle and batch policies only ever spend the share left by the rest of
+ * the group; raising it back is not, for an unprivileged process. A thread
+ * starting other threads must therefore not take a lower class than theirs.
+ * A failure is reported but not fatal: the thread still works, at the wrong
+ * priority.
+ */
+
+/**
+ * @brief Kind of work done by a plugin thread.
+ */
+typedef enum thread_class {
+    /** Waits on sockets (RTA/RetroAchievements loops, authentication): mostly
+     *  asleep, but keepalives and unlock events should not be late. */
+    THREAD_CLASS_NETWORK,
+    /** Downloads and decodes assets the user is about to see (achievement
+     *  icons): throughput work that must yield to the encoder. */
+    THREAD_CLASS_IO,
+    /** Speculative work nobody is waiting for (icon prefetch): runs only
+     *  when the CPU and the disk would otherwise be idle. */
+    THREAD_CLASS_BACKGROUND,
+} thread_class_t;
+
+/** Thread names are limited to 15 characters on Linux. */
+#define THREAD_NAME_MAX_LENGTH 15
+
+#if defined(_WIN32)
+
+typedef HRESULT(WINAPI *_set_thread_description_t)(HANDLE, PCWSTR);
+
+/**
+ * @brief Name the calling thread and apply the priority of its class.
+ *
+ * @param thread_class Kind of work done by the thread.
+ * @param name         Name shown in debuggers and profilers (may be NULL).
+ *
+ * @return false if the priority could not be applied.
+ */
+static inline bool thread_set_class(thread_class_t thread_class, const char *name) {
+
+    bool applied;
+
+    /* The background mode also lowers the I/O and memory priorities. */
+    if (thread_class == THREAD_CLASS_BACKGROUND) {
+        applied = SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN) != 0;
+    } else {
+        applied = SetThreadPriority(GetCurrentThread(),
+                                    thread_class == THREAD_CLASS_IO ? THREAD_PRIORITY_LOWEST
+                                                                    : THREAD_PRIORITY_BELOW_NORMAL) != 0;
+    }
+
+    if (!name) {
+        return applied;
+    }
+
+    /* SetThreadDescription only exists on Windows 10 1607 and later */
+    HMODULE kernel32 = GetModuleHandleW(L"kernel32.dll");
+    if (!kernel32) {
+        return applied;
+    }
+
+    _set_thread_description_t set_thread_description =
+        (_set_thread_description_t)(void *)GetProcAddress(kernel32, "SetThreadDescription");
+
+    wchar_t wide_name[64];
+    if (set_thread_description && MultiByteToWideChar(CP_UTF8, 0, name, -1, wide_name, 64) > 0) {
+        set_thread_description(GetCurrentThread(), wide_name);
+    }
+
+    return applied;
+}
+
+#elif defined(__APPLE__)
+
+#include <pthread/qos.h>
+#include <string.h>
+
+static inline bool thread_set_class(thread_class_t thread_class, const char *name) {
+
+    /* The background QoS also throttles the disk and network I/O. */
+    const qos_class_t qos_class = thread_class == THREAD_CLASS_BACKGROUND ? QOS_CLASS_BACKGROUND : QOS_CLASS_UTILITY;
+    const bool        applied   = pthread_set_qos_class_self_np(qos_class, 0) == 0;
+
+    if (name) {
+        char short_name[THREAD_NAME_MAX_LENGTH + 1];
+        strncpy(short_name, name, THREAD_NAME_MAX_LENGTH);
+        short_name[THREAD_NAME_MAX_LENGTH] = '\0';
+        pthread_setname_np(short_name);
+    }
+
+    return applied;
+}
+
+#elif defined(__linux__)
+
+#include <sched.h>
+#include <string.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/* Not exposed by the libc headers without _GNU_SOURCE (sched.h) or at all (ioprio). */
+#ifndef SCHED_BATCH
+#define SCHED_BATCH 3
+#endif
+#ifndef SCHED_IDLE
+#define SCHED_IDLE 5
+#endif
+
+#define _THREAD_IOPRIO_WHO_PROCESS 1
+#define _THREAD_IOPRIO_CLASS_BE    2
+#define _THREAD_IOPRIO_CLASS_IDLE  3
+#define _THREAD_IOPRIO_VALUE(io_class, level) (((io_class) << 13) | (level))
+
+static inline bool thread_set_class(thread_class_t thread_class, const char *name) {
+
+    /* On Linux, the nice value and the I/O priority are per thread */
+    const pid_t tid = (pid_t)syscall(SYS_gettid);
+
+    int policy  = SCHED_OTHER;
+    int nice    = 5;
+    int io_prio = _THREAD_IOPRIO_VALUE(_THREAD_IOPRIO_CLASS_BE, 4);
+
+    switch (thread_class) {
+    case THREAD_CLASS_IO:
+        policy  = SCHED_BATCH;
+        nice    = 10;
+        io_prio = _THREAD_IOPRIO_VALUE(_THREAD_IOPRIO_CLASS_BE, 7);
+        break;
+    case THREAD_CLASS_BACKGROUND:
+        policy  = SCHED_IDLE;
+        nice    = 19;
+        io_prio = _THREAD_IOPRIO_VALUE(_THREAD_IOPRIO_CLASS_IDLE, 0);
+        break;
+    case THREAD_CLASS_NETWORK:
+    default:
+        break;
+    }
+
+    struct sched_param param;
+    memset(&param, 0, sizeof(param));
+
+    /* Both fail (EPERM / EACCES) when asked for more than an inherited priority */
+    const bool applied = sched_setscheduler(0, policy, &param) == 0 && setpriority(PRIO_PROCESS, (id_t)tid, nice) == 0;
+
+    /* The I/O priority is best effort: some kernels restrict it */
+    syscall(SYS_ioprio_set, _THREAD_IOPRIO_WHO_PROCESS, tid, io_prio);
+
+    if (name) {
+        char short_name[THREAD_NAME_MAX_LENGTH + 1];
+        strncpy(short_name, name, THREAD_NAME_MAX_LENGTH);
+        short_name[THREAD_NAME_MAX_LENGTH] = '\0';
+        prctl(PR_SET_NAME, short_name, 0, 0, 0);
+    }
+
+    return applied;
+}
+
+#else /* Other POSIX systems */
+
+/* No portable per-thread priority or name: leave the thread as it is. */
+static inline bool thread_set_class(thread_class_t thread_class, const char *name) {
+    (void)thread_class;
+    (void)name;
+    return true;
+}
+
+#endif
@@ -0,0 +1,244 @@
+#include "util/worker_pool.h"
+
+#include <obs-module.h>
+#include <diagnostics/log.h>
+
+#include "util/thread_compat.h"
+
+#define WORKER_POOL_MAX_THREADS 8
+
+/**
+ * @brief Queued task (singly linked FIFO node).
+ */
+typedef struct worker_task_node {
+    worker_task_t            run;
+    worker_task_t            discard;
+    void                    *data;
+    struct worker_task_node *next;
+} worker_task_node_t;
+
+struct worker_pool {
+    /** Name used in log messages and as the thread name. */
+    char *name;
+
+    /** Priority class applied by each worker thread when it starts. */
+    thread_class_t thread_class;
+
+    /** Guards every member below. */
+    pthread_mutex_t mutex;
+
+    /** Signalled when a task is queued or the pool starts stopping. */
+    pthread_cond_t wake;
+
+    /** FIFO of pending tasks. */
+    worker_task_node_t *head;
+    worker_task_node_t *tail;
+
+    /** Set by worker_pool_destroy(). */
+    bool stopping;
+
+    pthread_t threads[WORKER_POOL_MAX_THREADS];
+    size_t    thread_count;
+};
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Private functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Detach the whole pending queue. Must be called with the mutex held.
+ */
+static worker_task_node_t *take_pending(worker_pool_t *pool) {
+
+    worker_task_node_t *pending = pool->head;
+
+    pool->head = NULL;
+    pool->tail = NULL;
+
+    return pending;
+}
+
+/**
+ * @brief Call the discard callback of every task of a detached queue and free it.
+ */
+static void discard_tasks(worker_task_node_t *task) {
+
+    while (task) {
+        worker_task_node_t *next = task->next;
+
+        if (task->discard) {
+            task->discard(task->data);
+        }
+
+        bfree(task);
+        task = next;
+    }
+}
+
+/**
+ * @brief Worker thread entry point: runs queued tasks until the pool stops.
+ */
+static void *worker_thread(void *arg) {
+
+    worker_pool_t *pool = arg;
+
+    if (!thread_set_class(pool->thread_class, pool->name)) {
+        obs_log(LOG_WARNING, "[%s] Could not apply the thread priority", pool->name);
+    }
+
+    while (true) {
+        pthread_mutex_lock(&pool->mutex);
+
+        while (!pool->stopping && !pool->head) {
+            pthread_cond_wait(&pool->wake, &pool->mutex);
+        }
+
+        if (pool->stopping) {
+            pthread_mutex_unlock(&pool->mutex);
+            break;
+        }
+
+        worker_task_node_t *task = pool->head;
+        pool->head               = task->next;
+
+        if (!pool->head) {
+            pool->tail = NULL;
+        }
+
+        pthread_mutex_unlock(&pool->mutex);
+
+        task->run(task->data);
+        bfree(task);
+    }
+
+    return NULL;
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public API
+//  --------------------------------------------------------------------------------------------------------------------
+
+worker_pool_t *worker_pool_create(const char *name, thread_class_t thread_class, size_t thread_count) {
+
+    if (thread_count == 0) {
+        thread_count = 1;
+    }
+
+    if (thread_count > WORKER_POOL_MAX_THREADS) {
+        thread_count = WORKER_POOL_MAX_THREADS;
+    }
+
+    worker_pool_t *pool = bzalloc(sizeof(worker_pool_t));
+    pool->name          = bstrdup(name ? name : "WorkerPool");
+    pool->thread_class  = thread_class;
+
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+
+    for (size_t i = 0; i < thread_count; i++) {
+        if (pthread_create(&pool->threads[pool->thread_count], NULL, worker_thread, pool) != 0) {
+            obs_log(LOG_ERROR, "[%s] Failed to create worker thread", pool->name);
+            break;
+        }
+
+        pool->thread_count++;
+    }
+
+    if (pool->thread_count == 0) {
+        worker_pool_destroy(&pool);
+        return NULL;
+    }
+
+    return pool;
+}
+
+bool worker_pool_submit(worker_pool_t *pool, worker_task_t run, worker_task_t discard, void *data) {
+
+    if (!pool || !run) {
+        if (discard) {
+            discard(data);
+        }
+        return false;
+    }
+
+    worker_task_node_t *task = bzalloc(sizeof(worker_task_node_t));
+    task->run                = run;
+    task->discard            = discard;
+    task->data               = data;
+
+    pthread_mutex_lock(&pool->mutex);
+
+    if (pool->stopping) {
+        pthread_mutex_unlock(&pool->mutex);
+        discard_tasks(task);
+        return false;
+    }
+
+    if (pool->tail) {
+        pool->tail->next = task;
+    } else {
+        pool->head = task;
+    }
+
+    pool->tail = task;
+
+    pthread_cond_signal(&pool->wake);
+    pthread_mutex_unlock(&pool->mutex);
+
+    return true;
+}
+
+void worker_pool_cancel_pending(worker_pool_t *pool) {
+
+    if (!pool) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->mutex);
+    worker_task_node_t *pending = take_pending(pool);
+    pthread_mutex_unlock(&pool->mutex);
+
+    discard_tasks(pending);
+}
+
+bool worker_pool_is_stopping(worker_pool_t *pool) {
+
+    if (!pool) {
+        return true;
+    }
+
+    pthread_mutex_lock(&pool->mutex);
+    bool stopping = pool->stopping;
+    pthread_mutex_unlock(&pool->mutex);
+
+    return stopping;
+}
+
+void worker_pool_destroy(worker_pool_t **pool) {
+
+    if (!pool || !*pool) {
+        return;
+    }
+
+    worker_pool_t *p = *pool;
+
+    pthread_mutex_lock(&p->mutex);
+    p->stopping                 = true;
+    worker_task_node_t *pending = take_pending(p);
+    pthread_cond_broadcast(&p->wake);
+    pthread_mutex_unlock(&p->mutex);
+
+    discard_tasks(pending);
+
+    for (size_t i = 0; i < p->thread_count; i++) {
+        pthread_join(p->threads[i], NULL);
+    }
+
+    pthread_cond_destroy(&p->wake);
+    pthread_mutex_destroy(&p->mutex);
+
+    bfree(p->name);
+    bfree(p);
+
+    *pool = NULL;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "util/thread_compat.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file worker_pool.h
+ * @brief Small pool of joinable background threads fed by a FIFO task queue.
+ *
+ * Replaces fire-and-forget detached threads for background work (icon
+ * downloads, prefetching) so that the owner can always tell when the work is
+ * over: @ref worker_pool_destroy discards the queued tasks, waits for the ones
+ * already running and joins every thread. Once it returns, no task can touch
+ * the owner's globals anymore.
+ *
+ * Cancellation is cooperative: long tasks poll @ref worker_pool_is_stopping
+ * between steps, and blocking HTTP calls are aborted by http_cancel_all().
+ *
+ * Thread safety:
+ *   All functions except @ref worker_pool_destroy are safe to call from any
+ *   thread, including from a task running on the pool.
+ */
+
+/**
+ * @brief Task callback.
+ *
+ * @param data Opaque pointer passed to @ref worker_pool_submit.
+ */
+typedef void (*worker_task_t)(void *data);
+
+/** @brief Opaque worker pool. */
+typedef struct worker_pool worker_pool_t;
+
+/**
+ * @brief Create a pool and start its threads.
+ *
+ * @param name         Short name used in log messages and as the name of the
+ *                     threads (copied).
+ * @param thread_class Priority class of the threads (see @ref thread_set_class).
+ * @param thread_count Number of worker threads (at least 1).
+ *
+ * @return Newly allocated pool (free with @ref worker_pool_destroy), or NULL
+ *         if no thread could be started.
+ */
+worker_pool_t *worker_pool_create(const char *name, thread_class_t thread_class, size_t thread_count);
+
+/**
+ * @brief Queue a task for execution on the pool.
+ *
+ * Exactly one of @p run or @p discard is eventually called with @p data:
+ * @p run when a worker picks the task up, @p discard when the task is dropped
+ * before running (see @ref worker_pool_cancel_pending and
+ * @ref worker_pool_destroy). Use @p discard to release @p data.
+ *
+ * @param pool    Target pool.
+ * @param run     Task to execute. Must not be NULL.
+ * @param discard Called instead of @p run when the task is dropped. May be NULL.
+ * @param data    Opaque pointer passed to @p run or @p discard.
+ *
+ * @return true if the task was queued; false if the pool is stopping (in which
+ *         case @p discard has already been called).
+ */
+bool worker_pool_submit(worker_pool_t *pool, worker_task_t run, worker_task_t discard, void *data);
+
+/**
+ * @brief Drop every task that has not started yet.
+ *
+ * Used when newer work supersedes the queued one (e.g. a new game replacing the
+ * icon prefetch of the previous one). Running tasks are not interrupted.
+ *
+ * @param pool Target pool. No-op if NULL.
+ */
+void worker_pool_cancel_pending(worker_pool_t *pool);
+
+/**
+ * @brief Check whether the pool is shutting down.
+ *
+ * @param pool Target pool.
+ *
+ * @return true once @ref worker_pool_destroy has been called (or if @p pool is
+ *         NULL); long tasks should then return as soon as possible.
+ */
+bool worker_pool_is_stopping(worker_pool_t *pool);
+
+/**
+ * @brief Stop the pool, wait for the running tasks and free it.
+ *
+ * Queued tasks are discarded, running tasks are asked to stop through
+ * @ref worker_pool_is_stopping, then all threads are joined. Must not be called
+ * from a task running on the pool.
+ *
+ * @param pool Address of the pool pointer; set to NULL on return. Safe to call
+ *             with NULL or with @c *pool == NULL.
+ */
+void worker_pool_destroy(worker_pool_t **pool);
+
+#ifdef __cplusplus
+}
+#endif
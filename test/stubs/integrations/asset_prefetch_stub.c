@@ -0,0 +1,13 @@
+#include "integrations/asset_prefetch.h"
+
+void asset_prefetch_start(const game_t *game, const identity_t *identity, const achievement_t *achievements) {
+    (void)game;
+    (void)identity;
+    (void)achievements;
+}
+
+void asset_prefetch_set_deferred(bool deferred) {
+    (void)deferred;
+}
+
+void asset_prefetch_stop(void) {}
@@ -0,0 +1,68 @@
+/**
+ * @file monitoring_service_stub.c
+ * @brief Stub implementations of the monitoring_service.h functions used by
+ *        the achievement display cycle.
+ *
+ * Stores the callbacks that achievement_cycle.c installs via
+ * monitoring_subscribe_*() and lets tests fire them via the mock_* helpers.
+ */
+
+#include "test/stubs/integrations/monitoring_service_stub.h"
+
+#include "integrations/monitoring_service.h"
+
+static on_monitoring_connection_changed_t   s_cb_connection_changed   = NULL;
+static on_monitoring_game_played_t          s_cb_game_played          = NULL;
+static on_monitoring_achievements_changed_t s_cb_achievements_changed = NULL;
+static on_monitoring_session_ready_t        s_cb_session_ready        = NULL;
+
+/* Achievements returned by monitoring_copy_current_game_achievements() */
+static achievement_t *s_achievements = NULL;
+
+/* -------------------------------------------------------------------------
+ * monitoring_service.h
+ * ---------------------------------------------------------------------- */
+
+void monitoring_subscribe_connection_changed(on_monitoring_connection_changed_t callback) {
+    s_cb_connection_changed = callback;
+}
+
+void monitoring_subscribe_game_played(on_monitoring_game_played_t callback) {
+    s_cb_game_played = callback;
+}
+
+void monitoring_subscribe_achievements_changed(on_monitoring_achievements_changed_t callback) {
+    s_cb_achievements_changed = callback;
+}
+
+void monitoring_subscribe_session_ready(on_monitoring_session_ready_t callback) {
+    s_cb_session_ready = callback;
+}
+
+achievement_t *monitoring_copy_current_game_achievements(void) {
+    return copy_achievement(s_achievements);
+}
+
+/* -------------------------------------------------------------------------
+ * Test controls
+ * ---------------------------------------------------------------------- */
+
+void mock_monitoring_set_achievements(achievement_t *achievements) {
+    free_achievement(&s_achievements);
+    s_achievements = achievements;
+}
+
+void mock_monitoring_fire_session_ready(void) {
+    if (s_cb_session_ready) {
+        s_cb_session_ready();
+    }
+}
+
+void mock_monitoring_reset(void) {
+    free_achievement(&s_achievements);
+
+    s_cb_connection_changed   = NULL;
+    s_cb_game_played          = NULL;
+    s_cb_achievements_changed = NULL;
+    s_cb_session_ready        = NULL;
+}
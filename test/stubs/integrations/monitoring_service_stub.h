@@ -0,0 +1,37 @@
+#pragma once
+
+/**
+ * @file monitoring_service_stub.h
+ * @brief Test controls for the monitoring_service stub.
+ *
+ * Lets tests drive the achievement display cycle without the monitors: the
+ * stub serves a fixed achievement list and fires the session-ready callback
+ * the cycle subscribes to.
+ */
+
+#include "common/achievement.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Set the achievements returned by monitoring_copy_current_game_achievements().
+ *
+ * The stub takes ownership of the list; pass NULL to clear it.
+ */
+void mock_monitoring_set_achievements(achievement_t *achievements);
+
+/**
+ * @brief Simulate the session-ready event (achievements loaded and icons prefetched).
+ */
+void mock_monitoring_fire_session_ready(void);
+
+/**
+ * @brief Forget the achievements and the registered callbacks.
+ */
+void mock_monitoring_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -34,6 +34,8 @@ static on_xbox_session_ready_t           s_cb_session_ready           = NULL;
 static xbox_identity_t    *s_xbox_identity     = NULL;
 /* Achievements returned by get_current_game_achievements() */
 static xbox_achievement_t *s_xbox_achievements = NULL;
+/* Game of the monitor session returned by get_current_game() */
+static game_t             *s_session_game      = NULL;
 
 /* -------------------------------------------------------------------------
  * xbox_subscribe_* — called by monitoring_service during monitoring_start()
@@ -64,7 +66,8 @@ bool xbox_monitoring_start(void) {
 }
 void xbox_monitoring_stop(void) {}
 bool xbox_monitoring_is_active(void) {
-    return false;
+    /* A session is only held while the monitor runs */
+    return s_session_game != NULL;
 }
 
 /* -------------------------------------------------------------------------
@@ -75,7 +78,7 @@ const gamerscore_t *get_current_gamerscore(void) {
     return NULL;
 }
 const game_t *get_current_game(void) {
-    return NULL;
+    return s_session_game;
 }
 const xbox_achievement_t *get_current_game_achievements(void) {
     return s_xbox_achievements;
@@ -137,6 +140,11 @@ void mock_xbox_monitor_set_achievements(xbox_achievement_t *achievements) {
     s_xbox_achievements = achievements; /* Takes ownership. */
 }
 
+void mock_xbox_monitor_set_session_game(game_t *game) {
+    free_game(&s_session_game);
+    s_session_game = game; /* Takes ownership. */
+}
+
 void mock_xbox_monitor_fire_connection_changed(bool connected, const char *error_message) {
     if (s_cb_connection_changed)
         s_cb_connection_changed(connected, error_message);
@@ -161,6 +169,7 @@ void mock_xbox_monitor_fire_achievements_progressed(const gamerscore_t
 void mock_xbox_monitor_reset(void) {
     free_identity(&s_xbox_identity);
     xbox_free_achievement(&s_xbox_achievements);
+    free_game(&s_session_game);
     s_cb_connection_changed      = NULL;
     s_cb_game_played             = NULL;
     s_cb_achievements_progressed = NULL;
@@ -34,6 +34,15 @@ extern "C" {
  */
 void mock_xbox_monitor_set_identity(xbox_identity_t *identity);
 
+/**
+ * @brief Set the game of the session the Xbox monitor holds.
+ *
+ * get_current_game() returns it and xbox_monitoring_is_active() reports the
+ * monitor as running, as while a session is retained through an outage. The
+ * stub takes ownership of the provided game; pass NULL to drop the session.
+ */
+void mock_xbox_monitor_set_session_game(game_t *game);
+
 /**
  * @brief Simulate an Xbox connection-changed event.
  *
@@ -1,4 +1,9 @@
-#include "io/cache.h"
+#include "io/cache_stub.h"
+
+#include "util/thread_compat.h"
+
+static pthread_mutex_t g_mutex          = PTHREAD_MUTEX_INITIALIZER;
+static int             g_download_count = 0;
 
 bool cache_download(const char *url, const char *type, const char *id, char *out_path, size_t path_size) {
     (void)url;
@@ -6,5 +11,24 @@ bool cache_download(const char *url, const char *type, const char *id, char *out
     (void)id;
     (void)out_path;
     (void)path_size;
+
+    pthread_mutex_lock(&g_mutex);
+    g_download_count++;
+    pthread_mutex_unlock(&g_mutex);
+
     return true;
 }
+
+int mock_cache_get_download_count(void) {
+    pthread_mutex_lock(&g_mutex);
+    const int count = g_download_count;
+    pthread_mutex_unlock(&g_mutex);
+
+    return count;
+}
+
+void mock_cache_reset(void) {
+    pthread_mutex_lock(&g_mutex);
+    g_download_count = 0;
+    pthread_mutex_unlock(&g_mutex);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+/**
+ * @file cache_stub.h
+ * @brief Test controls for the cache stub.
+ *
+ * cache_download() never touches the network or the disk: it only counts the
+ * calls, so that tests can check when the prefetch downloads.
+ */
+
+#include "io/cache.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Get the number of cache_download() calls since the last reset.
+ */
+int mock_cache_get_download_count(void);
+
+/**
+ * @brief Reset all stub state.
+ */
+void mock_cache_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,64 @@
+#include "test/stubs/io/snapshot_stub.h"
+
+#include "common/memory.h"
+
+static snapshot_t *s_loaded     = NULL;
+static snapshot_t *s_saved      = NULL;
+static int         s_save_count = 0;
+
+static snapshot_t *copy_snapshot(const snapshot_t *snapshot) {
+    snapshot_t *copy             = bzalloc(sizeof(snapshot_t));
+    copy->source                 = snapshot->source;
+    copy->identity               = copy_identity(snapshot->identity);
+    copy->game                   = copy_game(snapshot->game);
+    copy->achievements           = copy_achievement(snapshot->achievements);
+    copy->current_achievement_id = bstrdup(snapshot->current_achievement_id);
+    return copy;
+}
+
+bool snapshot_save(const snapshot_t *snapshot) {
+    free_snapshot(&s_saved);
+    s_saved = copy_snapshot(snapshot);
+    s_save_count++;
+    return true;
+}
+
+snapshot_t *snapshot_load(void) {
+    snapshot_t *snapshot = s_loaded;
+    s_loaded             = NULL;
+    return snapshot;
+}
+
+void snapshot_delete(void) {
+    free_snapshot(&s_saved);
+}
+
+void free_snapshot(snapshot_t **snapshot) {
+    if (!snapshot || !*snapshot)
+        return;
+
+    free_identity_t(&(*snapshot)->identity);
+    free_game(&(*snapshot)->game);
+    free_achievement(&(*snapshot)->achievements);
+    free_memory((void **)&(*snapshot)->current_achievement_id);
+    free_memory((void **)snapshot);
+}
+
+void mock_snapshot_set(snapshot_t *snapshot) {
+    free_snapshot(&s_loaded);
+    s_loaded = snapshot;
+}
+
+const snapshot_t *mock_snapshot_get_saved(void) {
+    return s_saved;
+}
+
+int mock_snapshot_get_save_count(void) {
+    return s_save_count;
+}
+
+void mock_snapshot_reset(void) {
+    free_snapshot(&s_loaded);
+    free_snapshot(&s_saved);
+    s_save_count = 0;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+/**
+ * @file snapshot_stub.h
+ * @brief Test controls for the in-memory snapshot stub.
+ *
+ * Replaces the file-backed snapshot store so monitoring_service tests can
+ * seed a warm start and inspect what would have been persisted.
+ */
+
+#include "io/snapshot.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Set the snapshot that snapshot_load() will return.
+ *
+ * The stub takes ownership of the provided snapshot; pass NULL to simulate a
+ * first launch (no snapshot on disk).
+ */
+void mock_snapshot_set(snapshot_t *snapshot);
+
+/**
+ * @brief Get the last snapshot passed to snapshot_save(), or NULL.
+ *
+ * The returned snapshot is owned by the stub.
+ */
+const snapshot_t *mock_snapshot_get_saved(void);
+
+/**
+ * @brief Get the number of snapshot_save() calls since the last reset.
+ */
+int mock_snapshot_get_save_count(void);
+
+/**
+ * @brief Reset all stub state.
+ */
+void mock_snapshot_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
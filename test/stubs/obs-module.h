@@ -9,3 +9,20 @@
 #ifndef UNUSED_PARAMETER
 #define UNUSED_PARAMETER(param) (void)(param)
 #endif
+
+/* Resolves a file under the plugin's config directory. Not implemented by the
+ * shared stubs: tests that exercise persistence define it themselves. */
+char *obs_module_config_path(const char *file);
+
+/* Settings and properties, opaque to the tests. Not implemented by the shared
+ * stubs either: the tests compiling a source helper define those it calls. */
+#include <stdbool.h>
+
+typedef struct obs_data       obs_data_t;
+typedef struct obs_properties obs_properties_t;
+typedef struct obs_property   obs_property_t;
+
+obs_property_t *obs_properties_add_bool(obs_properties_t *props, const char *name, const char *description);
+void            obs_data_set_default_bool(obs_data_t *data, const char *name, bool value);
+bool            obs_data_has_user_value(obs_data_t *data, const char *name);
+bool            obs_data_get_bool(obs_data_t *data, const char *name);
@@ -0,0 +1,299 @@
+/**
+ * @file test_achievement_grid_model.c
+ * @brief Unit tests for achievement_grid_model.c — incremental cells of the Achievement Grid.
+ */
+
+#include "unity.h"
+
+#include "sources/common/achievement_grid_model.h"
+#include "common/intern.h"
+
+#include <obs-module.h>
+
+static achievement_grid_model_t g_model;
+static achievement_t           *g_achievements;
+
+void setUp(void) {
+    g_model.highlighted = -1;
+}
+
+void tearDown(void) {
+    achievement_grid_model_free(&g_model);
+    free_achievement(&g_achievements);
+}
+
+/**
+ * @brief Append an achievement to g_achievements.
+ */
+static achievement_t *add_achievement(const char *id, const char *icon_url, int64_t unlocked_timestamp) {
+
+    achievement_t *achievement      = alloc_achievement();
+    achievement->id                 = intern_string(id);
+    achievement->icon_url           = intern_string(icon_url);
+    achievement->unlocked_timestamp = unlocked_timestamp;
+
+    achievement_t **tail = &g_achievements;
+    while (*tail) {
+        tail = &(*tail)->next;
+    }
+    *tail = achievement;
+
+    return achievement;
+}
+
+/**
+ * @brief Download every pending icon, caching it under "<id>.png".
+ */
+static void download_all(void) {
+
+    achievement_grid_download_t download;
+
+    while (achievement_grid_model_take_pending(&g_model, &download)) {
+        char cache_path[64];
+        snprintf(cache_path, sizeof(cache_path), "%s.png", download.id);
+
+        achievement_grid_model_icon_downloaded(&g_model, &download, cache_path);
+        achievement_grid_download_free(&download);
+    }
+}
+
+static size_t take_all_dirty(achievement_grid_dirty_cell_t *cells, size_t max) {
+    return achievement_grid_model_take_dirty(&g_model, cells, max);
+}
+
+/* -------------------------------------------------------------------------
+ * Tests
+ * ---------------------------------------------------------------------- */
+
+void achievement_grid_model_update__new_list__cells_built_in_list_order(void) {
+    //  Arrange.
+    add_achievement("a", "https://icons/a.png", 0);
+    add_achievement("b", NULL, 0);
+    add_achievement("c", "https://icons/c.png", 1700000000);
+
+    //  Act.
+    const size_t pending = achievement_grid_model_update(&g_model, g_achievements);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_size_t(2, pending);
+    TEST_ASSERT_EQUAL_size_t(3, g_model.count);
+    TEST_ASSERT_EQUAL_STRING("a", g_model.cells[0].id);
+    TEST_ASSERT_EQUAL_STRING("c", g_model.cells[2].id);
+    TEST_ASSERT_EQUAL_INT(ACHIEVEMENT_GRID_ICON_NONE, g_model.cells[1].icon_state);
+    TEST_ASSERT_EQUAL_INT(2, g_model.highlighted);
+}
+
+void achievement_grid_model_take_dirty__icons_downloaded__cells_returned_once(void) {
+    //  Arrange.
+    add_achievement("a", "https://icons/a.png", 0);
+    add_achievement("b", "https://icons/b.png", 1700000000);
+    achievement_grid_model_update(&g_model, g_achievements);
+    download_all();
+
+    achievement_grid_dirty_cell_t cells[4];
+
+    //  Act.
+    const size_t first  = take_all_dirty(cells, 4);
+    const size_t second = take_all_dirty(cells, 4);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_size_t(2, first);
+    TEST_ASSERT_EQUAL_size_t(0, second);
+    TEST_ASSERT_EQUAL_STRING("a.png", cells[0].cache_path);
+    TEST_ASSERT_FALSE(cells[0].unlocked);
+    TEST_ASSERT_TRUE(cells[1].unlocked);
+}
+
+void achievement_grid_model_take_dirty__other_game_downloading__cells_cleared_then_drawn(void) {
+    //  Arrange.
+    add_achievement("a", "https://icons/a.png", 0);
+    achievement_grid_model_update(&g_model, g_achievements);
+    download_all();
+
+    achievement_grid_dirty_cell_t cells[4];
+    take_all_dirty(cells, 4);
+
+    free_achievement(&g_achievements);
+    add_achievement("x", "https://icons/x.png", 0);
+    achievement_grid_model_update(&g_model, g_achievements);
+
+    achievement_grid_dirty_cell_t cleared[4];
+
+    //  Act.
+    const size_t cleared_count = take_all_dirty(cleared, 4);
+    download_all();
+    const size_t drawn_count = take_all_dirty(cells, 4);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_size_t(1, cleared_count);
+    TEST_ASSERT_EQUAL_STRING("", cleared[0].cache_path);
+    TEST_ASSERT_EQUAL_size_t(1, drawn_count);
+    TEST_ASSERT_EQUAL_STRING("x.png", cells[0].cache_path);
+}
+
+void achievement_grid_model_update__unlock_resorts_list__only_unlocked_cell_dirty(void) {
+    //  Arrange.
+    add_achievement("a", "https://icons/a.png", 1700000000);
+    add_achievement("b", "https://icons/b.png", 0);
+    add_achievement("c", "https://icons/c.png", 0);
+    achievement_grid_model_update(&g_model, g_achievements);
+    download_all();
+
+    achievement_grid_dirty_cell_t cells[4];
+    take_all_dirty(cells, 4);
+
+    const uint32_t generation = g_model.generation;
+
+    /* The monitoring service moves the unlocked achievement to the front */
+    free_achievement(&g_achievements);
+    add_achievement("c", "https://icons/c.png", 1700000100);
+    add_achievement("a", "https://icons/a.png", 1700000000);
+    add_achievement("b", "https://icons/b.png", 0);
+
+    //  Act.
+    const size_t pending = achievement_grid_model_update(&g_model, g_achievements);
+    const size_t dirty   = take_all_dirty(cells, 4);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_size_t(0, pending);
+    TEST_ASSERT_EQUAL_UINT32(generation, g_model.generation);
+    TEST_ASSERT_EQUAL_size_t(1, dirty);
+    TEST_ASSERT_EQUAL_size_t(2, cells[0].index);
+    TEST_ASSERT_TRUE(cells[0].unlocked);
+    TEST_ASSERT_EQUAL_INT(2, g_model.highlighted);
+}
+
+void achievement_grid_model_update__other_game__cells_rebuilt_and_stale_download_ignored(void) {
+    //  Arrange.
+    add_achievement("a", "https://icons/a.png", 0);
+    achievement_grid_model_update(&g_model, g_achievements);
+
+    achievement_grid_download_t download;
+    achievement_grid_model_take_pending(&g_model, &download);
+
+    free_achievement(&g_achievements);
+    add_achievement("x", "https://icons/x.png", 0);
+
+    //  Act.
+    achievement_grid_model_update(&g_model, g_achievements);
+    achievement_grid_model_icon_downloaded(&g_model, &download, "a.png");
+    achievement_grid_download_free(&download);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_size_t(1, g_model.count);
+    TEST_ASSERT_EQUAL_STRING("x", g_model.cells[0].id);
+    TEST_ASSERT_EQUAL_INT(ACHIEVEMENT_GRID_ICON_PENDING, g_model.cells[0].icon_state);
+    TEST_ASSERT_NULL(g_model.cells[0].cache_path);
+}
+
+void achievement_grid_model_update__achievement_added__downloaded_icons_kept(void) {
+    //  Arrange.
+    add_achievement("a", "https://icons/a.png", 0);
+    achievement_grid_model_update(&g_model, g_achievements);
+    download_all();
+
+    add_achievement("b", "https://icons/b.png", 0);
+
+    //  Act.
+    const size_t pending = achievement_grid_model_update(&g_model, g_achievements);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_size_t(1, pending);
+    TEST_ASSERT_EQUAL_INT(ACHIEVEMENT_GRID_ICON_READY, g_model.cells[0].icon_state);
+    TEST_ASSERT_EQUAL_STRING("a.png", g_model.cells[0].cache_path);
+}
+
+void achievement_grid_model_update_one__progress__cell_updated_without_redraw(void) {
+    //  Arrange.
+    achievement_t *achievement = add_achievement("a", "https://icons/a.png", 0);
+    achievement_grid_model_update(&g_model, g_achievements);
+    download_all();
+
+    achievement_grid_dirty_cell_t cells[4];
+    take_all_dirty(cells, 4);
+
+    achievement->measured_progress = intern_string("3/4");
+
+    //  Act.
+    const bool found = achievement_grid_model_update_one(&g_model, achievement);
+
+    //  Assert.
+    TEST_ASSERT_TRUE(found);
+    TEST_ASSERT_EQUAL_INT(750, (int)(g_model.cells[0].progress * 1000.0f + 0.5f));
+    TEST_ASSERT_EQUAL_size_t(0, take_all_dirty(cells, 4));
+}
+
+void achievement_grid_model_icon_downloaded__failed__cell_cleared(void) {
+    //  Arrange.
+    add_achievement("a", "https://icons/a.png", 0);
+    achievement_grid_model_update(&g_model, g_achievements);
+
+    achievement_grid_download_t download;
+    achievement_grid_model_take_pending(&g_model, &download);
+
+    achievement_grid_dirty_cell_t cells[4];
+
+    //  Act.
+    achievement_grid_model_icon_downloaded(&g_model, &download, NULL);
+    achievement_grid_download_free(&download);
+    const size_t dirty = take_all_dirty(cells, 4);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(ACHIEVEMENT_GRID_ICON_MISSING, g_model.cells[0].icon_state);
+    TEST_ASSERT_EQUAL_size_t(1, dirty);
+    TEST_ASSERT_EQUAL_STRING("", cells[0].cache_path);
+}
+
+void achievement_grid_model_take_dirty__more_than_max__rest_kept_for_next_call(void) {
+    //  Arrange.
+    add_achievement("a", "https://icons/a.png", 0);
+    add_achievement("b", "https://icons/b.png", 0);
+    add_achievement("c", "https://icons/c.png", 0);
+    achievement_grid_model_update(&g_model, g_achievements);
+    download_all();
+
+    achievement_grid_dirty_cell_t cells[2];
+
+    //  Act.
+    const size_t first  = take_all_dirty(cells, 2);
+    const size_t second = take_all_dirty(cells, 2);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_size_t(2, first);
+    TEST_ASSERT_EQUAL_size_t(1, second);
+    TEST_ASSERT_EQUAL_size_t(2, cells[0].index);
+}
+
+void achievement_grid_model_mark_all_dirty__after_take__every_cell_returned(void) {
+    //  Arrange.
+    add_achievement("a", "https://icons/a.png", 0);
+    add_achievement("b", "https://icons/b.png", 0);
+    achievement_grid_model_update(&g_model, g_achievements);
+    download_all();
+
+    achievement_grid_dirty_cell_t cells[4];
+    take_all_dirty(cells, 4);
+
+    //  Act.
+    achievement_grid_model_mark_all_dirty(&g_model);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_size_t(2, take_all_dirty(cells, 4));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(achievement_grid_model_update__new_list__cells_built_in_list_order);
+    RUN_TEST(achievement_grid_model_take_dirty__icons_downloaded__cells_returned_once);
+    RUN_TEST(achievement_grid_model_take_dirty__other_game_downloading__cells_cleared_then_drawn);
+    RUN_TEST(achievement_grid_model_update__unlock_resorts_list__only_unlocked_cell_dirty);
+    RUN_TEST(achievement_grid_model_update__other_game__cells_rebuilt_and_stale_download_ignored);
+    RUN_TEST(achievement_grid_model_update__achievement_added__downloaded_icons_kept);
+    RUN_TEST(achievement_grid_model_update_one__progress__cell_updated_without_redraw);
+    RUN_TEST(achievement_grid_model_icon_downloaded__failed__cell_cleared);
+    RUN_TEST(achievement_grid_model_take_dirty__more_than_max__rest_kept_for_next_call);
+    RUN_TEST(achievement_grid_model_mark_all_dirty__after_take__every_cell_returned);
+
+    return UNITY_END();
+}
@@ -0,0 +1,166 @@
+/**
+ * @file test_achievement_progress_model.c
+ * @brief Unit tests for achievement_progress_model.c — animated state of the Achievement Progress bar.
+ */
+
+#include "unity.h"
+
+#include "sources/common/achievement_progress_model.h"
+#include "common/intern.h"
+
+#include <obs-module.h>
+
+/** Duration of a frame at 60 FPS, in seconds. */
+#define FRAME_SECONDS (1.0f / 60.0f)
+
+static achievement_progress_model_t g_model;
+static achievement_t               *g_achievements;
+static uint64_t                     g_frame_time_ns;
+
+void setUp(void) {
+    memset(&g_model, 0, sizeof(g_model));
+    g_frame_time_ns = 0;
+}
+
+void tearDown(void) {
+    free_achievement(&g_achievements);
+}
+
+/**
+ * @brief Append an achievement to g_achievements (freed by tearDown).
+ */
+static achievement_t *add_achievement(const char *id, const char *measured_progress, int64_t unlocked_timestamp) {
+
+    achievement_t *achievement      = alloc_achievement();
+    achievement->id                 = intern_string(id);
+    achievement->measured_progress  = intern_string(measured_progress);
+    achievement->unlocked_timestamp = unlocked_timestamp;
+
+    achievement_t **tail = &g_achievements;
+    while (*tail) {
+        tail = &(*tail)->next;
+    }
+    *tail = achievement;
+
+    return achievement;
+}
+
+/**
+ * @brief Tick the model for @p count new frames.
+ */
+static void tick_frames(int count) {
+
+    for (int i = 0; i < count; i++) {
+        g_frame_time_ns += 16666667;
+        achievement_progress_model_tick(&g_model, g_frame_time_ns, FRAME_SECONDS);
+    }
+}
+
+/* -------------------------------------------------------------------------
+ * Tests
+ * ---------------------------------------------------------------------- */
+
+void achievement_progress_model_set_achievement__new_achievement__ratio_jumps(void) {
+    //  Arrange.
+    achievement_progress_model_set_achievement(&g_model, add_achievement("a", "2/10", 0));
+    tick_frames(60);
+
+    //  Act.
+    achievement_progress_model_set_achievement(&g_model, add_achievement("b", "8/10", 0));
+    tick_frames(1);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_FLOAT(0.8f, g_model.displayed_ratio);
+    TEST_ASSERT_TRUE(g_model.opacity > 0.0f);
+}
+
+void achievement_progress_model_set_achievement__same_achievement_progressed__ratio_eases(void) {
+    //  Arrange.
+    achievement_progress_model_set_achievement(&g_model, add_achievement("a", "2/10", 0));
+    tick_frames(60);
+
+    //  Act.
+    achievement_progress_model_set_achievement(&g_model, add_achievement("a", "8/10", 0));
+    tick_frames(1);
+
+    //  Assert.
+    TEST_ASSERT_TRUE(g_model.displayed_ratio > 0.2f);
+    TEST_ASSERT_TRUE(g_model.displayed_ratio < 0.8f);
+
+    tick_frames(60);
+    TEST_ASSERT_EQUAL_FLOAT(0.8f, g_model.displayed_ratio);
+}
+
+void achievement_progress_model_set_achievement__achievement_unlocked__bar_filled_and_faded(void) {
+    //  Arrange.
+    achievement_progress_model_set_achievement(&g_model, add_achievement("a", "9/10", 0));
+    tick_frames(60);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, g_model.opacity);
+
+    //  Act.
+    achievement_progress_model_set_achievement(&g_model, add_achievement("a", "9/10", 1700000000));
+    tick_frames(1);
+
+    //  Assert.
+    TEST_ASSERT_TRUE(g_model.opacity < 1.0f);
+    TEST_ASSERT_TRUE(g_model.opacity > 0.0f);
+    TEST_ASSERT_TRUE(g_model.displayed_ratio > 0.9f);
+
+    tick_frames(60);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, g_model.opacity);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, g_model.displayed_ratio);
+}
+
+void achievement_progress_model_set_achievement__unmeasured_achievement__bar_faded(void) {
+    //  Arrange.
+    achievement_progress_model_set_achievement(&g_model, add_achievement("a", "5/10", 0));
+    tick_frames(60);
+
+    //  Act.
+    achievement_progress_model_set_achievement(&g_model, add_achievement("b", NULL, 0));
+    tick_frames(60);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, g_model.opacity);
+}
+
+void achievement_progress_model_tick__same_frame_time__advanced_once(void) {
+    //  Arrange.
+    achievement_progress_model_set_achievement(&g_model, add_achievement("a", "5/10", 0));
+
+    //  Act.
+    const bool first  = achievement_progress_model_tick(&g_model, 1000, FRAME_SECONDS);
+    const bool second = achievement_progress_model_tick(&g_model, 1000, FRAME_SECONDS);
+
+    //  Assert.
+    TEST_ASSERT_TRUE(first);
+    TEST_ASSERT_FALSE(second);
+    TEST_ASSERT_EQUAL_FLOAT(FRAME_SECONDS / ACHIEVEMENT_PROGRESS_FADE_DURATION, g_model.opacity);
+}
+
+void achievement_progress_model_reset__bar_visible__bar_faded(void) {
+    //  Arrange.
+    achievement_progress_model_set_achievement(&g_model, add_achievement("a", "5/10", 0));
+    tick_frames(60);
+
+    //  Act.
+    achievement_progress_model_reset(&g_model);
+    tick_frames(60);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, g_model.opacity);
+    TEST_ASSERT_EQUAL_STRING("", g_model.achievement_id);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(achievement_progress_model_set_achievement__new_achievement__ratio_jumps);
+    RUN_TEST(achievement_progress_model_set_achievement__same_achievement_progressed__ratio_eases);
+    RUN_TEST(achievement_progress_model_set_achievement__achievement_unlocked__bar_filled_and_faded);
+    RUN_TEST(achievement_progress_model_set_achievement__unmeasured_achievement__bar_faded);
+    RUN_TEST(achievement_progress_model_tick__same_frame_time__advanced_once);
+    RUN_TEST(achievement_progress_model_reset__bar_visible__bar_faded);
+
+    return UNITY_END();
+}
@@ -0,0 +1,126 @@
+/**
+ * @file test_arena.c
+ * @brief Unit tests for arena.c — bump allocator and cJSON scratch scopes.
+ */
+
+#include "unity.h"
+
+#include "util/arena.h"
+#include "cJSON.h"
+
+#include <stdint.h>
+#include <string.h>
+
+static arena_t *arena = NULL;
+
+void setUp(void) {
+    arena = arena_create(256);
+}
+
+void tearDown(void) {
+    arena_json_end();
+    arena_destroy(&arena);
+}
+
+/* -------------------------------------------------------------------------
+ * Tests
+ * ---------------------------------------------------------------------- */
+
+void arena_alloc__several_allocations__aligned_and_owned(void) {
+    //  Act.
+    void *first  = arena_alloc(arena, 3);
+    void *second = arena_alloc(arena, 40);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(0, (int)((uintptr_t)first % 16));
+    TEST_ASSERT_EQUAL_INT(0, (int)((uintptr_t)second % 16));
+    TEST_ASSERT_TRUE(arena_owns(arena, first));
+    TEST_ASSERT_TRUE(arena_owns(arena, second));
+    TEST_ASSERT_FALSE(arena_owns(arena, &first));
+}
+
+void arena_alloc__larger_than_chunk__new_chunk_added(void) {
+    //  Arrange.
+    char *small = arena_strdup(arena, "kept");
+
+    //  Act.
+    char *large = arena_alloc(arena, 4096);
+    memset(large, 'x', 4096);
+
+    //  Assert.
+    TEST_ASSERT_TRUE(arena_owns(arena, large));
+    TEST_ASSERT_EQUAL_STRING("kept", small);
+}
+
+void arena_reset__after_growth__memory_reused(void) {
+    //  Arrange.
+    arena_alloc(arena, 200);
+    void *large = arena_alloc(arena, 4096);
+
+    //  Act.
+    arena_reset(arena);
+    void *reused = arena_alloc(arena, 4096);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_PTR(large, reused);
+}
+
+void arena_strndup__length_given__copy_terminated(void) {
+    //  Act.
+    char *copy = arena_strndup(arena, "achievement", 7);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_STRING("achieve", copy);
+    TEST_ASSERT_NULL(arena_strdup(arena, NULL));
+}
+
+void arena_json_begin__hooks_installed__tree_allocated_from_arena(void) {
+    //  Arrange.
+    arena_install_json_hooks();
+
+    //  Act.
+    const bool in_arena = arena_json_begin(arena);
+    cJSON     *root     = cJSON_Parse("{\"name\":\"Halo\",\"ids\":[1,2,3]}");
+    arena_json_end();
+
+    //  Assert.
+    TEST_ASSERT_TRUE(in_arena);
+    TEST_ASSERT_TRUE(arena_owns(arena, root));
+    TEST_ASSERT_TRUE(arena_owns(arena, cJSON_GetObjectItem(root, "name")->valuestring));
+    TEST_ASSERT_EQUAL_STRING("Halo", cJSON_GetObjectItem(root, "name")->valuestring);
+}
+
+void arena_json_end__outside_scope__tree_allocated_from_heap(void) {
+    //  Arrange.
+    arena_install_json_hooks();
+
+    //  Act.
+    cJSON *root = cJSON_Parse("{\"name\":\"Halo\"}");
+
+    //  Assert.
+    TEST_ASSERT_FALSE(arena_owns(arena, root));
+
+    cJSON_Delete(root);
+}
+
+void arena_json_begin__null_arena__false_returned(void) {
+    //  Act.
+    const bool in_arena = arena_json_begin(NULL);
+
+    //  Assert.
+    TEST_ASSERT_FALSE(in_arena);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(arena_alloc__several_allocations__aligned_and_owned);
+    RUN_TEST(arena_alloc__larger_than_chunk__new_chunk_added);
+    RUN_TEST(arena_reset__after_growth__memory_reused);
+    RUN_TEST(arena_strndup__length_given__copy_terminated);
+    RUN_TEST(arena_json_begin__hooks_installed__tree_allocated_from_arena);
+    RUN_TEST(arena_json_end__outside_scope__tree_allocated_from_heap);
+    RUN_TEST(arena_json_begin__null_arena__false_returned);
+
+    return UNITY_END();
+}
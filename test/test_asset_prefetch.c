@@ -0,0 +1,140 @@
+/**
+ * @file test_asset_prefetch.c
+ * @brief Unit tests for asset_prefetch.c — priority order of the prefetched images.
+ */
+
+#include "unity.h"
+
+#include "integrations/asset_prefetch.h"
+#include "io/cache_stub.h"
+#include "common/types.h"
+
+#include <string.h>
+
+/* -------------------------------------------------------------------------
+ * Helpers
+ * ---------------------------------------------------------------------- */
+
+static prefetch_asset_t *assets = NULL;
+
+static achievement_t make_achievement(const char *id, int64_t unlocked_timestamp) {
+    achievement_t achievement      = {0};
+    achievement.id                 = (char *)id;
+    achievement.icon_url           = (char *)"https://example.com/icon.png";
+    achievement.unlocked_timestamp = unlocked_timestamp;
+    return achievement;
+}
+
+static const prefetch_asset_t *asset_at(int index) {
+    const prefetch_asset_t *asset = assets;
+    for (int i = 0; asset && i < index; i++) {
+        asset = asset->next;
+    }
+    return asset;
+}
+
+static int count_assets(void) {
+    int count = 0;
+    for (const prefetch_asset_t *asset = assets; asset; asset = asset->next) {
+        count++;
+    }
+    return count;
+}
+
+static bool wait_for_downloads(int expected) {
+    for (int i = 0; i < 2000 && mock_cache_get_download_count() < expected; i++) {
+        sleep_ms(1);
+    }
+    return mock_cache_get_download_count() >= expected;
+}
+
+void setUp(void) {
+    mock_cache_reset();
+}
+
+void tearDown(void) {
+    asset_prefetch_stop();
+    asset_prefetch_set_deferred(false);
+    free_prefetch_assets(&assets);
+}
+
+/* -------------------------------------------------------------------------
+ * Tests
+ * ---------------------------------------------------------------------- */
+
+void asset_prefetch_plan__mixed_achievements__last_unlocked_then_cover_avatar_locked_rest(void) {
+    //  Arrange.
+    achievement_t older_unlocked = make_achievement("older", 1000);
+    achievement_t locked         = make_achievement("locked", 0);
+    achievement_t last_unlocked  = make_achievement("last", 2000);
+    older_unlocked.next          = &locked;
+    locked.next                  = &last_unlocked;
+
+    game_t     game     = {.id = "game", .title = "Halo", .cover_url = "https://example.com/cover.png"};
+    identity_t identity = {.name = "Player", .avatar_url = "https://example.com/avatar.png"};
+
+    //  Act.
+    assets = asset_prefetch_plan(&game, &identity, &older_unlocked);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(5, count_assets());
+    TEST_ASSERT_EQUAL_STRING("last", asset_at(0)->id);
+    TEST_ASSERT_EQUAL_STRING("game_cover", asset_at(1)->type);
+    TEST_ASSERT_EQUAL_STRING("game", asset_at(1)->id);
+    TEST_ASSERT_EQUAL_STRING("gamerpic", asset_at(2)->type);
+    TEST_ASSERT_EQUAL_STRING("Player", asset_at(2)->id);
+    TEST_ASSERT_EQUAL_STRING("locked", asset_at(3)->id);
+    TEST_ASSERT_EQUAL_STRING("older", asset_at(4)->id);
+    TEST_ASSERT_EQUAL_STRING("achievement_icon", asset_at(4)->type);
+}
+
+void asset_prefetch_plan__missing_urls__entries_skipped(void) {
+    //  Arrange.
+    achievement_t achievement = make_achievement("no-icon", 0);
+    achievement.icon_url      = NULL;
+
+    game_t     game     = {.id = "game", .title = "Halo", .cover_url = NULL};
+    identity_t identity = {.name = NULL, .avatar_url = "https://example.com/avatar.png"};
+
+    //  Act.
+    assets = asset_prefetch_plan(&game, &identity, &achievement);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(1, count_assets());
+    TEST_ASSERT_EQUAL_STRING("default", asset_at(0)->id);
+}
+
+void asset_prefetch_plan__nothing_given__null_returned(void) {
+    //  Act.
+    assets = asset_prefetch_plan(NULL, NULL, NULL);
+
+    //  Assert.
+    TEST_ASSERT_NULL(assets);
+}
+
+void asset_prefetch_set_deferred__started_while_deferred__downloads_after_resume(void) {
+    //  Arrange.
+    game_t game = {.id = "game", .title = "Halo", .cover_url = "https://example.com/cover.png"};
+    asset_prefetch_set_deferred(true);
+
+    //  Act.
+    asset_prefetch_start(&game, NULL, NULL);
+    sleep_ms(50);
+    const int deferred_count = mock_cache_get_download_count();
+    asset_prefetch_set_deferred(false);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(0, deferred_count);
+    TEST_ASSERT_TRUE(wait_for_downloads(1));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(asset_prefetch_plan__mixed_achievements__last_unlocked_then_cover_avatar_locked_rest);
+    RUN_TEST(asset_prefetch_plan__missing_urls__entries_skipped);
+    RUN_TEST(asset_prefetch_plan__nothing_given__null_returned);
+    RUN_TEST(asset_prefetch_set_deferred__started_while_deferred__downloads_after_resume);
+
+    return UNITY_END();
+}
@@ -0,0 +1,316 @@
+/**
+ * @file test_clock.c
+ * @brief Unit tests for clock.c — real, simulated and accelerated clocks, and
+ *        the display cycle and auto show/hide fades driven by them.
+ */
+
+#include "unity.h"
+
+#include "test/stubs/integrations/monitoring_service_stub.h"
+
+#include "time/clock.h"
+#include "time/time.h"
+#include "common/achievement.h"
+#include "common/intern.h"
+#include "common/memory.h"
+#include "common/token.h"
+#include "sources/common/achievement_cycle.h"
+#include "sources/common/visibility_cycle.h"
+
+#include <stdlib.h>
+
+#define SECOND_NS 1000000000ULL
+#define HOUR_S    3600
+
+/** 2023-11-14 22:13:20 UTC */
+#define START_UNIX_TIME 1700000000
+
+/** Auto show/hide durations of the fade tests: a 19 s cycle. */
+#define SHOW_S 10
+#define HIDE_S 5
+#define FADE_S 2
+
+/* -------------------------------------------------------------------------
+ * obs-module stubs (auto show/hide toggle, unused by the tests)
+ * ---------------------------------------------------------------------- */
+
+obs_property_t *obs_properties_add_bool(obs_properties_t *props, const char *name, const char *description) {
+    (void)props;
+    (void)name;
+    (void)description;
+    return NULL;
+}
+
+void obs_data_set_default_bool(obs_data_t *data, const char *name, bool value) {
+    (void)data;
+    (void)name;
+    (void)value;
+}
+
+bool obs_data_has_user_value(obs_data_t *data, const char *name) {
+    (void)data;
+    (void)name;
+    return false;
+}
+
+bool obs_data_get_bool(obs_data_t *data, const char *name) {
+    (void)data;
+    (void)name;
+    return false;
+}
+
+/* -------------------------------------------------------------------------
+ * Helpers
+ * ---------------------------------------------------------------------- */
+
+static achievement_t *make_achievement(const char *id, int64_t unlocked_timestamp) {
+    achievement_t *a      = alloc_achievement();
+    a->id                 = bstrdup(id);
+    a->name               = bstrdup(id);
+    a->unlocked_timestamp = unlocked_timestamp;
+    return a;
+}
+
+/** Move a simulated clock to the start of the auto show/hide cycle. */
+static void align_on_visibility_cycle(void) {
+    const uint64_t cycle_ns = (SHOW_S + HIDE_S + 2 * FADE_S) * SECOND_NS;
+    clock_advance_ns(cycle_ns - clock_monotonic_ns() % cycle_ns);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {
+    achievement_cycle_destroy();
+    mock_monitoring_reset();
+    clock_use_real();
+}
+
+/* -------------------------------------------------------------------------
+ * Tests
+ * ---------------------------------------------------------------------- */
+
+void clock_use_simulated__not_advanced__time_frozen(void) {
+    //  Arrange.
+    clock_use_simulated(START_UNIX_TIME);
+    const uint64_t monotonic_ns = clock_monotonic_ns();
+
+    //  Act & Assert.
+    TEST_ASSERT_EQUAL_UINT64(monotonic_ns, clock_monotonic_ns());
+    TEST_ASSERT_EQUAL_INT64(START_UNIX_TIME, (int64_t)clock_unix_time());
+    TEST_ASSERT_EQUAL_INT(CLOCK_MODE_SIMULATED, clock_get_mode());
+}
+
+void clock_advance_ns__simulated__monotonic_and_wall_clock_moved_together(void) {
+    //  Arrange.
+    clock_use_simulated(START_UNIX_TIME);
+    const uint64_t monotonic_ns = clock_monotonic_ns();
+
+    //  Act.
+    clock_advance_ns(3 * HOUR_S * SECOND_NS);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_UINT64(monotonic_ns + 3 * HOUR_S * SECOND_NS, clock_monotonic_ns());
+    TEST_ASSERT_EQUAL_INT64(START_UNIX_TIME + 3 * HOUR_S, (int64_t)clock_unix_time());
+    TEST_ASSERT_EQUAL_INT64(START_UNIX_TIME + 3 * HOUR_S, (int64_t)now());
+}
+
+void clock_advance_ns__real_clock__ignored(void) {
+    //  Arrange.
+    const time_t before = clock_unix_time();
+
+    //  Act.
+    clock_advance_ns(24 * HOUR_S * SECOND_NS);
+
+    //  Assert.
+    TEST_ASSERT_TRUE(clock_unix_time() - before < HOUR_S);
+    TEST_ASSERT_EQUAL_INT(CLOCK_MODE_REAL, clock_get_mode());
+}
+
+void clock_scale_frame__accelerated__frame_multiplied(void) {
+    //  Arrange.
+    clock_use_accelerated(60.0);
+
+    //  Act.
+    const float scaled = clock_scale_frame(0.5f);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(30000, (int)(scaled * 1000.0f));
+}
+
+void clock_scale_frame__simulated__frame_unchanged(void) {
+    //  Arrange.
+    clock_use_simulated(0);
+
+    //  Act.
+    const float scaled = clock_scale_frame(0.5f);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(500, (int)(scaled * 1000.0f));
+}
+
+void clock_use_accelerated__from_simulated__time_continues(void) {
+    //  Arrange.
+    clock_use_simulated(START_UNIX_TIME);
+    clock_advance_ns(HOUR_S * SECOND_NS);
+    const uint64_t monotonic_ns = clock_monotonic_ns();
+
+    //  Act.
+    clock_use_accelerated(1000.0);
+
+    //  Assert.
+    TEST_ASSERT_TRUE(clock_monotonic_ns() >= monotonic_ns);
+    TEST_ASSERT_TRUE((int64_t)clock_unix_time() >= START_UNIX_TIME + HOUR_S);
+}
+
+void token_is_expired__simulated_hours_later__expired(void) {
+    //  Arrange.
+    clock_use_simulated(START_UNIX_TIME);
+
+    token_t token = {
+        .value   = "token",
+        .expires = START_UNIX_TIME + HOUR_S,
+    };
+
+    //  Act.
+    const bool expired_at_start = token_is_expired(&token);
+    clock_advance_ns(2 * HOUR_S * SECOND_NS);
+    const bool expired_later = token_is_expired(&token);
+
+    //  Assert.
+    TEST_ASSERT_FALSE(expired_at_start);
+    TEST_ASSERT_TRUE(expired_later);
+}
+
+void clock_use_real__after_accelerated__monotonic_time_not_going_backwards(void) {
+    //  Arrange.
+    clock_use_simulated(START_UNIX_TIME);
+    clock_advance_ns(24 * HOUR_S * SECOND_NS);
+    const uint64_t monotonic_ns = clock_monotonic_ns();
+
+    //  Act.
+    clock_use_real();
+
+    //  Assert.
+    TEST_ASSERT_TRUE(clock_monotonic_ns() >= monotonic_ns);
+    TEST_ASSERT_EQUAL_INT(CLOCK_MODE_REAL, clock_get_mode());
+}
+
+void clock_use_accelerated_from_environment__factor_set__accelerated(void) {
+    //  Arrange.
+    setenv("ACHIEVEMENTS_TRACKER_TIME_FACTOR", "60", 1);
+
+    //  Act.
+    const double factor = clock_use_accelerated_from_environment();
+    unsetenv("ACHIEVEMENTS_TRACKER_TIME_FACTOR");
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(60, (int)factor);
+    TEST_ASSERT_EQUAL_INT(CLOCK_MODE_ACCELERATED, clock_get_mode());
+}
+
+void clock_use_accelerated_from_environment__invalid_factor__real(void) {
+    //  Arrange.
+    setenv("ACHIEVEMENTS_TRACKER_TIME_FACTOR", "fast", 1);
+
+    //  Act.
+    const double factor = clock_use_accelerated_from_environment();
+    unsetenv("ACHIEVEMENTS_TRACKER_TIME_FACTOR");
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(1, (int)factor);
+    TEST_ASSERT_EQUAL_INT(CLOCK_MODE_REAL, clock_get_mode());
+}
+
+void achievement_cycle_tick__accelerated_frames__locked_rotation_reached(void) {
+    //  Arrange.
+    achievement_t *achievements = make_achievement("unlocked", START_UNIX_TIME);
+    achievements->next          = make_achievement("locked", 0);
+    mock_monitoring_set_achievements(achievements);
+
+    achievement_cycle_init();
+    achievement_cycle_set_timings(45.0f, 30.0f, 120.0f);
+    mock_monitoring_fire_session_ready();
+
+    char *shown_first = achievement_cycle_get_current_id();
+
+    //  Act: 46 frames of 1/60 s at 60x are 46 s of cycle time
+    clock_use_accelerated(60.0);
+
+    for (int frame = 0; frame < 46; frame++) {
+        achievement_cycle_tick(clock_scale_frame(1.0f / 60.0f));
+    }
+
+    char *shown_after = achievement_cycle_get_current_id();
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_STRING("unlocked", shown_first);
+    TEST_ASSERT_EQUAL_STRING("locked", shown_after);
+
+    intern_release(&shown_first);
+    intern_release(&shown_after);
+}
+
+void auto_visibility_get_opacity__simulated_cycle__shown_faded_and_hidden(void) {
+    //  Arrange.
+    auto_visibility_config_t config = {
+        .enabled       = true,
+        .show_duration = SHOW_S,
+        .hide_duration = HIDE_S,
+        .fade_duration = FADE_S,
+    };
+
+    clock_use_simulated(START_UNIX_TIME);
+    align_on_visibility_cycle();
+
+    //  Act & Assert.
+    TEST_ASSERT_EQUAL_INT(100, (int)(auto_visibility_get_opacity(&config) * 100.0f + 0.5f));
+
+    clock_advance_ns((SHOW_S + FADE_S / 2) * SECOND_NS);
+    TEST_ASSERT_EQUAL_INT(50, (int)(auto_visibility_get_opacity(&config) * 100.0f + 0.5f));
+
+    clock_advance_ns((FADE_S / 2 + HIDE_S / 2) * SECOND_NS);
+    TEST_ASSERT_EQUAL_INT(0, (int)(auto_visibility_get_opacity(&config) * 100.0f + 0.5f));
+
+    clock_advance_ns((HIDE_S - HIDE_S / 2 + FADE_S) * SECOND_NS);
+    TEST_ASSERT_EQUAL_INT(100, (int)(auto_visibility_get_opacity(&config) * 100.0f + 0.5f));
+}
+
+void auto_visibility_get_opacity__simulated_hours_later__same_phase(void) {
+    //  Arrange.
+    auto_visibility_config_t config = {
+        .enabled       = true,
+        .show_duration = SHOW_S,
+        .hide_duration = HIDE_S,
+        .fade_duration = FADE_S,
+    };
+
+    clock_use_simulated(START_UNIX_TIME);
+    align_on_visibility_cycle();
+    clock_advance_ns((SHOW_S + FADE_S) * SECOND_NS);
+
+    //  Act: a whole number of cycles later, the source is hidden again
+    clock_advance_ns(1000ULL * (SHOW_S + HIDE_S + 2 * FADE_S) * SECOND_NS);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(0, (int)(auto_visibility_get_opacity(&config) * 100.0f + 0.5f));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(clock_use_simulated__not_advanced__time_frozen);
+    RUN_TEST(clock_advance_ns__simulated__monotonic_and_wall_clock_moved_together);
+    RUN_TEST(clock_advance_ns__real_clock__ignored);
+    RUN_TEST(clock_scale_frame__accelerated__frame_multiplied);
+    RUN_TEST(clock_scale_frame__simulated__frame_unchanged);
+    RUN_TEST(clock_use_accelerated__from_simulated__time_continues);
+    RUN_TEST(token_is_expired__simulated_hours_later__expired);
+    RUN_TEST(clock_use_real__after_accelerated__monotonic_time_not_going_backwards);
+    RUN_TEST(clock_use_accelerated_from_environment__factor_set__accelerated);
+    RUN_TEST(clock_use_accelerated_from_environment__invalid_factor__real);
+    RUN_TEST(achievement_cycle_tick__accelerated_frames__locked_rotation_reached);
+    RUN_TEST(auto_visibility_get_opacity__simulated_cycle__shown_faded_and_hidden);
+    RUN_TEST(auto_visibility_get_opacity__simulated_hours_later__same_phase);
+
+    return UNITY_END();
+}
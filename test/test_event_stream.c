@@ -0,0 +1,224 @@
+/**
+ * @file test_event_stream.c
+ * @brief Unit tests for event_stream.c — delta events and snapshot for external overlays.
+ */
+
+#include "unity.h"
+
+#include "integrations/event_stream.h"
+#include "cJSON.h"
+#include "util/bmem.h"
+
+#include <string.h>
+
+/* -------------------------------------------------------------------------
+ * Helpers
+ * ---------------------------------------------------------------------- */
+
+#define MAX_CAPTURED_EVENTS 8
+
+static int   g_event_count = 0;
+static char *g_event_types[MAX_CAPTURED_EVENTS];
+static char *g_event_payloads[MAX_CAPTURED_EVENTS];
+
+static void capture_sink(const char *event_type, const char *json) {
+    if (g_event_count >= MAX_CAPTURED_EVENTS) {
+        return;
+    }
+
+    g_event_types[g_event_count]    = bstrdup(event_type);
+    g_event_payloads[g_event_count] = bstrdup(json);
+    g_event_count++;
+}
+
+static void clear_captured_events(void) {
+    for (int i = 0; i < g_event_count; i++) {
+        bfree(g_event_types[i]);
+        bfree(g_event_payloads[i]);
+    }
+    g_event_count = 0;
+}
+
+static double read_number(const char *json, const char *key) {
+    cJSON *root  = cJSON_Parse(json);
+    double value = cJSON_GetObjectItemCaseSensitive(root, key)->valuedouble;
+    cJSON_Delete(root);
+    return value;
+}
+
+static achievement_t make_achievement(const char *id, int64_t unlocked_timestamp) {
+    achievement_t achievement      = {0};
+    achievement.id                 = (char *)id;
+    achievement.name               = (char *)"Name";
+    achievement.value              = 10;
+    achievement.unlocked_timestamp = unlocked_timestamp;
+    return achievement;
+}
+
+static game_t g_game = {
+    .id           = "game-id",
+    .title        = "Halo",
+    .console_name = "Xbox",
+    .cover_url    = NULL,
+};
+
+void setUp(void) {
+    event_stream_set_sink(capture_sink);
+}
+
+void tearDown(void) {
+    event_stream_cleanup();
+    clear_captured_events();
+}
+
+/* -------------------------------------------------------------------------
+ * Tests
+ * ---------------------------------------------------------------------- */
+
+void event_stream_game_changed__sink_set__event_published_with_next_generation(void) {
+    //  Arrange.
+    uint64_t generation = event_stream_get_generation();
+
+    //  Act.
+    event_stream_game_changed(&g_game);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(1, g_event_count);
+    TEST_ASSERT_EQUAL_STRING("GameChanged", g_event_types[0]);
+    TEST_ASSERT_NOT_NULL(strstr(g_event_payloads[0], "\"title\":\"Halo\""));
+    TEST_ASSERT_EQUAL_INT((int)generation + 1, (int)read_number(g_event_payloads[0], "generation"));
+}
+
+void event_stream_achievement_updated__unlocked_timestamp__unlocked_event_with_single_achievement(void) {
+    //  Arrange.
+    achievement_t unlocked   = make_achievement("a1", 1700000000LL);
+    achievement_t progressed = make_achievement("a2", 0);
+    unlocked.next            = &progressed;
+
+    //  Act.
+    event_stream_achievement_updated(&unlocked);
+    event_stream_achievement_updated(&progressed);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(2, g_event_count);
+    TEST_ASSERT_EQUAL_STRING("AchievementUnlocked", g_event_types[0]);
+    TEST_ASSERT_EQUAL_STRING("AchievementProgressed", g_event_types[1]);
+    TEST_ASSERT_NULL(strstr(g_event_payloads[0], "\"a2\""));
+}
+
+void event_stream_cycle_moved__same_achievement_twice__published_once(void) {
+    //  Arrange.
+    achievement_t achievement = make_achievement("a1", 0);
+
+    //  Act.
+    event_stream_cycle_moved(&achievement);
+    event_stream_cycle_moved(&achievement);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(1, g_event_count);
+    TEST_ASSERT_EQUAL_STRING("CycleMoved", g_event_types[0]);
+    TEST_ASSERT_NOT_NULL(strstr(g_event_payloads[0], "\"achievement_id\":\"a1\""));
+}
+
+void event_stream_get_snapshot__after_events__state_and_generation_returned(void) {
+    //  Arrange.
+    achievement_t first  = make_achievement("a1", 0);
+    achievement_t second = make_achievement("a2", 0);
+    first.next           = &second;
+
+    event_stream_game_changed(&g_game);
+    event_stream_achievements_loaded(&first);
+
+    second.unlocked_timestamp = 1700000000LL;
+    event_stream_achievement_updated(&second);
+    event_stream_cycle_moved(&second);
+
+    //  Act.
+    char *json = event_stream_get_snapshot();
+
+    //  Assert.
+    cJSON *root = cJSON_Parse(json);
+    TEST_ASSERT_NOT_NULL(root);
+    const cJSON *game         = cJSON_GetObjectItemCaseSensitive(root, "game");
+    const cJSON *achievements = cJSON_GetObjectItemCaseSensitive(root, "achievements");
+
+    TEST_ASSERT_EQUAL_INT((int)event_stream_get_generation(), cJSON_GetObjectItemCaseSensitive(root, "generation")->valueint);
+    TEST_ASSERT_EQUAL_STRING("Halo", cJSON_GetObjectItemCaseSensitive(game, "title")->valuestring);
+    TEST_ASSERT_EQUAL_STRING("a2", cJSON_GetObjectItemCaseSensitive(root, "current_achievement_id")->valuestring);
+    TEST_ASSERT_EQUAL_INT(2, cJSON_GetArraySize(achievements));
+    TEST_ASSERT_EQUAL_INT(
+        1700000000,
+        cJSON_GetObjectItemCaseSensitive(cJSON_GetArrayItem(achievements, 1), "unlocked_at")->valueint);
+
+    cJSON_Delete(root);
+    bfree(json);
+}
+
+void event_stream_game_changed__achievements_loaded__snapshot_achievements_cleared(void) {
+    //  Arrange.
+    achievement_t achievement = make_achievement("a1", 0);
+    event_stream_achievements_loaded(&achievement);
+
+    //  Act.
+    event_stream_game_changed(NULL);
+    char *json = event_stream_get_snapshot();
+
+    //  Assert.
+    TEST_ASSERT_NOT_NULL(strstr(json, "\"game\":null"));
+    TEST_ASSERT_NOT_NULL(strstr(json, "\"achievements\":[]"));
+
+    bfree(json);
+}
+
+void event_stream_set_sink__null_sink__generation_still_advances(void) {
+    //  Arrange.
+    event_stream_set_sink(NULL);
+    uint64_t generation = event_stream_get_generation();
+
+    //  Act.
+    event_stream_game_changed(&g_game);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(0, g_event_count);
+    TEST_ASSERT_EQUAL_INT((int)generation + 1, (int)event_stream_get_generation());
+}
+
+static char *g_snapshot_from_sink = NULL;
+
+static void snapshot_sink(const char *event_type, const char *json) {
+    capture_sink(event_type, json);
+
+    bfree(g_snapshot_from_sink);
+    g_snapshot_from_sink = event_stream_get_snapshot();
+}
+
+void event_stream_game_changed__sink_requests_snapshot__snapshot_includes_event(void) {
+    //  Arrange.
+    event_stream_set_sink(snapshot_sink);
+
+    //  Act.
+    event_stream_game_changed(&g_game);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(1, g_event_count);
+    TEST_ASSERT_NOT_NULL(g_snapshot_from_sink);
+    TEST_ASSERT_EQUAL_INT((int)read_number(g_event_payloads[0], "generation"),
+                          (int)read_number(g_snapshot_from_sink, "generation"));
+
+    bfree(g_snapshot_from_sink);
+    g_snapshot_from_sink = NULL;
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(event_stream_game_changed__sink_set__event_published_with_next_generation);
+    RUN_TEST(event_stream_achievement_updated__unlocked_timestamp__unlocked_event_with_single_achievement);
+    RUN_TEST(event_stream_cycle_moved__same_achievement_twice__published_once);
+    RUN_TEST(event_stream_get_snapshot__after_events__state_and_generation_returned);
+    RUN_TEST(event_stream_game_changed__achievements_loaded__snapshot_achievements_cleared);
+    RUN_TEST(event_stream_set_sink__null_sink__generation_still_advances);
+    RUN_TEST(event_stream_game_changed__sink_requests_snapshot__snapshot_includes_event);
+
+    return UNITY_END();
+}
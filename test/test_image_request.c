@@ -0,0 +1,171 @@
+/**
+ * @file test_image_request.c
+ * @brief Unit tests for image_request.c — size buckets and sized image URLs.
+ */
+
+#include "unity.h"
+
+#include "io/image_request.h"
+
+#include <obs-module.h>
+
+static char *url = NULL;
+
+void setUp(void) {
+    image_request_reset();
+}
+
+void tearDown(void) {
+    bfree(url);
+    url = NULL;
+}
+
+/* -------------------------------------------------------------------------
+ * Tests
+ * ---------------------------------------------------------------------- */
+
+void image_request_bucket__sizes__rounded_up_and_clamped(void) {
+    //  Act & Assert.
+    TEST_ASSERT_EQUAL_UINT32(100, image_request_bucket(0));
+    TEST_ASSERT_EQUAL_UINT32(100, image_request_bucket(64));
+    TEST_ASSERT_EQUAL_UINT32(200, image_request_bucket(200));
+    TEST_ASSERT_EQUAL_UINT32(400, image_request_bucket(201));
+    TEST_ASSERT_EQUAL_UINT32(800, image_request_bucket(800));
+    TEST_ASSERT_EQUAL_UINT32(IMAGE_REQUEST_MAX_SIZE, image_request_bucket(4000));
+}
+
+void image_request_get_size__several_displays__largest_until_removed(void) {
+    //  Arrange.
+    image_request_add_display("gamerpic", 200, 200);
+    image_request_add_display("gamerpic", 800, 200);
+
+    //  Act.
+    const uint32_t with_both = image_request_get_size("gamerpic");
+    image_request_remove_display("gamerpic", 800, 200);
+    const uint32_t with_small = image_request_get_size("gamerpic");
+    image_request_remove_display("gamerpic", 200, 200);
+    const uint32_t with_none = image_request_get_size("gamerpic");
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_UINT32(800, with_both);
+    TEST_ASSERT_EQUAL_UINT32(200, with_small);
+    TEST_ASSERT_EQUAL_UINT32(0, with_none);
+}
+
+void image_request_display_set_active__inactive_display__not_counted(void) {
+    //  Arrange.
+    image_request_display_t display;
+    image_request_display_init(&display, "gamerpic", 800, 800);
+
+    //  Act.
+    const uint32_t before_activation = image_request_get_size("gamerpic");
+    image_request_display_set_active(&display, true);
+    const uint32_t while_active = image_request_get_size("gamerpic");
+    image_request_display_set_active(&display, false);
+    const uint32_t after_deactivation = image_request_get_size("gamerpic");
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_UINT32(0, before_activation);
+    TEST_ASSERT_EQUAL_UINT32(800, while_active);
+    TEST_ASSERT_EQUAL_UINT32(0, after_deactivation);
+}
+
+void image_request_display_set_size__active_display_scaled_down__smaller_size_requested(void) {
+    //  Arrange.
+    image_request_display_t display;
+    image_request_display_init(&display, "game_cover", 800, 200);
+    image_request_display_set_active(&display, true);
+
+    //  Act.
+    image_request_display_set_size(&display, 160, 40);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_UINT32(200, image_request_get_size("game_cover"));
+
+    image_request_display_set_active(&display, false);
+    TEST_ASSERT_EQUAL_UINT32(0, image_request_get_size("game_cover"));
+}
+
+void image_request_plan_url__xbox_icon_with_size__size_replaced(void) {
+    //  Arrange.
+    image_request_add_display("achievement_icon", 300, 300);
+
+    //  Act.
+    url = image_request_plan_url("achievement_icon", "https://images-eds-ssl.xboxlive.com/image?url=abc&w=200&h=200");
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_STRING("https://images-eds-ssl.xboxlive.com/image?url=abc&w=400&h=400", url);
+}
+
+void image_request_plan_url__cover_without_query__size_appended(void) {
+    //  Arrange.
+    image_request_add_display("game_cover", 800, 200);
+
+    //  Act.
+    url = image_request_plan_url("game_cover", "https://store-images.s-microsoft.com/image/apps.1234.png");
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_STRING("https://store-images.s-microsoft.com/image/apps.1234.png?w=800&h=800", url);
+}
+
+void image_request_plan_url__other_host__unchanged(void) {
+    //  Arrange.
+    image_request_add_display("achievement_icon", 200, 200);
+
+    //  Act.
+    url = image_request_plan_url("achievement_icon", "https://media.retroachievements.org/Badge/1234.png");
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_STRING("https://media.retroachievements.org/Badge/1234.png", url);
+}
+
+void image_request_plan_url__no_display__unchanged(void) {
+    //  Act.
+    url = image_request_plan_url("gamerpic", "https://images-eds-ssl.xboxlive.com/image?url=abc&format=png");
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_STRING("https://images-eds-ssl.xboxlive.com/image?url=abc&format=png", url);
+}
+
+void image_request_plan_sized_url__xbox_icon__size_reported(void) {
+    //  Arrange.
+    uint32_t size = 0;
+    image_request_add_display("achievement_icon", 300, 300);
+
+    //  Act.
+    url = image_request_plan_sized_url("achievement_icon", "https://images-eds-ssl.xboxlive.com/image?url=abc", &size);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_STRING("https://images-eds-ssl.xboxlive.com/image?url=abc&w=400&h=400", url);
+    TEST_ASSERT_EQUAL_UINT32(400, size);
+}
+
+void image_request_plan_sized_url__other_host__no_size(void) {
+    //  Arrange.
+    uint32_t size = 123;
+    image_request_add_display("achievement_icon", 200, 200);
+
+    //  Act.
+    url = image_request_plan_sized_url("achievement_icon", "https://media.retroachievements.org/Badge/1234.png", &size);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_STRING("https://media.retroachievements.org/Badge/1234.png", url);
+    TEST_ASSERT_EQUAL_UINT32(0, size);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(image_request_bucket__sizes__rounded_up_and_clamped);
+    RUN_TEST(image_request_get_size__several_displays__largest_until_removed);
+    RUN_TEST(image_request_display_set_active__inactive_display__not_counted);
+    RUN_TEST(image_request_display_set_size__active_display_scaled_down__smaller_size_requested);
+    RUN_TEST(image_request_plan_url__xbox_icon_with_size__size_replaced);
+    RUN_TEST(image_request_plan_url__cover_without_query__size_appended);
+    RUN_TEST(image_request_plan_url__other_host__unchanged);
+    RUN_TEST(image_request_plan_url__no_display__unchanged);
+    RUN_TEST(image_request_plan_sized_url__xbox_icon__size_reported);
+    RUN_TEST(image_request_plan_sized_url__other_host__no_size);
+
+    return UNITY_END();
+}
@@ -0,0 +1,125 @@
+/**
+ * @file test_memory_accounting.c
+ * @brief Unit tests for memory_accounting.c — per-subsystem counters and report.
+ */
+
+#include "unity.h"
+
+#include "diagnostics/memory_accounting.h"
+
+#include <string.h>
+
+static memory_usage_t before;
+
+void setUp(void) {
+    memory_get_usage(MEMORY_TAG_NET, &before);
+}
+
+void tearDown(void) {}
+
+/* -------------------------------------------------------------------------
+ * Tests
+ * ---------------------------------------------------------------------- */
+
+void memory_alloc__then_freed__counters_back_to_previous_values(void) {
+    //  Arrange.
+    memory_usage_t allocated;
+    memory_usage_t released;
+
+    //  Act.
+    char *block = memory_alloc(MEMORY_TAG_NET, 100);
+    memory_get_usage(MEMORY_TAG_NET, &allocated);
+    memory_free(block);
+    memory_get_usage(MEMORY_TAG_NET, &released);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT64(before.live_bytes + 100, allocated.live_bytes);
+    TEST_ASSERT_EQUAL_INT64(before.live_blocks + 1, allocated.live_blocks);
+    TEST_ASSERT_TRUE(allocated.peak_bytes >= allocated.live_bytes);
+    TEST_ASSERT_EQUAL_INT64(before.live_bytes, released.live_bytes);
+    TEST_ASSERT_EQUAL_INT64(before.live_blocks, released.live_blocks);
+    TEST_ASSERT_EQUAL_INT64(allocated.peak_bytes, released.peak_bytes);
+}
+
+void memory_realloc__grown__live_bytes_adjusted_and_content_kept(void) {
+    //  Arrange.
+    char *block = memory_malloc(MEMORY_TAG_NET, 4);
+    memcpy(block, "abc", 4);
+
+    //  Act.
+    block = memory_realloc(MEMORY_TAG_NET, block, 64);
+
+    //  Assert.
+    memory_usage_t usage;
+    memory_get_usage(MEMORY_TAG_NET, &usage);
+
+    TEST_ASSERT_EQUAL_STRING("abc", block);
+    TEST_ASSERT_EQUAL_INT64(before.live_bytes + 64, usage.live_bytes);
+    TEST_ASSERT_EQUAL_INT64(before.live_blocks + 1, usage.live_blocks);
+
+    memory_free(block);
+}
+
+void memory_strdup__null_text__null_returned(void) {
+    //  Act & Assert.
+    TEST_ASSERT_NULL(memory_strdup(MEMORY_TAG_NET, NULL));
+}
+
+void memory_account__allocated_then_released__counters_back_to_previous_values(void) {
+    //  Arrange.
+    memory_usage_t gpu_before;
+    memory_usage_t allocated;
+    memory_usage_t released;
+    memory_get_usage(MEMORY_TAG_GPU, &gpu_before);
+
+    //  Act.
+    memory_account(MEMORY_TAG_GPU, 4096);
+    memory_get_usage(MEMORY_TAG_GPU, &allocated);
+    memory_account(MEMORY_TAG_GPU, -4096);
+    memory_get_usage(MEMORY_TAG_GPU, &released);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT64(gpu_before.live_bytes + 4096, allocated.live_bytes);
+    TEST_ASSERT_EQUAL_INT64(gpu_before.live_blocks + 1, allocated.live_blocks);
+    TEST_ASSERT_EQUAL_INT64(gpu_before.live_bytes, released.live_bytes);
+    TEST_ASSERT_EQUAL_INT64(gpu_before.live_blocks, released.live_blocks);
+}
+
+void memory_format_report__any_usage__every_tag_and_total_listed(void) {
+    //  Arrange.
+    char report[1024];
+
+    //  Act.
+    memory_format_report(report, sizeof(report));
+
+    //  Assert.
+    for (int tag = 0; tag < MEMORY_TAG_COUNT; tag++) {
+        TEST_ASSERT_NOT_NULL(strstr(report, memory_tag_name((memory_tag_t)tag)));
+    }
+
+    TEST_ASSERT_NOT_NULL(strstr(report, "total"));
+}
+
+void memory_format_report__small_buffer__terminated(void) {
+    //  Arrange.
+    char report[8];
+
+    //  Act.
+    memory_format_report(report, sizeof(report));
+
+    //  Assert.
+    TEST_ASSERT_TRUE(strlen(report) < sizeof(report));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(memory_alloc__then_freed__counters_back_to_previous_values);
+    RUN_TEST(memory_realloc__grown__live_bytes_adjusted_and_content_kept);
+    RUN_TEST(memory_strdup__null_text__null_returned);
+    RUN_TEST(memory_account__allocated_then_released__counters_back_to_previous_values);
+    RUN_TEST(memory_format_report__any_usage__every_tag_and_total_listed);
+    RUN_TEST(memory_format_report__small_buffer__terminated);
+
+    return UNITY_END();
+}
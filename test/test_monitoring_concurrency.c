@@ -0,0 +1,392 @@
+/**
+ * @file test_monitoring_concurrency.c
+ * @brief Stress tests for the monitor → monitoring service → achievement cycle flows.
+ *
+ * Drives the real monitoring_service.c and achievement_cycle.c through the
+ * stub monitors from one thread per integration, as the Xbox and
+ * RetroAchievements websocket threads do, while a render thread ticks the
+ * cycle and copies the achievements and a UI thread navigates.
+ *
+ * The assertions only check that the flows end in a consistent state: the
+ * target is built with ThreadSanitizer, which fails the test on any data race
+ * or lock-order inversion.
+ */
+
+#include "unity.h"
+
+#include "test/stubs/integrations/xbox_monitor_stub.h"
+#include "test/stubs/integrations/retro_achievements_monitor_stub.h"
+#include "test/stubs/io/snapshot_stub.h"
+#include "test/stubs/time/time_stub.h"
+
+#include "integrations/monitoring_service.h"
+#include "integrations/xbox/entities/xbox_identity.h"
+#include "sources/common/achievement_cycle.h"
+#include "common/game.h"
+#include "common/intern.h"
+#include "common/token.h"
+#include "common/memory.h"
+#include "util/thread_compat.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/** Events fired by each producer thread. */
+#define ITERATIONS 200
+
+/** Achievements of the stubbed Xbox game. */
+#define XBOX_ACHIEVEMENT_COUNT 3
+
+/** Achievements of the RetroAchievements game. */
+#define RETRO_ACHIEVEMENT_COUNT 6
+
+/* -------------------------------------------------------------------------
+ * Helpers — build lightweight test fixtures
+ * ---------------------------------------------------------------------- */
+
+static xbox_identity_t *make_xbox_identity(const char *gamertag) {
+    token_t *token = bzalloc(sizeof(token_t));
+    token->value   = bstrdup("test-token");
+    token->expires = 9999999999LL;
+
+    xbox_identity_t *id = bzalloc(sizeof(xbox_identity_t));
+    id->gamertag        = bstrdup(gamertag);
+    id->xid             = bstrdup("xuid-123");
+    id->uhs             = bstrdup("uhs-abc");
+    id->token           = token;
+    return id;
+}
+
+static game_t *make_game(const char *id, const char *title) {
+    game_t *game = alloc_game();
+    game->id     = intern_string(id);
+    game->title  = intern_string(title);
+    return game;
+}
+
+static xbox_achievement_t *make_xbox_achievements(void) {
+    xbox_achievement_t *root = NULL;
+
+    for (int i = XBOX_ACHIEVEMENT_COUNT; i > 0; i--) {
+        char id[16];
+        snprintf(id, sizeof(id), "ach-%d", i);
+
+        xbox_achievement_t *a = xbox_alloc_achievement();
+        a->id                 = bstrdup(id);
+        a->name               = bstrdup(id);
+        a->progress_state     = bstrdup("NotStarted");
+        a->service_config_id  = bstrdup("00000000-0000-0000-0000-0000700a1e17");
+        a->next               = root;
+        root                  = a;
+    }
+
+    return root;
+}
+
+/* -------------------------------------------------------------------------
+ * Shared counters
+ * ---------------------------------------------------------------------- */
+
+static pthread_mutex_t g_counters_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** Set by the test once the producers are done; stops the render and UI threads. */
+static bool g_stop = false;
+
+/** Notifications received from the achievement cycle. */
+static int g_cycle_notifications = 0;
+
+/** Achievements seen by the achievements-changed subscriber. */
+static int g_achievements_seen = 0;
+
+/** Copies made by the render thread. */
+static int g_render_copies = 0;
+
+static bool read_flag(const bool *flag) {
+    pthread_mutex_lock(&g_counters_mutex);
+    bool value = *flag;
+    pthread_mutex_unlock(&g_counters_mutex);
+    return value;
+}
+
+static void set_flag(bool *flag, bool value) {
+    pthread_mutex_lock(&g_counters_mutex);
+    *flag = value;
+    pthread_mutex_unlock(&g_counters_mutex);
+}
+
+static void add_to_counter(int *counter, int value) {
+    pthread_mutex_lock(&g_counters_mutex);
+    *counter += value;
+    pthread_mutex_unlock(&g_counters_mutex);
+}
+
+static int read_counter(const int *counter) {
+    pthread_mutex_lock(&g_counters_mutex);
+    int value = *counter;
+    pthread_mutex_unlock(&g_counters_mutex);
+    return value;
+}
+
+/* -------------------------------------------------------------------------
+ * Subscribers — read the data they are handed, as the sources do
+ * ---------------------------------------------------------------------- */
+
+static void on_cycle_changed(const achievement_t *achievement) {
+    /* Touch the fields: a freed achievement shows up as a race or a crash */
+    if (achievement && achievement->name) {
+        (void)strlen(achievement->name);
+    }
+
+    add_to_counter(&g_cycle_notifications, 1);
+}
+
+static void on_achievements_changed(void) {
+    add_to_counter(&g_achievements_seen, count_achievements(monitoring_get_current_game_achievements()));
+}
+
+/* -------------------------------------------------------------------------
+ * Threads
+ * ---------------------------------------------------------------------- */
+
+/** Plays the websocket thread of the Xbox monitor. */
+static void *xbox_producer(void *data) {
+    (void)data;
+
+    game_t *games[2] = {make_game("game-1", "Halo Infinite"), make_game("game-2", "Forza Horizon 5")};
+
+    for (int i = 0; i < ITERATIONS; i++) {
+        mock_xbox_monitor_fire_connection_changed(true, NULL);
+        mock_xbox_monitor_fire_game_played(games[i % 2]);
+        mock_xbox_monitor_fire_session_ready();
+
+        const xbox_achievement_progress_t progress = {
+            .service_config_id = "00000000-0000-0000-0000-0000700a1e17",
+            .id                = "ach-2",
+            .progress_state    = i % 4 == 0 ? "Achieved" : "InProgress",
+            .current           = "3",
+            .target            = "10",
+        };
+        mock_xbox_monitor_fire_achievements_progressed(NULL, &progress);
+
+        if (i % 10 == 9) {
+            mock_xbox_monitor_fire_game_played(NULL);
+            mock_xbox_monitor_fire_connection_changed(false, "Connection lost");
+        }
+    }
+
+    free_game(&games[0]);
+    free_game(&games[1]);
+
+    return NULL;
+}
+
+/** Plays the websocket thread of the RetroAchievements monitor. */
+static void *retro_producer(void *data) {
+    (void)data;
+
+    retro_user_t user;
+    memset(&user, 0, sizeof(user));
+    snprintf(user.username, sizeof(user.username), "octelys");
+    snprintf(user.display_name, sizeof(user.display_name), "Octelys");
+
+    retro_game_t game;
+    memset(&game, 0, sizeof(game));
+    snprintf(game.game_id, sizeof(game.game_id), "crc-abc");
+    snprintf(game.game_name, sizeof(game.game_name), "Chrono Trigger");
+    snprintf(game.console_name, sizeof(game.console_name), "SNES");
+
+    retro_achievement_t achievements[RETRO_ACHIEVEMENT_COUNT];
+    memset(achievements, 0, sizeof(achievements));
+
+    for (int i = 0; i < RETRO_ACHIEVEMENT_COUNT; i++) {
+        achievements[i].id     = (uint32_t)(100 + i);
+        achievements[i].points = 10;
+        snprintf(achievements[i].name, sizeof(achievements[i].name), "Retro %d", i);
+        snprintf(achievements[i].status, sizeof(achievements[i].status), "%s", i % 2 ? "unlocked" : "locked");
+    }
+
+    for (int i = 0; i < ITERATIONS; i++) {
+        mock_retro_monitor_fire_connection_changed(true, NULL);
+        mock_retro_monitor_fire_user(&user);
+        mock_retro_monitor_fire_game_playing(&game);
+        mock_retro_monitor_fire_achievements(achievements, RETRO_ACHIEVEMENT_COUNT);
+
+        if (i % 7 == 6) {
+            mock_retro_monitor_fire_no_user();
+        }
+
+        if (i % 5 == 4) {
+            mock_retro_monitor_fire_no_game();
+        }
+
+        if (i % 10 == 9) {
+            mock_retro_monitor_fire_connection_changed(false, "Connection lost");
+        }
+    }
+
+    return NULL;
+}
+
+/** Plays the OBS graphics thread: the sources tick the cycle every frame. */
+static void *render_thread(void *data) {
+    (void)data;
+
+    while (!read_flag(&g_stop)) {
+        /* Long frames so that every tick moves the cycle to its next phase */
+        achievement_cycle_tick(20.0f);
+
+        achievement_t *achievements = monitoring_copy_current_game_achievements();
+        (void)count_achievements(achievements);
+        free_achievement(&achievements);
+
+        char *current_id = achievement_cycle_get_current_id();
+        intern_release(&current_id);
+
+        add_to_counter(&g_render_copies, 1);
+    }
+
+    return NULL;
+}
+
+/** Plays the Achievement Tracker dialog. */
+static void *ui_thread(void *data) {
+    (void)data;
+
+    bool auto_cycle = false;
+
+    while (!read_flag(&g_stop)) {
+        achievement_cycle_navigate_next();
+        achievement_cycle_navigate_previous();
+        achievement_cycle_navigate_first_locked();
+        achievement_cycle_navigate_first_unlocked();
+        achievement_cycle_set_auto_cycle(auto_cycle);
+        auto_cycle = !auto_cycle;
+    }
+
+    achievement_cycle_set_auto_cycle(true);
+
+    return NULL;
+}
+
+/* -------------------------------------------------------------------------
+ * setUp / tearDown
+ * ---------------------------------------------------------------------- */
+
+void setUp(void) {
+    g_stop                = false;
+    g_cycle_notifications = 0;
+    g_achievements_seen   = 0;
+    g_render_copies       = 0;
+
+    mock_xbox_monitor_reset();
+    mock_retro_monitor_reset();
+    mock_snapshot_reset();
+    mock_now(1700000000);
+
+    mock_xbox_monitor_set_identity(make_xbox_identity("MasterChief"));
+    mock_xbox_monitor_set_achievements(make_xbox_achievements());
+
+    monitoring_start();
+    monitoring_subscribe_achievements_changed(on_achievements_changed);
+
+    achievement_cycle_init();
+    achievement_cycle_set_timings(ACHIEVEMENT_CYCLE_MIN_DURATION,
+                                  ACHIEVEMENT_CYCLE_MIN_DURATION,
+                                  2 * ACHIEVEMENT_CYCLE_MIN_DURATION);
+    achievement_cycle_subscribe(on_cycle_changed);
+}
+
+void tearDown(void) {
+    achievement_cycle_unsubscribe(on_cycle_changed);
+    achievement_cycle_destroy();
+
+    monitoring_stop();
+    mock_xbox_monitor_reset();
+    mock_retro_monitor_reset();
+    mock_snapshot_reset();
+}
+
+/* -------------------------------------------------------------------------
+ * Tests
+ * ---------------------------------------------------------------------- */
+
+void monitoring_service__concurrent_monitors_render_and_ui__state_consistent(void) {
+    //  Arrange.
+    pthread_t xbox;
+    pthread_t retro;
+    pthread_t render;
+    pthread_t ui;
+
+    pthread_create(&render, NULL, render_thread, NULL);
+    pthread_create(&ui, NULL, ui_thread, NULL);
+
+    //  Act.
+    pthread_create(&xbox, NULL, xbox_producer, NULL);
+    pthread_create(&retro, NULL, retro_producer, NULL);
+
+    pthread_join(xbox, NULL);
+    pthread_join(retro, NULL);
+
+    set_flag(&g_stop, true);
+
+    pthread_join(render, NULL);
+    pthread_join(ui, NULL);
+
+    /* End on a known state: the Xbox game is the last one played */
+    game_t *game = make_game("game-1", "Halo Infinite");
+    mock_xbox_monitor_fire_connection_changed(true, NULL);
+    mock_xbox_monitor_fire_game_played(game);
+    mock_xbox_monitor_fire_session_ready();
+    free_game(&game);
+
+    //  Assert.
+    achievement_t *achievements = monitoring_copy_current_game_achievements();
+    char          *current_id   = achievement_cycle_get_current_id();
+
+    TEST_ASSERT_EQUAL_INT(XBOX_ACHIEVEMENT_COUNT, count_achievements(achievements));
+    TEST_ASSERT_NOT_NULL(current_id);
+    TEST_ASSERT_NOT_NULL(strstr(current_id, "ach-"));
+    TEST_ASSERT_TRUE(read_counter(&g_cycle_notifications) > 0);
+    TEST_ASSERT_TRUE(read_counter(&g_achievements_seen) > 0);
+    TEST_ASSERT_TRUE(read_counter(&g_render_copies) > 0);
+
+    intern_release(&current_id);
+    free_achievement(&achievements);
+}
+
+void monitoring_stop__render_thread_copying__list_released_safely(void) {
+    //  Arrange.
+    pthread_t render;
+    game_t   *game = make_game("game-1", "Halo Infinite");
+
+    pthread_create(&render, NULL, render_thread, NULL);
+
+    //  Act.
+    for (int i = 0; i < ITERATIONS / 10; i++) {
+        mock_xbox_monitor_fire_connection_changed(true, NULL);
+        mock_xbox_monitor_fire_game_played(game);
+        mock_xbox_monitor_fire_session_ready();
+
+        monitoring_stop();
+        monitoring_start();
+    }
+
+    set_flag(&g_stop, true);
+    pthread_join(render, NULL);
+
+    free_game(&game);
+
+    //  Assert.
+    achievement_t *achievements = monitoring_copy_current_game_achievements();
+
+    TEST_ASSERT_NULL(achievements);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(monitoring_service__concurrent_monitors_render_and_ui__state_consistent);
+    RUN_TEST(monitoring_stop__render_thread_copying__list_released_safely);
+
+    return UNITY_END();
+}
@@ -45,12 +45,24 @@
  *  23. Xbox session_ready fires without an Xbox game → achievements NOT overwritten
  *  24. Xbox session_ready fires without an Xbox game → session_ready NOT re-fired
  *  25. Xbox session_ready fires with an Xbox game active → session_ready fired normally
+ *
+ *  Warm-start snapshot:
+ *  26. Snapshot restored → identity, game and achievements notified, session ready
+ *  27. No snapshot on disk → nothing notified
+ *  28. Xbox confirms the restored game → achievements swapped without resetting the cycle
+ *  29. Xbox reports another game → restored state replaced through the usual notifications
+ *  30. Xbox reports no game → restored state cleared
+ *  31. Xbox connection fails while warm → restored state kept
+ *  32. Retro no_game while an Xbox snapshot is restored → restored state kept
+ *  33. Xbox session ready → snapshot persisted with the loaded achievements
+ *  34. Xbox game changes before its achievements load → snapshot not persisted
  */
 
 #include "unity.h"
 
 #include "test/stubs/integrations/xbox_monitor_stub.h"
 #include "test/stubs/integrations/retro_achievements_monitor_stub.h"
+#include "test/stubs/io/snapshot_stub.h"
 
 #include "integrations/monitoring_service.h"
 #include "integrations/xbox/entities/xbox_identity.h"
@@ -58,6 +70,7 @@
 #include "common/token.h"
 #include "common/memory.h"
 
+#include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 
@@ -143,6 +156,35 @@ static xbox_achievement_t *make_xbox_achievement(const char *id, const char *nam
     return a;
 }
 
+static achievement_t *make_achievement(const char *id, const char *name, int64_t unlocked_timestamp) {
+    achievement_t *a      = bzalloc(sizeof(achievement_t));
+    a->id                 = bstrdup(id);
+    a->name               = bstrdup(name);
+    a->unlocked_timestamp = unlocked_timestamp;
+    a->source             = ACHIEVEMENT_SOURCE_XBOX;
+    return a;
+}
+
+/* Snapshot of an Xbox session on "game-1" with two locked achievements. */
+static snapshot_t *make_xbox_snapshot(void) {
+    identity_t *identity = bzalloc(sizeof(identity_t));
+    identity->source     = IDENTITY_SOURCE_XBOX;
+    identity->name       = bstrdup("MasterChief");
+    identity->score      = 1200;
+
+    game_t *game    = make_xbox_game("game-1", "Halo Infinite");
+    game->cover_url = bstrdup("https://example.com/cover.png");
+
+    snapshot_t *snapshot             = bzalloc(sizeof(snapshot_t));
+    snapshot->source                 = IDENTITY_SOURCE_XBOX;
+    snapshot->identity               = identity;
+    snapshot->game                   = game;
+    snapshot->achievements           = make_achievement("ach-1", "First Steps", 0);
+    snapshot->achievements->next     = make_achievement("ach-2", "Legend", 0);
+    snapshot->current_achievement_id = bstrdup("ach-2");
+    return snapshot;
+}
+
 /* -------------------------------------------------------------------------
  * Subscriber spies
  * ---------------------------------------------------------------------- */
@@ -175,6 +217,14 @@ static void on_achievements_changed(void) {
     s_achievements_changed_cb_count++;
 }
 
+static int  s_achievement_updated_cb_count = 0;
+static char s_last_achievement_updated_id[64];
+
+static void on_achievement_updated(const achievement_t *achievement) {
+    s_achievement_updated_cb_count++;
+    snprintf(s_last_achievement_updated_id, sizeof(s_last_achievement_updated_id), "%s", achievement->id);
+}
+
 /* -------------------------------------------------------------------------
  * setUp / tearDown
  * ---------------------------------------------------------------------- */
@@ -186,9 +236,12 @@ void setUp(void) {
     s_game_played_cb_count          = 0;
     s_last_game_played              = NULL;
     s_achievements_changed_cb_count = 0;
+    s_achievement_updated_cb_count  = 0;
+    s_last_achievement_updated_id[0] = '\0';
 
     mock_xbox_monitor_reset();
     mock_retro_monitor_reset();
+    mock_snapshot_reset();
 
     monitoring_start();
     monitoring_subscribe_active_identity(on_identity_changed);
@@ -206,6 +259,7 @@ void tearDown(void) {
     monitoring_stop();
     mock_xbox_monitor_reset();
     mock_retro_monitor_reset();
+    mock_snapshot_reset();
 }
 
 /* =========================================================================
@@ -262,6 +316,43 @@ static void monitoring_subscribe_active_identity__xbox_disconnected__null_notifi
     TEST_ASSERT_NULL(s_last_identity);
 }
 
+/* 4b. Xbox disconnects while the monitor retains the session, then resumes the same title
+ *     → the identity, the game and the achievements survive the outage */
+static void monitoring_subscribe_active_identity__xbox_same_title_reconnected__session_kept(void) {
+    mock_xbox_monitor_set_identity(make_xbox_identity("MasterChief"));
+    mock_xbox_monitor_fire_connection_changed(true, NULL);
+    mock_xbox_monitor_set_achievements(make_xbox_achievement("achievement-1", "Stop Hitting Yourself", "NotStarted"));
+
+    game_t *xbox_game = make_xbox_game("game-1", "Halo Infinite");
+    mock_xbox_monitor_fire_game_played(xbox_game);
+    mock_xbox_monitor_fire_session_ready();
+    mock_xbox_monitor_set_session_game(xbox_game);
+
+    s_identity_cb_count      = 0;
+    s_game_played_cb_count   = 0;
+    s_session_ready_cb_count = 0;
+
+    /* The monitor keeps its session: the reconnection resyncs it without any game-played or session-ready */
+    mock_xbox_monitor_fire_connection_changed(false, NULL);
+    const int identity_cb_count_while_disconnected = s_identity_cb_count;
+    mock_xbox_monitor_fire_connection_changed(true, NULL);
+
+    xbox_achievement_progress_t *progress =
+        make_xbox_achievement_progress("achievement-1", "InProgress", "42", "100");
+    mock_xbox_monitor_fire_achievements_progressed(NULL, progress);
+    free_xbox_achievement_progress(&progress);
+
+    TEST_ASSERT_EQUAL_INT(0, identity_cb_count_while_disconnected);
+    TEST_ASSERT_NOT_NULL(s_last_identity);
+    TEST_ASSERT_EQUAL_STRING("MasterChief", s_last_identity->name);
+    TEST_ASSERT_EQUAL_INT(0, s_game_played_cb_count);
+    TEST_ASSERT_EQUAL_INT(0, s_session_ready_cb_count);
+
+    const achievement_t *a = monitoring_get_current_game_achievements();
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_EQUAL_STRING("42/100", a->measured_progress);
+}
+
 /* 5. Xbox disconnects while a retro game is active → retro identity takes over */
 static void
 monitoring_subscribe_active_identity__xbox_disconnected_with_retro_game_active__retro_identity_notified(void) {
@@ -862,6 +953,48 @@ static void monitoring_achievements__xbox_progress_update_achieved__achievements
     TEST_ASSERT_EQUAL_INT(0, s_session_ready_cb_count);
 }
 
+/* 28b. Xbox achievement progressed → achievement_updated subscribers receive the
+ *      updated achievement only. */
+static void monitoring_subscribe_achievement_updated__xbox_progress_update__callback_fired(void) {
+    monitoring_subscribe_achievement_updated(on_achievement_updated);
+
+    mock_xbox_monitor_set_identity(make_xbox_identity("MasterChief"));
+    mock_xbox_monitor_fire_connection_changed(true, NULL);
+
+    mock_xbox_monitor_set_achievements(make_xbox_achievement("achievement-1", "Stop Hitting Yourself", "InProgress"));
+
+    game_t *xbox_game = make_xbox_game("game-1", "Halo Infinite");
+    mock_xbox_monitor_fire_game_played(xbox_game);
+    free_game(&xbox_game);
+
+    mock_xbox_monitor_fire_session_ready();
+
+    xbox_achievement_progress_t *progress = make_xbox_achievement_progress("achievement-1", "InProgress", "3", "10");
+    mock_xbox_monitor_fire_achievements_progressed(NULL, progress);
+    free_xbox_achievement_progress(&progress);
+
+    TEST_ASSERT_EQUAL_INT(1, s_achievement_updated_cb_count);
+    TEST_ASSERT_EQUAL_STRING("achievement-1", s_last_achievement_updated_id);
+}
+
+/* 28c. Game-played callback unsubscribed → it is no longer fired, other
+ *      subscriptions are kept. */
+static void monitoring_unsubscribe_game_played__callback_unsubscribed__not_fired(void) {
+    monitoring_unsubscribe_game_played(on_game_played);
+
+    mock_xbox_monitor_set_identity(make_xbox_identity("MasterChief"));
+    mock_xbox_monitor_fire_connection_changed(true, NULL);
+
+    game_t *xbox_game = make_xbox_game("game-1", "Halo Infinite");
+    mock_xbox_monitor_fire_game_played(xbox_game);
+    free_game(&xbox_game);
+
+    mock_xbox_monitor_fire_session_ready();
+
+    TEST_ASSERT_EQUAL_INT(0, s_game_played_cb_count);
+    TEST_ASSERT_EQUAL_INT(1, s_session_ready_cb_count);
+}
+
 /* 29. Xbox achievement progress update with NULL progress → nothing happens. */
 static void monitoring_achievements__xbox_progress_update_null__no_effect(void) {
     /* Set up Xbox game */
@@ -917,6 +1050,173 @@ static void monitoring_achievements__xbox_progress_update_no_identity__early_ret
  * Test runner
  * ---------------------------------------------------------------------- */
 
+/* =========================================================================
+ * Warm-start snapshot
+ * ====================================================================== */
+
+/* 26. Snapshot restored → identity, game and achievements notified, session ready */
+static void monitoring_restore_snapshot__snapshot_available__state_notified(void) {
+    mock_snapshot_set(make_xbox_snapshot());
+
+    monitoring_restore_snapshot();
+
+    TEST_ASSERT_EQUAL_INT(1, s_identity_cb_count);
+    TEST_ASSERT_NOT_NULL(s_last_identity);
+    TEST_ASSERT_EQUAL_STRING("MasterChief", s_last_identity->name);
+    TEST_ASSERT_EQUAL_UINT(1200, s_last_identity->score);
+    TEST_ASSERT_EQUAL_INT(1, s_game_played_cb_count);
+    TEST_ASSERT_EQUAL_STRING("Halo Infinite", s_last_game_played->title);
+    TEST_ASSERT_EQUAL_INT(1, s_session_ready_cb_count);
+    TEST_ASSERT_EQUAL_INT(2, count_achievements(monitoring_get_current_game_achievements()));
+}
+
+/* 27. No snapshot on disk → nothing notified */
+static void monitoring_restore_snapshot__no_snapshot__nothing_notified(void) {
+    monitoring_restore_snapshot();
+
+    TEST_ASSERT_EQUAL_INT(0, s_identity_cb_count);
+    TEST_ASSERT_EQUAL_INT(0, s_game_played_cb_count);
+    TEST_ASSERT_EQUAL_INT(0, s_session_ready_cb_count);
+    TEST_ASSERT_NULL(monitoring_get_current_game_achievements());
+}
+
+/* 28. Xbox confirms the restored game → the live achievements replace the
+ *     restored ones without game_played / session_ready / achievements_changed */
+static void monitoring_restore_snapshot__xbox_confirms_game__reconciled_silently(void) {
+    mock_snapshot_set(make_xbox_snapshot());
+    monitoring_restore_snapshot();
+
+    mock_xbox_monitor_set_identity(make_xbox_identity("MasterChief"));
+    mock_xbox_monitor_fire_connection_changed(true, NULL);
+
+    s_game_played_cb_count          = 0;
+    s_session_ready_cb_count        = 0;
+    s_achievements_changed_cb_count = 0;
+
+    game_t *game = make_xbox_game("game-1", "Halo Infinite");
+    mock_xbox_monitor_fire_game_played(game);
+    free_game(&game);
+
+    xbox_achievement_t *live = make_xbox_achievement("ach-1", "First Steps (live)", "NotStarted");
+    live->next               = make_xbox_achievement("ach-2", "Legend", "NotStarted");
+    mock_xbox_monitor_set_achievements(live);
+    mock_xbox_monitor_fire_session_ready();
+
+    TEST_ASSERT_EQUAL_INT(0, s_game_played_cb_count);
+    TEST_ASSERT_EQUAL_INT(0, s_session_ready_cb_count);
+    TEST_ASSERT_EQUAL_INT(0, s_achievements_changed_cb_count);
+    TEST_ASSERT_EQUAL_STRING("First Steps (live)", monitoring_get_current_game_achievements()->name);
+}
+
+/* 29. Xbox reports another game → restored state replaced through the usual notifications */
+static void monitoring_restore_snapshot__xbox_reports_other_game__game_played_notified(void) {
+    mock_snapshot_set(make_xbox_snapshot());
+    monitoring_restore_snapshot();
+
+    s_game_played_cb_count   = 0;
+    s_session_ready_cb_count = 0;
+
+    game_t *game = make_xbox_game("game-2", "Forza Horizon");
+    mock_xbox_monitor_fire_game_played(game);
+    free_game(&game);
+
+    mock_xbox_monitor_set_achievements(make_xbox_achievement("fh-1", "Welcome", "NotStarted"));
+    mock_xbox_monitor_fire_session_ready();
+
+    TEST_ASSERT_EQUAL_INT(1, s_game_played_cb_count);
+    TEST_ASSERT_EQUAL_STRING("Forza Horizon", s_last_game_played->title);
+    TEST_ASSERT_EQUAL_INT(1, s_session_ready_cb_count);
+    TEST_ASSERT_EQUAL_STRING("fh-1", monitoring_get_current_game_achievements()->id);
+}
+
+/* 30. Xbox reports no game → restored state cleared */
+static void monitoring_restore_snapshot__xbox_reports_no_game__state_cleared(void) {
+    mock_snapshot_set(make_xbox_snapshot());
+    monitoring_restore_snapshot();
+
+    mock_xbox_monitor_fire_game_played(NULL);
+
+    TEST_ASSERT_NULL(s_last_identity);
+    TEST_ASSERT_NULL(s_last_game_played);
+    TEST_ASSERT_NULL(monitoring_get_current_game_achievements());
+}
+
+/* 31. Xbox connection fails while warm → restored state kept */
+static void monitoring_restore_snapshot__xbox_connection_failed__state_kept(void) {
+    mock_snapshot_set(make_xbox_snapshot());
+    monitoring_restore_snapshot();
+
+    s_identity_cb_count = 0;
+
+    mock_xbox_monitor_fire_connection_changed(false, "Connection error");
+
+    TEST_ASSERT_EQUAL_INT(0, s_identity_cb_count);
+    TEST_ASSERT_NOT_NULL(monitoring_get_current_active_identity());
+    TEST_ASSERT_NOT_NULL(monitoring_get_current_game_achievements());
+}
+
+/* 32. Retro no_game while an Xbox snapshot is restored → restored state kept */
+static void monitoring_restore_snapshot__retro_no_game_with_xbox_snapshot__state_kept(void) {
+    mock_snapshot_set(make_xbox_snapshot());
+    monitoring_restore_snapshot();
+
+    s_game_played_cb_count = 0;
+
+    mock_retro_monitor_fire_no_game();
+
+    TEST_ASSERT_EQUAL_INT(0, s_game_played_cb_count);
+    TEST_ASSERT_NOT_NULL(monitoring_get_current_active_identity());
+    TEST_ASSERT_NOT_NULL(monitoring_get_current_game_achievements());
+}
+
+/* 33. Xbox session ready → snapshot persisted with the loaded achievements */
+static void monitoring_save_snapshot__xbox_session_ready__snapshot_persisted(void) {
+    mock_xbox_monitor_set_identity(make_xbox_identity("MasterChief"));
+    mock_xbox_monitor_fire_connection_changed(true, NULL);
+
+    game_t *game = make_xbox_game("game-1", "Halo Infinite");
+    mock_xbox_monitor_fire_game_played(game);
+    free_game(&game);
+
+    mock_xbox_monitor_set_achievements(make_xbox_achievement("ach-1", "First Steps", "NotStarted"));
+    mock_xbox_monitor_fire_session_ready();
+
+    const snapshot_t *saved = mock_snapshot_get_saved();
+    TEST_ASSERT_NOT_NULL(saved);
+    TEST_ASSERT_EQUAL_INT(IDENTITY_SOURCE_XBOX, saved->source);
+    TEST_ASSERT_EQUAL_STRING("MasterChief", saved->identity->name);
+    TEST_ASSERT_EQUAL_STRING("game-1", saved->game->id);
+    TEST_ASSERT_EQUAL_STRING("ach-1", saved->achievements->id);
+}
+
+/* 34. Xbox game changes before its achievements load → snapshot not persisted */
+static void monitoring_save_snapshot__achievements_loading__snapshot_not_persisted(void) {
+    mock_xbox_monitor_set_identity(make_xbox_identity("MasterChief"));
+    mock_xbox_monitor_fire_connection_changed(true, NULL);
+
+    game_t *game = make_xbox_game("game-1", "Halo Infinite");
+    mock_xbox_monitor_fire_game_played(game);
+    free_game(&game);
+
+    monitoring_save_snapshot();
+
+    TEST_ASSERT_EQUAL_INT(0, mock_snapshot_get_save_count());
+}
+
+/* 35. Snapshot restored → copy of the active identity owned by the caller */
+static void monitoring_copy_current_active_identity__snapshot_restored__copy_returned(void) {
+    mock_snapshot_set(make_xbox_snapshot());
+    monitoring_restore_snapshot();
+
+    identity_t *identity = monitoring_copy_current_active_identity();
+
+    TEST_ASSERT_NOT_NULL(identity);
+    TEST_ASSERT_EQUAL_STRING("MasterChief", identity->name);
+    TEST_ASSERT_TRUE(identity != monitoring_get_current_active_identity());
+
+    free_identity_t(&identity);
+}
+
 int main(void) {
     UNITY_BEGIN();
 
@@ -925,6 +1225,7 @@ int main(void) {
     RUN_TEST(monitoring_subscribe_active_identity__xbox_connected_and_game_played__xbox_identity_notified);
     RUN_TEST(monitoring_subscribe_active_identity__xbox_game_played_before_connect__null_notified);
     RUN_TEST(monitoring_subscribe_active_identity__xbox_disconnected__null_notified);
+    RUN_TEST(monitoring_subscribe_active_identity__xbox_same_title_reconnected__session_kept);
     RUN_TEST(monitoring_subscribe_active_identity__xbox_disconnected_with_retro_game_active__retro_identity_notified);
     RUN_TEST(monitoring_subscribe_active_identity__xbox_no_game__null_notified);
 
@@ -961,8 +1262,22 @@ int main(void) {
     RUN_TEST(monitoring_achievements__xbox_progress_update_non_zero__measured_progress_set);
     RUN_TEST(monitoring_achievements__xbox_progress_update_zero_current__measured_progress_not_set);
     RUN_TEST(monitoring_achievements__xbox_progress_update_achieved__achievements_changed_fired);
+    RUN_TEST(monitoring_subscribe_achievement_updated__xbox_progress_update__callback_fired);
+    RUN_TEST(monitoring_unsubscribe_game_played__callback_unsubscribed__not_fired);
     RUN_TEST(monitoring_achievements__xbox_progress_update_null__no_effect);
     RUN_TEST(monitoring_achievements__xbox_progress_update_no_identity__early_return);
 
+    /* Warm-start snapshot */
+    RUN_TEST(monitoring_restore_snapshot__snapshot_available__state_notified);
+    RUN_TEST(monitoring_restore_snapshot__no_snapshot__nothing_notified);
+    RUN_TEST(monitoring_restore_snapshot__xbox_confirms_game__reconciled_silently);
+    RUN_TEST(monitoring_restore_snapshot__xbox_reports_other_game__game_played_notified);
+    RUN_TEST(monitoring_restore_snapshot__xbox_reports_no_game__state_cleared);
+    RUN_TEST(monitoring_restore_snapshot__xbox_connection_failed__state_kept);
+    RUN_TEST(monitoring_restore_snapshot__retro_no_game_with_xbox_snapshot__state_kept);
+    RUN_TEST(monitoring_save_snapshot__xbox_session_ready__snapshot_persisted);
+    RUN_TEST(monitoring_save_snapshot__achievements_loading__snapshot_not_persisted);
+    RUN_TEST(monitoring_copy_current_active_identity__snapshot_restored__copy_returned);
+
     return UNITY_END();
 }
@@ -1,6 +1,7 @@
 #include "unity.h"
 
 #include "text/parsers.h"
+#include "util/arena.h"
 
 #include <string.h>
 
@@ -301,7 +302,76 @@ static void parse_achievements__message_is_multiple_achievements_achievements_re
     TEST_ASSERT_EQUAL_INT(4, achievements_count);
 }
 
+//  Test parse_device_code_poll_error
+
+static void parse_device_code_poll_error__message_is_null_unknown_returned(void) {
+    //  Act.
+    device_code_poll_error_t actual = parse_device_code_poll_error(NULL);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(DEVICE_CODE_POLL_ERROR_UNKNOWN, actual);
+}
+
+static void parse_device_code_poll_error__message_is_not_json_unknown_returned(void) {
+    //  Arrange.
+    const char *message = "<html>Service Unavailable</html>";
+
+    //  Act.
+    device_code_poll_error_t actual = parse_device_code_poll_error(message);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(DEVICE_CODE_POLL_ERROR_UNKNOWN, actual);
+}
+
+static void parse_device_code_poll_error__message_is_pending_authorization_pending_returned(void) {
+    //  Arrange.
+    const char *message =
+        "{\"error\":\"authorization_pending\",\"error_description\":\"The user has not yet completed authorization\"}";
+
+    //  Act.
+    device_code_poll_error_t actual = parse_device_code_poll_error(message);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(DEVICE_CODE_POLL_ERROR_AUTHORIZATION_PENDING, actual);
+}
+
+static void parse_device_code_poll_error__message_is_slow_down_slow_down_returned(void) {
+    //  Arrange.
+    const char *message = "{\"error\":\"slow_down\"}";
+
+    //  Act.
+    device_code_poll_error_t actual = parse_device_code_poll_error(message);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(DEVICE_CODE_POLL_ERROR_SLOW_DOWN, actual);
+}
+
+static void parse_device_code_poll_error__message_is_expired_token_expired_token_returned(void) {
+    //  Arrange.
+    const char *message = "{\"error\":\"expired_token\"}";
+
+    //  Act.
+    device_code_poll_error_t actual = parse_device_code_poll_error(message);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(DEVICE_CODE_POLL_ERROR_EXPIRED_TOKEN, actual);
+}
+
+static void parse_device_code_poll_error__message_is_unexpected_error_other_returned(void) {
+    //  Arrange.
+    const char *message = "{\"error\":\"invalid_grant\"}";
+
+    //  Act.
+    device_code_poll_error_t actual = parse_device_code_poll_error(message);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(DEVICE_CODE_POLL_ERROR_OTHER, actual);
+}
+
 int main(void) {
+    /* Same configuration as the plugin: the cJSON trees are built in scratch arenas */
+    arena_install_json_hooks();
+
     UNITY_BEGIN();
     //  Test is_presence_message
     RUN_TEST(is_presence_message__message_is_null_false_returned);
@@ -330,5 +400,12 @@ int main(void) {
     //  Test parse_achievements
     RUN_TEST(parse_achievements__message_is_one_achievement_achievement_returned);
     RUN_TEST(parse_achievements__message_is_multiple_achievements_achievements_returned);
+    //  Test parse_device_code_poll_error
+    RUN_TEST(parse_device_code_poll_error__message_is_null_unknown_returned);
+    RUN_TEST(parse_device_code_poll_error__message_is_not_json_unknown_returned);
+    RUN_TEST(parse_device_code_poll_error__message_is_pending_authorization_pending_returned);
+    RUN_TEST(parse_device_code_poll_error__message_is_slow_down_slow_down_returned);
+    RUN_TEST(parse_device_code_poll_error__message_is_expired_token_expired_token_returned);
+    RUN_TEST(parse_device_code_poll_error__message_is_unexpected_error_other_returned);
     return UNITY_END();
 }
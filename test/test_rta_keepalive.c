@@ -0,0 +1,137 @@
+/**
+ * @file test_rta_keepalive.c
+ * @brief Unit tests for rta_keepalive.c — adaptive ping pacing and reconnection delays.
+ */
+
+#include "unity.h"
+
+#include "integrations/xbox/rta_keepalive.h"
+
+#define SECOND_NS 1000000000ULL
+
+static rta_keepalive_t keepalive;
+
+void setUp(void) {
+    const rta_connection_configuration_t configuration = {
+        .ping_interval       = 10,
+        .max_ping_interval   = 40,
+        .pong_timeout        = 8,
+        .compression_enabled = true,
+    };
+
+    rta_keepalive_reset(&keepalive, &configuration, 100 * SECOND_NS);
+}
+
+void tearDown(void) {}
+
+/* -------------------------------------------------------------------------
+ * Tests
+ * ---------------------------------------------------------------------- */
+
+void rta_keepalive_is_ping_due__traffic_received__ping_postponed(void) {
+    //  Arrange.
+    rta_keepalive_on_activity(&keepalive, 105 * SECOND_NS);
+
+    //  Act.
+    const bool due_before = rta_keepalive_is_ping_due(&keepalive, 112 * SECOND_NS);
+    const bool due_after  = rta_keepalive_is_ping_due(&keepalive, 115 * SECOND_NS);
+
+    //  Assert.
+    TEST_ASSERT_FALSE(due_before);
+    TEST_ASSERT_TRUE(due_after);
+}
+
+void rta_keepalive_on_pong__fast_pongs__interval_doubled_up_to_max(void) {
+    //  Arrange.
+    uint64_t now_ns = 110 * SECOND_NS;
+
+    //  Act.
+    for (int i = 0; i < 4; i++) {
+        rta_keepalive_on_ping_sent(&keepalive, now_ns);
+        now_ns += SECOND_NS / 10;
+        rta_keepalive_on_pong(&keepalive, now_ns);
+    }
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_UINT64(40 * SECOND_NS, keepalive.interval_ns);
+    TEST_ASSERT_FALSE(rta_keepalive_is_ping_due(&keepalive, now_ns + 39 * SECOND_NS));
+    TEST_ASSERT_TRUE(rta_keepalive_is_ping_due(&keepalive, now_ns + 40 * SECOND_NS));
+}
+
+void rta_keepalive_on_pong__slow_pong__interval_back_to_base(void) {
+    //  Arrange.
+    rta_keepalive_on_ping_sent(&keepalive, 110 * SECOND_NS);
+    rta_keepalive_on_pong(&keepalive, 110 * SECOND_NS + SECOND_NS / 10);
+    rta_keepalive_on_ping_sent(&keepalive, 130 * SECOND_NS);
+
+    //  Act.
+    const int64_t round_trip_ms = rta_keepalive_on_pong(&keepalive, 135 * SECOND_NS);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(5000, (int)round_trip_ms);
+    TEST_ASSERT_EQUAL_UINT64(10 * SECOND_NS, keepalive.interval_ns);
+}
+
+void rta_keepalive_on_pong__no_ping_in_flight__minus_one_returned(void) {
+    //  Act.
+    const int64_t round_trip_ms = rta_keepalive_on_pong(&keepalive, 110 * SECOND_NS);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(-1, (int)round_trip_ms);
+}
+
+void rta_keepalive_is_dead__pong_timeout_elapsed__true_returned(void) {
+    //  Arrange.
+    rta_keepalive_on_ping_sent(&keepalive, 110 * SECOND_NS);
+
+    //  Act & Assert.
+    TEST_ASSERT_FALSE(rta_keepalive_is_dead(&keepalive, 117 * SECOND_NS));
+    TEST_ASSERT_TRUE(rta_keepalive_is_dead(&keepalive, 118 * SECOND_NS));
+    TEST_ASSERT_FALSE(rta_keepalive_is_ping_due(&keepalive, 130 * SECOND_NS));
+}
+
+void rta_keepalive_is_dead__traffic_after_ping__false_returned(void) {
+    //  Arrange.
+    rta_keepalive_on_ping_sent(&keepalive, 110 * SECOND_NS);
+    rta_keepalive_on_activity(&keepalive, 111 * SECOND_NS);
+
+    //  Act.
+    const bool dead = rta_keepalive_is_dead(&keepalive, 130 * SECOND_NS);
+
+    //  Assert.
+    TEST_ASSERT_FALSE(dead);
+}
+
+void rta_reconnect_delay_with_jitter__any_random__within_25_percent(void) {
+    //  Act.
+    const int lowest  = rta_reconnect_delay_with_jitter(4000, 0);
+    const int highest = rta_reconnect_delay_with_jitter(4000, 2000);
+    const int wrapped = rta_reconnect_delay_with_jitter(4000, 2001);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(3000, lowest);
+    TEST_ASSERT_EQUAL_INT(5000, highest);
+    TEST_ASSERT_EQUAL_INT(3000, wrapped);
+}
+
+void rta_reconnect_next_delay__near_max__capped(void) {
+    //  Act & Assert.
+    TEST_ASSERT_EQUAL_INT(2000, rta_reconnect_next_delay(1000, 60000));
+    TEST_ASSERT_EQUAL_INT(60000, rta_reconnect_next_delay(32000, 60000));
+    TEST_ASSERT_EQUAL_INT(60000, rta_reconnect_next_delay(60000, 60000));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(rta_keepalive_is_ping_due__traffic_received__ping_postponed);
+    RUN_TEST(rta_keepalive_on_pong__fast_pongs__interval_doubled_up_to_max);
+    RUN_TEST(rta_keepalive_on_pong__slow_pong__interval_back_to_base);
+    RUN_TEST(rta_keepalive_on_pong__no_ping_in_flight__minus_one_returned);
+    RUN_TEST(rta_keepalive_is_dead__pong_timeout_elapsed__true_returned);
+    RUN_TEST(rta_keepalive_is_dead__traffic_after_ping__false_returned);
+    RUN_TEST(rta_reconnect_delay_with_jitter__any_random__within_25_percent);
+    RUN_TEST(rta_reconnect_next_delay__near_max__capped);
+
+    return UNITY_END();
+}
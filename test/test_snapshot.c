@@ -0,0 +1,262 @@
+/**
+ * @file test_snapshot.c
+ * @brief Unit tests for snapshot.c — warm-start snapshot encoding and persistence.
+ *
+ * obs_module_config_path() is implemented below so that snapshot files land in
+ * the test's working directory.
+ */
+
+#include "unity.h"
+
+#include "io/snapshot.h"
+#include "common/memory.h"
+
+#include <stdio.h>
+#include <string.h>
+
+char *obs_module_config_path(const char *file) {
+    char path[256];
+    snprintf(path, sizeof(path), "test_snapshot_%s", file);
+    return bstrdup(path);
+}
+
+/* -------------------------------------------------------------------------
+ * Helpers
+ * ---------------------------------------------------------------------- */
+
+static achievement_t *make_achievement(const char *id, const char *name, int64_t unlocked_timestamp) {
+    achievement_t *a      = bzalloc(sizeof(achievement_t));
+    a->id                 = bstrdup(id);
+    a->name               = bstrdup(name);
+    a->description        = bstrdup("Description");
+    a->icon_url           = bstrdup("https://example.com/icon.png");
+    a->value              = 50;
+    a->unlocked_timestamp = unlocked_timestamp;
+    a->source             = ACHIEVEMENT_SOURCE_RETRO;
+    return a;
+}
+
+static snapshot_t *make_snapshot(void) {
+    identity_t *identity = bzalloc(sizeof(identity_t));
+    identity->source     = IDENTITY_SOURCE_RETRO;
+    identity->name       = bstrdup("Samus");
+    identity->avatar_url = bstrdup("https://example.com/avatar.png");
+    identity->score      = 4242;
+
+    game_t *game       = bzalloc(sizeof(game_t));
+    game->id           = bstrdup("1234");
+    game->title        = bstrdup("Super Metroid");
+    game->console_name = bstrdup("SNES");
+    game->cover_url    = NULL;
+
+    achievement_t *achievements             = make_achievement("1", "Morph Ball", 1700000000LL);
+    achievements->next                      = make_achievement("2", "Screw Attack", 0);
+    achievements->next->measured_progress   = bstrdup("3/5");
+    achievements->next->is_secret           = true;
+
+    snapshot_t *snapshot             = bzalloc(sizeof(snapshot_t));
+    snapshot->source                 = IDENTITY_SOURCE_RETRO;
+    snapshot->identity               = identity;
+    snapshot->game                   = game;
+    snapshot->achievements           = achievements;
+    snapshot->current_achievement_id = bstrdup("2");
+    return snapshot;
+}
+
+void setUp(void) {
+    snapshot_delete();
+}
+
+void tearDown(void) {
+    snapshot_delete();
+}
+
+/* -------------------------------------------------------------------------
+ * Encoding
+ * ---------------------------------------------------------------------- */
+
+static void snapshot_decode__encoded_snapshot__all_fields_restored(void) {
+    //  Arrange.
+    snapshot_t *snapshot = make_snapshot();
+    size_t      size     = 0;
+    uint8_t    *data     = snapshot_encode(snapshot, &size);
+
+    //  Act.
+    snapshot_t *decoded = snapshot_decode(data, size);
+
+    //  Assert.
+    TEST_ASSERT_NOT_NULL(decoded);
+    TEST_ASSERT_EQUAL_INT(IDENTITY_SOURCE_RETRO, decoded->source);
+    TEST_ASSERT_EQUAL_INT(IDENTITY_SOURCE_RETRO, decoded->identity->source);
+    TEST_ASSERT_EQUAL_STRING("Samus", decoded->identity->name);
+    TEST_ASSERT_EQUAL_STRING("https://example.com/avatar.png", decoded->identity->avatar_url);
+    TEST_ASSERT_EQUAL_UINT(4242, decoded->identity->score);
+    TEST_ASSERT_EQUAL_STRING("1234", decoded->game->id);
+    TEST_ASSERT_EQUAL_STRING("Super Metroid", decoded->game->title);
+    TEST_ASSERT_EQUAL_STRING("SNES", decoded->game->console_name);
+    TEST_ASSERT_NULL(decoded->game->cover_url);
+    TEST_ASSERT_EQUAL_STRING("2", decoded->current_achievement_id);
+
+    const achievement_t *first = decoded->achievements;
+    TEST_ASSERT_EQUAL_STRING("Morph Ball", first->name);
+    TEST_ASSERT_TRUE(first->unlocked_timestamp == 1700000000LL);
+    TEST_ASSERT_NULL(first->measured_progress);
+    TEST_ASSERT_FALSE(first->is_secret);
+    TEST_ASSERT_EQUAL_INT(50, first->value);
+    TEST_ASSERT_EQUAL_INT(ACHIEVEMENT_SOURCE_RETRO, first->source);
+
+    const achievement_t *second = first->next;
+    TEST_ASSERT_EQUAL_STRING("Screw Attack", second->name);
+    TEST_ASSERT_EQUAL_STRING("3/5", second->measured_progress);
+    TEST_ASSERT_TRUE(second->is_secret);
+    TEST_ASSERT_NULL(second->next);
+
+    free_snapshot(&decoded);
+    free_snapshot(&snapshot);
+    bfree(data);
+}
+
+static void snapshot_decode__empty_snapshot__no_fields_restored(void) {
+    //  Arrange.
+    snapshot_t snapshot = {0};
+    size_t     size     = 0;
+    uint8_t   *data     = snapshot_encode(&snapshot, &size);
+
+    //  Act.
+    snapshot_t *decoded = snapshot_decode(data, size);
+
+    //  Assert.
+    TEST_ASSERT_NOT_NULL(decoded);
+    TEST_ASSERT_NULL(decoded->identity);
+    TEST_ASSERT_NULL(decoded->game);
+    TEST_ASSERT_NULL(decoded->achievements);
+    TEST_ASSERT_NULL(decoded->current_achievement_id);
+
+    free_snapshot(&decoded);
+    bfree(data);
+}
+
+static void snapshot_decode__truncated_data__null_returned(void) {
+    //  Arrange.
+    snapshot_t *snapshot = make_snapshot();
+    size_t      size     = 0;
+    uint8_t    *data     = snapshot_encode(snapshot, &size);
+
+    //  Act / Assert.
+    for (size_t length = 0; length < size; length++) {
+        TEST_ASSERT_NULL(snapshot_decode(data, length));
+    }
+
+    free_snapshot(&snapshot);
+    bfree(data);
+}
+
+static void snapshot_decode__corrupted_byte__null_returned(void) {
+    //  Arrange.
+    snapshot_t *snapshot = make_snapshot();
+    size_t      size     = 0;
+    uint8_t    *data     = snapshot_encode(snapshot, &size);
+
+    data[size / 2] ^= 0x5A;
+
+    //  Act.
+    snapshot_t *decoded = snapshot_decode(data, size);
+
+    //  Assert.
+    TEST_ASSERT_NULL(decoded);
+
+    free_snapshot(&snapshot);
+    bfree(data);
+}
+
+static void snapshot_decode__foreign_data__null_returned(void) {
+    //  Arrange.
+    const char *json = "{\"identity\":\"not a snapshot at all\"}";
+
+    //  Act.
+    snapshot_t *decoded = snapshot_decode((const uint8_t *)json, strlen(json));
+
+    //  Assert.
+    TEST_ASSERT_NULL(decoded);
+}
+
+/* -------------------------------------------------------------------------
+ * Persistence
+ * ---------------------------------------------------------------------- */
+
+static void snapshot_load__saved_snapshot__snapshot_returned(void) {
+    //  Arrange.
+    snapshot_t *snapshot = make_snapshot();
+    TEST_ASSERT_TRUE(snapshot_save(snapshot));
+
+    //  Act.
+    snapshot_t *loaded = snapshot_load();
+
+    //  Assert.
+    TEST_ASSERT_NOT_NULL(loaded);
+    TEST_ASSERT_EQUAL_STRING("Super Metroid", loaded->game->title);
+    TEST_ASSERT_EQUAL_INT(2, count_achievements(loaded->achievements));
+
+    free_snapshot(&loaded);
+    free_snapshot(&snapshot);
+}
+
+static void snapshot_load__snapshot_saved_twice__latest_returned(void) {
+    //  Arrange.
+    snapshot_t *snapshot = make_snapshot();
+    TEST_ASSERT_TRUE(snapshot_save(snapshot));
+
+    free_memory((void **)&snapshot->current_achievement_id);
+    snapshot->current_achievement_id = bstrdup("1");
+    TEST_ASSERT_TRUE(snapshot_save(snapshot));
+
+    //  Act.
+    snapshot_t *loaded = snapshot_load();
+
+    //  Assert.
+    TEST_ASSERT_NOT_NULL(loaded);
+    TEST_ASSERT_EQUAL_STRING("1", loaded->current_achievement_id);
+
+    free_snapshot(&loaded);
+    free_snapshot(&snapshot);
+}
+
+static void snapshot_load__no_snapshot__null_returned(void) {
+    //  Act.
+    snapshot_t *loaded = snapshot_load();
+
+    //  Assert.
+    TEST_ASSERT_NULL(loaded);
+}
+
+static void snapshot_load__deleted_snapshot__null_returned(void) {
+    //  Arrange.
+    snapshot_t *snapshot = make_snapshot();
+    TEST_ASSERT_TRUE(snapshot_save(snapshot));
+
+    //  Act.
+    snapshot_delete();
+    snapshot_t *loaded = snapshot_load();
+
+    //  Assert.
+    TEST_ASSERT_NULL(loaded);
+
+    free_snapshot(&snapshot);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(snapshot_decode__encoded_snapshot__all_fields_restored);
+    RUN_TEST(snapshot_decode__empty_snapshot__no_fields_restored);
+    RUN_TEST(snapshot_decode__truncated_data__null_returned);
+    RUN_TEST(snapshot_decode__corrupted_byte__null_returned);
+    RUN_TEST(snapshot_decode__foreign_data__null_returned);
+
+    RUN_TEST(snapshot_load__saved_snapshot__snapshot_returned);
+    RUN_TEST(snapshot_load__snapshot_saved_twice__latest_returned);
+    RUN_TEST(snapshot_load__no_snapshot__null_returned);
+    RUN_TEST(snapshot_load__deleted_snapshot__null_returned);
+
+    return UNITY_END();
+}
@@ -0,0 +1,117 @@
+/**
+ * @file test_source_activity.c
+ * @brief Unit tests for source_activity.c — visibility counting and transitions.
+ */
+
+#include "unity.h"
+
+#include "sources/common/source_activity.h"
+
+static int  notification_count;
+static bool last_visible;
+
+static void on_changed(bool visible) {
+    notification_count++;
+    last_visible = visible;
+}
+
+void setUp(void) {
+    notification_count = 0;
+    last_visible       = false;
+    source_activity_subscribe(&on_changed);
+}
+
+void tearDown(void) {
+    source_activity_unsubscribe(&on_changed);
+
+    while (source_activity_is_visible()) {
+        source_activity_hide(NULL);
+        source_activity_deactivate(NULL);
+    }
+}
+
+/* -------------------------------------------------------------------------
+ * Tests
+ * ---------------------------------------------------------------------- */
+
+void source_activity_is_visible__nothing_shown__false_returned(void) {
+    //  Act & Assert.
+    TEST_ASSERT_FALSE(source_activity_is_visible());
+    TEST_ASSERT_FALSE(source_activity_is_active());
+}
+
+void source_activity_show__first_source__visible_notified_once(void) {
+    //  Act.
+    source_activity_show(NULL);
+    source_activity_show(NULL);
+
+    //  Assert.
+    TEST_ASSERT_TRUE(source_activity_is_visible());
+    TEST_ASSERT_EQUAL_INT(1, notification_count);
+    TEST_ASSERT_TRUE(last_visible);
+}
+
+void source_activity_hide__one_of_two_sources__still_visible(void) {
+    //  Arrange.
+    source_activity_show(NULL);
+    source_activity_show(NULL);
+
+    //  Act.
+    source_activity_hide(NULL);
+
+    //  Assert.
+    TEST_ASSERT_TRUE(source_activity_is_visible());
+    TEST_ASSERT_EQUAL_INT(1, notification_count);
+}
+
+void source_activity_hide__last_source__hidden_notified(void) {
+    //  Arrange.
+    source_activity_show(NULL);
+
+    //  Act.
+    source_activity_hide(NULL);
+
+    //  Assert.
+    TEST_ASSERT_FALSE(source_activity_is_visible());
+    TEST_ASSERT_EQUAL_INT(2, notification_count);
+    TEST_ASSERT_FALSE(last_visible);
+}
+
+void source_activity_deactivate__source_still_shown__still_visible(void) {
+    //  Arrange.
+    source_activity_show(NULL);
+    source_activity_activate(NULL);
+
+    //  Act.
+    source_activity_deactivate(NULL);
+
+    //  Assert.
+    TEST_ASSERT_TRUE(source_activity_is_visible());
+    TEST_ASSERT_FALSE(source_activity_is_active());
+    TEST_ASSERT_EQUAL_INT(1, notification_count);
+}
+
+void source_activity_hide__unpaired_call__counter_not_negative(void) {
+    //  Arrange.
+    source_activity_hide(NULL);
+
+    //  Act.
+    source_activity_show(NULL);
+
+    //  Assert.
+    TEST_ASSERT_TRUE(source_activity_is_visible());
+    TEST_ASSERT_EQUAL_INT(1, notification_count);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(source_activity_is_visible__nothing_shown__false_returned);
+    RUN_TEST(source_activity_show__first_source__visible_notified_once);
+    RUN_TEST(source_activity_hide__one_of_two_sources__still_visible);
+    RUN_TEST(source_activity_hide__last_source__hidden_notified);
+    RUN_TEST(source_activity_deactivate__source_still_shown__still_visible);
+    RUN_TEST(source_activity_hide__unpaired_call__counter_not_negative);
+
+    return UNITY_END();
+}
@@ -1,6 +1,7 @@
 #include "unity.h"
 
 #include "common/types.h"
+#include "common/intern.h"
 
 #include "test/stubs/time/time_stub.h"
 
@@ -353,14 +354,9 @@ static void copy_gamerscore__no_unlocked_achievements__base_value_returned(void)
 
 static void copy_gamerscore__one_unlocked_achievement__total_returned(void) {
     //  Arrange.
-    xbox_unlocked_achievement_t *unlocked_achievement = bzalloc(sizeof(xbox_unlocked_achievement_t));
-    unlocked_achievement->id                          = bstrdup("achievement-id");
-    unlocked_achievement->value                       = 200;
-    unlocked_achievement->next                        = NULL;
-
-    gamerscore_t *gamerscore          = bzalloc(sizeof(gamerscore_t));
-    gamerscore->base_value            = 400;
-    gamerscore->unlocked_achievements = unlocked_achievement;
+    gamerscore_t *gamerscore = bzalloc(sizeof(gamerscore_t));
+    gamerscore->base_value   = 400;
+    gamerscore_add_unlocked_achievement(gamerscore, "achievement-id", 200);
 
     //  Act.
     int result = gamerscore_compute(gamerscore);
@@ -371,19 +367,10 @@ static void copy_gamerscore__one_unlocked_achievement__total_returned(void) {
 
 static void copy_gamerscore__two_unlocked_achievements__total_returned(void) {
     //  Arrange.
-    xbox_unlocked_achievement_t *unlocked_achievement_2 = bzalloc(sizeof(xbox_unlocked_achievement_t));
-    unlocked_achievement_2->id                          = bstrdup("achievement-id-2");
-    unlocked_achievement_2->value                       = 200;
-    unlocked_achievement_2->next                        = NULL;
-
-    xbox_unlocked_achievement_t *unlocked_achievement_1 = bzalloc(sizeof(xbox_unlocked_achievement_t));
-    unlocked_achievement_1->id                          = bstrdup("achievement-id-1");
-    unlocked_achievement_1->value                       = 100;
-    unlocked_achievement_1->next                        = unlocked_achievement_2;
-
-    gamerscore_t *gamerscore          = bzalloc(sizeof(gamerscore_t));
-    gamerscore->base_value            = 400;
-    gamerscore->unlocked_achievements = unlocked_achievement_1;
+    gamerscore_t *gamerscore = bzalloc(sizeof(gamerscore_t));
+    gamerscore->base_value   = 400;
+    gamerscore_add_unlocked_achievement(gamerscore, "achievement-id-1", 100);
+    gamerscore_add_unlocked_achievement(gamerscore, "achievement-id-2", 200);
 
     //  Act.
     int result = gamerscore_compute(gamerscore);
@@ -392,6 +379,101 @@ static void copy_gamerscore__two_unlocked_achievements__total_returned(void) {
     TEST_ASSERT_EQUAL_INT(result, 700);
 }
 
+static void copy_gamerscore__unlocked_achievements_added__total_and_tail_copied(void) {
+    //  Arrange.
+    gamerscore_t *gamerscore = bzalloc(sizeof(gamerscore_t));
+    gamerscore->base_value   = 400;
+    gamerscore_add_unlocked_achievement(gamerscore, "achievement-id-1", 100);
+    gamerscore_add_unlocked_achievement(gamerscore, "achievement-id-2", 200);
+
+    //  Act.
+    gamerscore_t *copy = copy_gamerscore(gamerscore);
+    gamerscore_add_unlocked_achievement(copy, "achievement-id-3", 50);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(750, gamerscore_compute(copy));
+    TEST_ASSERT_EQUAL_INT(700, gamerscore_compute(gamerscore));
+    TEST_ASSERT_EQUAL_STRING("achievement-id-3", copy->unlocked_achievements->next->next->id);
+    TEST_ASSERT_EQUAL_PTR(copy->unlocked_achievements->next->next, copy->unlocked_achievements_tail);
+
+    free_gamerscore(&gamerscore);
+    free_gamerscore(&copy);
+}
+
+static void gamerscore_add_unlocked_achievement__first_achievement__head_and_tail_set(void) {
+    //  Arrange.
+    gamerscore_t *gamerscore = bzalloc(sizeof(gamerscore_t));
+
+    //  Act.
+    bool added = gamerscore_add_unlocked_achievement(gamerscore, "achievement-id", 20);
+
+    //  Assert.
+    TEST_ASSERT_TRUE(added);
+    TEST_ASSERT_NOT_NULL(gamerscore->unlocked_achievements);
+    TEST_ASSERT_EQUAL_PTR(gamerscore->unlocked_achievements, gamerscore->unlocked_achievements_tail);
+    TEST_ASSERT_EQUAL_STRING("achievement-id", gamerscore->unlocked_achievements->id);
+    TEST_ASSERT_EQUAL_INT(20, gamerscore->unlocked_value);
+
+    free_gamerscore(&gamerscore);
+}
+
+static void gamerscore_add_unlocked_achievement__duplicate_id__counted_once(void) {
+    //  Arrange.
+    gamerscore_t *gamerscore = bzalloc(sizeof(gamerscore_t));
+    gamerscore->base_value   = 400;
+    gamerscore_add_unlocked_achievement(gamerscore, "achievement-id", 100);
+
+    //  Act.
+    bool added = gamerscore_add_unlocked_achievement(gamerscore, "achievement-id", 100);
+
+    //  Assert.
+    TEST_ASSERT_FALSE(added);
+    TEST_ASSERT_EQUAL_INT(500, gamerscore_compute(gamerscore));
+    TEST_ASSERT_NULL(gamerscore->unlocked_achievements->next);
+
+    free_gamerscore(&gamerscore);
+}
+
+static void gamerscore_add_unlocked_achievement__index_grown__duplicates_still_found(void) {
+    //  Arrange.
+    gamerscore_t *gamerscore = bzalloc(sizeof(gamerscore_t));
+    char          id[32];
+
+    for (int i = 0; i < 100; i++) {
+        snprintf(id, sizeof(id), "achievement-%d", i);
+        gamerscore_add_unlocked_achievement(gamerscore, id, 10);
+    }
+
+    gamerscore_t *copy = copy_gamerscore(gamerscore);
+
+    //  Act.
+    bool added       = gamerscore_add_unlocked_achievement(gamerscore, "achievement-42", 10);
+    bool added_copy  = gamerscore_add_unlocked_achievement(copy, "achievement-99", 10);
+    bool added_fresh = gamerscore_add_unlocked_achievement(gamerscore, "achievement-100", 10);
+
+    //  Assert.
+    TEST_ASSERT_FALSE(added);
+    TEST_ASSERT_FALSE(added_copy);
+    TEST_ASSERT_TRUE(added_fresh);
+    TEST_ASSERT_EQUAL_INT(1010, gamerscore_compute(gamerscore));
+    TEST_ASSERT_EQUAL_INT(1000, gamerscore_compute(copy));
+
+    free_gamerscore(&copy);
+    free_gamerscore(&gamerscore);
+}
+
+static void gamerscore_add_unlocked_achievement__null_arguments__false_returned(void) {
+    //  Arrange.
+    gamerscore_t *gamerscore = bzalloc(sizeof(gamerscore_t));
+
+    //  Act & Assert.
+    TEST_ASSERT_FALSE(gamerscore_add_unlocked_achievement(NULL, "achievement-id", 100));
+    TEST_ASSERT_FALSE(gamerscore_add_unlocked_achievement(gamerscore, NULL, 100));
+    TEST_ASSERT_EQUAL_INT(0, gamerscore_compute(gamerscore));
+
+    free_gamerscore(&gamerscore);
+}
+
 //  Tests unlocked_achievement.c
 
 static void xbox_free_unlocked_achievement__unlocked_achievement_is_null__null_unlocked_achievement_returned(void) {
@@ -1325,6 +1407,89 @@ static void get_random_locked_achievement__multiple_calls__returns_locked_achiev
     }
 }
 
+//  Tests get_achievement_progress
+
+static void get_achievement_progress__achievement_is_null__negative_returned(void) {
+    //  Act.
+    const float progress = get_achievement_progress(NULL);
+
+    //  Assert.
+    TEST_ASSERT_TRUE(progress < 0.0f);
+}
+
+static void get_achievement_progress__unlocked__one_returned(void) {
+    //  Arrange.
+    achievement_t achievement      = {0};
+    achievement.unlocked_timestamp = 1700000000;
+    achievement.measured_progress  = "3/10";
+
+    //  Act.
+    const float progress = get_achievement_progress(&achievement);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(1000, (int)(progress * 1000.0f));
+}
+
+static void get_achievement_progress__locked_not_measured__negative_returned(void) {
+    //  Arrange.
+    achievement_t achievement = {0};
+
+    //  Act.
+    const float progress = get_achievement_progress(&achievement);
+
+    //  Assert.
+    TEST_ASSERT_TRUE(progress < 0.0f);
+}
+
+static void get_achievement_progress__fraction__ratio_returned(void) {
+    //  Arrange.
+    achievement_t achievement     = {0};
+    achievement.measured_progress = "5/20";
+
+    //  Act.
+    const float progress = get_achievement_progress(&achievement);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(250, (int)(progress * 1000.0f + 0.5f));
+}
+
+static void get_achievement_progress__percentage__ratio_returned(void) {
+    //  Arrange.
+    achievement_t achievement     = {0};
+    achievement.measured_progress = "40%";
+
+    //  Act.
+    const float progress = get_achievement_progress(&achievement);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(400, (int)(progress * 1000.0f + 0.5f));
+}
+
+static void get_achievement_progress__invalid_or_zero_target__negative_returned(void) {
+    //  Arrange.
+    achievement_t text     = {0};
+    text.measured_progress = "in progress";
+
+    achievement_t zero_target     = {0};
+    zero_target.measured_progress = "3/0";
+
+    //  Act & Assert.
+    TEST_ASSERT_TRUE(get_achievement_progress(&text) < 0.0f);
+    TEST_ASSERT_TRUE(get_achievement_progress(&zero_target) < 0.0f);
+}
+
+static void get_achievement_progress__above_target__clamped_to_one(void) {
+    //  Arrange.
+    achievement_t achievement     = {0};
+    achievement.measured_progress = "12/10";
+
+    //  Act.
+    const float progress = get_achievement_progress(&achievement);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(1000, (int)(progress * 1000.0f));
+}
+
 //  Tests achievement_progress.c
 
 static void xbox_free_achievement_progress__achievement_progress_is_null__null_achievement_progress_returned(void) {
@@ -1433,6 +1598,114 @@ static void xbox_copy_achievement_progress__two_achievement_progresses__copy_ret
     TEST_ASSERT_NULL(copy->next->next);
 }
 
+//  Tests intern.c
+
+static void intern_string__same_text_twice__same_pointer_returned(void) {
+    //  Arrange.
+    char *first = intern_string("Halo Infinite");
+
+    //  Act.
+    char *second = intern_string("Halo Infinite");
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_PTR(first, second);
+
+    intern_release(&first);
+    intern_release(&second);
+}
+
+static void intern_string__null_text__null_returned(void) {
+    //  Act.
+    char *interned = intern_string(NULL);
+
+    //  Assert.
+    TEST_ASSERT_NULL(interned);
+}
+
+static void intern_release__last_reference__string_removed_from_pool(void) {
+    //  Arrange.
+    const size_t count  = intern_count();
+    char        *first  = intern_string("intern-release-last-reference");
+    char        *second = intern_string("intern-release-last-reference");
+
+    //  Act.
+    intern_release(&first);
+    const size_t count_after_first = intern_count();
+    intern_release(&second);
+
+    //  Assert.
+    TEST_ASSERT_NULL(first);
+    TEST_ASSERT_NULL(second);
+    TEST_ASSERT_EQUAL_INT((int)count + 1, (int)count_after_first);
+    TEST_ASSERT_EQUAL_INT((int)count, (int)intern_count());
+}
+
+static void intern_release__string_not_interned__string_freed(void) {
+    //  Arrange.
+    char *interned = intern_string("intern-release-not-interned");
+    char *text     = bstrdup("intern-release-not-interned");
+
+    //  Act.
+    intern_release(&text);
+
+    //  Assert.
+    TEST_ASSERT_NULL(text);
+    TEST_ASSERT_EQUAL_STRING("intern-release-not-interned", interned);
+
+    intern_release(&interned);
+}
+
+static void intern_assign__same_interned_value__value_kept(void) {
+    //  Arrange.
+    char *text = intern_string("intern-assign-same");
+
+    //  Act.
+    intern_assign(&text, text);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_STRING("intern-assign-same", text);
+
+    intern_release(&text);
+}
+
+static void copy_achievement__copy_of_copy__strings_shared(void) {
+    //  Arrange.
+    achievement_t *achievement = bzalloc(sizeof(achievement_t));
+    achievement->id            = bstrdup("copy-achievement-shared-id");
+    achievement->name          = bstrdup("Name");
+    achievement_t *copy        = copy_achievement(achievement);
+    const size_t   count       = intern_count();
+
+    //  Act.
+    achievement_t *second_copy = copy_achievement(copy);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_PTR(copy->id, second_copy->id);
+    TEST_ASSERT_EQUAL_PTR(copy->name, second_copy->name);
+    TEST_ASSERT_EQUAL_INT((int)count, (int)intern_count());
+
+    free_achievement(&achievement);
+    free_achievement(&copy);
+    free_achievement(&second_copy);
+}
+
+static void copy_game__game_copied_twice__strings_shared(void) {
+    //  Arrange.
+    game_t game = {.id = "copy-game-shared-id", .title = "Test Game", .console_name = "xbox"};
+
+    //  Act.
+    game_t *first  = copy_game(&game);
+    game_t *second = copy_game(&game);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_PTR(first->id, second->id);
+    TEST_ASSERT_EQUAL_PTR(first->title, second->title);
+    TEST_ASSERT_NULL(second->cover_url);
+
+    free_game(&first);
+    free_game(&second);
+}
+
 int main(void) {
     UNITY_BEGIN();
 
@@ -1523,6 +1796,11 @@ int main(void) {
     RUN_TEST(copy_gamerscore__no_unlocked_achievements__base_value_returned);
     RUN_TEST(copy_gamerscore__one_unlocked_achievement__total_returned);
     RUN_TEST(copy_gamerscore__two_unlocked_achievements__total_returned);
+    RUN_TEST(copy_gamerscore__unlocked_achievements_added__total_and_tail_copied);
+    RUN_TEST(gamerscore_add_unlocked_achievement__first_achievement__head_and_tail_set);
+    RUN_TEST(gamerscore_add_unlocked_achievement__duplicate_id__counted_once);
+    RUN_TEST(gamerscore_add_unlocked_achievement__index_grown__duplicates_still_found);
+    RUN_TEST(gamerscore_add_unlocked_achievement__null_arguments__false_returned);
 
     //  Tests unlocked_achievement.c
     RUN_TEST(xbox_free_unlocked_achievement__unlocked_achievement_is_null__null_unlocked_achievement_returned);
@@ -1532,6 +1810,13 @@ int main(void) {
     RUN_TEST(xbox_copy_unlocked_achievement__unlocked_achievement_is_not_null__copy_returned);
 
     //  Tests achievement_progress.c
+    RUN_TEST(get_achievement_progress__achievement_is_null__negative_returned);
+    RUN_TEST(get_achievement_progress__unlocked__one_returned);
+    RUN_TEST(get_achievement_progress__locked_not_measured__negative_returned);
+    RUN_TEST(get_achievement_progress__fraction__ratio_returned);
+    RUN_TEST(get_achievement_progress__percentage__ratio_returned);
+    RUN_TEST(get_achievement_progress__invalid_or_zero_target__negative_returned);
+    RUN_TEST(get_achievement_progress__above_target__clamped_to_one);
     RUN_TEST(xbox_free_achievement_progress__achievement_progress_is_null__null_achievement_progress_returned);
     RUN_TEST(xbox_free_achievement_progress__one_achievement_progress__null_achievement_progress_returned);
     RUN_TEST(xbox_free_achievement_progress__two_achievement_progresses__null_achievement_progress_returned);
@@ -1540,5 +1825,14 @@ int main(void) {
     RUN_TEST(xbox_copy_achievement_progress__one_achievement_progress__copy_returned);
     RUN_TEST(xbox_copy_achievement_progress__two_achievement_progresses__copy_returned);
 
+    //  Tests intern.c
+    RUN_TEST(intern_string__same_text_twice__same_pointer_returned);
+    RUN_TEST(intern_string__null_text__null_returned);
+    RUN_TEST(intern_release__last_reference__string_removed_from_pool);
+    RUN_TEST(intern_release__string_not_interned__string_freed);
+    RUN_TEST(intern_assign__same_interned_value__value_kept);
+    RUN_TEST(copy_achievement__copy_of_copy__strings_shared);
+    RUN_TEST(copy_game__game_copied_twice__strings_shared);
+
     return UNITY_END();
 }
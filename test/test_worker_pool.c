@@ -0,0 +1,219 @@
+/**
+ * @file test_worker_pool.c
+ * @brief Unit tests for worker_pool.c — joinable background task queue.
+ */
+
+#include "unity.h"
+
+#include "util/thread_compat.h"
+#include "util/worker_pool.h"
+#include "common/types.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+/* -------------------------------------------------------------------------
+ * Helpers
+ * ---------------------------------------------------------------------- */
+
+static pthread_mutex_t g_counters_mutex = PTHREAD_MUTEX_INITIALIZER;
+static int             g_run_count      = 0;
+static int             g_discard_count  = 0;
+
+/** Set by blocking_task once it has started; set by the test to release it. */
+static bool g_blocking_started = false;
+static bool g_blocking_release = false;
+
+static worker_pool_t *pool = NULL;
+
+static void counting_task(void *data) {
+    (void)data;
+    pthread_mutex_lock(&g_counters_mutex);
+    g_run_count++;
+    pthread_mutex_unlock(&g_counters_mutex);
+}
+
+static bool read_flag(const bool *flag) {
+    pthread_mutex_lock(&g_counters_mutex);
+    bool value = *flag;
+    pthread_mutex_unlock(&g_counters_mutex);
+    return value;
+}
+
+static void set_flag(bool *flag) {
+    pthread_mutex_lock(&g_counters_mutex);
+    *flag = true;
+    pthread_mutex_unlock(&g_counters_mutex);
+}
+
+static void counting_discard(void *data) {
+    (void)data;
+    pthread_mutex_lock(&g_counters_mutex);
+    g_discard_count++;
+    pthread_mutex_unlock(&g_counters_mutex);
+}
+
+/** Keeps the single worker busy until released or the pool stops. */
+static void blocking_task(void *data) {
+    worker_pool_t *owner = data;
+
+    set_flag(&g_blocking_started);
+
+    while (!read_flag(&g_blocking_release) && !worker_pool_is_stopping(owner)) {
+        sleep_ms(1);
+    }
+
+    counting_task(NULL);
+}
+
+#if defined(__linux__)
+/** Name and scheduling policy seen by the worker thread. */
+static char g_thread_name[16];
+static int  g_thread_policy = -1;
+
+static void thread_info_task(void *data) {
+    (void)data;
+    char name[16] = {0};
+    prctl(PR_GET_NAME, name, 0, 0, 0);
+
+    pthread_mutex_lock(&g_counters_mutex);
+    memcpy(g_thread_name, name, sizeof(g_thread_name));
+    g_thread_policy = sched_getscheduler(0);
+    pthread_mutex_unlock(&g_counters_mutex);
+
+    counting_task(NULL);
+}
+#endif
+
+static int get_run_count(void) {
+    pthread_mutex_lock(&g_counters_mutex);
+    int count = g_run_count;
+    pthread_mutex_unlock(&g_counters_mutex);
+    return count;
+}
+
+static void wait_for_run_count(int expected) {
+    for (int i = 0; i < 2000 && get_run_count() < expected; i++) {
+        sleep_ms(1);
+    }
+}
+
+static void wait_for_blocking_task(void) {
+    for (int i = 0; i < 2000 && !read_flag(&g_blocking_started); i++) {
+        sleep_ms(1);
+    }
+}
+
+void setUp(void) {
+    g_run_count        = 0;
+    g_discard_count    = 0;
+    g_blocking_started = false;
+    g_blocking_release = false;
+    pool               = worker_pool_create("Test", THREAD_CLASS_BACKGROUND, 1);
+}
+
+void tearDown(void) {
+    set_flag(&g_blocking_release);
+    worker_pool_destroy(&pool);
+}
+
+/* -------------------------------------------------------------------------
+ * Tests
+ * ---------------------------------------------------------------------- */
+
+void worker_pool_submit__tasks_queued__all_tasks_run(void) {
+    //  Act.
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_TRUE(worker_pool_submit(pool, counting_task, counting_discard, NULL));
+    }
+
+    wait_for_run_count(10);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(10, get_run_count());
+    TEST_ASSERT_EQUAL_INT(0, g_discard_count);
+}
+
+void worker_pool_cancel_pending__worker_busy__queued_tasks_discarded(void) {
+    //  Arrange.
+    worker_pool_submit(pool, blocking_task, NULL, pool);
+    wait_for_blocking_task();
+    worker_pool_submit(pool, counting_task, counting_discard, NULL);
+    worker_pool_submit(pool, counting_task, counting_discard, NULL);
+
+    //  Act.
+    worker_pool_cancel_pending(pool);
+    set_flag(&g_blocking_release);
+    worker_pool_submit(pool, counting_task, counting_discard, NULL);
+    wait_for_run_count(2);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(2, get_run_count());
+    TEST_ASSERT_EQUAL_INT(2, g_discard_count);
+}
+
+void worker_pool_destroy__task_running__task_stopped_and_queue_discarded(void) {
+    //  Arrange.
+    worker_pool_submit(pool, blocking_task, NULL, pool);
+    wait_for_blocking_task();
+    worker_pool_submit(pool, counting_task, counting_discard, NULL);
+
+    //  Act.
+    worker_pool_destroy(&pool);
+
+    //  Assert.
+    TEST_ASSERT_NULL(pool);
+    TEST_ASSERT_EQUAL_INT(1, get_run_count());
+    TEST_ASSERT_EQUAL_INT(1, g_discard_count);
+}
+
+void worker_pool_submit__null_pool__task_discarded(void) {
+    //  Act.
+    bool submitted = worker_pool_submit(NULL, counting_task, counting_discard, NULL);
+
+    //  Assert.
+    TEST_ASSERT_FALSE(submitted);
+    TEST_ASSERT_EQUAL_INT(0, get_run_count());
+    TEST_ASSERT_EQUAL_INT(1, g_discard_count);
+}
+
+void worker_pool_destroy__null_pool__no_crash(void) {
+    //  Arrange.
+    worker_pool_t *none = NULL;
+
+    //  Act.
+    worker_pool_destroy(&none);
+    worker_pool_destroy(NULL);
+
+    //  Assert.
+    TEST_ASSERT_NULL(none);
+}
+
+void worker_pool_create__background_class__worker_named_and_idle_scheduled(void) {
+#if defined(__linux__)
+    //  Act.
+    worker_pool_submit(pool, thread_info_task, NULL, NULL);
+    wait_for_run_count(1);
+
+    //  Assert.
+    pthread_mutex_lock(&g_counters_mutex);
+    TEST_ASSERT_EQUAL_STRING("Test", g_thread_name);
+    TEST_ASSERT_EQUAL_INT(SCHED_IDLE, g_thread_policy);
+    pthread_mutex_unlock(&g_counters_mutex);
+#else
+    TEST_IGNORE_MESSAGE("Thread names and policies are only checked on Linux");
+#endif
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(worker_pool_submit__tasks_queued__all_tasks_run);
+    RUN_TEST(worker_pool_cancel_pending__worker_busy__queued_tasks_discarded);
+    RUN_TEST(worker_pool_destroy__task_running__task_stopped_and_queue_discarded);
+    RUN_TEST(worker_pool_submit__null_pool__task_discarded);
+    RUN_TEST(worker_pool_destroy__null_pool__no_crash);
+    RUN_TEST(worker_pool_create__background_class__worker_named_and_idle_scheduled);
+
+    return UNITY_END();
+}
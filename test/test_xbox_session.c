@@ -275,9 +275,7 @@ static void xbox_session_compute_gamerscore__session_has_one_unlocked_achievemen
     session->gamerscore             = bzalloc(sizeof(gamerscore_t));
     session->gamerscore->base_value = 1000;
 
-    session->gamerscore->unlocked_achievements        = bzalloc(sizeof(xbox_unlocked_achievement_t));
-    session->gamerscore->unlocked_achievements->value = 50;
-    session->gamerscore->unlocked_achievements->next  = NULL;
+    gamerscore_add_unlocked_achievement(session->gamerscore, "achievement-a", 50);
 
     //  Act.
     int total_gamerscore = xbox_session_compute_gamerscore(session);
@@ -291,12 +289,8 @@ static void xbox_session_compute_gamerscore__session_has_two_unlocked_achievemen
     session->gamerscore             = bzalloc(sizeof(gamerscore_t));
     session->gamerscore->base_value = 1000;
 
-    session->gamerscore->unlocked_achievements        = bzalloc(sizeof(xbox_unlocked_achievement_t));
-    session->gamerscore->unlocked_achievements->value = 50;
-
-    session->gamerscore->unlocked_achievements->next        = bzalloc(sizeof(xbox_unlocked_achievement_t));
-    session->gamerscore->unlocked_achievements->next->value = 80;
-    session->gamerscore->unlocked_achievements->next->next  = NULL;
+    gamerscore_add_unlocked_achievement(session->gamerscore, "achievement-a", 50);
+    gamerscore_add_unlocked_achievement(session->gamerscore, "achievement-b", 80);
 
     //  Act.
     int total_gamerscore = xbox_session_compute_gamerscore(session);
@@ -338,6 +332,42 @@ static void xbox_session_unlock_achievement__two_achievements_unlocked__gamersco
     TEST_ASSERT_EQUAL(total_gamerscore, 1000 + 500 + 80);
 }
 
+static void xbox_session_unlock_achievement__same_achievement_unlocked_twice__gamerscore_counted_once(void) {
+    //  Arrange.
+    xbox_achievement_t *achievements = xbox_copy_achievement(achievement_1);
+    achievements->next               = xbox_copy_achievement(achievement_2);
+
+    session->achievements = achievements;
+
+    //  Act.
+    xbox_session_unlock_achievement(session, achievement_progress_2);
+    xbox_session_unlock_achievement(session, achievement_progress_2);
+
+    //  Assert.
+    int total_gamerscore = xbox_session_compute_gamerscore(session);
+    TEST_ASSERT_EQUAL(total_gamerscore, 1000 + 500);
+}
+
+static void xbox_session_unlock_achievement__already_unlocked__achievement_untouched(void) {
+    //  Arrange.
+    xbox_achievement_t *achievements = xbox_copy_achievement(achievement_1);
+    achievements->next               = xbox_copy_achievement(achievement_2);
+
+    session->achievements = achievements;
+
+    achievement_progress_2->unlocked_timestamp = 1700000000;
+    const bool first                           = xbox_session_unlock_achievement(session, achievement_progress_2);
+
+    //  Act.
+    achievement_progress_2->unlocked_timestamp = 1800000000;
+    const bool second                          = xbox_session_unlock_achievement(session, achievement_progress_2);
+
+    //  Assert.
+    TEST_ASSERT_TRUE(first);
+    TEST_ASSERT_FALSE(second);
+    TEST_ASSERT_EQUAL_INT64(1700000000, xbox_session_get_last_unlock_timestamp(session));
+}
+
 static void xbox_session_unlock_achievement__unknown_achievements_unlocked__gamerscore_unchanged(void) {
     //  Act.
     xbox_session_unlock_achievement(session, achievement_progress_1);
@@ -364,6 +394,94 @@ static void xbox_session_unlock_achievement__no_reward_found__gamerscore_unchang
     TEST_ASSERT_EQUAL(total_gamerscore, 1000);
 }
 
+//   Test xbox_session_get_last_unlock_timestamp
+
+static void xbox_session_get_last_unlock_timestamp__no_unlocked_achievement__0_returned(void) {
+    //  Arrange.
+    session->achievements = xbox_copy_achievement(achievement_1);
+
+    //  Act & Assert.
+    TEST_ASSERT_EQUAL_INT64(0, xbox_session_get_last_unlock_timestamp(session));
+}
+
+static void xbox_session_get_last_unlock_timestamp__two_unlocked_achievements__latest_returned(void) {
+    //  Arrange.
+    xbox_achievement_t *achievements = xbox_copy_achievement(achievement_1);
+    achievements->next               = xbox_copy_achievement(achievement_2);
+
+    achievements->unlocked_timestamp       = 1700000200;
+    achievements->next->unlocked_timestamp = 1700000100;
+
+    session->achievements = achievements;
+
+    //  Act & Assert.
+    TEST_ASSERT_EQUAL_INT64(1700000200, xbox_session_get_last_unlock_timestamp(session));
+}
+
+//   Test xbox_session_find_missed_unlocks
+
+static void xbox_session_find_missed_unlocks__one_achievement_unlocked_remotely__progress_returned(void) {
+    //  Arrange.
+    xbox_achievement_t *achievements = xbox_copy_achievement(achievement_1);
+    achievements->next               = xbox_copy_achievement(achievement_2);
+
+    session->achievements = achievements;
+
+    xbox_achievement_t *unlocked = xbox_copy_achievement(achievement_2);
+    unlocked->unlocked_timestamp = 1700000100;
+
+    //  Act.
+    xbox_achievement_progress_t *missed = xbox_session_find_missed_unlocks(session, unlocked);
+
+    //  Assert.
+    TEST_ASSERT_NOT_NULL(missed);
+    TEST_ASSERT_EQUAL_STRING(achievement_2->id, missed->id);
+    TEST_ASSERT_EQUAL_STRING("Achieved", missed->progress_state);
+    TEST_ASSERT_EQUAL_INT64(1700000100, missed->unlocked_timestamp);
+    TEST_ASSERT_NULL(missed->next);
+
+    xbox_session_unlock_achievement(session, missed);
+    TEST_ASSERT_EQUAL(1000 + 500, xbox_session_compute_gamerscore(session));
+
+    xbox_free_achievement_progress(&missed);
+    xbox_free_achievement(&unlocked);
+}
+
+static void xbox_session_find_missed_unlocks__achievement_already_unlocked__null_returned(void) {
+    //  Arrange.
+    xbox_achievement_t *achievements = xbox_copy_achievement(achievement_1);
+    achievements->unlocked_timestamp = 1700000100;
+
+    session->achievements = achievements;
+
+    xbox_achievement_t *unlocked = xbox_copy_achievement(achievement_1);
+    unlocked->unlocked_timestamp = 1700000100;
+
+    //  Act.
+    xbox_achievement_progress_t *missed = xbox_session_find_missed_unlocks(session, unlocked);
+
+    //  Assert.
+    TEST_ASSERT_NULL(missed);
+
+    xbox_free_achievement(&unlocked);
+}
+
+static void xbox_session_find_missed_unlocks__unknown_achievement__null_returned(void) {
+    //  Arrange.
+    session->achievements = xbox_copy_achievement(achievement_1);
+
+    xbox_achievement_t *unlocked = xbox_copy_achievement(achievement_2);
+    unlocked->unlocked_timestamp = 1700000100;
+
+    //  Act.
+    xbox_achievement_progress_t *missed = xbox_session_find_missed_unlocks(session, unlocked);
+
+    //  Assert.
+    TEST_ASSERT_NULL(missed);
+
+    xbox_free_achievement(&unlocked);
+}
+
 int main(void) {
     UNITY_BEGIN();
     //  Test xbox_session_is_game_played
@@ -388,5 +506,14 @@ int main(void) {
     RUN_TEST(xbox_session_unlock_achievement__no_reward_found__gamerscore_unchanged);
     RUN_TEST(xbox_session_unlock_achievement__one_achievement_unlocked__gamerscore_incremented);
     RUN_TEST(xbox_session_unlock_achievement__two_achievements_unlocked__gamerscore_incremented);
+    RUN_TEST(xbox_session_unlock_achievement__same_achievement_unlocked_twice__gamerscore_counted_once);
+    RUN_TEST(xbox_session_unlock_achievement__already_unlocked__achievement_untouched);
+
+    RUN_TEST(xbox_session_get_last_unlock_timestamp__no_unlocked_achievement__0_returned);
+    RUN_TEST(xbox_session_get_last_unlock_timestamp__two_unlocked_achievements__latest_returned);
+
+    RUN_TEST(xbox_session_find_missed_unlocks__one_achievement_unlocked_remotely__progress_returned);
+    RUN_TEST(xbox_session_find_missed_unlocks__achievement_already_unlocked__null_returned);
+    RUN_TEST(xbox_session_find_missed_unlocks__unknown_achievement__null_returned);
     return UNITY_END();
 }
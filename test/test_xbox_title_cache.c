@@ -0,0 +1,99 @@
+/**
+ * @file test_xbox_title_cache.c
+ * @brief Unit tests for xbox_title_cache.c — title resolution and eviction.
+ */
+
+#include "unity.h"
+
+#include "common/types.h"
+#include "common/intern.h"
+#include "integrations/xbox/xbox_title_cache.h"
+
+#include <stdio.h>
+
+static game_t *game;
+
+void setUp(void) {
+    game               = alloc_game();
+    game->id           = intern_string("1915865634");
+    game->title        = intern_string("Forza Horizon 5");
+    game->console_name = intern_string("xbox");
+}
+
+void tearDown(void) {
+    free_game(&game);
+    xbox_title_cache_clear();
+}
+
+/* -------------------------------------------------------------------------
+ * Tests
+ * ---------------------------------------------------------------------- */
+
+void xbox_title_cache_resolve__unknown_title__null_returned(void) {
+    //  Act & Assert.
+    TEST_ASSERT_NULL(xbox_title_cache_resolve("1915865634"));
+}
+
+void xbox_title_cache_resolve__title_put__copy_returned(void) {
+    //  Arrange.
+    xbox_title_cache_put(game);
+
+    //  Act.
+    game_t *resolved = xbox_title_cache_resolve("1915865634");
+
+    //  Assert.
+    TEST_ASSERT_NOT_NULL(resolved);
+    TEST_ASSERT_TRUE(resolved != game);
+    TEST_ASSERT_EQUAL_STRING("Forza Horizon 5", resolved->title);
+    TEST_ASSERT_EQUAL_STRING("xbox", resolved->console_name);
+
+    free_game(&resolved);
+}
+
+void xbox_title_cache_put__same_title_put_twice__entry_replaced(void) {
+    //  Arrange.
+    xbox_title_cache_put(game);
+    intern_assign((char **)&game->title, "Forza Horizon 5 Premium Edition");
+
+    //  Act.
+    xbox_title_cache_put(game);
+    game_t *resolved = xbox_title_cache_resolve("1915865634");
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_STRING("Forza Horizon 5 Premium Edition", resolved->title);
+
+    free_game(&resolved);
+}
+
+void xbox_title_cache_put__capacity_exceeded__oldest_title_evicted(void) {
+    //  Arrange.
+    xbox_title_cache_put(game);
+
+    //  Act.
+    for (int i = 0; i < XBOX_TITLE_CACHE_CAPACITY; i++) {
+        char id[16];
+        snprintf(id, sizeof(id), "%d", i);
+        intern_assign((char **)&game->id, id);
+        xbox_title_cache_put(game);
+    }
+
+    //  Assert.
+    game_t *evicted = xbox_title_cache_resolve("1915865634");
+    game_t *kept    = xbox_title_cache_resolve("0");
+
+    TEST_ASSERT_NULL(evicted);
+    TEST_ASSERT_NOT_NULL(kept);
+
+    free_game(&kept);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(xbox_title_cache_resolve__unknown_title__null_returned);
+    RUN_TEST(xbox_title_cache_resolve__title_put__copy_returned);
+    RUN_TEST(xbox_title_cache_put__same_title_put_twice__entry_replaced);
+    RUN_TEST(xbox_title_cache_put__capacity_exceeded__oldest_title_evicted);
+
+    return UNITY_END();
+}